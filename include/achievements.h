@@ -4,7 +4,7 @@
  * 
  * Achievement model, categories, and public API
  *
- * Exposes the Achievement type, constants, criteria function prototypes,
+ * Exposes the Achievement type, the data-driven definition table,
  * and management routines (init, save/load, unlock, listing).
  */
 
@@ -17,23 +17,154 @@
 /* Limits and storage                                                        */
 /* ------------------------------------------------------------------------- */
 
-#define MAX_ACHIEVEMENTS                 25
-
-#define MAX_GENERAL_ACHIEVEMENTS          6
-#define MAX_BLACKJACK_ACHIEVEMENTS        5
-#define MAX_SOLITAIRE_ACHIEVEMENTS        5
-#define MAX_IDIOT_ACHIEVEMENTS            5
-#define MAX_HIDDEN_ACHIEVEMENTS           4
+#define MAX_ACHIEVEMENTS                256
 
 #define MAX_ACHIEVEMENT_NAME_LENGTH      64
 #define MAX_ACHIEVEMENT_DESCRIPTION_LENGTH 128
 
-#define ACHIEVEMENT_SAVE                  "achievements/achievements.dat"
+/* Every definition is an AND of this many (stat, comparator, threshold) clauses. */
+#define ACH_MAX_CLAUSES                   2
+
+/* ------------------------------------------------------------------------- */
+/* Categories, stats, comparators                                            */
+/* ------------------------------------------------------------------------- */
+
+typedef enum {
+    ACH_CAT_GENERAL,
+    ACH_CAT_BLACKJACK,
+    ACH_CAT_SOLITAIRE,
+    ACH_CAT_IDIOT,
+    ACH_CAT_HIDDEN,               /* only listed once unlocked */
+
+    ACH_CAT_COUNT
+} AchievementCategory;
+
+/*
+ * Stat counters achievements can depend on. checkAchievements() detects
+ * which of these changed since the last evaluation and only re-runs the
+ * definitions that read them.
+ */
+typedef enum {
+    STAT_GAMES_PLAYED,
+    STAT_TOTAL_WINS,
+    STAT_BJ_BLACKJACK_WINS,
+    STAT_BJ_DOUBLEDOWN_WINS,
+    STAT_BJ_INSURANCE_SUCCESS,
+    STAT_BJ_SPLIT_WINS,
+    STAT_BJ_MAX_WIN_STREAK,
+    STAT_SOL_PERFECT_CLEAR,
+    STAT_SOL_EASY_WINS,
+    STAT_SOL_NORMAL_WINS,
+    STAT_SOL_HARD_WINS,
+    STAT_SOL_LONGEST_GAME,
+    STAT_IDIOT_WINS,
+    STAT_IDIOT_MIRROR_MATCH,
+    STAT_IDIOT_BURNS,
+    STAT_IDIOT_FOUR_KIND_BURNS,
+    STAT_IDIOT_TRICKSTER_WINS,
+    STAT_TIME_PLAYED_HOURS,
+    STAT_STARTING_BALANCE,
+    STAT_PLAYER_MONEY,
+    STAT_UNLOCKED_COUNT,          /* derived: number of unlocked achievements */
+    STAT_NONE,                    /* constant 0; fills unused clauses         */
+
+    STAT_FIELD_COUNT
+} StatField;
+
+#define STAT_BIT(field)           (1u << (field))
+
+typedef enum {
+    ACH_CMP_GE,                   /* stat >= threshold */
+    ACH_CMP_LT                    /* stat <  threshold */
+} AchievementCmp;
+
+/* ------------------------------------------------------------------------- */
+/* Definitions                                                               */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * The achievement table. Each row is
+ *   X(id, category, name, description, stat, cmp, threshold, stat2, cmp2, threshold2)
+ * and single-clause rows pad the second clause with (STAT_NONE, ACH_CMP_GE, 0),
+ * which is always true. Row order is the on-screen order within a category.
+ * Adding an achievement is one new row; no code changes are needed.
+ */
+#define ACHIEVEMENT_DEFINITIONS(X) \
+    /* General */ \
+    X(ACH_FIRST_SHUFFLE,        ACH_CAT_GENERAL,   "First Shuffle",        "Play your first game.", \
+      STAT_GAMES_PLAYED,          ACH_CMP_GE, 1,         STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_PERSISTENT_PLAYER,    ACH_CAT_GENERAL,   "Persistent Player",    "Play 100 games.", \
+      STAT_GAMES_PLAYED,          ACH_CMP_GE, 100,       STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_CARD_NOVICE,          ACH_CAT_GENERAL,   "Card Novice",          "Win 5 games.", \
+      STAT_TOTAL_WINS,            ACH_CMP_GE, 5,         STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_CARD_APPRENTICE,      ACH_CAT_GENERAL,   "Card Apprentice",      "Win 10 games.", \
+      STAT_TOTAL_WINS,            ACH_CMP_GE, 10,        STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_CARD_PROFIT,          ACH_CAT_GENERAL,   "Card Profit",          "Win 25 games.", \
+      STAT_TOTAL_WINS,            ACH_CMP_GE, 25,        STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_CARD_MASTER,          ACH_CAT_GENERAL,   "Card Master",          "Win 50 games.", \
+      STAT_TOTAL_WINS,            ACH_CMP_GE, 50,        STAT_NONE,         ACH_CMP_GE, 0) \
+    \
+    /* 21 Blackjack */ \
+    X(ACH_BLACKJACK_WIN,        ACH_CAT_BLACKJACK, "21 Blackjack",         "Win with a blackjack.", \
+      STAT_BJ_BLACKJACK_WINS,     ACH_CMP_GE, 1,         STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_DOUBLE_TROUBLE,       ACH_CAT_BLACKJACK, "Double Trouble",       "Win or Draw after doubling down.", \
+      STAT_BJ_DOUBLEDOWN_WINS,    ACH_CMP_GE, 1,         STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_INSURANCE_PAYOUT,     ACH_CAT_BLACKJACK, "Insurance Payout",     "Successfully use insurance.", \
+      STAT_BJ_INSURANCE_SUCCESS,  ACH_CMP_GE, 1,         STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_RISK_TAKER,           ACH_CAT_BLACKJACK, "Risk Taker",           "Win both hands after splitting.", \
+      STAT_BJ_SPLIT_WINS,         ACH_CMP_GE, 1,         STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_LUCKY_STREAK,         ACH_CAT_BLACKJACK, "Lucky Streak",         "Win 10 games in a row.", \
+      STAT_BJ_MAX_WIN_STREAK,     ACH_CMP_GE, 10,        STAT_NONE,         ACH_CMP_GE, 0) \
+    \
+    /* Solitaire */ \
+    X(ACH_PERFECT_CLEAR,        ACH_CAT_SOLITAIRE, "Perfect Clear",        "Win without using an undo.", \
+      STAT_SOL_PERFECT_CLEAR,     ACH_CMP_GE, 1,         STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_SOLITAIRE_NOVICE,     ACH_CAT_SOLITAIRE, "Solitaire Novice",     "Win 1 game on easy difficulty.", \
+      STAT_SOL_EASY_WINS,         ACH_CMP_GE, 1,         STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_SOLITAIRE_APPRENTICE, ACH_CAT_SOLITAIRE, "Solitaire Apprentice", "Win 1 game on normal difficulty.", \
+      STAT_SOL_NORMAL_WINS,       ACH_CMP_GE, 1,         STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_SOLITAIRE_MASTER,     ACH_CAT_SOLITAIRE, "Solitaire Master",     "Win 1 game on hard difficulty.", \
+      STAT_SOL_HARD_WINS,         ACH_CMP_GE, 1,         STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_THE_LONG_GAME,        ACH_CAT_SOLITAIRE, "The Long Game",        "Take at least 30 minutes to complete a game.", \
+      STAT_SOL_LONGEST_GAME,      ACH_CMP_GE, 30,        STAT_NONE,         ACH_CMP_GE, 0) \
+    \
+    /* Idiot */ \
+    X(ACH_NOT_THE_IDIOT,        ACH_CAT_IDIOT,     "Not the Idiot",        "Win 1 game of Idiot.", \
+      STAT_IDIOT_WINS,            ACH_CMP_GE, 1,         STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_MIRROR_MATCH,         ACH_CAT_IDIOT,     "Mirror Match",         "Play a 3 against another 3.", \
+      STAT_IDIOT_MIRROR_MATCH,    ACH_CMP_GE, 1,         STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_PYROTECHNIC,          ACH_CAT_IDIOT,     "Pyrotechnic",          "Burn the pile 10 times.", \
+      STAT_IDIOT_BURNS,           ACH_CMP_GE, 10,        STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_FOUR_OF_A_KIND,       ACH_CAT_IDIOT,     "4 of a Kind",          "Burn the pile with 4 of a kind.", \
+      STAT_IDIOT_FOUR_KIND_BURNS, ACH_CMP_GE, 1,         STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_THE_TRICKSTER,        ACH_CAT_IDIOT,     "The Trickster",        "Win a game without picking up the pile.", \
+      STAT_IDIOT_TRICKSTER_WINS,  ACH_CMP_GE, 1,         STAT_NONE,         ACH_CMP_GE, 0) \
+    \
+    /* Hidden */ \
+    X(ACH_TIME_MASTER,          ACH_CAT_HIDDEN,    "Time Master",          "Play for at least 1 hour.", \
+      STAT_TIME_PLAYED_HOURS,     ACH_CMP_GE, 1,         STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_INFINITE_WEALTH,      ACH_CAT_HIDDEN,    "Infinite Wealth",      "Have a starting balance of at least $1,000,000.", \
+      STAT_STARTING_BALANCE,      ACH_CMP_GE, 1000000,   STAT_NONE,         ACH_CMP_GE, 0) \
+    X(ACH_RAGS_TO_RICHES,       ACH_CAT_HIDDEN,    "From Rags to Riches",  "Start with a balance less than $100 and earn at least $10,000.", \
+      STAT_STARTING_BALANCE,      ACH_CMP_LT, 100,       STAT_PLAYER_MONEY, ACH_CMP_GE, 10000) \
+    /* Keep last: needs every other achievement (ACH_COUNT - 1 of them). */ \
+    X(ACH_THE_COLLECTOR,        ACH_CAT_HIDDEN,    "The Collector",        "Collect all achievements.", \
+      STAT_UNLOCKED_COUNT,        ACH_CMP_GE, ACH_COUNT - 1, STAT_NONE,     ACH_CMP_GE, 0)
+
+/* Integer IDs; the value is also the slot in achievements[]. */
+#define ACH_ENUM_ENTRY(id, ...)   id,
+typedef enum {
+    ACHIEVEMENT_DEFINITIONS(ACH_ENUM_ENTRY)
+
+    ACH_COUNT
+} AchievementId;
+#undef ACH_ENUM_ENTRY
 
 /* ------------------------------------------------------------------------- */
 /* Data types                                                                */
 /* ------------------------------------------------------------------------- */
 
+/* Runtime/persisted record (the save file is an array of these). */
 typedef struct {
     char name[MAX_ACHIEVEMENT_NAME_LENGTH];
     char description[MAX_ACHIEVEMENT_DESCRIPTION_LENGTH];
@@ -41,59 +172,24 @@ typedef struct {
     bool hidden_unlocked;
 } Achievement;
 
-/* Each entry pairs a display name with a boolean predicate to unlock it. */
+/* One compact, read-only table row (expanded from ACHIEVEMENT_DEFINITIONS). */
 typedef struct {
-    const char *name;
-    bool (*criteria_func)(void);
-} AchievementCheck;
+    const char        *name;
+    const char        *description;
+    uint8_t            category;                     /* AchievementCategory */
+    uint8_t            stat[ACH_MAX_CLAUSES];        /* StatField           */
+    uint8_t            cmp[ACH_MAX_CLAUSES];         /* AchievementCmp      */
+    unsigned long long threshold[ACH_MAX_CLAUSES];
+} AchievementDef;
 
 /* ------------------------------------------------------------------------- */
 /* External state                                                            */
 /* ------------------------------------------------------------------------- */
 
 extern Achievement achievements[MAX_ACHIEVEMENTS];
-extern AchievementCheck achievementChecks[];
+extern const AchievementDef achievementDefs[ACH_COUNT];
 extern int achievement_count;
 
-/* ------------------------------------------------------------------------- */
-/* Criteria prototypes                                                       */
-/* ------------------------------------------------------------------------- */
-
-/* General */
-bool firstShuffleCriteria(void);
-bool persistentPlayerCriteria(void);
-bool cardNoviceCriteria(void);
-bool cardApprenticeCriteria(void);
-bool cardProfitCriteria(void);
-bool cardMasterCriteria(void);
-
-/* 21 Blackjack */
-bool blackjackWinCriteria(void);
-bool doubleTroubleCriteria(void);
-bool insurancePayoutCriteria(void);
-bool riskTakerCriteria(void);
-bool luckyStreakCriteria(void);
-
-/* Solitaire */
-bool perfectClearCriteria(void);
-bool solitaireNoviceCriteria(void);
-bool solitaireApprenticeCriteria(void);
-bool solitaireMasterCriteria(void);
-bool theLongGameCriteria(void);
-
-/* Idiot */
-bool notTheIdiotCriteria(void);
-bool mirrorMatchCriteria(void);
-bool pyrotechnicCriteria(void);
-bool fourOfAKindCriteria(void);
-bool theTricksterCriteria(void);
-
-/* Hidden */
-bool timeMasterCriteria(void);
-bool infiniteWealthCriteria(void);
-bool fromRagsToRichesCriteria(void);
-bool theCollectorCriteria(void);
-
 /* ------------------------------------------------------------------------- */
 /* Public API                                                                */
 /* ------------------------------------------------------------------------- */
@@ -103,11 +199,22 @@ int  add_achievement(const char *name, const char *description);
 int  unlock_achievement(const char *name);
 int  is_achievement_unlocked(const char *name);
 void list_achievements(void);
+
+/* O(1) variants keyed by AchievementId (bitset lookups, no string compares). */
+int  unlock_achievement_id(AchievementId id);
+int  is_achievement_unlocked_id(AchievementId id);
+
+/* Lock every achievement and force a full re-evaluation on the next check. */
+void reset_achievements_state(void);
+
 int  save_achievements(void);
 int  load_achievements(void);
 
+/* Category of the achievement in slot index (ACH_CAT_GENERAL if unknown). */
+AchievementCategory achievement_category(int index);
+
 /* Utility render helpers */
-void printAchievementCategory(const char *categoryName, int start, int count);
+void printAchievementCategory(const char *categoryName, AchievementCategory category);
 
 /* Evaluate and unlock newly met criteria */
 void checkAchievements(void);
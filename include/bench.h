@@ -0,0 +1,27 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Headless benchmark suite (`--bench`).
+ *
+ * Runs fixed, seeded workloads over the hot kernels without touching saves
+ * or the terminal, and prints one line per kernel:
+ *
+ *   bench <kernel> <throughput> <unit>
+ *
+ * The makefile uses it as the PGO training run, and
+ * scripts/bench_compare.sh compares its output across build variants.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+/**
+ * bench_run
+ * Run every kernel and print the results to stdout.
+ *
+ * @return process exit code (0 on success).
+ */
+int bench_run(void);
+
+#endif /* BENCH_H */
@@ -2,61 +2,36 @@
  * @author: Anthony Ward
  * @upload date: 08/24/2025
  * 
- * 21 Blackjack public surface + shared types
+ * 21 Blackjack public surface
  *
- * Exposes the Hand type, a Shoe container for multi-deck play,
- * and the public functions to run Blackjack and show the how-to.
+ * Exposes the public functions to run Blackjack and show the how-to. The
+ * Hand and Shoe types, hand evaluation, the dealer policy and settlement
+ * come from libcardsim (cardsim.h, src/engine/blackjack.c).
  *
  * Uses config.num_decks (clamped to 1..8) to size the shoe.
  * The shoe is shuffled at init and re-shuffled only when running low.
+ *
+ * Settled hands go to the round's CsStatsSink (the profile sink from
+ * stats.h in the game), not straight into playerData.
  */
 
 #ifndef BLACKJACK_H
 #define BLACKJACK_H
 
 #include "core.h"
-
-/* ------------------------------------------------------------------------- */
-/* Game constants                                                            */
-/* ------------------------------------------------------------------------- */
-
-#define MAX_HAND_CARDS            12     /* Max cards a hand can hold.      */
-#define MAX_SHOE_DECKS            8      /* Hard cap for config.num_decks.  */
-/* Cut-card penetration: reshuffle when >= this % of the shoe has been dealt.
-   Typical casinos use ~75–85%. Change this single value to tune. */
-#define CUT_CARD_PENETRATION_PERCENT 80
-
-/* ------------------------------------------------------------------------- */
-/* Core containers                                                           */
-/* ------------------------------------------------------------------------- */
-
-/**
- * Hand
- * One Blackjack hand with its wager and flags.
- */
-typedef struct {
-    Card          cards[MAX_HAND_CARDS];
-    int           count;            /* number of cards in this hand          */
-    unsigned int  bet;              /* wager associated with this hand       */
-    int           surrendered;      /* 1 if player surrendered this hand     */
-    bool          doubled;          /* true if doubled down                  */
-    int           fromSplit;        /* 1 if this hand originated from split  */
-} Hand;
+#include "gametimer.h"
 
 /**
- * Shoe
- * Multi-deck deal shoe. The next card to deal is at cards[next_index].
- *
- * Invariants:
- *  - 0 <= next_index <= total
- *  - total == decks_in_shoe * DECK_SIZE
+ * BlackjackRound
+ * Per-round context: where settled hands go, the round timer, and the
+ * insurance outcome that rides along with the next recorded hand.
  */
 typedef struct {
-    Card cards[MAX_SHOE_DECKS * DECK_SIZE];
-    int  total;        /* total cards in the shoe               */
-    int  next_index;   /* next card to deal                     */
-    int  decks_in_shoe;/* number of decks used (1..MAX_SHOE_DECKS) */
-} Shoe;
+    CsStatsSink stats;
+    GameTimer   timer;
+    uint16_t    decisions;      /* round-wide flags (insurance)               */
+    int64_t     insuranceNet;   /* settled insurance, charged to the next row */
+} BlackjackRound;
 
 /* ------------------------------------------------------------------------- */
 /* Public API                                                                */
@@ -67,11 +42,12 @@ void blackjack_start(void);
 
 /* Round helpers exposed elsewhere in your codebase */
 unsigned int get_valid_bet(unsigned int minBet, unsigned int maxBet);
-void         handle_insurance(Hand *dealerHand);
-void         handle_blackjack(Hand *dealerHand, unsigned int bet);
+void         handle_insurance(BlackjackRound *round, Hand *dealerHand);
+void         handle_blackjack(BlackjackRound *round, Hand *dealerHand, unsigned int bet);
 bool         handle_split(Shoe *shoe, Hand *playerHand1, Hand *playerHand2, unsigned int bet);
 void         dealer_play(Shoe *shoe, Hand *dealerHand, int roundNumber);
-void         resolve_hands(bool isSplit, Hand *playerHand1, Hand *playerHand2, Hand *dealerHand);
+void         resolve_hands(BlackjackRound *round, bool isSplit, Hand *playerHand1, Hand *playerHand2,
+                           Hand *dealerHand);
 bool         play_again(void);
 
 #endif /* BLACKJACK_H */
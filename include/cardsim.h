@@ -0,0 +1,1012 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * libcardsim — the card game engines behind a C API.
+ *
+ * Everything the games do that is not UI: cards and decks, a Blackjack shoe
+ * and round engine, the Klondike model and solver, and the Idiot rules and
+ * AI. The terminal games in this repo are clients of it; `make lib` builds
+ * it on its own as build/lib/libcardsim.a and libcardsim.so (.dll on
+ * Windows) for embedding elsewhere.
+ *
+ * Rules of the API:
+ *   - No globals. Every function works only on the objects passed in, so
+ *     independent objects may be used from different threads at once (one
+ *     object per thread; none of them lock).
+ *   - No I/O: nothing prints, reads input or touches the filesystem.
+ *   - Randomness only through an explicit CsRng, so a seed fully determines
+ *     a shoe, a deal or a self-played game.
+ *   - Results only through an explicit CsStatsSink: an engine never keeps
+ *     counters of its own, the caller decides where settled rounds go.
+ *   - The structs below are part of the API. Changing a layout or a
+ *     constant bumps CARDSIM_API_VERSION.
+ *
+ * Card strings point at static tables inside the library (or the caller's
+ * own literals); the engines compare them by content, never by address.
+ * Cards the library builds also carry their id, so game rules read values
+ * from the cs_card_info table instead of parsing the strings.
+ * Anything that leaves the process (saves, the server, corpora) goes
+ * through the pointer-free snapshots at the end of this header instead.
+ */
+
+#ifndef CARDSIM_H
+#define CARDSIM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define CARDSIM_API_VERSION  5
+
+/* ------------------------------------------------------------------------- */
+/* Cards and decks                                                           */
+/* ------------------------------------------------------------------------- */
+
+#define NUM_SUITS   4
+#define NUM_RANKS   13
+#define DECK_SIZE   52
+
+/* Standardized difficulty identifiers (Klondike deal rules, Idiot AI). */
+#define DIFFICULTY_EASY      1   /* Klondike: draw 1, recycling, undo allowed. */
+#define DIFFICULTY_NORMAL    2   /* Klondike: draw 1, no recycling, no undo.   */
+#define DIFFICULTY_HARD      3   /* Klondike: draw 3, no recycling, no undo.   */
+
+/**
+ * Card
+ * A playing card identified by (suit, rank).
+ * 'revealed' is used by Solitaire to control face-down rendering.
+ * 'is_joker' is used by games that allow jokers (e.g., Idiot).
+ * 'code' is cs_card_id() + 1 for cards built by the library (decks,
+ * cs_card_from_id()); 0 means "not known yet, read the strings". Code that
+ * repoints suit/rank must clear it.
+ */
+typedef struct {
+    char    *suit;
+    char    *rank;
+    int      revealed;
+    bool     is_joker;
+    uint8_t  code;
+} Card;
+
+/**
+ * CsRng
+ * Explicit random stream (splitmix64). Seed it once; copy it to fork a
+ * stream. Zero is a valid seed.
+ */
+typedef struct {
+    uint64_t state;
+} CsRng;
+
+void     cs_rng_seed (CsRng *rng, uint64_t seed);
+uint64_t cs_rng_next (CsRng *rng);
+
+/** Uniform integer in [0, bound) without modulo bias (0 when bound is 0). */
+uint32_t cs_rng_below(CsRng *rng, uint32_t bound);
+
+/** Fill `deck` (DECK_SIZE cards) in suit-major order, face down, no jokers. */
+void cs_deck_init(Card *deck);
+
+/** Fisher–Yates shuffle of `count` cards. */
+void cs_deck_shuffle(Card *cards, int count, CsRng *rng);
+
+/* Compact card ids: suit * NUM_RANKS + rank (2..Ace as 0..12) in the
+   cs_deck_init() order, so 0..51; Jokers are CS_CARD_JOKER. The face-up
+   flag is not part of the id. */
+#define CS_CARD_JOKER   52
+#define CS_CARD_COUNT   53
+
+/** Id of `card`; -1 if its strings are not a known suit and rank. */
+int  cs_card_id(Card card);
+
+/** The face-down card for `id`, pointing at the library's string tables. */
+Card cs_card_from_id(int id);
+
+/**
+ * CsCardInfo
+ * Everything the games derive from a card, precomputed per card id. The
+ * table has CS_CARD_COUNT + 1 rows; the last one (no game values, no name)
+ * stands for cards whose strings are not a known suit and rank.
+ */
+typedef struct {
+    uint8_t     suit;             /* 0..3 in cs_deck_init() order; 4 otherwise    */
+    uint8_t     rank;             /* 0..12 for 2..Ace; 13 Joker, 14 unknown       */
+    uint8_t     blackjackValue;   /* 2..10, Ace=11 (hands drop it to 1)           */
+    uint8_t     idiotValue;       /* 2..14, Ace=14; the Joker plays as a 3        */
+    uint8_t     klondikeRank;     /* Ace=1 .. King=13                             */
+    bool        red;              /* Hearts/Diamonds                              */
+    const char *name;             /* "Queen of Spades", "Joker"; NULL if unknown  */
+} CsCardInfo;
+
+extern const CsCardInfo cs_card_info[CS_CARD_COUNT + 1];
+
+/** Row of `card` in cs_card_info: its id, or CS_CARD_COUNT if unknown. */
+static inline int cs_card_index(const Card *card)
+{
+    if (card->code) return card->code - 1;
+    const int id = cs_card_id(*card);
+    return id < 0 ? CS_CARD_COUNT : id;
+}
+
+static inline const CsCardInfo *cs_card_meta(const Card *card) { return &cs_card_info[cs_card_index(card)]; }
+
+static inline int  cs_card_blackjack_value(const Card *card) { return cs_card_meta(card)->blackjackValue; }
+static inline int  cs_card_klondike_rank  (const Card *card) { return cs_card_meta(card)->klondikeRank; }
+static inline bool cs_card_red            (const Card *card) { return cs_card_meta(card)->red; }
+
+/** Same rank (Jokers match Jokers), whatever the suits. */
+static inline bool cs_card_same_rank(const Card *a, const Card *b)
+{
+    return cs_card_meta(a)->rank == cs_card_meta(b)->rank;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Stats sinks                                                               */
+/* ------------------------------------------------------------------------- */
+
+typedef enum {
+    CS_GAME_BLACKJACK = 1,
+    CS_GAME_KLONDIKE  = 2,
+    CS_GAME_IDIOT     = 3
+} CsGame;
+
+typedef enum {
+    CS_OUTCOME_LOSS = -1,
+    CS_OUTCOME_PUSH =  0,
+    CS_OUTCOME_WIN  =  1
+} CsOutcome;
+
+/* What happened in a round (bit flags in CsRoundResult.flags). */
+#define CS_ROUND_DOUBLE      0x0001u   /* blackjack: doubled down          */
+#define CS_ROUND_SPLIT       0x0002u   /* blackjack: hand came from a split */
+#define CS_ROUND_SURRENDER   0x0004u   /* blackjack: surrendered           */
+#define CS_ROUND_INSURANCE   0x0008u   /* blackjack: took insurance        */
+#define CS_ROUND_NATURAL     0x0010u   /* blackjack: two-card 21           */
+#define CS_ROUND_BUST        0x0020u   /* blackjack: went over 21          */
+#define CS_ROUND_UNDO        0x0040u   /* klondike: used undo              */
+#define CS_ROUND_HARD        0x0080u   /* klondike/idiot: hard             */
+#define CS_ROUND_EASY        0x0100u   /* klondike/idiot: easy             */
+
+/**
+ * CsRoundResult
+ * One settled hand or game, from the player's (seat 0's) side. `net` is
+ * the change to the bankroll; durationMs is 0 unless the caller times
+ * rounds.
+ */
+typedef struct {
+    uint8_t  game;          /* CsGame           */
+    int8_t   outcome;       /* CsOutcome        */
+    uint16_t flags;         /* CS_ROUND_*       */
+    uint32_t bet;
+    int64_t  net;
+    uint32_t durationMs;
+} CsRoundResult;
+
+/**
+ * CsStatsSink
+ * Where an engine reports settled rounds. `record` runs on the thread that
+ * drives the engine, so a sink shared by several threads must lock; the
+ * cheap pattern is one CsTally per worker, merged at the end. A zeroed
+ * sink drops everything.
+ */
+typedef struct {
+    void (*record)(void *user, const CsRoundResult *result);
+    void  *user;
+} CsStatsSink;
+
+static inline void cs_stats_emit(const CsStatsSink *sink, const CsRoundResult *result)
+{
+    if (sink->record) sink->record(sink->user, result);
+}
+
+/**
+ * CsTally
+ * Plain counters, usable as a sink through cs_tally_sink().
+ */
+typedef struct {
+    uint64_t rounds;
+    uint64_t wins;
+    uint64_t losses;
+    uint64_t pushes;
+    uint64_t wagered;       /* sum of bets      */
+    int64_t  net;           /* sum of nets      */
+} CsTally;
+
+/** CsStatsSink.record for a CsTally (`user` is the tally). */
+void        cs_tally_record(void *tally, const CsRoundResult *result);
+CsStatsSink cs_tally_sink  (CsTally *tally);
+
+/** Add `from` into `into` (e.g. per-worker tallies after a parallel run). */
+void        cs_tally_merge (CsTally *into, const CsTally *from);
+
+/* ------------------------------------------------------------------------- */
+/* Blackjack                                                                 */
+/* ------------------------------------------------------------------------- */
+
+#define CS_HAND_MAX_CARDS             12     /* Max cards a Blackjack hand can hold. */
+#define MAX_SHOE_DECKS                8      /* Hard cap for the number of decks.    */
+/* Cut-card penetration: reshuffle when >= this % of the shoe has been dealt.
+   Typical casinos use ~75–85%. Change this single value to tune. */
+#define CUT_CARD_PENETRATION_PERCENT  80
+
+/**
+ * Hand
+ * One Blackjack hand with its wager and flags.
+ */
+typedef struct {
+    Card          cards[CS_HAND_MAX_CARDS];
+    int           count;            /* number of cards in this hand          */
+    unsigned int  bet;              /* wager associated with this hand       */
+    int           surrendered;      /* 1 if player surrendered this hand     */
+    bool          doubled;          /* true if doubled down                  */
+    int           fromSplit;        /* 1 if this hand originated from split  */
+} Hand;
+
+/**
+ * Shoe
+ * Multi-deck deal shoe. The next card to deal is at cards[next_index].
+ *
+ * Invariants:
+ *  - 0 <= next_index <= total
+ *  - total == decks_in_shoe * DECK_SIZE
+ */
+typedef struct {
+    Card cards[MAX_SHOE_DECKS * DECK_SIZE];
+    int  total;        /* total cards in the shoe               */
+    int  next_index;   /* next card to deal                     */
+    int  decks_in_shoe;/* number of decks used (1..MAX_SHOE_DECKS) */
+} Shoe;
+
+/** Refill with `decks` (clamped 1..MAX_SHOE_DECKS) unshuffled decks. */
+void cs_shoe_build(Shoe *shoe, int decks);
+
+/** Shuffle the whole shoe and rewind it. */
+void cs_shoe_shuffle(Shoe *shoe, CsRng *rng);
+
+/** Cards left before the end of the shoe. */
+int  cs_shoe_remaining(const Shoe *shoe);
+
+/** True at the cut card or when fewer than `needed` cards remain. */
+bool cs_shoe_needs_reshuffle(const Shoe *shoe, int needed);
+
+/**
+ * cs_shoe_deal
+ * Deal one card into `hand`, rebuilding and reshuffling first at the cut
+ * card. Returns false (nothing dealt) if the hand is full.
+ */
+bool cs_shoe_deal(Shoe *shoe, CsRng *rng, Hand *hand);
+
+/** Best total with Aces counted as 11 while that does not bust. */
+int  cs_hand_value(const Hand *hand);
+bool cs_hand_is_blackjack(const Hand *hand);   /* two cards totalling 21     */
+bool cs_hand_is_pair(const Hand *hand);        /* two cards of the same rank */
+
+/** Dealer policy: hit below 17, stand on all 17s. */
+bool cs_dealer_should_hit(const Hand *dealer);
+
+/**
+ * CsHandResult
+ * How a player hand settled. Net payouts (bet b): WIN +b, BLACKJACK +3b/2,
+ * PUSH 0, LOSS and BUST -b, SURRENDER -(b - b/2).
+ */
+typedef enum {
+    CS_HAND_PENDING = 0,
+    CS_HAND_WIN,
+    CS_HAND_BLACKJACK,
+    CS_HAND_PUSH,
+    CS_HAND_LOSS,
+    CS_HAND_BUST,
+    CS_HAND_SURRENDER
+} CsHandResult;
+
+/** Settle a finished, non-surrendered hand against the dealer's total. */
+CsHandResult cs_hand_settle(const Hand *player, int dealerValue);
+
+/** Net payout for a settled hand (see CsHandResult). */
+int64_t cs_hand_payout(CsHandResult result, unsigned int bet);
+
+typedef enum {
+    CS_BJ_HIT,
+    CS_BJ_STAND,
+    CS_BJ_DOUBLE,         /* first decision on a hand; one more card        */
+    CS_BJ_SPLIT,          /* first decision on an unsplit pair              */
+    CS_BJ_SURRENDER       /* first decision on an unsplit hand; half back   */
+} CsBlackjackAction;
+
+/**
+ * CsBlackjackTable
+ * One seat against the dealer, with its own shoe, random stream and stats
+ * sink. The caller owns the bankroll: the table only reports each hand's
+ * result and the round's net (doubles and splits add to the stake, so
+ * check funds before asking for them). No insurance side bet.
+ */
+typedef struct {
+    Shoe          shoe;
+    CsRng         rng;
+    CsStatsSink   stats;            /* one CsRoundResult per settled hand    */
+    Hand          dealer;
+    Hand          hands[2];         /* hands[1] is used after a split        */
+    CsHandResult  results[2];
+    int           handCount;        /* 1, or 2 after a split                 */
+    int           active;           /* hand to act on; == handCount when over */
+    int64_t       net;              /* round net once over                   */
+} CsBlackjackTable;
+
+/**
+ * cs_blackjack_init
+ * Build and shuffle a shoe of `decks` decks; `seed` drives every deal.
+ * Settled hands are reported to `stats` (NULL: nowhere).
+ */
+void cs_blackjack_init(CsBlackjackTable *table, int decks, uint64_t seed, const CsStatsSink *stats);
+
+/**
+ * cs_blackjack_deal
+ * Start a round with `bet` on one hand (reshuffles at the cut card). A
+ * natural on either side settles the round immediately.
+ */
+void cs_blackjack_deal(CsBlackjackTable *table, unsigned int bet);
+
+/** True if `action` is legal for the active hand right now. */
+bool cs_blackjack_can(const CsBlackjackTable *table, CsBlackjackAction action);
+
+/**
+ * cs_blackjack_act
+ * Apply `action` to the active hand. When the last hand is done the dealer
+ * plays and the round settles. Returns false (no change) if illegal.
+ */
+bool cs_blackjack_act(CsBlackjackTable *table, CsBlackjackAction action);
+
+static inline bool cs_blackjack_round_over(const CsBlackjackTable *table)
+{
+    return table->active >= table->handCount;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Klondike                                                                  */
+/* ------------------------------------------------------------------------- */
+
+/* Table geometry: seven columns in Klondike. */
+#define COLUMNS                   7
+
+/* Four foundations (one per suit). */
+#define FOUNDATION_PILES          4
+
+/* Capacity used for stock/waste/foundation arrays. */
+#define MAX_DRAW_STACK            52
+
+/* Max size of a completed foundation (Ace..King). */
+#define MAX_FOUNDATION            13
+
+/**
+ * Stack
+ * Simple LIFO container for cards used by draw pile, waste pile, and each
+ * foundation pile. The "top" card is at index (count - 1).
+ *
+ * Invariants:
+ *   - 0 <= count <= MAX_DRAW_STACK
+ *   - Elements are valid only for indices [0, count).
+ */
+typedef struct {
+    Card cards[MAX_DRAW_STACK];
+    int  count;
+} Stack;
+
+/**
+ * KlondikeGame
+ * Complete snapshot of a Klondike position.
+ *
+ * Members:
+ *   - table:        7 columns of face-down/up cards; top is table[i][table_counts[i]-1].
+ *   - table_counts: live size for each table column.
+ *   - drawPile:     stock (cards yet to be drawn).
+ *   - wastePile:    upturned cards from the stock.
+ *   - foundation:   four ascending-by-suit piles (Ace->King).
+ *   - difficulty:   DIFFICULTY_EASY / DIFFICULTY_NORMAL / DIFFICULTY_HARD.
+ *   - undo:         set true when the player used undo this game (affects stats).
+ *   - recycled:     set once Easy recycles the waste; every stock card has then
+ *                   been seen (cs_klondike_determinize keeps them in place).
+ *
+ * Important notes:
+ *   - Card.revealed is used on table cards to render [???] vs face-up.
+ *   - For draw/waste, code treats cards as face-up when drawn; the revealed flag
+ *     may be set accordingly at deal time.
+ */
+typedef struct {
+    Card  table[COLUMNS][MAX_DRAW_STACK];
+    int   table_counts[COLUMNS];
+    Stack drawPile;
+    Stack wastePile;
+    Stack foundation[FOUNDATION_PILES];
+    int   difficulty;
+    bool  undo;
+    bool  recycled;
+} KlondikeGame;
+
+/**
+ * cs_klondike_deal
+ * Deal `deck` (DECK_SIZE cards, already shuffled) in the 1..7 pyramid, last
+ * card of each column face up; the rest becomes the stock. Difficulty and
+ * the undo flag are left to the caller.
+ */
+void cs_klondike_deal(KlondikeGame *game, Card *deck);
+
+/** Build, shuffle and deal a fresh board at `difficulty`. */
+void cs_klondike_deal_random(KlondikeGame *game, int difficulty, CsRng *rng);
+
+/**
+ * cs_klondike_draw
+ * Stock -> waste: 3 cards on Hard, else 1. On Easy an empty stock first
+ * recycles the waste.
+ */
+void cs_klondike_draw(KlondikeGame *game);
+
+bool cs_card_is_red(Card card);                                   /* Hearts/Diamonds      */
+int  cs_klondike_rank(Card card);                                 /* Ace=1 .. King=13     */
+bool cs_klondike_fits_foundation(Card card, const Stack *foundation);
+bool cs_klondike_fits_table(Card moving, Card destination);       /* alt. colour, rank-1  */
+bool cs_klondike_is_won(const KlondikeGame *game);
+
+/* Player moves (numbered like the terminal game's move menu). */
+typedef enum {
+    CS_KLONDIKE_WASTE_TO_FOUNDATION  = 1,   /* first foundation that takes it */
+    CS_KLONDIKE_WASTE_TO_COLUMN      = 2,
+    CS_KLONDIKE_COLUMN_TO_COLUMN     = 3,   /* longest face-up run that fits  */
+    CS_KLONDIKE_COLUMN_TO_FOUNDATION = 4,   /* top card                       */
+    CS_KLONDIKE_FOUNDATION_TO_COLUMN = 5
+} CsKlondikeMove;
+
+/**
+ * cs_klondike_move
+ * Apply a player move. `from` and `to` are 0-based column or foundation
+ * indexes (ignored where the move does not use them). Kings alone open an
+ * empty column; a column's new top card is turned face up. Returns false,
+ * leaving the game untouched, if the move is not legal.
+ */
+bool cs_klondike_move(KlondikeGame *game, CsKlondikeMove move, int from, int to);
+
+/* Scripted players for simulations. Every policy moves runs that uncover a
+   face-down card, plays the waste onto the table and draws when nothing
+   else is left; they differ in when a card may go up to a foundation. */
+typedef enum {
+    CS_KLONDIKE_POLICY_GREEDY,          /* any foundation move, at once            */
+    CS_KLONDIKE_POLICY_SAFE,            /* only safe ones (Aces, 2s, cards the other
+                                           colour no longer needs)                 */
+    CS_KLONDIKE_POLICY_AUTO_COMPLETE,   /* safe, then greedy once the terminal game
+                                           would offer auto-complete               */
+    CS_KLONDIKE_POLICY_COUNT
+} CsKlondikePolicy;
+
+/**
+ * cs_klondike_play
+ * Play `game` with `policy` until it is won, the policy has no move left
+ * (including a full trip through the stock with nothing else to do) or
+ * `maxMoves` moves were made. Draws count as moves. Returns true if won;
+ * `*moves` (may be NULL) receives the number of moves made.
+ */
+bool cs_klondike_play(KlondikeGame *game, CsKlondikePolicy policy, int maxMoves, int *moves);
+
+/* --- Solver -------------------------------------------------------------- */
+
+/* Depth cap for the solver’s explicit stack (heap-backed). */
+#define DFS_MAX_DEPTH             512
+
+/* Open-addressing hash table capacity for visited states (prime for spread). */
+#define VISITED_CAP               200003
+
+/* Hard node-visit ceiling to prevent runaway searches. */
+#define DFS_NODE_LIMIT            2000000
+
+/**
+ * VisitedEntry
+ * Single slot in the solver’s open-addressing transposition table. A slot is
+ * occupied only if its generation matches the context's current one, so a
+ * new solve "clears" the table by bumping the generation (no memset).
+ */
+typedef struct {
+    uint64_t key;
+    uint32_t generation;
+} VisitedEntry;
+
+/**
+ * SolverFrame
+ * One level of the solver's explicit stack: where the iterator over the
+ * children of states[depth] stands. `phase` is the move family being
+ * enumerated (0 = not expanded yet); the other bytes are its loop indices.
+ */
+typedef struct {
+    uint8_t phase;
+    uint8_t column;               /* source column                          */
+    uint8_t row;                  /* first row of the run being moved       */
+    uint8_t target;               /* next foundation or column to try       */
+} SolverFrame;
+
+typedef enum {
+    CS_SOLVE_RUNNING,             /* yielded; cs_solver_run() resumes it    */
+    CS_SOLVE_WON,
+    CS_SOLVE_LOST                 /* no win found (or no solve started)     */
+} CsSolveStatus;
+
+/**
+ * SolverContext
+ * Reusable solver storage. The state stack, its frames and the
+ * transposition table are carved out of one arena allocated once, so
+ * repeated solves (e.g. the 1000-attempt winnable-deal loop) do no heap
+ * traffic and touch pages that are already mapped. The whole search lives
+ * here rather than on the C stack, so it can be paused, resumed and
+ * checkpointed. One context per thread.
+ */
+typedef struct {
+    void          *arena;         /* single block backing the arrays below  */
+    KlondikeGame  *states;        /* DFS_MAX_DEPTH + 2 nodes                */
+    SolverFrame   *frames;        /* DFS_MAX_DEPTH + 1 iterators            */
+    VisitedEntry  *visited;       /* VISITED_CAP slots                      */
+    uint32_t       generation;    /* live tag for `visited`                 */
+    size_t         nodeCount;     /* nodes expanded by the current solve    */
+    int            depth;         /* top of the stack, -1 once exhausted    */
+    CsSolveStatus  status;
+    unsigned       options;       /* CS_SOLVER_*; set before a solve begins */
+} SolverContext;
+
+/*
+ * Solver options. By default the search only pushes "safe" cards to the
+ * foundations and never takes one back, which proves most wins cheaply but
+ * declares some winnable deals lost. CS_SOLVER_COMPLETE_MOVES adds every
+ * other legal move (unsafe pushes, runs split anywhere, foundation ->
+ * column), tried after the moves that make progress.
+ */
+#define CS_SOLVER_COMPLETE_MOVES  0x01u
+
+/**
+ * cs_solver_create / cs_solver_destroy
+ * Allocate (zeroed) or release a solver context. Returns NULL if the arena
+ * cannot be allocated.
+ */
+SolverContext *cs_solver_create(void);
+void           cs_solver_destroy(SolverContext *solver);
+
+/**
+ * cs_klondike_solve
+ * Run the DFS/heuristic solver against `game` using `solver`'s storage.
+ * Allocation-free; `solver->nodeCount` reports the work done.
+ *
+ * @return true if a forced win sequence exists from this state.
+ */
+bool cs_klondike_solve(SolverContext *solver, const KlondikeGame *game);
+
+/**
+ * cs_solver_begin / cs_solver_run
+ * The same search in slices: begin() sets up a solve of `game`, run()
+ * expands at most `nodeBudget` nodes (0 = no limit) and returns RUNNING if
+ * it stopped early; call it again to carry on. Slicing never changes the
+ * verdict or the node count.
+ */
+void          cs_solver_begin(SolverContext *solver, const KlondikeGame *game);
+CsSolveStatus cs_solver_run(SolverContext *solver, size_t nodeBudget);
+
+/**
+ * cs_solver_checkpoint / cs_solver_resume
+ * Flatten a RUNNING solve into `out` (frames, the states on the current
+ * path as Klondike snapshots, the live transposition entries) so it can be
+ * written to disk, and load one back into any context to carry on. The
+ * resumed search ends exactly as the uninterrupted one would have.
+ * cs_solver_checkpoint_size() bounds the bytes needed; checkpoint returns
+ * the bytes written (0 if not running or `capacity` is short).
+ */
+#define CS_SOLVER_CHECKPOINT_MAGIC    0x4B435343u  /* "CSCK" */
+#define CS_SOLVER_CHECKPOINT_VERSION  2
+
+size_t cs_solver_checkpoint_size(const SolverContext *solver);
+size_t cs_solver_checkpoint(const SolverContext *solver, void *out, size_t capacity);
+bool   cs_solver_resume(SolverContext *solver, const void *data, size_t size);
+
+/**
+ * cs_klondike_determinize
+ * Copy `game` to `out` with the cards a player cannot see (face-down
+ * column cards, and the stock until it has been recycled) dealt again at
+ * random into the same places.
+ */
+void cs_klondike_determinize(const KlondikeGame *game, KlondikeGame *out, CsRng *rng);
+
+/* Outcome of a blind solve. Unresolved samples are neither won nor lost,
+   so the win probability lies in [wins, wins + unresolved] / samples. */
+typedef struct {
+    uint64_t samples;
+    uint64_t wins;
+    uint64_t unresolved;          /* budget or DFS_NODE_LIMIT ran out first */
+    uint64_t nodes;
+} CsBlindResult;
+
+/**
+ * cs_klondike_blind_solve
+ * Rate `game` as a player would face it: solve `samples` determinizations,
+ * each with at most `nodeBudget` nodes (0 = only DFS_NODE_LIMIT), and add
+ * the outcome to `result`. Every sample is solved with full knowledge of
+ * its own cards, so the estimate leans optimistic, but unlike
+ * cs_klondike_solve it no longer reads the real face-down cards. Split
+ * the samples over threads (one solver and CsRng each) and sum the results
+ * to run a rating in parallel.
+ */
+void cs_klondike_blind_solve(SolverContext *solver, const KlondikeGame *game, int samples,
+                             size_t nodeBudget, CsRng *rng, CsBlindResult *result);
+
+/* ------------------------------------------------------------------------- */
+/* Idiot                                                                     */
+/* ------------------------------------------------------------------------- */
+
+#define HAND_SIZE            3      /* Number of cards in hand */
+#define FACE_UP_SIZE         3      /* Number of face-up cards */
+#define FACE_DOWN_SIZE       3      /* Number of face-down cards */
+#define MAX_PILE             60     /* Enough space for whole deck + Jokers */
+#define CS_IDIOT_MAX_CARDS   60     /* Allow picking up the entire pile */
+#define LASTMOVE_MAX         2      /* UI shows up to 2 cards per AI turn */
+
+/**
+ * IdiotPlayer
+ * Aggregates all player zones and their dynamic counts.
+ */
+typedef struct {
+    Card hand        [CS_IDIOT_MAX_CARDS];
+    Card faceUp      [FACE_UP_SIZE];
+    Card faceDown    [FACE_DOWN_SIZE];
+    int  handCount;
+    int  faceUpCount;
+    int  faceDownCount;
+} IdiotPlayer;
+
+/**
+ * CardPile
+ * Generic pile stack used for both draw and waste piles.
+ */
+typedef struct {
+    Card pile [MAX_PILE];
+    int  count;
+} CardPile;
+
+/**
+ * AILastMove
+ * Summary of one AI turn (cards played, whether a burn happened, and any
+ * “mirrored” target when playing a 3/Joker), for display or logging.
+ */
+typedef struct {
+    int   playedCount;                        /* 0..LASTMOVE_MAX */
+    Card  played[LASTMOVE_MAX];               /* Cards AI played this visible turn */
+    int   burned;                             /* 1 if 10/four-of-a-kind burn occurred */
+    int   mirrored;                           /* 1 if last play mirrored a lock */
+    Card *mirroredCard;                       /* The mirrored target (may be NULL) */
+} AILastMove;
+
+/** Ace=14 .. 2=2; Jokers count as 3 (they act exactly like a 3). */
+int  cs_idiot_card_value(const Card *card);
+bool cs_idiot_card_is(const Card *card, int value);
+bool cs_idiot_is_power_card(const Card *card);            /* Joker, 2, 3, 10 */
+
+/**
+ * cs_idiot_can_play
+ * Placement rule: power cards always play; on a 3/Joker compare against the
+ * last card below the run of 3s/Jokers; otherwise `next` must be >= `top`.
+ * `top` may be NULL (empty pile).
+ */
+bool cs_idiot_can_play(const Card *top, const Card *next, const CardPile *wastePile);
+
+bool  cs_idiot_is_four_of_a_kind(const CardPile *wastePile);
+void  cs_idiot_burn(CardPile *wastePile);
+
+/** The lock a 3/Joker on top mirrors (last non-3/Joker below), or NULL. */
+Card *cs_idiot_mirrored_card(CardPile *wastePile);
+
+/** Draw until the hand holds HAND_SIZE cards or the draw pile is empty. */
+void  cs_idiot_draw_up(IdiotPlayer *player, CardPile *drawPile);
+
+void  cs_idiot_sort_hand(IdiotPlayer *player);            /* ascending by value */
+
+/** Take the whole waste pile into the hand (then sort it). */
+void  cs_idiot_pick_up(IdiotPlayer *player, CardPile *wastePile);
+
+/**
+ * cs_idiot_deal
+ * Deal `deck` (DECK_SIZE cards, already shuffled): 3 face-down, 3 face-up
+ * and 3 hand cards each, `first` before `second`; the rest forms the draw
+ * pile.
+ */
+void  cs_idiot_deal(const Card *deck, IdiotPlayer *first, IdiotPlayer *second, CardPile *drawPile);
+
+/**
+ * cs_idiot_ai_play
+ * Play one AI turn for `ai` at `difficulty` (Easy: timid; Normal: chains
+ * after 2s and dumps duplicates; Hard: greedy one-ply look-ahead), picking
+ * up the pile when nothing fits. `lastMove` describes what happened; the
+ * same player moves again after a burn, a 2 or a pick-up.
+ */
+void  cs_idiot_ai_play(IdiotPlayer *ai,
+                       IdiotPlayer *opponent,
+                       CardPile    *wastePile,
+                       CardPile    *drawPile,
+                       int          difficulty,
+                       AILastMove  *lastMove);
+
+/**
+ * CsIdiotGame
+ * A whole game: both seats, the piles, whose turn it is and where the
+ * result goes. AI seats move with cs_idiot_step(), human seats with
+ * cs_idiot_play(); two AIs make a self-play game (simulations, tuning).
+ */
+typedef struct {
+    IdiotPlayer players[2];
+    CardPile    drawPile;
+    CardPile    wastePile;
+    AILastMove  lastMove;
+    CsStatsSink stats;             /* one CsRoundResult (seat 0's side) at the end */
+    int         difficulty[2];     /* per seat                               */
+    int         turn;              /* seat to move                           */
+    int         winner;            /* -1 while the game is running           */
+} CsIdiotGame;
+
+/**
+ * cs_idiot_new_game
+ * Shuffle and deal (optionally shuffling two Jokers into the draw pile);
+ * seat 0 moves first. The result is reported to `stats` (NULL: nowhere).
+ */
+void cs_idiot_new_game(CsIdiotGame *game, int difficulty0, int difficulty1, bool jokers,
+                       CsRng *rng, const CsStatsSink *stats);
+
+/**
+ * cs_idiot_step
+ * Play one AI turn for the seat to move. Returns the winning seat once a
+ * player runs out of cards, else -1. Two AIs can trade pick-ups forever
+ * in the endgame, so self-play loops should cap the number of steps.
+ */
+int  cs_idiot_step(CsIdiotGame *game);
+
+/**
+ * cs_idiot_play
+ * A human turn for the seat to move, with the terminal game's rules:
+ * `index` 0 picks up the pile; otherwise it is 1-based into the hand, or
+ * the face-up cards once the hand is empty, or the face-down cards (played
+ * blind; an unplayable one is picked up with the pile) after that. `extras`
+ * more cards of the same rank follow from the hand. Burns, 2s and pick-ups
+ * keep the turn. Returns false, changing nothing, for an illegal choice;
+ * otherwise game->lastMove describes the turn.
+ */
+bool cs_idiot_play(CsIdiotGame *game, int index, int extras);
+
+/**
+ * cs_idiot_play_extras
+ * How many more cards of the chosen card's rank the hand would hold once
+ * cs_idiot_play(game, index, ...) has played it and drawn up: the most
+ * `extras` can use (0 for a pick-up or a blind face-down card). Returns -1
+ * for an illegal choice. Changes nothing.
+ */
+int  cs_idiot_play_extras(const CsIdiotGame *game, int index);
+
+/* ------------------------------------------------------------------------- */
+/* Snapshots                                                                 */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * A snapshot is a flat, pointer-free, versioned image of one game, the same
+ * bytes on disk and on the wire. All integers are little-endian; nothing
+ * is aligned, nothing needs parsing:
+ *
+ *    0  u32  magic        CS_SNAP_MAGIC
+ *    4  u16  version      CS_SNAP_VERSION of the writer
+ *    6  u8   game         CsGame
+ *    7  u8   flags        CS_SNAP_PLAYER_VIEW
+ *    8  u32  size         total bytes, header included
+ *   12  u16  fieldCount   entries in the offset table
+ *   14  u16  offset[fieldCount]   start of each field; 0 = absent
+ *
+ * A field is a scalar (1, 2, 4 or 8 bytes) or a card list (u16 count, then
+ * one byte per card: cs_card_id() | CS_SNAP_FACE_UP, or CS_SNAP_HIDDEN).
+ * Readers open a snapshot once (bounds checked against the schema) and
+ * then read fields in place through the offset table.
+ *
+ * Compatibility: field ids are only ever appended, never reused or
+ * retyped. A reader skips fields it does not know and reads missing ones
+ * as 0 / empty, so old and new builds open each other's snapshots.
+ *
+ * Snapshots can be stored back to back (a save file, a replay, a corpus);
+ * cs_snap_next() walks such a stream.
+ */
+
+#define CS_SNAP_MAGIC         0x504E5343u  /* "CSNP" */
+#define CS_SNAP_VERSION       1
+#define CS_SNAP_HEADER_SIZE   14
+#define CS_SNAP_MAX_SIZE      512          /* bound for any snapshot (cs_snap_max_size) */
+
+#define CS_SNAP_FACE_UP       0x80u        /* card byte: face up          */
+#define CS_SNAP_HIDDEN        0xFFu        /* card byte: not shown        */
+
+/* Header flags */
+#define CS_SNAP_PLAYER_VIEW   0x01u        /* only what seat 0 may see; cannot be restored */
+
+/* Blackjack fields */
+enum {
+    CS_SNAP_BJ_RNG,             /* u64  (absent in player views)          */
+    CS_SNAP_BJ_NET,             /* u64  round net (two's complement)      */
+    CS_SNAP_BJ_DECKS,           /* u8                                     */
+    CS_SNAP_BJ_SHOE_NEXT,       /* u16  cards dealt from this shoe        */
+    CS_SNAP_BJ_SHOE,            /* list undealt cards (absent in views)   */
+    CS_SNAP_BJ_HAND_COUNT,      /* u8                                     */
+    CS_SNAP_BJ_ACTIVE,          /* u8                                     */
+    CS_SNAP_BJ_DEALER,          /* list (hole card hidden in live views)  */
+    CS_SNAP_BJ_HAND0,           /* list                                   */
+    CS_SNAP_BJ_HAND1,           /* list                                   */
+    CS_SNAP_BJ_BET0,            /* u32                                    */
+    CS_SNAP_BJ_BET1,            /* u32                                    */
+    CS_SNAP_BJ_FLAGS0,          /* u8   CS_SNAP_HAND_*                    */
+    CS_SNAP_BJ_FLAGS1,          /* u8                                     */
+    CS_SNAP_BJ_RESULT0,         /* u8   CsHandResult                      */
+    CS_SNAP_BJ_RESULT1,         /* u8                                     */
+    CS_SNAP_BJ_FIELDS
+};
+
+#define CS_SNAP_HAND_DOUBLED      0x01u
+#define CS_SNAP_HAND_SPLIT        0x02u
+#define CS_SNAP_HAND_SURRENDERED  0x04u
+
+/* Klondike fields (columns, then foundations, are consecutive ids) */
+enum {
+    CS_SNAP_KL_DIFFICULTY,      /* u8                                     */
+    CS_SNAP_KL_UNDO,            /* u8                                     */
+    CS_SNAP_KL_COLUMN0,         /* list x COLUMNS (face-down hidden in views) */
+    CS_SNAP_KL_STOCK = CS_SNAP_KL_COLUMN0 + COLUMNS,   /* list (hidden in views) */
+    CS_SNAP_KL_WASTE,           /* list                                   */
+    CS_SNAP_KL_FOUNDATION0,     /* list x FOUNDATION_PILES                */
+    CS_SNAP_KL_VERDICT = CS_SNAP_KL_FOUNDATION0 + FOUNDATION_PILES,
+                                /* u8   solver: 0 unknown, 1 lost, 2 won  */
+    CS_SNAP_KL_NODES,           /* u32  solver nodes for the verdict      */
+    CS_SNAP_KL_SOLVER,          /* u8   CS_SOLVER_* options of the solve  */
+    CS_SNAP_KL_RECYCLED,        /* u8   the waste was recycled (Easy)     */
+    CS_SNAP_KL_FIELDS
+};
+
+/* Idiot fields (per seat: hand, face-up, face-down) */
+enum {
+    CS_SNAP_ID_TURN,            /* u8                                     */
+    CS_SNAP_ID_WINNER,          /* u8   0xFF while running                */
+    CS_SNAP_ID_DIFFICULTY0,     /* u8                                     */
+    CS_SNAP_ID_DIFFICULTY1,     /* u8                                     */
+    CS_SNAP_ID_HAND0,           /* list seat 0 (then FACE_UP0, FACE_DOWN0) */
+    CS_SNAP_ID_FACE_UP0,
+    CS_SNAP_ID_FACE_DOWN0,      /* list (hidden in views)                 */
+    CS_SNAP_ID_HAND1,           /* list (hidden in views)                 */
+    CS_SNAP_ID_FACE_UP1,
+    CS_SNAP_ID_FACE_DOWN1,      /* list (hidden in views)                 */
+    CS_SNAP_ID_DRAW,            /* list (hidden in views)                 */
+    CS_SNAP_ID_WASTE,           /* list                                   */
+    CS_SNAP_ID_LAST_PLAYED,     /* list the last turn's cards             */
+    CS_SNAP_ID_LAST_BURNED,     /* u8                                     */
+    CS_SNAP_ID_LAST_MIRRORED,   /* u8                                     */
+    CS_SNAP_ID_FIELDS
+};
+
+/* --- Reading -------------------------------------------------------------- */
+
+/**
+ * CsSnapshot
+ * An opened snapshot: a view of the caller's bytes, nothing copied.
+ */
+typedef struct {
+    const uint8_t *data;
+    uint32_t       size;
+    uint16_t       fieldCount;
+    uint8_t        game;
+    uint8_t        flags;
+} CsSnapshot;
+
+/**
+ * cs_snap_open
+ * Check the header and every field this library knows against `size`.
+ * Returns false for anything that is not a whole, well-formed snapshot;
+ * after true, the accessors below never read out of bounds.
+ */
+bool cs_snap_open(CsSnapshot *snap, const void *data, size_t size);
+
+/**
+ * cs_snap_next
+ * Open the snapshot at `*offset` in a stream of back-to-back snapshots and
+ * advance `*offset` past it. False at the end or on a damaged entry.
+ */
+bool cs_snap_next(const void *stream, size_t size, size_t *offset, CsSnapshot *snap);
+
+static inline uint64_t cs_snap_le(const uint8_t *bytes, int width)
+{
+    uint64_t value = 0;
+    for (int i = width - 1; i >= 0; --i) value = (value << 8) | bytes[i];
+    return value;
+}
+
+/** Offset of `field`, 0 if the snapshot does not have it. */
+static inline uint32_t cs_snap_offset(const CsSnapshot *snap, int field)
+{
+    if (field < 0 || field >= snap->fieldCount) return 0;
+    return (uint32_t)cs_snap_le(snap->data + CS_SNAP_HEADER_SIZE + 2 * field, 2);
+}
+
+static inline uint64_t cs_snap_scalar(const CsSnapshot *snap, int field, int width)
+{
+    const uint32_t offset = cs_snap_offset(snap, field);
+    return offset ? cs_snap_le(snap->data + offset, width) : 0;
+}
+
+static inline uint8_t  cs_snap_u8 (const CsSnapshot *s, int f) { return (uint8_t) cs_snap_scalar(s, f, 1); }
+static inline uint16_t cs_snap_u16(const CsSnapshot *s, int f) { return (uint16_t)cs_snap_scalar(s, f, 2); }
+static inline uint32_t cs_snap_u32(const CsSnapshot *s, int f) { return (uint32_t)cs_snap_scalar(s, f, 4); }
+static inline uint64_t cs_snap_u64(const CsSnapshot *s, int f) { return cs_snap_scalar(s, f, 8); }
+
+/** Card bytes of a list field (NULL and 0 cards if absent). */
+static inline const uint8_t *cs_snap_cards(const CsSnapshot *snap, int field, int *count)
+{
+    const uint32_t offset = cs_snap_offset(snap, field);
+    *count = offset ? (int)cs_snap_le(snap->data + offset, 2) : 0;
+    return offset ? snap->data + offset + 2 : NULL;
+}
+
+/* --- Writing -------------------------------------------------------------- */
+
+/**
+ * CsSnapWriter
+ * Builds a snapshot in a caller buffer. Fields may be put in any order;
+ * running out of room is sticky and makes cs_snap_finish() return 0.
+ */
+typedef struct {
+    uint8_t *data;
+    size_t   capacity;
+    size_t   length;
+    int      fieldCount;
+    unsigned flags;
+    bool     overflow;
+} CsSnapWriter;
+
+/** Start a snapshot of `game` with room for that game's fields. */
+void     cs_snap_begin(CsSnapWriter *writer, void *buffer, size_t capacity, CsGame game, unsigned flags);
+
+/** Put a scalar field; `width` must be the one in the field list above. */
+void     cs_snap_put(CsSnapWriter *writer, int field, uint64_t value, int width);
+
+/** Reserve a list of `count` card bytes and return them to fill (NULL on overflow). */
+uint8_t *cs_snap_put_list(CsSnapWriter *writer, int field, int count);
+
+/** Put `count` cards; with `hideFaceDown`, face-down ones as CS_SNAP_HIDDEN. */
+void     cs_snap_put_cards(CsSnapWriter *writer, int field, const Card *cards, int count, bool hideFaceDown);
+
+/** Put a list of `count` cards that are all CS_SNAP_HIDDEN. */
+void     cs_snap_put_hidden(CsSnapWriter *writer, int field, int count);
+
+/** Seal the header; returns the snapshot size, 0 if it did not fit. */
+size_t   cs_snap_finish(CsSnapWriter *writer);
+
+/** Largest snapshot the engine writers produce for `game` (0 if unknown). */
+size_t   cs_snap_max_size(CsGame game);
+
+/** Card byte for `card`: its id plus the face-up bit. */
+static inline uint8_t cs_snap_card(Card card)
+{
+    return (uint8_t)(cs_card_id(card) | (card.revealed ? CS_SNAP_FACE_UP : 0));
+}
+
+/* --- Engine states -------------------------------------------------------- */
+
+/*
+ * cs_*_snapshot_write puts a game's fields into a begun writer (callers may
+ * add their own fields, e.g. a solver verdict, before finishing);
+ * cs_*_snapshot does begin + write + finish and returns the size (0 if
+ * `capacity` is too small). `flags` is 0 or CS_SNAP_PLAYER_VIEW.
+ *
+ * cs_*_restore rebuilds the engine struct from a full snapshot of its game,
+ * pointing the cards at the library's tables. False, for a player view or
+ * inconsistent contents, leaves the target unspecified.
+ */
+void   cs_blackjack_snapshot_write(CsSnapWriter *writer, const CsBlackjackTable *table);
+size_t cs_blackjack_snapshot(const CsBlackjackTable *table, unsigned flags, void *out, size_t capacity);
+bool   cs_blackjack_restore(CsBlackjackTable *table, const CsSnapshot *snap, const CsStatsSink *stats);
+
+void   cs_klondike_snapshot_write(CsSnapWriter *writer, const KlondikeGame *game);
+size_t cs_klondike_snapshot(const KlondikeGame *game, unsigned flags, void *out, size_t capacity);
+bool   cs_klondike_restore(KlondikeGame *game, const CsSnapshot *snap);
+
+void   cs_idiot_snapshot_write(CsSnapWriter *writer, const CsIdiotGame *game);
+size_t cs_idiot_snapshot(const CsIdiotGame *game, unsigned flags, void *out, size_t capacity);
+bool   cs_idiot_restore(CsIdiotGame *game, const CsSnapshot *snap, const CsStatsSink *stats);
+
+#endif /* CARDSIM_H */
@@ -5,7 +5,7 @@
  * Core types + globals shared across the card games
  *
  * Exposes:
- *   - Card, GameConfig, GameStats, PlayerData.
+ *   - Card (from libcardsim, cardsim.h), GameConfig, GameStats, PlayerData.
  *   - Common helpers (deck init/shuffle/print, clear_screen).
  *   - Top-level menus callable from other modules.
  */
@@ -24,6 +24,7 @@
 #include <stdbool.h>
 #include <ctype.h>
 #include <stdint.h>
+#include "cardsim.h"        /* Card, decks and the game engines.  */
 #include "achievements.h"   /* Needed for achievement types, API. */
 
 #ifdef _WIN32
@@ -33,31 +34,10 @@
   #include <unistd.h>
 #endif
 
-/* ------------------------------------------------------------------------- */
-/* Card constants                                                            */
-/* ------------------------------------------------------------------------- */
-
-#define NUM_SUITS   4
-#define NUM_RANKS   13
-#define DECK_SIZE   52
-
 /* ------------------------------------------------------------------------- */
 /* Data types                                                                */
 /* ------------------------------------------------------------------------- */
 
-/**
- * Card
- * A playing card identified by (suit, rank).
- * 'revealed' is used by Solitaire to control face-down rendering.
- * 'is_joker' is used by games that allow jokers (e.g., Idiot).
- */
-typedef struct {
-    char *suit;
-    char *rank;
-    int   revealed;
-    bool  is_joker;
-} Card;
-
 /**
  * GameConfig
  * Global rules that affect game modes.
@@ -134,6 +114,7 @@ typedef struct {
 /* Globals                                                                   */
 /* ------------------------------------------------------------------------- */
 
+/* Owned by the main thread; other threads read them through state.h. */
 extern PlayerData playerData;
 extern GameConfig config;
 
@@ -168,6 +149,7 @@ void ensureWinnableSolutions(void);
 void autosave_menu(void);
 void statsDisplay(void);
 void printAchievements(void);
+void profilesMenu(void);
 
 /* ------------------------------------------------------------------------- */
 /* Game entry points (menus/launchers provided elsewhere)                    */
@@ -0,0 +1,95 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Game timers and latency histograms shared by all three games.
+ *
+ * GameTimer measures how long a game (or round) has actually been played:
+ * it runs on the monotonic nanosecond clock, so wall-clock changes cannot
+ * corrupt it, and it can be paused while the game is not being played
+ * (e.g. the Solitaire save prompt).
+ *
+ * Latency histograms record how long the program takes to respond to the
+ * player: solver calls, AI turns, the dealer's draw, a board redraw. They are
+ * log2-bucketed, lock-free and live for the session only; the stats screen
+ * prints their percentiles.
+ */
+
+#ifndef GAMETIMER_H
+#define GAMETIMER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ------------------------------------------------------------------------- */
+/* Game timer                                                                */
+/* ------------------------------------------------------------------------- */
+
+typedef struct {
+    uint64_t startNs;       /* platform_now_ns() when the current run began */
+    uint64_t elapsedNs;     /* accumulated by earlier runs                  */
+    bool     running;
+} GameTimer;
+
+/** Reset to zero and start running. */
+void game_timer_start(GameTimer *timer);
+
+/** Stop accumulating (no-op if already paused). */
+void game_timer_pause(GameTimer *timer);
+
+/** Continue after game_timer_pause (no-op if running). */
+void game_timer_resume(GameTimer *timer);
+
+/** Time accumulated so far, including the current run. */
+uint64_t game_timer_elapsed_ns(const GameTimer *timer);
+
+static inline uint32_t game_timer_elapsed_ms(const GameTimer *timer)
+{
+    const uint64_t ms = game_timer_elapsed_ns(timer) / 1000000ULL;
+    return (ms > UINT32_MAX) ? UINT32_MAX : (uint32_t)ms;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Latency histograms                                                        */
+/* ------------------------------------------------------------------------- */
+
+typedef enum {
+    LATENCY_SOLITAIRE_SOLVER = 0,   /* one winnability probe of a deal    */
+    LATENCY_SOLITAIRE_FRAME,        /* board redraw after a move          */
+    LATENCY_IDIOT_AI,               /* one AI turn                        */
+    LATENCY_IDIOT_FRAME,            /* table redraw                       */
+    LATENCY_BLACKJACK_DEALER,       /* dealer draws to 17                 */
+    LATENCY_BLACKJACK_FRAME,        /* hand + menu frame                  */
+    LATENCY_KIND_COUNT
+} LatencyKind;
+
+/* Bucket i counts samples in [2^i, 2^(i+1)) ns; the last one is open-ended. */
+#define LATENCY_BUCKETS  40
+
+typedef struct {
+    uint64_t count;
+    uint64_t totalNs;
+    uint64_t maxNs;
+    uint64_t buckets[LATENCY_BUCKETS];
+} LatencyHistogram;
+
+/** Add one sample (any thread). */
+void latency_record(LatencyKind kind, uint64_t ns);
+
+/** Record the time since `startNs` (a platform_now_ns() reading). */
+void latency_record_since(LatencyKind kind, uint64_t startNs);
+
+/** Copy one histogram out (counts may be mid-update; fine for display). */
+void latency_snapshot(LatencyKind kind, LatencyHistogram *out);
+
+/**
+ * latency_percentile
+ * Upper bound of the bucket holding the p-th percentile (0 < p <= 100),
+ * clamped to the largest sample. 0 if the histogram is empty.
+ */
+uint64_t latency_percentile(const LatencyHistogram *histogram, double p);
+
+/** Short display name ("Solitaire solver", ...). */
+const char *latency_kind_name(LatencyKind kind);
+
+#endif /* GAMETIMER_H */
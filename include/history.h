@@ -0,0 +1,130 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Columnar, append-only game history.
+ *
+ * Every finished round / game is appended as one fixed-width row. Each field
+ * lives in its own file under <profile>/history/ (one column per file, native
+ * byte order, no header), so row N of every column is at offset N * width.
+ * Readers map the columns and replay them linearly; nothing is parsed and
+ * nothing is loaded into PlayerData. The stats screen reads rollups.h,
+ * which is built from this log.
+ *
+ * A crash between column writes can leave columns of unequal length. Readers
+ * use the shortest column; the writer truncates the others back to it before
+ * appending again.
+ */
+
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ------------------------------------------------------------------------- */
+/* Record fields                                                             */
+/* ------------------------------------------------------------------------- */
+
+typedef enum {
+    HISTORY_GAME_ANY       = 0,   /* query filter: every game */
+    HISTORY_GAME_BLACKJACK = 1,
+    HISTORY_GAME_SOLITAIRE = 2,
+    HISTORY_GAME_IDIOT     = 3,
+    HISTORY_GAME_COUNT
+} HistoryGame;
+
+typedef enum {
+    HISTORY_LOSS = -1,
+    HISTORY_PUSH =  0,
+    HISTORY_WIN  =  1
+} HistoryOutcome;
+
+/* Key decisions / events of a round (bit flags in HistoryRecord.decisions). */
+#define HISTORY_DEC_DOUBLE         0x0001u   /* blackjack: doubled down        */
+#define HISTORY_DEC_SPLIT          0x0002u   /* blackjack: hand came from split */
+#define HISTORY_DEC_SURRENDER      0x0004u   /* blackjack: surrendered         */
+#define HISTORY_DEC_INSURANCE      0x0008u   /* blackjack: took insurance      */
+#define HISTORY_DEC_NATURAL        0x0010u   /* blackjack: two-card 21         */
+#define HISTORY_DEC_BUST           0x0020u   /* blackjack: went over 21        */
+#define HISTORY_DEC_UNDO           0x0040u   /* solitaire: used undo           */
+#define HISTORY_DEC_HARD           0x0080u   /* solitaire/idiot: hard mode     */
+#define HISTORY_DEC_EASY           0x0100u   /* solitaire/idiot: easy mode     */
+#define HISTORY_DECISION_COUNT     9
+
+/**
+ * HistoryRecord
+ * One row as seen by callers (the on-disk form is split per column).
+ *
+ * - payout:     net change of the balance caused by this round (may be < 0).
+ * - durationMs: time actually played, deal to settlement (gametimer.h).
+ */
+typedef struct {
+    int64_t  timestamp;       /* time(NULL) at settlement */
+    uint8_t  game;            /* HistoryGame              */
+    int8_t   outcome;         /* HistoryOutcome           */
+    uint16_t decisions;       /* HISTORY_DEC_* flags      */
+    uint32_t bet;
+    int64_t  payout;
+    uint32_t durationMs;
+} HistoryRecord;
+
+/* ------------------------------------------------------------------------- */
+/* Aggregates                                                                */
+/* ------------------------------------------------------------------------- */
+
+/* Aggregates over a set of rows, as kept by rollups.h.
+   Streak histograms: bucket i counts streaks of length i+1; the last bucket
+   counts streaks of HISTORY_STREAK_BUCKETS or more. */
+#define HISTORY_STREAK_BUCKETS     8
+
+typedef struct {
+    uint64_t rounds;
+    uint64_t wins;
+    uint64_t losses;
+    uint64_t pushes;
+
+    uint64_t wagered;                 /* sum of bets                      */
+    int64_t  net;                     /* sum of payouts                   */
+    uint64_t durationMs;              /* sum of durations                 */
+
+    uint32_t longestWinStreak;
+    uint32_t longestLossStreak;
+    uint32_t winStreaks [HISTORY_STREAK_BUCKETS];
+    uint32_t lossStreaks[HISTORY_STREAK_BUCKETS];
+
+    /* Rounds with decision bit i set, and their summed payouts. */
+    uint64_t decisionRounds[HISTORY_DECISION_COUNT];
+    int64_t  decisionNet   [HISTORY_DECISION_COUNT];
+} HistorySummary;
+
+/* ------------------------------------------------------------------------- */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * history_append
+ * Append one row to every column file (opened lazily, kept open, flushed per
+ * row). Fills in timestamp if it is 0.
+ *
+ * @return true if the whole row was written.
+ */
+bool history_append(const HistoryRecord *record);
+
+/**
+ * history_replay
+ * Map every column and call fn once per complete row from row `firstRow`
+ * (0 = the whole log) onwards, oldest first. Used to rebuild or catch up
+ * derived data (rollups.h).
+ *
+ * @return false if the history could not be read.
+ */
+bool history_replay(uint64_t firstRow, void (*fn)(const HistoryRecord *record, void *arg), void *arg);
+
+/** Number of complete rows in the log (the shortest column wins). */
+uint64_t history_rows(void);
+
+/** Close the append handles (at exit, and before a profile switch). */
+void history_close(void);
+
+#endif /* HISTORY_H */
@@ -0,0 +1,110 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Event-driven keyboard input.
+ *
+ * Responsibilities:
+ *   - Put the terminal into cbreak mode (no line buffering, no echo) and
+ *     restore it on exit or on a fatal signal.
+ *   - Poll stdin with a timeout and deliver key events; while waiting, run
+ *     registered idle tasks (autosave, precompute, ...) on the main thread.
+ *   - Provide line-oriented helpers (read a number, wait for Enter) built on
+ *     top of the key events, replacing scanf/getchar across the program.
+ *
+ * When stdin is not a terminal (pipe or file) the same API works without
+ * cbreak mode or echo, so scripted input behaves like before.
+ */
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ------------------------------------------------------------------------- */
+/* Limits                                                                    */
+/* ------------------------------------------------------------------------- */
+
+#define INPUT_MAX_IDLE_TASKS     8
+#define INPUT_MAX_LINE         128
+
+/* ------------------------------------------------------------------------- */
+/* Types                                                                     */
+/* ------------------------------------------------------------------------- */
+
+typedef enum {
+    INPUT_EVENT_NONE,       /* timed out, nothing arrived      */
+    INPUT_EVENT_KEY,        /* one byte of input in .key       */
+    INPUT_EVENT_EOF         /* stdin closed                    */
+} InputEventType;
+
+typedef struct {
+    InputEventType type;
+    int            key;
+} InputEvent;
+
+/* Idle task body; runs on the main thread between key events. */
+typedef void (*InputIdleFn)(void *arg);
+
+/* ------------------------------------------------------------------------- */
+/* Lifecycle + event loop                                                    */
+/* ------------------------------------------------------------------------- */
+
+/** Enter cbreak mode if stdin is a terminal (idempotent; restored at exit). */
+void input_init(void);
+
+/** Restore the terminal to the mode it had before input_init(). */
+void input_shutdown(void);
+
+/**
+ * input_add_idle_task
+ * Run fn(arg) roughly every periodMs while the program waits for input.
+ *
+ * @return true if registered, false if the task table is full.
+ */
+bool input_add_idle_task(InputIdleFn fn, void *arg, unsigned int periodMs);
+
+/**
+ * input_poll_event
+ * Wait up to timeoutMs (negative = forever) for the next key, running due
+ * idle tasks meanwhile.
+ *
+ * @return true if an event (key or EOF) was stored in *event.
+ */
+bool input_poll_event(InputEvent *event, int timeoutMs);
+
+/** Handler called when stdin reaches EOF inside a read helper (default: exit). */
+void input_set_eof_handler(void (*handler)(void));
+
+/**
+ * Hook called just before a line helper waits, with the kind of answer it
+ * expects ("int", "uint", "u64", "enter"). Used by protocol mode.
+ */
+void input_set_prompt_hook(void (*hook)(const char *kind));
+
+/* ------------------------------------------------------------------------- */
+/* Line helpers                                                              */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * input_read_line
+ * Collect keys (with echo + backspace in cbreak mode) until Enter.
+ *
+ * @return false on EOF (after invoking the EOF handler, if it returns).
+ */
+bool input_read_line(char *buffer, size_t capacity);
+
+/*
+ * Read one number from the next non-blank line (scanf-like: leading number,
+ * rest of the line ignored). On a non-numeric line *out is left untouched
+ * and false is returned; the line is always consumed, so callers never spin.
+ */
+bool input_read_int (int *out);
+bool input_read_uint(unsigned int *out);
+bool input_read_u64 (unsigned long long *out);
+
+/** Discard input up to and including the next Enter. */
+void input_wait_enter(void);
+
+#endif /* INPUT_H */
@@ -6,6 +6,7 @@
  *
  * Responsibilities:
  *   - Define canonical on-disk locations for all save files.
+ *   - Resolve per-profile files against the active profile's directory.
  *   - Provide a tiny helper to format per-slot Solitaire save paths.
  *   - Keep names portable (forward slashes OK on Windows/POSIX).
  */
@@ -18,36 +19,72 @@
 /* ------------------------------------------------------------------------- */
 /*
  * saves/
+ *   profiles.idx            (profile index, see profile.h)
+ *   <profile files>         ("default" profile lives in the root)
+ *   profiles/
+ *     <name>/
+ *       <profile files>
+ *
+ * <profile files>:
  *   player_data.dat
  *   achievements.dat
+ *   rollups.dat             (precomputed stats, see rollups.h)
  *   solitaire/
  *     solitaire_save_slot_1.dat
  *     ...
+ *   history/
+ *     <column>.col          (one fixed-width column per file, see history.h)
  */
 
 #define SAVE_DIR                 "saves"
+#define PROFILES_DIR             SAVE_DIR "/profiles"
+#define PROFILE_INDEX_PATH       SAVE_DIR "/profiles.idx"
 
-/* Flat files */
-#define PLAYER_DATA_PATH         SAVE_DIR "/player_data.dat"
-#define ACHIEVEMENTS_PATH        SAVE_DIR "/achievements.dat"
-
-/* Backward-compat aliases (older modules may use these names) */
-#define PLAYER_SAVE_FILE         PLAYER_DATA_PATH
-#define ACHIEVEMENT_SAVE         ACHIEVEMENTS_PATH
-
-/* Solitaire saves */
-#define SOLITAIRE_SAVE_DIR       SAVE_DIR "/solitaire"
+/* Per-profile files, relative to the active profile directory */
+#define PLAYER_DATA_FILE         "player_data.dat"
+#define ACHIEVEMENTS_FILE        "achievements.dat"
+#define ROLLUPS_FILE             "rollups.dat"
+#define HISTORY_SUBDIR           "history"
+#define SOLITAIRE_SUBDIR         "solitaire"
 #define SOLITAIRE_SLOT_BASENAME  "solitaire_save_slot_%d.dat"
-#define SOLITAIRE_SLOT_FMT       SOLITAIRE_SAVE_DIR "/" SOLITAIRE_SLOT_BASENAME
 
 /* A generous buffer size for building file paths */
 #ifndef SAVE_PATH_MAX
 #define SAVE_PATH_MAX 512
 #endif
 
+/* Longest profile directory: PROFILES_DIR "/" + a PROFILE_NAME_MAX name */
+#define PROFILE_DIR_MAX          64
+
 /* ------------------------------------------------------------------------- */
-/* Helper                                                                    */
+/* Helpers                                                                   */
 /* ------------------------------------------------------------------------- */
+
+#include <stdio.h>
+
+/**
+ * profile_dir
+ * Copy the directory of the active profile, e.g. "saves" or
+ * "saves/profiles/ann" (profile.c). Copied under the profile lock because
+ * the persistence writer builds paths while the game thread may switch.
+ */
+void profile_dir(char *buf, size_t bufsize);
+
+/**
+ * save_path
+ * Build the path of a per-profile file or directory.
+ *
+ * Usage:
+ *   char path[SAVE_PATH_MAX];
+ *   save_path(path, sizeof(path), PLAYER_DATA_FILE);  // -> "saves/player_data.dat"
+ */
+static inline void save_path(char *buf, size_t bufsize, const char *relative)
+{
+    char dir[PROFILE_DIR_MAX];
+    profile_dir(dir, sizeof(dir));
+    (void)snprintf(buf, bufsize, "%s/%s", dir, relative);
+}
+
 /**
  * solitaire_slot_path
  * Build a concrete save-file path for a given Solitaire slot.
@@ -60,10 +97,11 @@
  *   char path[SAVE_PATH_MAX];
  *   solitaire_slot_path(path, sizeof(path), 1);  // -> "saves/solitaire/solitaire_save_slot_1.dat"
  */
-#include <stdio.h>
 static inline void solitaire_slot_path(char *buf, size_t bufsize, int slot)
 {
-    (void)snprintf(buf, bufsize, SOLITAIRE_SLOT_FMT, slot);
+    char dir[PROFILE_DIR_MAX];
+    profile_dir(dir, sizeof(dir));
+    (void)snprintf(buf, bufsize, "%s/" SOLITAIRE_SUBDIR "/" SOLITAIRE_SLOT_BASENAME, dir, slot);
 }
 
 #endif /* PATHS_H */
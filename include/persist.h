@@ -0,0 +1,47 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Write-behind persistence service.
+ *
+ * Game code marks what changed (player profile, achievements, rollups) instead of
+ * writing files inline. A background writer coalesces the marks and writes
+ * each file at most once per staleness window. persist_flush() forces any
+ * pending writes out immediately (used on exit and for explicit saves).
+ *
+ * If the writer thread cannot be started, marks fall back to synchronous
+ * writes, so callers never need to care which mode is active.
+ */
+
+#ifndef PERSIST_H
+#define PERSIST_H
+
+/* ------------------------------------------------------------------------- */
+/* Dirty flags                                                               */
+/* ------------------------------------------------------------------------- */
+
+#define PERSIST_PLAYER            0x01u   /* PlayerData + GameConfig blob.   */
+#define PERSIST_ACHIEVEMENTS      0x02u   /* achievements.dat                */
+#define PERSIST_ROLLUPS           0x04u   /* rollups.dat (stats dashboard)   */
+#define PERSIST_ALL               (PERSIST_PLAYER | PERSIST_ACHIEVEMENTS | PERSIST_ROLLUPS)
+
+/* Upper bound on how long a change may sit in memory before hitting disk. */
+#define PERSIST_MAX_STALENESS_MS  2000
+
+/* ------------------------------------------------------------------------- */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------- */
+
+/** Start the background writer (idempotent). Registers a flush at exit. */
+void persist_init(void);
+
+/** Mark one or more PERSIST_* targets as needing a write. Never blocks on I/O. */
+void persist_mark_dirty(unsigned int what);
+
+/** Synchronously write everything currently marked dirty. */
+void persist_flush(void);
+
+/** Flush pending writes and stop the writer thread (idempotent). */
+void persist_shutdown(void);
+
+#endif /* PERSIST_H */
@@ -0,0 +1,105 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Thin portability layer (threads, locks, clocks).
+ *
+ * Responsibilities:
+ *   - Wrap Win32 threads / critical sections / condition variables and their
+ *     POSIX pthread equivalents behind one small API.
+ *   - Provide monotonic millisecond / nanosecond clocks and a portable sleep.
+ *
+ * Only what the program actually needs lives here; this is not a general
+ * purpose threading library.
+ */
+
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <pthread.h>
+#endif
+
+/* ------------------------------------------------------------------------- */
+/* Types                                                                     */
+/* ------------------------------------------------------------------------- */
+
+#ifdef _WIN32
+  typedef HANDLE             PlatformThread;
+  typedef CRITICAL_SECTION   PlatformMutex;
+  typedef CONDITION_VARIABLE PlatformCond;
+#else
+  typedef pthread_t          PlatformThread;
+  typedef pthread_mutex_t    PlatformMutex;
+  typedef pthread_cond_t     PlatformCond;
+#endif
+
+/* Thread body signature (same on every platform). */
+typedef void (*PlatformThreadFn)(void *arg);
+
+/* ------------------------------------------------------------------------- */
+/* Threads                                                                   */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * platform_thread_create
+ * Start fn(arg) on a new thread.
+ *
+ * @return true on success, false if the OS refused to create the thread.
+ */
+bool platform_thread_create(PlatformThread *thread, PlatformThreadFn fn, void *arg);
+
+/** Block until the thread exits and release its handle. */
+void platform_thread_join(PlatformThread thread);
+
+/** Processors currently online (at least 1); a default for worker counts. */
+int  platform_cpu_count(void);
+
+/* ------------------------------------------------------------------------- */
+/* Mutex + condition variable                                                */
+/* ------------------------------------------------------------------------- */
+
+void platform_mutex_init   (PlatformMutex *mutex);
+void platform_mutex_destroy(PlatformMutex *mutex);
+void platform_mutex_lock   (PlatformMutex *mutex);
+void platform_mutex_unlock (PlatformMutex *mutex);
+
+void platform_cond_init     (PlatformCond *cond);
+void platform_cond_destroy  (PlatformCond *cond);
+void platform_cond_wait     (PlatformCond *cond, PlatformMutex *mutex);
+void platform_cond_signal   (PlatformCond *cond);
+void platform_cond_broadcast(PlatformCond *cond);
+
+/**
+ * platform_cond_timedwait
+ * Wait on cond for at most timeoutMs milliseconds (spurious wakeups allowed).
+ *
+ * @return false if the wait timed out, true otherwise.
+ */
+bool platform_cond_timedwait(PlatformCond *cond, PlatformMutex *mutex, uint64_t timeoutMs);
+
+/* ------------------------------------------------------------------------- */
+/* Time                                                                      */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * Monotonic milliseconds since an arbitrary epoch (never jumps backwards and
+ * does not advance while the machine is suspended).
+ */
+uint64_t platform_now_ms(void);
+
+/**
+ * Highest-resolution monotonic clock, in nanoseconds since an arbitrary
+ * epoch. For measuring short intervals (gametimer.h), not for calendars.
+ */
+uint64_t platform_now_ns(void);
+
+/** Sleep the calling thread for roughly ms milliseconds. */
+void platform_sleep_ms(unsigned int ms);
+
+#endif /* PLATFORM_H */
@@ -0,0 +1,84 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Named player profiles.
+ *
+ * Each profile owns a directory with its own player data, achievements,
+ * rollups, history and Solitaire slots (see paths.h). The "default" profile
+ * is the legacy saves/ root, so existing saves keep working untouched.
+ *
+ * saves/profiles.idx is a compact index (one fixed-size row per profile:
+ * name, balance, last-played time) plus the last selected profile. Menus
+ * list profiles from the index alone; only the selected profile's files are
+ * ever loaded, so switching costs the same with 3 profiles or 300.
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ------------------------------------------------------------------------- */
+/* Limits                                                                    */
+/* ------------------------------------------------------------------------- */
+
+#define PROFILE_NAME_MAX        32          /* including the terminator */
+#define PROFILE_DEFAULT_NAME    "default"
+#define PROFILE_MAX_COUNT       1024
+
+/* ------------------------------------------------------------------------- */
+/* Types                                                                     */
+/* ------------------------------------------------------------------------- */
+
+/** One index row (also the on-disk record). */
+typedef struct {
+    char               name[PROFILE_NAME_MAX];
+    unsigned long long balance;
+    int64_t            lastPlayed;          /* time(NULL) of the last save, 0 = never */
+} ProfileSummary;
+
+/* ------------------------------------------------------------------------- */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * profile_init
+ * Load the index and activate `requested` (or, if NULL, the last selected
+ * profile, falling back to "default"). Only sets the active directory; the
+ * caller loads the profile's data as usual.
+ *
+ * @return false if `requested` is not a valid profile name.
+ */
+bool profile_init(const char *requested);
+
+/** Name of the active profile. */
+const char *profile_current(void);
+
+/** Letters, digits, '-' and '_' only; 1..PROFILE_NAME_MAX-1 characters. */
+bool profile_valid_name(const char *name);
+
+/** Number of profiles in the index, and row access (false if out of range). */
+int  profile_count(void);
+bool profile_at(int index, ProfileSummary *out);
+
+/**
+ * profile_switch
+ * Flush pending saves and close per-profile handles, then make `name` the
+ * active profile (creating its directories and index row if needed). The
+ * caller reloads player data, achievements and rollups afterwards. Main
+ * thread only.
+ *
+ * @return false if the name is invalid or the index is full.
+ */
+bool profile_switch(const char *name);
+
+/**
+ * profile_sync_index
+ * Copy the active profile's balance and the current time into its index row
+ * and rewrite saves/profiles.idx. Called whenever player data is saved.
+ */
+void profile_sync_index(void);
+
+#endif /* PROFILE_H */
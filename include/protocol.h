@@ -0,0 +1,72 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Machine protocol mode for scripted / regression runs.
+ *
+ * Started with `CardSimulation --protocol [--seed N]`:
+ *   - Input:  one answer per line on stdin (same answers a human would type).
+ *   - Output: one JSON object per line on the ORIGINAL stdout, e.g.
+ *               {"event":"screen","name":"main_menu","funds":1000}
+ *               {"event":"prompt","screen":"main_menu","kind":"int"}
+ *               {"event":"hand_result","game":"blackjack","result":"win",...}
+ *   - Human-readable text is redirected to stderr and never cleared, so a
+ *     driver can ignore it (2>/dev/null) or keep it as a transcript.
+ *   - EOF on stdin emits {"event":"eof"} and exits cleanly.
+ *
+ * Every function here is a cheap no-op when protocol mode is off, so game
+ * code can call them unconditionally.
+ */
+
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include "core.h"
+
+/* ------------------------------------------------------------------------- */
+/* Lifecycle                                                                 */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * protocol_init
+ * Switch to protocol mode: keep the real stdout for events, point stdout at
+ * stderr for human text, and hook prompts/EOF in the input layer.
+ *
+ * @return true if protocol mode is active.
+ */
+bool protocol_init(void);
+
+/** True once protocol_init() succeeded. */
+bool protocol_enabled(void);
+
+/* ------------------------------------------------------------------------- */
+/* Events                                                                    */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * protocol_emit
+ * Write {"event":"<event>"[,<fields>]} as one line. fieldsFmt is a printf
+ * format producing the remaining JSON members (or NULL for none), e.g.
+ *   protocol_emit("deal", "\"game\":\"%s\",\"round\":%d", "blackjack", 3);
+ */
+void protocol_emit(const char *event, const char *fieldsFmt, ...);
+
+/** Enter a named screen; emits a "screen" event carrying the current funds. */
+void protocol_screen(const char *name);
+
+/**
+ * protocol_cards
+ * Format cards as a JSON array of "Rank of Suit" strings. Returns a static
+ * buffer that is valid until the next call (use once per protocol_emit).
+ */
+const char *protocol_cards(const Card *cards, int count);
+
+/**
+ * protocol_json_string
+ * Quote text as a JSON string, escaping quotes, backslashes and control
+ * characters. Use it for any free-form text such as player or achievement
+ * names. Returns a static buffer valid until the next call.
+ */
+const char *protocol_json_string(const char *text);
+
+#endif /* PROTOCOL_H */
@@ -0,0 +1,67 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Frame-buffered terminal renderer.
+ *
+ * Responsibilities:
+ *   - Collect a whole screen ("frame") in one memory buffer and emit it with
+ *     a single write() instead of many small printf calls.
+ *   - Clear the screen with ANSI escapes rather than forking a shell.
+ *   - Optionally redraw only the lines that changed since the last frame.
+ *
+ * Usage:
+ *   render_begin();
+ *   render_printf("Draw Pile: %d cards\n", count);
+ *   ...
+ *   render_end();        // clears + writes the frame in one syscall
+ *
+ * render_printf() called outside a begin/end pair behaves like printf(), so
+ * small print helpers can be shared by framed and unframed code paths.
+ */
+
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stdbool.h>
+
+/* ------------------------------------------------------------------------- */
+/* Tunables                                                                  */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Rows kept free below a frame for prompts and messages. Partial redraws
+ * address rows absolutely, so they are only used when frame + margin fits
+ * on screen (i.e. nothing can have scrolled since the last frame).
+ */
+#define RENDER_SCROLL_MARGIN    12
+
+/* ------------------------------------------------------------------------- */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------- */
+
+/** Detect the terminal and enable ANSI processing (idempotent). */
+void render_init(void);
+
+/** Never emit escapes or clears; frames are written as plain text (scripted runs). */
+void render_set_plain(void);
+
+/** Enable/disable diff-based partial redraws (enabled by default on a TTY). */
+void render_set_partial(bool enabled);
+
+/** Start a new frame; output from render_printf() is buffered until render_end(). */
+void render_begin(void);
+
+/** Append formatted text to the open frame (or print directly if none is open). */
+void render_printf(const char *fmt, ...);
+
+/** Clear (or diff against the previous frame) and write the frame in one call. */
+void render_end(void);
+
+/** Clear the whole screen and forget the previous frame. */
+void render_clear(void);
+
+/** Forget the previous frame so the next one is drawn in full. */
+void render_invalidate(void);
+
+#endif /* RENDER_H */
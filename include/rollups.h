@@ -0,0 +1,110 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Incremental stats rollups.
+ *
+ * Aggregates that the stats screen reads directly, kept up to date in O(1)
+ * per settled round instead of being recomputed from the history log:
+ *   - per game (plus all games combined),
+ *   - per game and difficulty,
+ *   - per calendar day (local time) for the last ROLLUP_DAYS days.
+ *
+ * The table is a fixed-size blob saved to <profile>/rollups.dat through the
+ * persistence service (PERSIST_ROLLUPS). The blob records how many history
+ * rows it covers; at startup any rows logged after the last save are replayed
+ * into it. If the file is missing or from an older layout, it is rebuilt once
+ * from the whole history log.
+ */
+
+#ifndef ROLLUPS_H
+#define ROLLUPS_H
+
+#include "history.h"
+
+/* ------------------------------------------------------------------------- */
+/* Dimensions                                                                */
+/* ------------------------------------------------------------------------- */
+
+#define ROLLUP_DAYS            30
+
+typedef enum {
+    ROLLUP_DIFFICULTY_EASY,
+    ROLLUP_DIFFICULTY_NORMAL,     /* Blackjack has no difficulty: always Normal */
+    ROLLUP_DIFFICULTY_HARD,
+    ROLLUP_DIFFICULTY_COUNT
+} RollupDifficulty;
+
+/**
+ * RollupDay
+ * Aggregate for one local calendar day. `day` is days since 1970-01-01.
+ */
+typedef struct {
+    int64_t        day;
+    HistorySummary totals;
+} RollupDay;
+
+/* ------------------------------------------------------------------------- */
+/* Derived metrics                                                           */
+/* ------------------------------------------------------------------------- */
+
+static inline double rollup_mean_bet(const HistorySummary *s)
+{
+    return s->rounds ? (double)s->wagered / (double)s->rounds : 0.0;
+}
+
+static inline double rollup_win_rate(const HistorySummary *s)
+{
+    return s->rounds ? (double)s->wins / (double)s->rounds : 0.0;
+}
+
+/** Expected value (net payout) per round. */
+static inline double rollup_ev(const HistorySummary *s)
+{
+    return s->rounds ? (double)s->net / (double)s->rounds : 0.0;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * rollups_init
+ * Load the active profile's rollups.dat and replay the history rows it does
+ * not cover yet, or rebuild it from the history log if unusable.
+ */
+void rollups_init(void);
+
+/**
+ * rollups_apply
+ * Fold one settled round into every rollup it belongs to. O(1). Pass
+ * logged = true only if the round was appended to the history log, so the
+ * covered row count stays a prefix of the log.
+ */
+void rollups_apply(const HistoryRecord *record, bool logged);
+
+/** Write the table to disk (called by the persistence service). */
+bool rollups_save(void);
+
+/** Clear every rollup (the history log is left alone and stays uncounted). */
+void rollups_reset(void);
+
+/**
+ * rollups_game
+ * Copy the rollup for one game (HISTORY_GAME_ANY = all games). The streak in
+ * progress is counted in the streak histograms of the copy.
+ */
+void rollups_game(HistoryGame game, HistorySummary *out);
+
+/** Same as rollups_game(), restricted to one difficulty. */
+void rollups_difficulty(HistoryGame game, RollupDifficulty difficulty, HistorySummary *out);
+
+/**
+ * rollups_days
+ * Copy up to `max` day rollups with activity, most recent first.
+ *
+ * @return number of entries written.
+ */
+int rollups_days(RollupDay *out, int max);
+
+#endif /* ROLLUPS_H */
@@ -0,0 +1,194 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * cardsim-server internals (src/server/), shared by its three parts:
+ *
+ *   - server.c:   options, the epoll loop, connections and framing.
+ *   - session.c:  the session table, per-game slab arenas, and the session
+ *                 records: full snapshots (cardsim.h) the engines are
+ *                 restored from / snapshotted back into on every request.
+ *   - workers.c:  the worker pool for solver and AI jobs.
+ *
+ * Threading: only the loop thread touches the session table and the
+ * connections. A session whose job is queued is marked busy; the worker
+ * then owns its record until the job comes back through the done queue.
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "cardsim.h"
+#include "platform.h"
+#include "wire.h"
+
+/* ------------------------------------------------------------------------- */
+/* Engine scratch                                                            */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * EngineScratch
+ * Full-size engine structs a record is restored into for one request, plus
+ * the thread's solver and result tally. One per thread (loop and workers).
+ */
+typedef struct {
+    CsBlackjackTable  blackjack;
+    KlondikeGame      klondike;
+    CsIdiotGame       idiot;
+    SolverContext    *solver;      /* workers only */
+    CsTally           tally;       /* every settled round this thread saw */
+} EngineScratch;
+
+/* ------------------------------------------------------------------------- */
+/* Sessions                                                                  */
+/* ------------------------------------------------------------------------- */
+
+/* Low bits of a session id are the slot index + 1, the rest its generation. */
+#define SESSION_INDEX_BITS   20
+#define SESSION_MAX          ((1u << SESSION_INDEX_BITS) - 1)
+
+/**
+ * SlabArena
+ * Fixed-size records carved out of large chunks, with an intrusive free
+ * list: opening and closing a session never calls malloc once the arena
+ * has grown to the working set.
+ */
+typedef struct {
+    size_t   slotSize;
+    size_t   slotsPerChunk;
+    void   **chunks;
+    int      chunkCount;
+    int      chunkCapacity;
+    void    *freeList;
+    size_t   live;
+} SlabArena;
+
+/**
+ * SessionSlot
+ * One entry of the session table. `record` is NULL while the slot is free.
+ * The owner's sessions form a doubly linked list through prev/next; free
+ * slots are chained through `next`.
+ */
+typedef struct {
+    void     *record;
+    uint32_t  generation;
+    uint8_t   game;            /* CsGame                                   */
+    uint8_t   busy;            /* a worker holds the record                */
+    uint8_t   orphaned;        /* owner left while busy: free on return    */
+    int32_t   owner;           /* connection index                         */
+    int32_t   prev;
+    int32_t   next;
+} SessionSlot;
+
+typedef struct {
+    SessionSlot *slots;
+    uint32_t     capacity;
+    uint32_t     live;
+    int32_t      freeHead;
+    SlabArena    arenas[4];    /* indexed by CsGame */
+} SessionTable;
+
+bool  session_table_init(SessionTable *table, uint32_t capacity);
+void  session_table_free(SessionTable *table);
+
+/**
+ * session_open
+ * Allocate a slot and a zeroed record (cs_snap_max_size() bytes) for `game`,
+ * linked at the head of the owner's list `*owned`. Returns the slot index,
+ * or -1 when full.
+ */
+int32_t session_open(SessionTable *table, CsGame game, int32_t owner, int32_t *owned);
+
+/** Unlink slot `index` from `*owned` and free it (or orphan it while busy). */
+void  session_close(SessionTable *table, int32_t index, int32_t *owned);
+
+/** Free a slot whose owner already unlinked it (orphan coming back). */
+void  session_release(SessionTable *table, int32_t index);
+
+/** Slot for `id` if it is live and belongs to `owner`, else -1. */
+int32_t session_lookup(const SessionTable *table, uint32_t id, int32_t owner);
+
+static inline uint32_t session_id(const SessionTable *table, int32_t index)
+{
+    return (table->slots[index].generation << SESSION_INDEX_BITS) | (uint32_t)(index + 1);
+}
+
+/* --- Records ------------------------------------------------------------- */
+
+/**
+ * session_start
+ * Deal a new game into an open slot's record. Returns CS_WIRE_BAD_GAME for
+ * options the game does not take.
+ */
+CsWireStatus session_start(EngineScratch *scratch, CsGame game, void *record, const WireOpen *open);
+
+/** True if `action` has to go to a worker (solver, AI turns). */
+bool  session_is_slow(CsGame game, const WireAction *action);
+
+/**
+ * session_apply
+ * Restore the record, apply `action`, snapshot it back. Runs on the loop thread
+ * for quick actions and on a worker for slow ones.
+ */
+CsWireStatus session_apply(EngineScratch *scratch, CsGame game, void *record, const WireAction *action);
+
+/**
+ * session_view
+ * Write a player-view snapshot of the record to `out` (at most `capacity`
+ * bytes; see wire.h). Returns the length, or 0 if it does not fit.
+ */
+size_t session_view(EngineScratch *scratch, CsGame game, const void *record, uint8_t *out, size_t capacity);
+
+/* ------------------------------------------------------------------------- */
+/* Workers                                                                   */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * ServerJob
+ * A slow action. The loop fills in the request half; the worker runs it
+ * and writes `status` and the reply body.
+ */
+typedef struct ServerJob {
+    struct ServerJob *next;
+    int32_t           slot;
+    int32_t           conn;
+    uint32_t          connGeneration;
+    uint32_t          session;
+    uint32_t          tag;
+    uint8_t           game;
+    WireAction        action;
+    void             *record;
+
+    CsWireStatus      status;
+    size_t            bodyLength;
+    uint8_t           body[CS_WIRE_MAX_FRAME - CS_WIRE_HEADER_SIZE];
+} ServerJob;
+
+typedef struct WorkerPool WorkerPool;
+
+/**
+ * worker_pool_start
+ * Start `count` workers, each with its own EngineScratch and solver.
+ * Finished jobs are announced on an eventfd (worker_pool_fd()).
+ */
+WorkerPool *worker_pool_start(int count);
+
+/**
+ * worker_pool_stop
+ * Cancel the jobs no worker has started, let running ones finish, join the
+ * workers, merge their tallies into `tally` (may be NULL) and free the pool
+ * with any jobs still in it.
+ */
+void        worker_pool_stop(WorkerPool *pool, CsTally *tally);
+
+int         worker_pool_fd(const WorkerPool *pool);
+void        worker_pool_submit(WorkerPool *pool, ServerJob *job);
+
+/**
+ * worker_pool_take_done
+ * Take every finished job, oldest first, as a list through `next` (NULL if
+ * none). The caller frees them. Loop thread only.
+ */
+ServerJob  *worker_pool_take_done(WorkerPool *pool);
+
+#endif /* SERVER_H */
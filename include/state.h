@@ -0,0 +1,64 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Thread-safe access to the global game state.
+ *
+ * playerData and config (core.h) are owned by the main thread, which may keep
+ * mutating them directly. Every other thread goes through this layer:
+ *
+ *   - Snapshot: the main thread publishes a copy of PlayerData + GameConfig
+ *     under a seqlock (state_publish); background threads read a consistent
+ *     copy with state_snapshot(). Readers never block or take a lock; they
+ *     retry if a publish overlapped their copy.
+ *   - Play time: derived from the monotonic clock (see below) and folded
+ *     into playerData's h/m/s fields when it is published.
+ *
+ * persist_mark_dirty(PERSIST_PLAYER) publishes, so whatever the writer thread
+ * saves is at least as new as the last mark.
+ */
+
+#ifndef STATE_H
+#define STATE_H
+
+#include "core.h"
+
+/** Consistent copy of the shared state. */
+typedef struct {
+    PlayerData player;
+    GameConfig config;
+} StateSnapshot;
+
+/* ------------------------------------------------------------------------- */
+/* Snapshot (seqlock)                                                        */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * state_publish
+ * Fold the atomic counters into playerData, then copy playerData + config
+ * into the shared snapshot. Main thread (writers are serialized anyway).
+ */
+void state_publish(void);
+
+/** Copy the last published state. Lock-free; safe from any thread. */
+void state_snapshot(StateSnapshot *out);
+
+/* ------------------------------------------------------------------------- */
+/* Play time                                                                 */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Play time is not ticked by anything. The layer keeps one atomic "origin":
+ * the platform_now_ms() value at which the profile's play time would have
+ * been zero. Elapsed play time is now - origin, so it costs nothing while
+ * idle, never drifts, and skips time the machine spends suspended (the
+ * monotonic clock does not advance then).
+ */
+
+/** Total play time in seconds, including the current session (any thread). */
+unsigned long long state_playtime_seconds(void);
+
+/** Restart accounting at `seconds`, e.g. from freshly loaded playerData fields. */
+void state_playtime_set(unsigned long long seconds);
+
+#endif /* STATE_H */
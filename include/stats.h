@@ -0,0 +1,37 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Round recording entry point.
+ *
+ * Game code reports each settled round / game once, here; the record is
+ * fanned out to the history log (history.h) and the rollups (rollups.h),
+ * and the rollups are marked dirty for the persistence service.
+ *
+ * Engines that report through a CsStatsSink (cardsim.h) get the same
+ * treatment, plus the profile counters, from stats_profile_sink().
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include "history.h"
+#include "cardsim.h"
+
+/**
+ * stats_record_round
+ * Append the round to the history log and fold it into the rollups. Fills in
+ * the timestamp if it is 0.
+ */
+void stats_record_round(const HistoryRecord *record);
+
+/**
+ * stats_profile_sink
+ * Sink for the signed-in profile: each result bumps the game's wins /
+ * losses / draws, streaks and totals in playerData (plus what its flags
+ * imply, e.g. natural and double-down wins), then goes through
+ * stats_record_round(). Main thread only, like playerData itself.
+ */
+CsStatsSink stats_profile_sink(void);
+
+#endif /* STATS_H */
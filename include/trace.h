@@ -0,0 +1,78 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Scoped trace points for profiling game loops.
+ *
+ * Build with `make TRACE=1` (defines CARDSIM_TRACE) and run with
+ * `--trace FILE`. Every TRACE_SCOPE / TRACE_BEGIN..TRACE_END pair records a
+ * begin and an end event into a per-thread ring buffer (the newest events
+ * win when a ring wraps); at exit the rings are written as
+ *
+ *   - Chrome trace JSON when FILE ends in ".json" (chrome://tracing,
+ *     Perfetto), or
+ *   - folded stacks otherwise ("a;b;c <self-µs>" lines for flamegraph.pl,
+ *     speedscope, ...).
+ *
+ * Without CARDSIM_TRACE every macro expands to nothing and trace.c only
+ * reports that tracing is unavailable, so trace points cost nothing in
+ * normal builds.
+ *
+ * Names must be string literals (or otherwise live for the whole run); only
+ * the pointer is stored.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+
+/* ------------------------------------------------------------------------- */
+/* Control                                                                   */
+/* ------------------------------------------------------------------------- */
+
+/** True when the program was built with CARDSIM_TRACE. */
+bool trace_available(void);
+
+/**
+ * trace_start
+ * Start recording and export to `path` at exit (atexit). Returns false in
+ * builds without tracing.
+ */
+bool trace_start(const char *path);
+
+/** Write the rings to `path` now (format from the extension, see above). */
+bool trace_export(const char *path);
+
+/* ------------------------------------------------------------------------- */
+/* Trace points                                                              */
+/* ------------------------------------------------------------------------- */
+
+#ifdef CARDSIM_TRACE
+
+void trace_begin(const char *name);
+void trace_end(void);
+
+/* Cleanup hook for TRACE_SCOPE; not called directly. */
+static inline void trace_scope_exit(int *unused) { (void)unused; trace_end(); }
+
+#define TRACE_CONCAT_(a, b)  a##b
+#define TRACE_CONCAT(a, b)   TRACE_CONCAT_(a, b)
+
+/* Begin now, end when the enclosing block exits (GCC/Clang cleanup). */
+#define TRACE_SCOPE(name) \
+    __attribute__((cleanup(trace_scope_exit))) int TRACE_CONCAT(traceScope_, __LINE__) = \
+        (trace_begin(name), 0)
+
+#define TRACE_BEGIN(name)  trace_begin(name)
+#define TRACE_END()        trace_end()
+
+#else
+
+#define TRACE_SCOPE(name)  ((void)0)
+#define TRACE_BEGIN(name)  ((void)0)
+#define TRACE_END()        ((void)0)
+
+#endif /* CARDSIM_TRACE */
+
+#endif /* TRACE_H */
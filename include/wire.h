@@ -0,0 +1,160 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * cardsim-server wire protocol (see src/server/).
+ *
+ * A connection carries frames in both directions. Every frame is:
+ *
+ *   u32  length     bytes that follow (header + body), at most CS_WIRE_MAX_FRAME
+ *   u8   type       CS_MSG_*; a reply is the request type | CS_MSG_REPLY
+ *   u8   game       CsGame (OPEN); echoed in replies
+ *   u16  status     CS_WIRE_* in replies, 0 in requests
+ *   u32  session    session id (0 in OPEN; the new id in its reply)
+ *   u32  tag        chosen by the client, copied into the reply
+ *   ...  body
+ *
+ * Integers are little-endian. Requests on one connection may be pipelined;
+ * replies to jobs that run on a worker (solves, AI turns) can overtake
+ * later replies, so clients match them by `tag`.
+ *
+ * Views are player-view snapshots (cardsim.h), read in place with
+ * cs_snap_open() and the cs_snap_* accessors.
+ */
+
+#ifndef WIRE_H
+#define WIRE_H
+
+#include <stdint.h>
+
+#define CS_WIRE_VERSION       2
+
+#define CS_WIRE_HEADER_SIZE   12         /* after the length prefix            */
+#define CS_WIRE_MAX_FRAME     4096       /* largest length a peer may announce */
+
+/* ------------------------------------------------------------------------- */
+/* Messages                                                                  */
+/* ------------------------------------------------------------------------- */
+
+typedef enum {
+    CS_MSG_OPEN   = 1,     /* body: WireOpen; reply: view of the new session  */
+    CS_MSG_ACTION = 2,     /* body: WireAction; reply: view after the action  */
+    CS_MSG_VIEW   = 3,     /* no body; reply: view                            */
+    CS_MSG_CLOSE  = 4,     /* no body; reply: empty                           */
+    CS_MSG_REPLY  = 0x80
+} CsWireType;
+
+/* Reply status (a failed request gets an empty body). */
+typedef enum {
+    CS_WIRE_OK         = 0,
+    CS_WIRE_BAD_FRAME  = 1,    /* malformed header or body                 */
+    CS_WIRE_BAD_GAME   = 2,    /* unknown game or option                   */
+    CS_WIRE_NO_SESSION = 3,    /* unknown id, or owned by another connection */
+    CS_WIRE_BUSY       = 4,    /* a worker job for this session is running */
+    CS_WIRE_ILLEGAL    = 5,    /* the engine rejected the action           */
+    CS_WIRE_FULL       = 6,    /* session limit reached                    */
+    CS_WIRE_BAD_TYPE   = 7     /* unknown message type                     */
+} CsWireStatus;
+
+/**
+ * WireOpen (12 bytes)
+ * Blackjack: option = decks (1..MAX_SHOE_DECKS). Klondike: difficulty.
+ * Idiot: difficulty of the AI seat, option 1 = shuffle in two Jokers.
+ */
+typedef struct {
+    uint8_t  difficulty;
+    uint8_t  option;
+    uint64_t seed;
+} WireOpen;
+
+#define CS_WIRE_OPEN_SIZE     12    /* u8 difficulty, u8 option, u16 0, u64 seed */
+
+/**
+ * WireAction (8 bytes)
+ * u8 action, u8 arg0, u8 arg1, u8 arg2, u32 amount.
+ */
+typedef struct {
+    uint8_t  action;
+    uint8_t  arg[3];
+    uint32_t amount;
+} WireAction;
+
+#define CS_WIRE_ACTION_SIZE   8
+
+/* Blackjack actions. DEAL takes the bet in `amount`. */
+#define CS_ACT_BJ_DEAL        1
+#define CS_ACT_BJ_HIT         2
+#define CS_ACT_BJ_STAND       3
+#define CS_ACT_BJ_DOUBLE      4
+#define CS_ACT_BJ_SPLIT       5
+#define CS_ACT_BJ_SURRENDER   6
+
+/* Klondike actions. MOVE: arg0 = CsKlondikeMove, arg1 = from, arg2 = to
+   (0-based). SOLVE runs the solver on a worker and fills in the verdict. */
+#define CS_ACT_KL_DRAW        1
+#define CS_ACT_KL_MOVE        2
+#define CS_ACT_KL_SOLVE       3
+
+/* Idiot action: the player's turn (arg0 = index, arg1 = extras, as for
+   cs_idiot_play()), then the AI's replies on a worker until it is the
+   player's turn again. */
+#define CS_ACT_ID_PLAY        1
+
+/* ------------------------------------------------------------------------- */
+/* Views (reply bodies)                                                      */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * OPEN, ACTION and VIEW replies carry a CS_SNAP_PLAYER_VIEW snapshot of the
+ * session; the player is seat 0 (the Idiot AI is seat 1). Hidden cards are
+ * CS_SNAP_HIDDEN but keep their place, so every pile still has its count.
+ *
+ * Blackjack:  no RNG or shoe (SHOE_NEXT gives the cards dealt); the hole
+ *             card is hidden until the round is over.
+ * Klondike:   face-down column cards and the whole stock are hidden.
+ *             VERDICT and NODES are present once SOLVE has run on this
+ *             board, and dropped by the next DRAW or MOVE.
+ * Idiot:      the AI's hand, all face-down cards and the draw pile are
+ *             hidden; LAST_* describe the AI's last turn.
+ */
+
+/* ------------------------------------------------------------------------- */
+/* Little-endian helpers                                                     */
+/* ------------------------------------------------------------------------- */
+
+static inline void wire_put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void wire_put_u32(uint8_t *p, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static inline void wire_put_u64(uint8_t *p, uint64_t v)
+{
+    for (int i = 0; i < 8; ++i) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static inline uint16_t wire_get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t wire_get_u32(const uint8_t *p)
+{
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+static inline uint64_t wire_get_u64(const uint8_t *p)
+{
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+#endif /* WIRE_H */
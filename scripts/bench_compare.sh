@@ -0,0 +1,87 @@
+#!/bin/sh
+#
+# @author: Anthony Ward
+# @upload date: 08/24/2025
+#
+# Compare `--bench` throughput between build variants.
+#
+# Usage: scripts/bench_compare.sh BASELINE CANDIDATE [CANDIDATE...]
+#
+# The binaries run the benchmark suite in turn, BENCH_RUNS rounds (default
+# 3), so slow drift on a busy machine hits every variant alike; the best
+# result per kernel is kept. The script prints a table and exits with 1
+# if any key kernel of any candidate is more than BENCH_TOLERANCE percent
+# (default 5) slower than the baseline.
+#
+# Key kernels: BENCH_KERNELS (default "solver deal rollups").
+#
+# The 5% default assumes a quiet machine; on a shared or single-core box the
+# solver kernel alone swings by more than that, so raise BENCH_RUNS and/or
+# BENCH_TOLERANCE there rather than trusting a single red line.
+
+set -eu
+
+RUNS=${BENCH_RUNS:-3}
+TOLERANCE=${BENCH_TOLERANCE:-5}
+KERNELS=${BENCH_KERNELS:-"solver deal rollups"}
+
+if [ "$#" -lt 2 ]; then
+    echo "usage: $0 BASELINE CANDIDATE [CANDIDATE...]" >&2
+    exit 2
+fi
+
+# Raw output of every run, tagged with the binary's position: "N kernel value"
+samples=$(mktemp)
+trap 'rm -f "$samples"' EXIT
+
+i=0
+while [ "$i" -lt "$RUNS" ]; do
+    n=0
+    for binary in "$@"; do
+        "$binary" --bench | awk -v n="$n" '$1 == "bench" { print n, $2, $3 }' >> "$samples"
+        n=$((n + 1))
+    done
+    i=$((i + 1))
+done
+
+# best_of N -> "kernel throughput" lines for the N-th binary (max over runs)
+best_of() {
+    awk -v n="$1" '$1 == n { if ($3 > best[$2]) best[$2] = $3 }
+                   END { for (k in best) print k, best[k] }' "$samples"
+}
+
+echo "Baseline: $1 ($RUNS runs, tolerance ${TOLERANCE}%)"
+baseline=$(best_of 0)
+shift
+
+status=0
+index=1
+for candidate in "$@"; do
+    echo
+    echo "Candidate: $candidate"
+    results=$(best_of "$index")
+    index=$((index + 1))
+
+    for kernel in $KERNELS; do
+        base=$(echo "$baseline" | awk -v k="$kernel" '$1 == k { print $2 }')
+        cand=$(echo "$results"  | awk -v k="$kernel" '$1 == k { print $2 }')
+
+        if [ -z "$base" ] || [ -z "$cand" ]; then
+            echo "  $kernel: missing from the --bench output"
+            status=1
+            continue
+        fi
+
+        verdict=$(awk -v b="$base" -v c="$cand" -v t="$TOLERANCE" 'BEGIN {
+            change = (c - b) / b * 100
+            printf "%+7.1f%% %s", change, (change < -t) ? "REGRESSION" : "ok"
+        }')
+        printf "  %-8s %14.1f -> %14.1f  %s\n" "$kernel" "$base" "$cand" "$verdict"
+
+        case $verdict in
+            *REGRESSION) status=1 ;;
+        esac
+    done
+done
+
+exit $status
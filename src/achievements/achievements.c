@@ -5,14 +5,22 @@
  * Achievement initialization, persistence, and criteria
  *
  * This module:
- *  - registers all known achievements in well-defined category order,
+ *  - loads the ACHIEVEMENT_DEFINITIONS table into flat per-clause arrays,
  *  - offers save/load to a compact binary file,
  *  - exposes helpers to unlock and render achievements,
- *  - defines criteria predicates read from global playerData stats.
+ *  - evaluates every definition with one loop over global playerData stats.
+ *
+ * The records are changed on the main thread and saved from the persistence
+ * writer thread, so every write to achievements[] / achievement_count and
+ * the save copy go through g_Lock. Main-thread reads need no lock.
  */
 
 #include "achievements.h"
 #include "paths.h"
+#include "persist.h"
+#include "platform.h"
+#include "protocol.h"
+#include "state.h"
 
 Achievement achievements[MAX_ACHIEVEMENTS];
 
@@ -22,48 +30,54 @@ Achievement achievements[MAX_ACHIEVEMENTS];
 
 int achievement_count = 0;
 
-/* Table of (name, predicate) pairs used by checkAchievements() */
-AchievementCheck achievementChecks[] = {
-    /* General */
-    { "First Shuffle",        firstShuffleCriteria       },
-    { "Persistent Player",    persistentPlayerCriteria   },
-    { "Card Novice",          cardNoviceCriteria         },
-    { "Card Apprentice",      cardApprenticeCriteria     },
-    { "Card Profit",          cardProfitCriteria         },
-    { "Card Master",          cardMasterCriteria         },
-
-    /* 21 Blackjack */
-    { "21 Blackjack",         blackjackWinCriteria       },
-    { "Double Trouble",       doubleTroubleCriteria      },
-    { "Insurance Payout",     insurancePayoutCriteria    },
-    { "Risk Taker",           riskTakerCriteria          },
-    { "Lucky Streak",         luckyStreakCriteria        },
-
-    /* Solitaire */
-    { "Perfect Clear",        perfectClearCriteria       },
-    { "Solitaire Novice",     solitaireNoviceCriteria    },
-    { "Solitaire Apprentice", solitaireApprenticeCriteria},
-    { "Solitaire Master",     solitaireMasterCriteria    },
-    { "The Long Game",        theLongGameCriteria        },
-
-    /* Idiot */
-    { "Not the Idiot",        notTheIdiotCriteria        },
-    { "Mirror Match",         mirrorMatchCriteria        },
-    { "Pyrotechnic",          pyrotechnicCriteria        },
-    { "4 of a Kind",          fourOfAKindCriteria        },
-    { "The Trickster",        theTricksterCriteria       },
-
-    /* Hidden */
-    { "Time Master",          timeMasterCriteria         },
-    { "Infinite Wealth",      infiniteWealthCriteria     },
-    { "From Rags to Riches",  fromRagsToRichesCriteria   },
-    { "The Collector",        theCollectorCriteria       },
+/* Read-only definition rows, expanded from the table in achievements.h. */
+#define ACH_DEF_ENTRY(id, category, name, description, stat, cmp, threshold, stat2, cmp2, threshold2) \
+    [id] = { name, description, category, { stat, stat2 }, { cmp, cmp2 }, { threshold, threshold2 } },
+
+const AchievementDef achievementDefs[ACH_COUNT] = {
+    ACHIEVEMENT_DEFINITIONS(ACH_DEF_ENTRY)
 };
 
+#undef ACH_DEF_ENTRY
+
+/*
+ * Struct-of-arrays copy of the definitions, indexed like achievements[].
+ * A clause holds when (stat >= threshold) XOR invert, i.e. ACH_CMP_LT is
+ * stored as an inverted ACH_CMP_GE so evaluation needs no switch.
+ */
+static uint8_t            g_Category[MAX_ACHIEVEMENTS];
+static uint32_t           g_DependsOn[MAX_ACHIEVEMENTS];    /* STAT_BIT mask */
+static uint8_t            g_ClauseStat[ACH_MAX_CLAUSES][MAX_ACHIEVEMENTS];
+static uint8_t            g_ClauseInvert[ACH_MAX_CLAUSES][MAX_ACHIEVEMENTS];
+static unsigned long long g_ClauseThreshold[ACH_MAX_CLAUSES][MAX_ACHIEVEMENTS];
+
+/* Unlocked bitset mirrored from achievements[].unlocked (one bit per slot). */
+#define ACH_BITSET_WORDS ((MAX_ACHIEVEMENTS + 31) / 32)
+
+static uint32_t g_UnlockedBits[ACH_BITSET_WORDS];
+static int      g_UnlockedCount = 0;
+
+/* Last observed value of every stat; a mismatch marks the stat dirty. */
+static unsigned long long g_StatShadow[STAT_FIELD_COUNT];
+static bool               g_StatShadowValid = false;
+
+/* Records as of the last save, written outside the lock. */
+static Achievement   g_SaveCopy[MAX_ACHIEVEMENTS];
+static int           g_SaveCount = 0;
+static PlatformMutex g_Lock;
+static bool          g_LockReady = false;   /* first use is on the main thread */
+
 /* ------------------------------------------------------------------------- */
 /* Internal helpers                                                          */
 /* ------------------------------------------------------------------------- */
 
+static void ensure_lock(void)
+{
+    if (g_LockReady) { return; }
+    platform_mutex_init(&g_Lock);
+    g_LockReady = true;
+}
+
 /* Safe bounded copy that always NUL-terminates the destination. */
 static void copy_str_safe(char *dst, size_t dst_cap, const char *src)
 {
@@ -73,53 +87,147 @@ static void copy_str_safe(char *dst, size_t dst_cap, const char *src)
     dst[dst_cap - 1] = '\0';
 }
 
+static inline bool bit_test(int index)
+{
+    return (g_UnlockedBits[index >> 5] >> (index & 31)) & 1u;
+}
+
+static inline void bit_set(int index)
+{
+    g_UnlockedBits[index >> 5] |= (1u << (index & 31));
+}
+
+/* Linear name lookup; returns the slot or -1. Only used off the hot path. */
+static int find_achievement(const char *name)
+{
+    if (!name) { return -1; }
+
+    for (int i = 0; i < achievement_count; ++i)
+    {
+        if (strcmp(achievements[i].name, name) == 0) { return i; }
+    }
+    return -1;
+}
+
+/* Rebuild the bitset from achievements[].unlocked (after load/reset). */
+static void sync_unlocked_bits(void)
+{
+    memset(g_UnlockedBits, 0, sizeof(g_UnlockedBits));
+    g_UnlockedCount = 0;
+
+    for (int i = 0; i < achievement_count; ++i)
+    {
+        if (achievements[i].unlocked)
+        {
+            bit_set(i);
+            ++g_UnlockedCount;
+        }
+    }
+
+    /* Stats may disagree with the new lock state: re-evaluate everything. */
+    g_StatShadowValid = false;
+}
+
+/* Store one clause of slot index into the flat arrays. */
+static void set_clause(int index, int clause, uint8_t stat, uint8_t cmp,
+                       unsigned long long threshold)
+{
+    if (stat >= STAT_FIELD_COUNT) { stat = STAT_NONE; }
+
+    g_ClauseStat[clause][index]      = stat;
+    g_ClauseInvert[clause][index]    = (cmp == ACH_CMP_LT) ? 1u : 0u;
+    g_ClauseThreshold[clause][index] = threshold;
+
+    if (stat != STAT_NONE) { g_DependsOn[index] |= STAT_BIT(stat); }
+}
+
+/* Register one table row: the display record plus its flattened clauses. */
+static void load_definition(const AchievementDef *def)
+{
+    const int index = achievement_count;
+    if (add_achievement(def->name, def->description) != 0) { return; }
+
+    g_Category[index] = def->category;
+    for (int clause = 0; clause < ACH_MAX_CLAUSES; ++clause)
+    {
+        set_clause(index, clause, def->stat[clause], def->cmp[clause], def->threshold[clause]);
+    }
+}
+
+/* Current value of one stat counter. */
+static unsigned long long read_stat(StatField field)
+{
+    switch (field)
+    {
+        case STAT_GAMES_PLAYED:          return (unsigned long long)playerData.games_played;
+        case STAT_TOTAL_WINS:            return (unsigned long long)playerData.total_wins;
+        case STAT_BJ_BLACKJACK_WINS:     return (unsigned long long)playerData.blackjack.blackjack_wins;
+        case STAT_BJ_DOUBLEDOWN_WINS:    return (unsigned long long)playerData.blackjack.doubledown_wins;
+        case STAT_BJ_INSURANCE_SUCCESS:  return (unsigned long long)playerData.blackjack.insurance_success;
+        case STAT_BJ_SPLIT_WINS:         return (unsigned long long)playerData.blackjack.split_wins;
+        case STAT_BJ_MAX_WIN_STREAK:     return (unsigned long long)playerData.blackjack.max_win_streak;
+        case STAT_SOL_PERFECT_CLEAR:     return (unsigned long long)playerData.solitaire.perfect_clear;
+        case STAT_SOL_EASY_WINS:         return (unsigned long long)playerData.solitaire.easy_wins;
+        case STAT_SOL_NORMAL_WINS:       return (unsigned long long)playerData.solitaire.normal_wins;
+        case STAT_SOL_HARD_WINS:         return (unsigned long long)playerData.solitaire.hard_wins;
+        case STAT_SOL_LONGEST_GAME:      return (unsigned long long)playerData.solitaire.longest_game_minutes;
+        case STAT_IDIOT_WINS:            return (unsigned long long)playerData.idiot.wins;
+        case STAT_IDIOT_MIRROR_MATCH:    return (unsigned long long)playerData.idiot.mirror_match;
+        case STAT_IDIOT_BURNS:           return (unsigned long long)playerData.idiot.burns;
+        case STAT_IDIOT_FOUR_KIND_BURNS: return (unsigned long long)playerData.idiot.four_of_a_kind_burns;
+        case STAT_IDIOT_TRICKSTER_WINS:  return (unsigned long long)playerData.idiot.trickster_wins;
+        case STAT_TIME_PLAYED_HOURS:     return state_playtime_seconds() / 3600ULL;   /* live, not last save */
+        case STAT_STARTING_BALANCE:      return playerData.starting_balance;
+        case STAT_PLAYER_MONEY:          return playerData.uPlayerMoney;
+        case STAT_UNLOCKED_COUNT:        return (unsigned long long)g_UnlockedCount;
+        default:                         return 0;   /* STAT_NONE */
+    }
+}
+
+/* Refresh the stat shadow; return the mask of stats that changed. */
+static uint32_t collect_dirty_stats(void)
+{
+    uint32_t dirtyMask = 0;
+
+    for (int field = 0; field < STAT_FIELD_COUNT; ++field)
+    {
+        const unsigned long long value = read_stat((StatField)field);
+        if (!g_StatShadowValid || value != g_StatShadow[field])
+        {
+            g_StatShadow[field] = value;
+            dirtyMask |= STAT_BIT(field);
+        }
+    }
+
+    g_StatShadowValid = true;
+    return dirtyMask;
+}
+
 /* ------------------------------------------------------------------------- */
 /* Initialization                                                            */
 /* ------------------------------------------------------------------------- */
 
 void initialize_achievements(void)
 {
+    ensure_lock();
+
+    platform_mutex_lock(&g_Lock);
     achievement_count = 0;
     memset(achievements, 0, sizeof(achievements));
+    platform_mutex_unlock(&g_Lock);
 
-    /* General */
-    add_achievement("First Shuffle",       "Play your first game.");
-    add_achievement("Persistent Player",   "Play 100 games.");
-    add_achievement("Card Novice",         "Win 5 games.");
-    add_achievement("Card Apprentice",     "Win 10 games.");
-    add_achievement("Card Profit",         "Win 25 games.");
-    add_achievement("Card Master",         "Win 50 games.");
-
-    /* 21 Blackjack */
-    add_achievement("21 Blackjack",        "Win with a blackjack.");
-    add_achievement("Double Trouble",      "Win or Draw after doubling down.");
-    add_achievement("Insurance Payout",    "Successfully use insurance.");
-    add_achievement("Risk Taker",          "Win both hands after splitting.");
-    add_achievement("Lucky Streak",        "Win 10 games in a row.");
-
-    /* Solitaire */
-    add_achievement("Perfect Clear",       "Win without using an undo.");
-    add_achievement("Solitaire Novice",    "Win 1 game on easy difficulty.");
-    add_achievement("Solitaire Apprentice","Win 1 game on normal difficulty.");
-    add_achievement("Solitaire Master",    "Win 1 game on hard difficulty.");
-    add_achievement("The Long Game",       "Take at least 30 minutes to complete a game.");
-
-    /* Idiot */
-    add_achievement("Not the Idiot",       "Win 1 game of Idiot.");
-    add_achievement("Mirror Match",        "Play a 3 against another 3.");
-    add_achievement("Pyrotechnic",         "Burn the pile 10 times.");
-    add_achievement("4 of a Kind",         "Burn the pile with 4 of a kind.");
-    add_achievement("The Trickster",       "Win a game without picking up the pile.");
-
-    /* Hidden */
-    add_achievement("Time Master",         "Play for at least 1 hour.");
-    add_achievement("Infinite Wealth",     "Have a starting balance of at least $1,000,000.");
-    add_achievement("From Rags to Riches", "Start with a balance less than $100 and earn at least $10,000.");
-    add_achievement("The Collector",       "Collect all achievements.");
-
-    /* Load persistent state; if none exists yet, create it. */
+    memset(g_DependsOn, 0, sizeof(g_DependsOn));
+
+    for (int id = 0; id < ACH_COUNT; ++id)
+    {
+        load_definition(&achievementDefs[id]);
+    }
+
+    /* Load persistent state; if none exists yet, create it (via the writer,
+     * so the file is never written from two threads at once). */
     if (load_achievements() != 0) {
-        (void)save_achievements();
+        sync_unlocked_bits();
+        persist_mark_dirty(PERSIST_ACHIEVEMENTS);
     }
 }
 
@@ -127,49 +235,98 @@ void initialize_achievements(void)
 /* CRUD / management                                                         */
 /* ------------------------------------------------------------------------- */
 
+/**
+ * add_achievement
+ * Append a display record. Achievements added this way have no criteria
+ * (their clause can never hold) and are only unlocked explicitly.
+ */
 int add_achievement(const char *name, const char *description)
 {
     if (achievement_count >= MAX_ACHIEVEMENTS) { return -1; }
 
-    copy_str_safe(achievements[achievement_count].name,
-                  sizeof(achievements[achievement_count].name),
+    const int index = achievement_count;
+
+    ensure_lock();
+    platform_mutex_lock(&g_Lock);
+
+    copy_str_safe(achievements[index].name,
+                  sizeof(achievements[index].name),
                   name);
 
-    copy_str_safe(achievements[achievement_count].description,
-                  sizeof(achievements[achievement_count].description),
+    copy_str_safe(achievements[index].description,
+                  sizeof(achievements[index].description),
                   description);
 
-    achievements[achievement_count].unlocked        = false;
-    achievements[achievement_count].hidden_unlocked = false;
-
+    achievements[index].unlocked        = false;
+    achievements[index].hidden_unlocked = false;
     ++achievement_count;
+
+    platform_mutex_unlock(&g_Lock);
+
+    /* Default: STAT_NONE >= 1 never holds; load_definition() overrides. */
+    g_Category[index]  = ACH_CAT_GENERAL;
+    g_DependsOn[index] = 0;
+    for (int clause = 0; clause < ACH_MAX_CLAUSES; ++clause)
+    {
+        set_clause(index, clause, STAT_NONE, ACH_CMP_GE, 1);
+    }
+
     return 0;
 }
 
+int unlock_achievement_id(AchievementId id)
+{
+    if ((int)id < 0 || (int)id >= achievement_count) { return 0; }
+    if (bit_test((int)id)) { return 0; }  /* already unlocked */
+
+    bit_set((int)id);
+    ++g_UnlockedCount;
+
+    platform_mutex_lock(&g_Lock);
+    achievements[id].unlocked = true;
+    platform_mutex_unlock(&g_Lock);
+    printf("Achievement unlocked: %s\n", achievements[id].name);
+    protocol_emit("achievement", "\"name\":%s", protocol_json_string(achievements[id].name));
+    return 1; /* success */
+}
+
+int is_achievement_unlocked_id(AchievementId id)
+{
+    if ((int)id < 0 || (int)id >= achievement_count) { return 0; }
+    return bit_test((int)id) ? 1 : 0;
+}
+
+/* Name-based lookups are kept for callers outside the hot path. */
 int unlock_achievement(const char *name)
 {
-    for (int i = 0; i < achievement_count; ++i)
-    {
-        if (strcmp(achievements[i].name, name) == 0 && !achievements[i].unlocked)
-        {
-            achievements[i].unlocked = true;
-            printf("Achievement unlocked: %s\n", achievements[i].name);
-            return 1; /* success */
-        }
-    }
-    return 0; /* not found or already unlocked */
+    const int index = find_achievement(name);
+    return (index < 0) ? 0 : unlock_achievement_id((AchievementId)index);
 }
 
 int is_achievement_unlocked(const char *name)
 {
+    const int index = find_achievement(name);
+    return (index < 0) ? 0 : is_achievement_unlocked_id((AchievementId)index);
+}
+
+void reset_achievements_state(void)
+{
+    ensure_lock();
+
+    platform_mutex_lock(&g_Lock);
     for (int i = 0; i < achievement_count; ++i)
     {
-        if (strcmp(achievements[i].name, name) == 0)
-        {
-            return achievements[i].unlocked ? 1 : 0;
-        }
+        achievements[i].unlocked = false;
     }
-    return 0;
+    platform_mutex_unlock(&g_Lock);
+
+    sync_unlocked_bits();
+}
+
+AchievementCategory achievement_category(int index)
+{
+    if (index < 0 || index >= achievement_count) { return ACH_CAT_GENERAL; }
+    return (AchievementCategory)g_Category[index];
 }
 
 void list_achievements(void)
@@ -190,17 +347,27 @@ void list_achievements(void)
 
 int save_achievements(void)
 {
-    FILE *file = fopen(ACHIEVEMENTS_PATH, "wb");
+    char path[SAVE_PATH_MAX];
+    save_path(path, sizeof(path), ACHIEVEMENTS_FILE);
+
+    ensure_lock();
+
+    platform_mutex_lock(&g_Lock);
+    g_SaveCount = achievement_count;
+    memcpy(g_SaveCopy, achievements, sizeof(Achievement) * (size_t)g_SaveCount);
+    platform_mutex_unlock(&g_Lock);
+
+    FILE *file = fopen(path, "wb");
     if (!file) { return -1; }  /* could not open file */
 
-    if (fwrite(&achievement_count, sizeof(int), 1, file) != 1)
+    if (fwrite(&g_SaveCount, sizeof(int), 1, file) != 1)
     {
         fclose(file);
         return -2;  /* Error writing count */
     }
 
-    if (fwrite(achievements, sizeof(Achievement), (size_t)achievement_count, file)
-        != (size_t)achievement_count)
+    if (fwrite(g_SaveCopy, sizeof(Achievement), (size_t)g_SaveCount, file)
+        != (size_t)g_SaveCount)
     {
         fclose(file);
         return -3;  /* Error writing array */
@@ -210,28 +377,53 @@ int save_achievements(void)
     return 0;
 }
 
+/**
+ * load_achievements
+ * Restore unlocked flags from disk. Records are matched to the loaded
+ * definitions by name, so rows can be added or reordered in the table
+ * without invalidating existing save files; unknown names are ignored.
+ */
 int load_achievements(void)
 {
-    FILE *file = fopen(ACHIEVEMENTS_PATH, "rb");
+    char path[SAVE_PATH_MAX];
+    save_path(path, sizeof(path), ACHIEVEMENTS_FILE);
+
+    FILE *file = fopen(path, "rb");
     if (!file) { return -1; }  /* could not open file */
 
-    if (fread(&achievement_count, sizeof(int), 1, file) != 1)
+    int savedCount = 0;
+    if (fread(&savedCount, sizeof(int), 1, file) != 1)
     {
         fclose(file);
         return -2;  /* Error reading count */
     }
 
-    if (achievement_count < 0)                   { achievement_count = 0; }
-    if (achievement_count > MAX_ACHIEVEMENTS)    { achievement_count = MAX_ACHIEVEMENTS; }
+    if (savedCount < 0) { savedCount = 0; }
 
-    if (fread(achievements, sizeof(Achievement), (size_t)achievement_count, file)
-        != (size_t)achievement_count)
+    Achievement record;
+    for (int i = 0; i < savedCount; ++i)
     {
-        fclose(file);
-        return -3;  /* Error reading array */
+        if (fread(&record, sizeof(Achievement), 1, file) != 1)
+        {
+            fclose(file);
+            sync_unlocked_bits();
+            return -3;  /* Error reading array */
+        }
+
+        record.name[MAX_ACHIEVEMENT_NAME_LENGTH - 1] = '\0';
+
+        const int index = find_achievement(record.name);
+        if (index >= 0)
+        {
+            platform_mutex_lock(&g_Lock);
+            achievements[index].unlocked        = record.unlocked;
+            achievements[index].hidden_unlocked = record.hidden_unlocked;
+            platform_mutex_unlock(&g_Lock);
+        }
     }
 
     fclose(file);
+    sync_unlocked_bits();
     return 0;
 }
 
@@ -239,18 +431,16 @@ int load_achievements(void)
 /* Presentation helpers                                                      */
 /* ------------------------------------------------------------------------- */
 
-void printAchievementCategory(const char *categoryName, int start, int count)
+void printAchievementCategory(const char *categoryName, AchievementCategory category)
 {
-    if (!categoryName || count <= 0 || start >= achievement_count) { return; }
-    if (start < 0) { start = 0; }
-
-    int end = start + count;
-    if (end > achievement_count) { end = achievement_count; }
+    if (!categoryName) { return; }
 
     printf("\n%s\n", categoryName);
 
-    for (int i = start; i < end; ++i)
+    for (int i = 0; i < achievement_count; ++i)
     {
+        if (g_Category[i] != (uint8_t)category) { continue; }
+
         printf("[%c] %s: %s\n",
                achievements[i].unlocked ? 'X' : ' ',
                achievements[i].name,
@@ -262,17 +452,38 @@ void printAchievementCategory(const char *categoryName, int start, int count)
 /* Criteria evaluation                                                       */
 /* ------------------------------------------------------------------------- */
 
+/**
+ * checkAchievements
+ * Find the stat counters that changed since the previous call, then make one
+ * pass over the flat definition arrays, testing only locked achievements
+ * that read a changed stat. Unlocks bump STAT_UNLOCKED_COUNT, so we repeat
+ * until nothing new fires.
+ */
 void checkAchievements(void)
 {
-    const size_t n = sizeof(achievementChecks) / sizeof(achievementChecks[0]);
-
-    for (size_t i = 0; i < n; ++i)
+    uint32_t dirtyMask;
+    while ((dirtyMask = collect_dirty_stats()) != 0)
     {
-        if (achievementChecks[i].criteria_func() &&
-            !is_achievement_unlocked(achievementChecks[i].name))
+        int unlockedThisPass = 0;
+
+        for (int i = 0; i < achievement_count; ++i)
         {
-            (void)unlock_achievement(achievementChecks[i].name);
+            if (!(g_DependsOn[i] & dirtyMask) || bit_test(i)) { continue; }
+
+            unsigned int met = 1u;
+            for (int clause = 0; clause < ACH_MAX_CLAUSES; ++clause)
+            {
+                const unsigned long long value = g_StatShadow[g_ClauseStat[clause][i]];
+                met &= (unsigned int)(value >= g_ClauseThreshold[clause][i]) ^ g_ClauseInvert[clause][i];
+            }
+
+            if (met)
+            {
+                unlockedThisPass += unlock_achievement_id((AchievementId)i);
+            }
         }
+
+        if (unlockedThisPass == 0) { break; }
     }
 }
 
@@ -287,56 +498,14 @@ int achievement_name_cmp(const void *a, const void *b)
 /* Debug function to unlock all achievements and persist to disk. */
 void unlockAllAchievements(void)
 {
+    ensure_lock();
+    platform_mutex_lock(&g_Lock);
     for (int i = 0; i < achievement_count; ++i)
     {
         achievements[i].unlocked = true;
     }
-    (void)save_achievements();
-}
-
-/* ------------------------------------------------------------------------- */
-/* Criteria predicates                                                       */
-/* ------------------------------------------------------------------------- */
-
-/* General */
-bool firstShuffleCriteria(void)      { return playerData.games_played           >= 1; }
-bool persistentPlayerCriteria(void)  { return playerData.games_played           >= 100; }
-bool cardNoviceCriteria(void)        { return playerData.total_wins             >= 5; }
-bool cardApprenticeCriteria(void)    { return playerData.total_wins             >= 10; }
-bool cardProfitCriteria(void)        { return playerData.total_wins             >= 25; }
-bool cardMasterCriteria(void)        { return playerData.total_wins             >= 50; }
-
-/* 21 Blackjack */
-bool blackjackWinCriteria(void)      { return playerData.blackjack.blackjack_wins   >= 1; }
-bool doubleTroubleCriteria(void)     { return playerData.blackjack.doubledown_wins  >= 1; }
-bool insurancePayoutCriteria(void)   { return playerData.blackjack.insurance_success>= 1; }
-bool riskTakerCriteria(void)         { return playerData.blackjack.split_wins       >= 1; }
-bool luckyStreakCriteria(void)       { return playerData.blackjack.max_win_streak   >= 10; }
-
-/* Solitaire */
-bool perfectClearCriteria(void)      { return playerData.solitaire.perfect_clear        >= 1; }
-bool solitaireNoviceCriteria(void)   { return playerData.solitaire.easy_wins            >= 1; }
-bool solitaireApprenticeCriteria(void){ return playerData.solitaire.normal_wins         >= 1; }
-bool solitaireMasterCriteria(void)   { return playerData.solitaire.hard_wins            >= 1; }
-bool theLongGameCriteria(void)       { return playerData.solitaire.longest_game_minutes >= 30; }
-
-/* Idiot */
-bool notTheIdiotCriteria(void)       { return playerData.idiot.wins                 >= 1; }
-bool mirrorMatchCriteria(void)       { return playerData.idiot.mirror_match         >= 1; }
-bool pyrotechnicCriteria(void)       { return playerData.idiot.burns                >= 10; }
-bool fourOfAKindCriteria(void)       { return playerData.idiot.four_of_a_kind_burns >= 1; }
-bool theTricksterCriteria(void)      { return playerData.idiot.trickster_wins       >= 1; }
-
-/* Hidden */
-bool timeMasterCriteria(void)        { return playerData.time_played_hours >= 1; }
-bool infiniteWealthCriteria(void)    { return playerData.starting_balance >= 1000000; }
-bool fromRagsToRichesCriteria(void)  { return (playerData.starting_balance < 100) && (playerData.uPlayerMoney >= 10000); }
-bool theCollectorCriteria(void)
-{
-    /* All but the very last ("The Collector") must be unlocked. */
-    for (int i = 0; i < achievement_count - 1; ++i)
-    {
-        if (!achievements[i].unlocked) { return false; }
-    }
-    return true;
+    platform_mutex_unlock(&g_Lock);
+    sync_unlocked_bits();
+    persist_mark_dirty(PERSIST_ACHIEVEMENTS);
+    persist_flush();
 }
\ No newline at end of file
@@ -0,0 +1,164 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Headless benchmark kernels (see bench.h).
+ *
+ * Responsibilities:
+ *   - solver:  DFS winnability probes on a fixed list of seeded Easy deals
+ *              (nodes expanded per second).
+ *   - deal:    build + shuffle + deal a Klondike board (deals per second).
+ *   - rollups: fold synthetic rounds into the stats rollups (rows per second).
+ *   - snap:    snapshot + open + restore a Klondike board and a live
+ *              Blackjack table (round trips per second).
+ *
+ * Every workload is seeded, so two builds run exactly the same work and the
+ * throughput numbers are directly comparable.
+ */
+
+#include "bench.h"
+#include "solitaire.h"
+#include "rollups.h"
+#include "platform.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BENCH_DEAL_COUNT       200000
+#define BENCH_ROLLUP_ROWS      2000000
+#define BENCH_SNAP_ROUNDS      100000
+
+/*
+ * Seeds whose Easy deals the solver settles in well under the node limit
+ * (about 165K nodes together), so the kernel measures search speed rather
+ * than how long it takes to give up on a hopeless board.
+ */
+static const unsigned int g_SolverSeeds[] = { 1, 3, 6, 9, 11 };
+
+/* ------------------------------------------------------------------------- */
+/* Kernels                                                                   */
+/* ------------------------------------------------------------------------- */
+
+static void report(const char *kernel, double work, uint64_t elapsedNs, const char *unit)
+{
+    const double seconds = (double)(elapsedNs ? elapsedNs : 1) / 1e9;
+    printf("bench %-8s %14.1f %s\n", kernel, work / seconds, unit);
+    fflush(stdout);
+}
+
+static bool bench_solver(void)
+{
+    SolverContext *solver = cs_solver_create();
+    if (!solver) return false;
+
+    uint64_t nodes   = 0;
+    uint64_t elapsed = 0;
+
+    for (size_t i = 0; i < sizeof(g_SolverSeeds) / sizeof(g_SolverSeeds[0]); ++i) {
+        KlondikeGame game = { 0 };
+        srand(g_SolverSeeds[i]);
+        solitaire_deal_random(&game);
+        game.difficulty = DIFFICULTY_EASY;
+
+        const uint64_t start = platform_now_ns();
+        (void)cs_klondike_solve(solver, &game);
+        elapsed += platform_now_ns() - start;
+        nodes   += solver->nodeCount;
+    }
+
+    cs_solver_destroy(solver);
+    report("solver", (double)nodes, elapsed, "nodes/s");
+    return true;
+}
+
+static void bench_deal(void)
+{
+    KlondikeGame game = { 0 };
+    unsigned int checksum = 0;
+
+    srand(1);
+    const uint64_t start = platform_now_ns();
+    for (int i = 0; i < BENCH_DEAL_COUNT; ++i) {
+        solitaire_deal_random(&game);
+        checksum += (unsigned char)game.table[COLUMNS - 1][COLUMNS - 1].rank[0];
+    }
+    const uint64_t elapsed = platform_now_ns() - start;
+
+    if (checksum == 0) printf("bench deal: empty checksum\n");   /* keeps the loop observable */
+    report("deal", (double)BENCH_DEAL_COUNT, elapsed, "deals/s");
+}
+
+static void bench_rollups(void)
+{
+    rollups_reset();
+
+    static const int8_t outcomes[5] = { HISTORY_PUSH, HISTORY_LOSS, HISTORY_LOSS, HISTORY_WIN, HISTORY_WIN };
+
+    HistoryRecord record = { 0 };
+    const int64_t base = 1700000000;   /* fixed epoch: same day buckets every run */
+
+    const uint64_t start = platform_now_ns();
+    for (int i = 0; i < BENCH_ROLLUP_ROWS; ++i) {
+        record.timestamp  = base + i * 7;
+        record.game       = (uint8_t)(1 + i % (HISTORY_GAME_COUNT - 1));
+        record.outcome    = outcomes[i % 5];
+        record.decisions  = (uint16_t)(i & 0x1FF);
+        record.bet        = 10u + (uint32_t)(i % 90);
+        record.payout     = (record.outcome > 0) ? record.bet : -(int64_t)record.bet;
+        record.durationMs = 1000u + (uint32_t)(i % 5000);
+        rollups_apply(&record, false);
+    }
+    const uint64_t elapsed = platform_now_ns() - start;
+
+    rollups_reset();
+    report("rollups", (double)BENCH_ROLLUP_ROWS, elapsed, "rows/s");
+}
+
+static bool bench_snap(void)
+{
+    static CsBlackjackTable table;
+    static CsBlackjackTable tableCopy;
+    KlondikeGame game = { 0 };
+    KlondikeGame gameCopy;
+    CsRng        rng;
+    uint8_t      bytes[CS_SNAP_MAX_SIZE];
+    CsSnapshot   snap;
+    bool         ok = true;
+
+    cs_rng_seed(&rng, 1);
+    cs_klondike_deal_random(&game, DIFFICULTY_EASY, &rng);
+    cs_blackjack_init(&table, 6, 1, NULL);
+    cs_blackjack_deal(&table, 10);
+
+    const uint64_t start = platform_now_ns();
+    for (int i = 0; i < BENCH_SNAP_ROUNDS && ok; ++i) {
+        size_t size = cs_klondike_snapshot(&game, 0, bytes, sizeof(bytes));
+        ok = cs_snap_open(&snap, bytes, size) && cs_klondike_restore(&gameCopy, &snap);
+
+        size = cs_blackjack_snapshot(&table, 0, bytes, sizeof(bytes));
+        ok = ok && cs_snap_open(&snap, bytes, size) && cs_blackjack_restore(&tableCopy, &snap, NULL);
+    }
+    const uint64_t elapsed = platform_now_ns() - start;
+
+    if (ok) report("snap", (double)BENCH_SNAP_ROUNDS, elapsed, "trips/s");
+    return ok;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------- */
+
+int bench_run(void)
+{
+    if (!bench_solver()) {
+        fprintf(stderr, "bench: could not allocate the solver context\n");
+        return 1;
+    }
+    bench_deal();
+    bench_rollups();
+    if (!bench_snap()) {
+        fprintf(stderr, "bench: snapshot round trip failed\n");
+        return 1;
+    }
+    return 0;
+}
@@ -11,30 +11,42 @@
  *    or if not enough cards remain for the next operation.
  *
  * Notes:
- *  - Relies on deck.h's Card type and initialize_deck() helpers.
- *  - Uses global playerData, config, clear_screen(), save_player_data(),
- *    save_achievements(), checkAchievements(), blackjack() (menu), etc.
+ *  - Hand/shoe rules and settlement come from libcardsim (cardsim.h); this
+ *    file is the interactive table around them.
+ *  - Uses global playerData (bankroll), config, clear_screen(),
+ *    checkAchievements(), blackjack() (menu), etc. Win/loss counters and
+ *    history rows come from the round's stats sink (BlackjackRound).
+ *  - Never writes save files inline; rounds only mark state dirty and the
+ *    persistence service (persist.h) coalesces the writes.
  */
 
 #include "blackjack.h"
+#include "persist.h"
+#include "render.h"
+#include "input.h"
+#include "protocol.h"
+#include "stats.h"
+#include "platform.h"
+#include "gametimer.h"
+#include "trace.h"
 
 /* --------------------------------------------------------------------------- */
 /* INTERNAL / FILE-LOCAL FUNCTIONS                                             */
 /* --------------------------------------------------------------------------- */
 
 /* Shoe lifecycle */
-static void shoe_build(Shoe *shoe, int requestedDecks);
 static void shoe_shuffle(Shoe *shoe);
-static int  shoe_remaining(const Shoe *shoe);
 static void shoe_ensure_cards(Shoe *shoe, int needed);  /* re-shuffle when low */
 
 /* Gameplay helpers (file-local) */
-static int  get_hand_value(Hand *hand);
 static void print_hand(const char *name, Hand *hand);
 static void deal_card(Shoe *shoe, Hand *hand);
-static int  is_pair(Hand *hand);
-static int  check_blackjack(Hand *hand);
-static void play_hand(Shoe *shoe, Hand *hand, int roundNumber);
+static void play_hand(BlackjackRound *round, Shoe *shoe, Hand *hand, const Card *dealerUpcard,
+                      int roundNumber);
+
+/* Round recording (the round's stats sink) */
+static void record_round(BlackjackRound *round, unsigned int bet, const Hand *hand,
+                         CsOutcome outcome, int64_t payout, uint16_t flags);
 
 /* --------------------------------------------------------------------------- */
 /* HOW TO PLAY / UI                                                            */
@@ -108,8 +120,8 @@ void blackjack_start(void)
     if (requestedDecks < 1)                requestedDecks = 1;
     if (requestedDecks > MAX_SHOE_DECKS)   requestedDecks = MAX_SHOE_DECKS;
 
-    srand((unsigned int)time(NULL));
-    shoe_build(&gameShoe, requestedDecks);
+    /* RNG is seeded once in main() (fixed by --seed for reproducible runs). */
+    cs_shoe_build(&gameShoe, requestedDecks);
     shoe_shuffle(&gameShoe);
 
     const unsigned int minBet = 10;
@@ -117,6 +129,8 @@ void blackjack_start(void)
 
     int roundNumber = 1;
 
+    BlackjackRound round = { .stats = stats_profile_sink() };
+
     while (playerData.uPlayerMoney >= minBet)
     {
         clear_screen();
@@ -125,6 +139,7 @@ void blackjack_start(void)
         or if fewer than `needed` cards remain. */
         shoe_ensure_cards(&gameShoe, 10);
 
+        protocol_screen("blackjack_bet");
         printf("=== Round %d ===\n", roundNumber);
         printf("You have: $%lld\n\n", playerData.uPlayerMoney);
 
@@ -138,6 +153,10 @@ void blackjack_start(void)
 
         playerData.uPlayerMoney -= betAmount;
 
+        game_timer_start(&round.timer);
+        round.decisions    = 0;
+        round.insuranceNet = 0;
+
         /* Initial deal: P, D, P, D */
         deal_card(&gameShoe, &playerHand1);
         deal_card(&gameShoe, &dealerHand);
@@ -145,44 +164,45 @@ void blackjack_start(void)
         deal_card(&gameShoe, &dealerHand);
 
         clear_screen();
+        protocol_emit("deal", "\"game\":\"blackjack\",\"round\":%d,\"bet\":%u,\"dealer_up\":%s",
+                      roundNumber, betAmount, protocol_cards(dealerHand.cards, 1));
         print_hand("Dealer shows", &(Hand){ .cards = { dealerHand.cards[0] }, .count = 1 });
 
-        handle_insurance(&dealerHand);
+        handle_insurance(&round, &dealerHand);
 
         /* If dealer has Blackjack and player doesn't: immediate resolution. */
-        if (check_blackjack(&dealerHand) && !check_blackjack(&playerHand1))
+        if (cs_hand_is_blackjack(&dealerHand) && !cs_hand_is_blackjack(&playerHand1))
         {
             printf("Dealer has Blackjack. You lose this round.\n");
-            resolve_hands(isSplit, &playerHand1, &playerHand2, &dealerHand);
+            resolve_hands(&round, isSplit, &playerHand1, &playerHand2, &dealerHand);
             checkAchievements();
-            save_player_data();
-            save_achievements();
+            persist_mark_dirty(PERSIST_ALL);
             if (!play_again()) break;
             roundNumber++;
             continue;
         }
 
         /* Player Blackjack handling (push if dealer also has it). */
-        if (check_blackjack(&playerHand1))
+        if (cs_hand_is_blackjack(&playerHand1))
         {
-            handle_blackjack(&dealerHand, betAmount);
+            handle_blackjack(&round, &dealerHand, betAmount);
             roundNumber++;
             continue;
         }
 
         /* Offer split if first two cards are a pair. */
-        if (is_pair(&playerHand1))
+        if (cs_hand_is_pair(&playerHand1))
         {
             isSplit = handle_split(&gameShoe, &playerHand1, &playerHand2, betAmount);
             if (isSplit)
             {
-                play_hand(&gameShoe, &playerHand1, roundNumber);
-                play_hand(&gameShoe, &playerHand2, roundNumber);
+                play_hand(&round, &gameShoe, &playerHand1, &dealerHand.cards[0], roundNumber);
+                play_hand(&round, &gameShoe, &playerHand2, &dealerHand.cards[0], roundNumber);
                 goto dealer_turn;
             }
         }
 
-        play_hand(&gameShoe, &playerHand1, roundNumber);
+        play_hand(&round, &gameShoe, &playerHand1, &dealerHand.cards[0], roundNumber);
 
     dealer_turn:
         /* If both hands surrendered, round ends. */
@@ -192,17 +212,19 @@ void blackjack_start(void)
         }
 
         /* If player busted (or both split hands busted), skip dealer play. */
-        if ((!isSplit && get_hand_value(&playerHand1) > 21) ||
-            (isSplit && get_hand_value(&playerHand1) > 21 && get_hand_value(&playerHand2) > 21))
+        if ((!isSplit && cs_hand_value(&playerHand1) > 21) ||
+            (isSplit && cs_hand_value(&playerHand1) > 21 && cs_hand_value(&playerHand2) > 21))
         {
-            resolve_hands(isSplit, &playerHand1, &playerHand2, &dealerHand);
+            resolve_hands(&round, isSplit, &playerHand1, &playerHand2, &dealerHand);
             if (!play_again()) break;
             roundNumber++;
             continue;
         }
 
+        const uint64_t dealerStartNs = platform_now_ns();
         dealer_play(&gameShoe, &dealerHand, roundNumber);
-        resolve_hands(isSplit, &playerHand1, &playerHand2, &dealerHand);
+        latency_record_since(LATENCY_BLACKJACK_DEALER, dealerStartNs);
+        resolve_hands(&round, isSplit, &playerHand1, &playerHand2, &dealerHand);
 
         roundNumber++;
 
@@ -214,7 +236,7 @@ void blackjack_start(void)
         if (!play_again()) break;
     }
 
-    save_player_data();
+    persist_mark_dirty(PERSIST_PLAYER);
     clear_screen();
 }
 
@@ -232,7 +254,7 @@ unsigned int get_valid_bet(unsigned int minBet, unsigned int maxBet)
             : maxBet;
 
         printf("Enter your bet ($%u - $%llu): ", minBet, maxAllowed);
-        scanf("%u", &betAmount);
+        if (!input_read_uint(&betAmount)) { betAmount = 0; }
 
         if (betAmount < minBet || betAmount > maxBet || betAmount > playerData.uPlayerMoney) {
             printf("Invalid bet. Please enter an amount between $%u and $%llu\n",
@@ -240,7 +262,7 @@ unsigned int get_valid_bet(unsigned int minBet, unsigned int maxBet)
         }
     } while (betAmount < minBet || betAmount > maxBet || betAmount > playerData.uPlayerMoney);
 
-    save_player_data();
+    persist_mark_dirty(PERSIST_PLAYER);
     return betAmount;
 }
 
@@ -248,36 +270,33 @@ unsigned int get_valid_bet(unsigned int minBet, unsigned int maxBet)
 /* INSURANCE / BLACKJACK / SPLIT                                             */
 /* ------------------------------------------------------------------------- */
 
-void handle_insurance(Hand *dealerHand)
+void handle_insurance(BlackjackRound *round, Hand *dealerHand)
 {
     /* Simple fixed insurance bet (kept as-is from original). */
     unsigned int insuranceBet = 50;
 
-    if (strcmp(dealerHand->cards[0].rank, "Ace") == 0)
+    if (cs_card_blackjack_value(&dealerHand->cards[0]) == 11)
     {
         int choice = 0;
+        protocol_screen("blackjack_insurance");
         printf("Dealer shows Ace. Take insurance for $%u?\n", insuranceBet);
         printf("1: Yes\n");
         printf("2: No\n");
         printf("> ");
-        scanf("%d", &choice);
 
-        if (choice == 1)
+        if (input_read_int(&choice) && choice == 1)
         {
-            if (check_blackjack(dealerHand))
+            round->decisions |= CS_ROUND_INSURANCE;
+
+            if (cs_hand_is_blackjack(dealerHand))
             {
-                printf("Dealer has Blackjack. Insurance pays 2:1 and you lose this round.\n");
+                /* The winnings ride on the round's settled hand: blackjack_start
+                   resolves the dealer's natural and reports one result through
+                   the stats sink, so nothing is counted or prompted here. */
+                round->insuranceNet += (int64_t)insuranceBet * 2;
+                printf("Dealer has Blackjack. Insurance pays 2:1.\n");
                 playerData.blackjack.insurance_success++;
-                playerData.blackjack.losses++;
                 playerData.uPlayerMoney += insuranceBet * 2;
-                playerData.total_losses++;
-                checkAchievements();
-
-                /* End round if dealer has blackjack. */
-                if (!play_again()) {
-                    blackjack();
-                    return;
-                }
                 return;
             }
             else
@@ -289,37 +308,33 @@ void handle_insurance(Hand *dealerHand)
                     printf("Not enough money for insurance.\n");
                 } else {
                     playerData.uPlayerMoney -= insuranceBet;
+                    round->insuranceNet -= insuranceBet;
                 }
-                save_player_data();
+                persist_mark_dirty(PERSIST_PLAYER);
             }
         }
     }
 }
 
-void handle_blackjack(Hand *dealerHand, unsigned int bet)
+void handle_blackjack(BlackjackRound *round, Hand *dealerHand, unsigned int bet)
 {
-    if (check_blackjack(dealerHand))
+    if (cs_hand_is_blackjack(dealerHand))
     {
         printf("Both you and dealer have Blackjack. Push.\n");
+        protocol_emit("hand_result", "\"game\":\"blackjack\",\"result\":\"push\",\"bet\":%u", bet);
+        record_round(round, bet, NULL, CS_OUTCOME_PUSH, 0, CS_ROUND_NATURAL);
         playerData.uPlayerMoney += bet;
-        playerData.blackjack.draws++;
-        playerData.total_draws++;
     }
     else
     {
         printf("Blackjack! You win 3:2.\n");
-        playerData.blackjack.blackjack_wins++;
+        protocol_emit("hand_result", "\"game\":\"blackjack\",\"result\":\"blackjack\",\"bet\":%u", bet);
+        record_round(round, bet, NULL, CS_OUTCOME_WIN, (int64_t)(unsigned int)(bet * 1.5), CS_ROUND_NATURAL);
         playerData.uPlayerMoney += bet + (unsigned int)(bet * 1.5);
-        playerData.blackjack.wins++;
-        playerData.blackjack.win_streak++;
-        if (playerData.blackjack.max_win_streak < playerData.blackjack.win_streak) {
-            playerData.blackjack.max_win_streak = playerData.blackjack.win_streak;
-        }
-        playerData.total_wins++;
         checkAchievements();
     }
 
-    save_player_data();
+    persist_mark_dirty(PERSIST_ALL);
 
     if (!play_again()) {
         blackjack();
@@ -335,9 +350,8 @@ bool handle_split(Shoe *shoe, Hand *playerHand1, Hand *playerHand2, unsigned int
     printf("1: Yes\n");
     printf("2: No\n");
     printf("> ");
-    scanf("%d", &choice);
 
-    if (choice == 1 && playerData.uPlayerMoney >= bet)
+    if (input_read_int(&choice) && choice == 1 && playerData.uPlayerMoney >= bet)
     {
         playerData.uPlayerMoney -= bet;
 
@@ -373,16 +387,17 @@ void dealer_play(Shoe *shoe, Hand *dealerHand, int roundNumber)
     printf("=== Round %d ===\n\nDealer's turn:\n", roundNumber);
     print_hand("Dealer", dealerHand);
 
-    while (get_hand_value(dealerHand) < 17)
+    while (cs_dealer_should_hit(dealerHand))
     {
         deal_card(shoe, dealerHand);
         print_hand("Dealer", dealerHand);
     }
 }
 
-void resolve_hands(bool isSplit, Hand *playerHand1, Hand *playerHand2, Hand *dealerHand)
+void resolve_hands(BlackjackRound *round, bool isSplit, Hand *playerHand1, Hand *playerHand2,
+                   Hand *dealerHand)
 {
-    int dealerValue   = get_hand_value(dealerHand);
+    int dealerValue   = cs_hand_value(dealerHand);
     int handsToResolve= isSplit ? 2 : 1;
     Hand *hands[]     = { playerHand1, playerHand2 };
 
@@ -391,7 +406,9 @@ void resolve_hands(bool isSplit, Hand *playerHand1, Hand *playerHand2, Hand *dea
         Hand *ph = hands[i];
         if (ph->count == 0 || ph->surrendered) continue;
 
-        int playerValue = get_hand_value(ph);
+        int playerValue = cs_hand_value(ph);
+        const CsHandResult settled = cs_hand_settle(ph, dealerValue);
+        const char *result;
 
         if (isSplit) printf("\nYour hand %d: ", i + 1);
         else         printf("\nYour hand: ");
@@ -399,58 +416,54 @@ void resolve_hands(bool isSplit, Hand *playerHand1, Hand *playerHand2, Hand *dea
         print_hand("", ph);
         printf("Your total: %d vs Dealer: %d\n", playerValue, dealerValue);
 
-        if (playerValue > 21)
+        if (settled == CS_HAND_BUST)
         {
             printf("You busted. Lose $%u\n", ph->bet);
-            playerData.blackjack.losses++;
-            playerData.blackjack.win_streak = 0;
-            playerData.total_losses++;
+            result = "bust";
+            record_round(round, ph->bet, ph, CS_OUTCOME_LOSS, -(int64_t)ph->bet, CS_ROUND_BUST);
         }
-        else if (dealerValue > 21 || playerValue > dealerValue)
+        else if (settled == CS_HAND_WIN)
         {
             printf("You win! Gain $%u\n", ph->bet);
+            result = "win";
+            record_round(round, ph->bet, ph, CS_OUTCOME_WIN, (int64_t)ph->bet, 0);
             playerData.uPlayerMoney += (ph->bet * 2);
-            playerData.blackjack.wins++;
-            playerData.blackjack.win_streak++;
-            if (playerData.blackjack.max_win_streak < playerData.blackjack.win_streak) {
-                playerData.blackjack.max_win_streak = playerData.blackjack.win_streak;
-            }
-            playerData.total_wins++;
-            if (ph->doubled) playerData.blackjack.doubledown_wins++;
         }
-        else if (playerValue < dealerValue)
+        else if (settled == CS_HAND_LOSS)
         {
             printf("Dealer wins. Lose $%u\n", ph->bet);
-            playerData.blackjack.losses++;
-            playerData.blackjack.win_streak = 0;
-            playerData.total_losses++;
+            result = "loss";
+            record_round(round, ph->bet, ph, CS_OUTCOME_LOSS, -(int64_t)ph->bet, 0);
         }
         else
         {
             printf("Push. No money gained or lost.\n");
+            result = "push";
+            record_round(round, ph->bet, ph, CS_OUTCOME_PUSH, 0, 0);
             playerData.uPlayerMoney += ph->bet;
-            playerData.blackjack.draws++;
-            playerData.total_draws++;
         }
+
+        protocol_emit("hand_result",
+                      "\"game\":\"blackjack\",\"hand\":%d,\"result\":\"%s\",\"bet\":%u,"
+                      "\"player\":%d,\"dealer\":%d,\"cards\":%s",
+                      i + 1, result, ph->bet, playerValue, dealerValue,
+                      protocol_cards(ph->cards, ph->count));
     }
 
     if (isSplit)
     {
         int win1 = (playerHand1->count > 0 && !playerHand1->surrendered &&
-                    get_hand_value(playerHand1) <= 21 &&
-                    (dealerValue > 21 || get_hand_value(playerHand1) > dealerValue));
+                    cs_hand_settle(playerHand1, dealerValue) == CS_HAND_WIN);
 
         int win2 = (playerHand2->count > 0 && !playerHand2->surrendered &&
-                    get_hand_value(playerHand2) <= 21 &&
-                    (dealerValue > 21 || get_hand_value(playerHand2) > dealerValue));
+                    cs_hand_settle(playerHand2, dealerValue) == CS_HAND_WIN);
 
         if (win1 && win2) playerData.blackjack.split_wins++;
     }
 
     playerData.games_played++;
     checkAchievements();
-    save_player_data();
-    save_achievements();
+    persist_mark_dirty(PERSIST_ALL);
 }
 
 /* ------------------------------------------------------------------------- */
@@ -460,50 +473,20 @@ void resolve_hands(bool isSplit, Hand *playerHand1, Hand *playerHand2, Hand *dea
 bool play_again(void)
 {
     int again = 0;
+    protocol_screen("blackjack_play_again");
     printf("\nPlay another round?\n");
     printf("1: Yes\n");
     printf("2: No\n");
     printf("> ");
-    scanf("%d", &again);
+    const bool answered = input_read_int(&again);
     clear_screen();
-    return (again == 1);
+    return answered && again == 1;
 }
 
 /* ------------------------------------------------------------------------- */
 /* HAND/DEAL UTILITIES                                                       */
 /* ------------------------------------------------------------------------- */
 
-/**
- * get_hand_value
- * Sum hand value with proper Ace adjustment (11 -> 1 as needed).
- */
-static int get_hand_value(Hand *hand)
-{
-    int total = 0, aces = 0;
-
-    for (int i = 0; i < hand->count; ++i)
-    {
-        if (strcmp(hand->cards[i].rank, "Ace") == 0) {
-            total += 11; aces++;
-        }
-        else if (strcmp(hand->cards[i].rank, "King")  == 0 ||
-                 strcmp(hand->cards[i].rank, "Queen") == 0 ||
-                 strcmp(hand->cards[i].rank, "Jack")  == 0) {
-            total += 10;
-        }
-        else {
-            total += atoi(hand->cards[i].rank);
-        }
-    }
-
-    while (total > 21 && aces > 0) {
-        total -= 10; /* count one Ace as 1 instead of 11 */
-        aces--;
-    }
-
-    return total;
-}
-
 /**
  * deal_card
  * Deal the next card from the shoe into a hand. If running low, the shoe
@@ -511,7 +494,7 @@ static int get_hand_value(Hand *hand)
  */
 static void deal_card(Shoe *shoe, Hand *hand)
 {
-    if (hand->count >= MAX_HAND_CARDS) {
+    if (hand->count >= CS_HAND_MAX_CARDS) {
         printf("Hand is full!\n");
         return;
     }
@@ -529,65 +512,63 @@ static void deal_card(Shoe *shoe, Hand *hand)
 
 /**
  * print_hand
- * Print cards in a hand with an optional label.
+ * Print cards in a hand with an optional label (into the open frame, if any).
  */
 static void print_hand(const char *name, Hand *hand)
 {
-    if (name && *name) printf("%s: ", name);
+    TRACE_SCOPE("print_hand");
+    if (name && *name) render_printf("%s: ", name);
     for (int i = 0; i < hand->count; ++i) {
-        printf("[%s of %s] ", hand->cards[i].rank, hand->cards[i].suit);
+        render_printf("[%s of %s] ", hand->cards[i].rank, hand->cards[i].suit);
     }
-    printf("\n");
-}
-
-/**
- * is_pair
- * True if the hand has exactly 2 cards of the same rank.
- */
-static int is_pair(Hand *hand)
-{
-    return hand->count == 2 && strcmp(hand->cards[0].rank, hand->cards[1].rank) == 0;
-}
-
-/**
- * check_blackjack
- * True if exactly two cards sum to 21.
- */
-static int check_blackjack(Hand *hand)
-{
-    return hand->count == 2 && get_hand_value(hand) == 21;
+    render_printf("\n");
 }
 
 /**
  * play_hand
  * Drive player decisions for a single hand (Hit/Stand/Surrender/Double).
+ * Each decision screen is one frame that also repeats the dealer's upcard.
  */
-static void play_hand(Shoe *shoe, Hand *hand, int roundNumber)
+static void play_hand(BlackjackRound *round, Shoe *shoe, Hand *hand, const Card *dealerUpcard,
+                      int roundNumber)
 {
-    int choice     = 0;
     int firstTurn  = 1;
 
     for (;;)
     {
-        printf("=== Round %d ===\n\n", roundNumber);
-        printf("-- Playing Your Hand --\n");
+        protocol_screen("blackjack_hand");
+        protocol_emit("hand", "\"game\":\"blackjack\",\"cards\":%s,\"total\":%d",
+                      protocol_cards(hand->cards, hand->count), cs_hand_value(hand));
+
+        /* Hand + menu + prompt go out as one frame (render.h). */
+        const uint64_t frameStartNs = platform_now_ns();
+        render_begin();
+        render_printf("=== Round %d ===\n\n", roundNumber);
+        render_printf("Dealer shows: [%s of %s]\n\n", dealerUpcard->rank, dealerUpcard->suit);
+        render_printf("-- Playing Your Hand --\n");
         print_hand("Your hand", hand);
 
-        int currentTotal = get_hand_value(hand);
-        printf("Current total: %d\n", currentTotal);
+        int currentTotal = cs_hand_value(hand);
+        render_printf("Current total: %d\n", currentTotal);
 
         if (currentTotal > 21) {
+            render_end();
             break; /* bust */
         }
 
-        printf("\n1: Hit\n");
-        printf("2: Stand\n");
+        render_printf("\n1: Hit\n");
+        render_printf("2: Stand\n");
         if (firstTurn) {
-            printf("3: Surrender (-50%%)\n");
-            printf("4: Double Down\n");
+            render_printf("3: Surrender (-50%%)\n");
+            render_printf("4: Double Down\n");
         }
-        printf("> ");
-        scanf("%d", &choice);
+        render_printf("> ");
+        render_end();
+        latency_record_since(LATENCY_BLACKJACK_FRAME, frameStartNs);
+
+        /* A line that is not a number redraws the frame; it never repeats the last choice. */
+        int choice = 0;
+        if (!input_read_int(&choice)) { continue; }
 
         switch (choice)
         {
@@ -605,10 +586,11 @@ static void play_hand(Shoe *shoe, Hand *hand, int roundNumber)
                     break;
                 }
                 printf("You surrendered. Lose half your bet.\n");
+                protocol_emit("hand_result", "\"game\":\"blackjack\",\"result\":\"surrender\",\"bet\":%u", hand->bet);
                 hand->surrendered = 1;
                 playerData.uPlayerMoney += hand->bet / 2;
+                record_round(round, hand->bet, hand, CS_OUTCOME_LOSS, -(int64_t)(hand->bet - hand->bet / 2), 0);
                 hand->count = 0; /* remove cards for clarity */
-                playerData.blackjack.win_streak = 0;
 
                 if (!play_again()) {
                     blackjack();
@@ -629,51 +611,50 @@ static void play_hand(Shoe *shoe, Hand *hand, int roundNumber)
                 return;
 
             default:
-                clear_screen();
                 break;
         }
-
-        clear_screen();
+        /* No clear here: the next frame redraws (or diffs) the screen. */
     }
 }
 
-/* ------------------------------------------------------------------------- */
-/* SHOE IMPLEMENTATION                                                       */
-/* ------------------------------------------------------------------------- */
-
 /**
- * shoe_build
- * Fill the shoe with N concatenated decks (each via initialize_deck()).
+ * record_round
+ * Report one settled hand to the round's stats sink. Hand flags (double,
+ * split, surrender) are folded into `flags`; pending insurance winnings/
+ * losses are charged to this row. `hand` may be NULL (naturals settle by
+ * bet only).
  */
-static void shoe_build(Shoe *shoe, int requestedDecks)
+static void record_round(BlackjackRound *round, unsigned int bet, const Hand *hand,
+                         CsOutcome outcome, int64_t payout, uint16_t flags)
 {
-    if (!shoe) return;
-
-    if (requestedDecks < 1)              requestedDecks = 1;
-    if (requestedDecks > MAX_SHOE_DECKS) requestedDecks = MAX_SHOE_DECKS;
-
-    shoe->decks_in_shoe = requestedDecks;
-    shoe->total         = requestedDecks * DECK_SIZE;
-    shoe->next_index    = 0;
-
-    /* Build by appending initialized decks. */
-    Card tempDeck[DECK_SIZE];
-
-    int writePos = 0;
-    for (int d = 0; d < requestedDecks; ++d)
-    {
-        initialize_deck(tempDeck);
-        /* keep .revealed and string fields exactly as deck.h sets them */
-
-        for (int i = 0; i < DECK_SIZE; ++i) {
-            shoe->cards[writePos++] = tempDeck[i];
-        }
+    if (hand) {
+        if (hand->doubled)     flags |= CS_ROUND_DOUBLE;
+        if (hand->fromSplit)   flags |= CS_ROUND_SPLIT;
+        if (hand->surrendered) flags |= CS_ROUND_SURRENDER;
     }
+
+    const CsRoundResult result = {
+        .game       = CS_GAME_BLACKJACK,
+        .outcome    = (int8_t)outcome,
+        .flags      = (uint16_t)(flags | round->decisions),
+        .bet        = bet,
+        .net        = payout + round->insuranceNet,
+        .durationMs = game_timer_elapsed_ms(&round->timer),
+    };
+    round->insuranceNet = 0;
+
+    cs_stats_emit(&round->stats, &result);
 }
 
+/* ------------------------------------------------------------------------- */
+/* SHOE IMPLEMENTATION                                                       */
+/* ------------------------------------------------------------------------- */
+
 /**
  * shoe_shuffle
- * Fisher-Yates shuffle over the entire shoe.
+ * Fisher-Yates shuffle over the entire shoe. Uses rand() (seeded in main,
+ * fixed by --seed) rather than cs_shoe_shuffle's CsRng so seeded runs keep
+ * dealing the same shoes.
  */
 static void shoe_shuffle(Shoe *shoe)
 {
@@ -690,40 +671,21 @@ static void shoe_shuffle(Shoe *shoe)
     shoe->next_index = 0;
 }
 
-/**
- * shoe_remaining
- * Count of undealt cards in the shoe.
- */
-static int shoe_remaining(const Shoe *shoe)
-{
-    return (shoe && shoe->total >= shoe->next_index)
-         ? (shoe->total - shoe->next_index)
-         : 0;
-}
-
 /**
  * shoe_ensure_cards
- * If remaining cards < SHOE_RESHUFFLE_THRESHOLD or < needed,
- * rebuild and shuffle the shoe (same number of decks).
+ * At the cut card or when fewer than `needed` cards remain
+ * (cs_shoe_needs_reshuffle), rebuild and shuffle the shoe (same number of
+ * decks).
  */
 static void shoe_ensure_cards(Shoe *shoe, int needed)
 {
+    TRACE_SCOPE("shoe_ensure_cards");
     if (!shoe) return;
 
-    const int remaining = shoe_remaining(shoe);
-
-    /* Compute cut index (number of cards dealt at which we reshuffle). */
-    int pct = CUT_CARD_PENETRATION_PERCENT;
-    if (pct < 50) pct = 50;           /* sanity clamp to sensible range */
-    if (pct > 95) pct = 95;
-
-    const int cut_index = (shoe->total * pct) / 100;       /* cards dealt */
-    const int dealt     = shoe->next_index;
-
-    if (remaining < needed || dealt >= cut_index)
+    if (cs_shoe_needs_reshuffle(shoe, needed))
     {
         const int decks = shoe->decks_in_shoe;
-        shoe_build(shoe, decks);
+        cs_shoe_build(shoe, decks);
         shoe_shuffle(shoe);
     }
 }
@@ -12,13 +12,10 @@
 
 #include "core.h"
 #include "paths.h"
-
-/* ------------------------------------------------------------------------- */
-/* Local tables (rank/suit strings)                                          */
-/* ------------------------------------------------------------------------- */
-
-static const char *suits[NUM_SUITS] = {"Hearts", "Diamonds", "Clubs", "Spades"};
-static const char *ranks[NUM_RANKS] = {"2","3","4","5","6","7","8","9","10","Jack","Queen","King","Ace"};
+#include "render.h"
+#include "input.h"
+#include "state.h"
+#include "trace.h"
 
 /* ------------------------------------------------------------------------- */
 /* Persistence                                                               */
@@ -26,17 +23,26 @@ static const char *ranks[NUM_RANKS] = {"2","3","4","5","6","7","8","9","10","Jac
 
 /**
  * save_player_data
- * Persist both PlayerData and GameConfig in a single binary blob.
+ * Persist both PlayerData and GameConfig in a single binary blob (active
+ * profile). Writes the last published snapshot (state.h), so it is safe to
+ * call from the persistence writer thread.
  *
  * @return true on success, false on error opening/writing the file.
  */
 bool save_player_data(void)
 {
-    FILE *fp = fopen(PLAYER_DATA_PATH, "wb");
+    TRACE_SCOPE("save_player_data");
+    char path[SAVE_PATH_MAX];
+    save_path(path, sizeof(path), PLAYER_DATA_FILE);
+
+    StateSnapshot snapshot;
+    state_snapshot(&snapshot);
+
+    FILE *fp = fopen(path, "wb");
     if (!fp) return false;
 
-    const size_t w1 = fwrite(&playerData, sizeof(PlayerData), 1, fp);
-    const size_t w2 = fwrite(&config,     sizeof(GameConfig), 1, fp);
+    const size_t w1 = fwrite(&snapshot.player, sizeof(PlayerData), 1, fp);
+    const size_t w2 = fwrite(&snapshot.config, sizeof(GameConfig), 1, fp);
     fclose(fp);
 
     return (w1 == 1 && w2 == 1);
@@ -50,7 +56,10 @@ bool save_player_data(void)
  */
 bool load_player_data(void)
 {
-    FILE *fp = fopen(PLAYER_DATA_PATH, "rb");
+    char path[SAVE_PATH_MAX];
+    save_path(path, sizeof(path), PLAYER_DATA_FILE);
+
+    FILE *fp = fopen(path, "rb");
     if (!fp) return false;
 
     const size_t r1 = fread(&playerData, sizeof(PlayerData), 1, fp);
@@ -72,21 +81,13 @@ bool load_player_data(void)
  */
 void initialize_deck(Card *deck)
 {
-    int cardWriteIndex = 0;
-    for (int suitIndex = 0; suitIndex < NUM_SUITS; ++suitIndex) {
-        for (int rankIndex = 0; rankIndex < NUM_RANKS; ++rankIndex) {
-            deck[cardWriteIndex].suit     = (char*)suits[suitIndex];
-            deck[cardWriteIndex].rank     = (char*)ranks[rankIndex];
-            deck[cardWriteIndex].revealed = 0;
-            deck[cardWriteIndex].is_joker = false;
-            ++cardWriteIndex;
-        }
-    }
+    cs_deck_init(deck);
 }
 
 /**
  * shuffle_deck
- * In-place Fisher–Yates shuffle using rand().
+ * In-place Fisher–Yates shuffle using rand() (the games' seeded stream;
+ * libcardsim's cs_deck_shuffle takes an explicit CsRng instead).
  */
 void shuffle_deck(Card *deck)
 {
@@ -116,25 +117,20 @@ void print_deck(Card *deck)
 
 /**
  * clear_screen
- * Cross-platform clear (crude, but fine for a CLI game).
+ * Cross-platform clear via ANSI escapes (see render.h); no shell is spawned.
  */
 void clear_screen(void)
 {
-#ifdef _WIN32
-    system("cls");
-#else
-    system("clear");
-#endif
+    render_clear();
 }
 
 /**
  * pause_for_enter
  * Pause until the user presses Enter (used by menus).
- * Reads and discards a pending newline from prior scanf, then waits for Enter.
+ * Input is line-based (input.h), so no leftover newline needs swallowing.
  */
 void pause_for_enter(void)
 {
     printf("Press Enter to continue...");
-    int c = getchar(); (void)c; /* swallow any leftover newline */
-    getchar();
+    input_wait_enter();
 }
\ No newline at end of file
@@ -5,7 +5,7 @@
  * Filesystem bootstrap helpers.
  *
  * Responsibilities:
- *   - Ensure save directories exist at startup.
+ *   - Ensure the save root and the active profile's directories exist.
  *   - Touch base save files so later loads don't fail.
  *   - Cross-platform mkdir abstraction.
  */
@@ -24,22 +24,6 @@
   #define MKDIR(p) mkdir((p), 0755)
 #endif
 
-/* ------------------------------------------------------------------------- */
-/* Path fallbacks (only used if paths.h leaves these undefined)              */
-/* ------------------------------------------------------------------------- */
-#ifndef SAVE_DIR
-  #define SAVE_DIR "saves"
-#endif
-#ifndef PLAYER_SAVE_FILE
-  #define PLAYER_SAVE_FILE "saves/player_data.dat"
-#endif
-#ifndef ACHIEVEMENT_SAVE
-  #define ACHIEVEMENT_SAVE "saves/achievements.dat"
-#endif
-#ifndef SOLITAIRE_SAVE_DIR
-  #define SOLITAIRE_SAVE_DIR "saves/solitaire"
-#endif
-
 /* ------------------------------------------------------------------------- */
 /* Internal helpers                                                          */
 /* ------------------------------------------------------------------------- */
@@ -74,13 +58,21 @@ static void touch_file(const char *path)
 
 /**
  * fs_init
- * Create the save root + solitaire subdir and ensure the two main save files
- * exist so first-run code paths that try to load won't fail noisily.
+ * Create the save root and the active profile's directory + solitaire/history
+ * subdirs, and ensure the two main save files exist so first-run code paths
+ * that try to load won't fail noisily. Called again after a profile switch.
  */
 void fs_init(void)
 {
+    char path[SAVE_PATH_MAX];
+
     ensure_dir(SAVE_DIR);
-    ensure_dir(SOLITAIRE_SAVE_DIR);
-    touch_file(PLAYER_SAVE_FILE);
-    touch_file(ACHIEVEMENT_SAVE);
+    ensure_dir(PROFILES_DIR);
+    profile_dir(path, sizeof(path));
+    ensure_dir(path);
+
+    save_path(path, sizeof(path), SOLITAIRE_SUBDIR);  ensure_dir(path);
+    save_path(path, sizeof(path), HISTORY_SUBDIR);    ensure_dir(path);
+    save_path(path, sizeof(path), PLAYER_DATA_FILE);  touch_file(path);
+    save_path(path, sizeof(path), ACHIEVEMENTS_FILE); touch_file(path);
 }
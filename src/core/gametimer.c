@@ -0,0 +1,154 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Game timers and latency histograms (see gametimer.h).
+ *
+ * Responsibilities:
+ *   - Pause/resume-aware elapsed time on the monotonic nanosecond clock.
+ *   - Per-kind log2 latency histograms updated with relaxed atomics, so the
+ *     solver or AI can record from worker threads without locking.
+ */
+
+#include "gametimer.h"
+#include "platform.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+/* ------------------------------------------------------------------------- */
+/* File-scope state                                                          */
+/* ------------------------------------------------------------------------- */
+
+typedef struct {
+    _Atomic uint64_t count;
+    _Atomic uint64_t totalNs;
+    _Atomic uint64_t maxNs;
+    _Atomic uint64_t buckets[LATENCY_BUCKETS];
+} AtomicHistogram;
+
+static AtomicHistogram g_Histograms[LATENCY_KIND_COUNT];
+
+static const char *const g_KindNames[LATENCY_KIND_COUNT] = {
+    [LATENCY_SOLITAIRE_SOLVER] = "Solitaire solver",
+    [LATENCY_SOLITAIRE_FRAME]  = "Solitaire redraw",
+    [LATENCY_IDIOT_AI]         = "Idiot AI turn",
+    [LATENCY_IDIOT_FRAME]      = "Idiot redraw",
+    [LATENCY_BLACKJACK_DEALER] = "Blackjack dealer",
+    [LATENCY_BLACKJACK_FRAME]  = "Blackjack redraw",
+};
+
+/* ------------------------------------------------------------------------- */
+/* Internal helpers                                                          */
+/* ------------------------------------------------------------------------- */
+
+/** floor(log2(ns)) clamped to the bucket range (0 and 1 ns share bucket 0). */
+static int bucket_of(uint64_t ns)
+{
+    int bucket = 0;
+    while (ns > 1 && bucket < LATENCY_BUCKETS - 1) {
+        ns >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Game timer                                                                */
+/* ------------------------------------------------------------------------- */
+
+void game_timer_start(GameTimer *timer)
+{
+    if (!timer) return;
+    timer->elapsedNs = 0;
+    timer->startNs   = platform_now_ns();
+    timer->running   = true;
+}
+
+void game_timer_pause(GameTimer *timer)
+{
+    if (!timer || !timer->running) return;
+    timer->elapsedNs += platform_now_ns() - timer->startNs;
+    timer->running    = false;
+}
+
+void game_timer_resume(GameTimer *timer)
+{
+    if (!timer || timer->running) return;
+    timer->startNs = platform_now_ns();
+    timer->running = true;
+}
+
+uint64_t game_timer_elapsed_ns(const GameTimer *timer)
+{
+    if (!timer) return 0;
+    return timer->elapsedNs + (timer->running ? platform_now_ns() - timer->startNs : 0);
+}
+
+/* ------------------------------------------------------------------------- */
+/* Latency histograms                                                        */
+/* ------------------------------------------------------------------------- */
+
+void latency_record(LatencyKind kind, uint64_t ns)
+{
+    if ((int)kind < 0 || kind >= LATENCY_KIND_COUNT) return;
+    AtomicHistogram *h = &g_Histograms[kind];
+
+    atomic_fetch_add_explicit(&h->count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&h->totalNs, ns, memory_order_relaxed);
+    atomic_fetch_add_explicit(&h->buckets[bucket_of(ns)], 1, memory_order_relaxed);
+
+    uint64_t seen = atomic_load_explicit(&h->maxNs, memory_order_relaxed);
+    while (ns > seen &&
+           !atomic_compare_exchange_weak_explicit(&h->maxNs, &seen, ns,
+                                                  memory_order_relaxed, memory_order_relaxed))
+    {
+        /* `seen` was reloaded; retry while we are still the maximum */
+    }
+}
+
+void latency_record_since(LatencyKind kind, uint64_t startNs)
+{
+    latency_record(kind, platform_now_ns() - startNs);
+}
+
+void latency_snapshot(LatencyKind kind, LatencyHistogram *out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if ((int)kind < 0 || kind >= LATENCY_KIND_COUNT) return;
+
+    AtomicHistogram *h = &g_Histograms[kind];
+    out->count   = atomic_load_explicit(&h->count,   memory_order_relaxed);
+    out->totalNs = atomic_load_explicit(&h->totalNs, memory_order_relaxed);
+    out->maxNs   = atomic_load_explicit(&h->maxNs,   memory_order_relaxed);
+    for (int i = 0; i < LATENCY_BUCKETS; ++i) {
+        out->buckets[i] = atomic_load_explicit(&h->buckets[i], memory_order_relaxed);
+    }
+}
+
+uint64_t latency_percentile(const LatencyHistogram *histogram, double p)
+{
+    if (!histogram || histogram->count == 0) return 0;
+    if (p <= 0.0)   p = 0.0;
+    if (p > 100.0)  p = 100.0;
+
+    uint64_t rank = (uint64_t)((double)histogram->count * p / 100.0 + 0.5);
+    if (rank == 0) rank = 1;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < LATENCY_BUCKETS; ++i) {
+        seen += histogram->buckets[i];
+        if (seen >= rank) {
+            const uint64_t upper = (i < 63) ? (2ULL << i) - 1 : UINT64_MAX;
+            return (upper < histogram->maxNs) ? upper : histogram->maxNs;
+        }
+    }
+    return histogram->maxNs;
+}
+
+const char *latency_kind_name(LatencyKind kind)
+{
+    if ((int)kind < 0 || kind >= LATENCY_KIND_COUNT) return "?";
+    return g_KindNames[kind];
+}
@@ -0,0 +1,403 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Event-driven keyboard input (Win32 console + POSIX termios/poll).
+ *
+ * Responsibilities:
+ *   - cbreak mode setup/teardown (ISIG stays on so Ctrl+C still works).
+ *   - poll()-based wait that interleaves idle tasks with key delivery.
+ *   - Minimal line editor and number parsing for menus and prompts.
+ */
+
+#ifndef _WIN32
+  #define _POSIX_C_SOURCE 200809L   /* poll, termios, sigaction, fileno */
+#endif
+
+#include "input.h"
+#include "platform.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+  #include <windows.h>
+  #include <conio.h>
+  #include <io.h>
+#else
+  #include <poll.h>
+  #include <signal.h>
+  #include <termios.h>
+  #include <unistd.h>
+#endif
+
+#define KEY_CTRL_D      0x04
+#define KEY_BACKSPACE   0x08
+#define KEY_ESCAPE      0x1B
+#define KEY_DELETE      0x7F
+
+/* ------------------------------------------------------------------------- */
+/* File-scope state                                                          */
+/* ------------------------------------------------------------------------- */
+
+typedef struct {
+    InputIdleFn  fn;
+    void        *arg;
+    unsigned int periodMs;
+    uint64_t     nextDueMs;
+} IdleTask;
+
+static IdleTask g_IdleTasks[INPUT_MAX_IDLE_TASKS];
+static int      g_IdleTaskCount = 0;
+
+static bool g_Initialized = false;
+static bool g_IsTerminal  = false;   /* stdin is an interactive console */
+static bool g_RawMode     = false;   /* we switched it to cbreak        */
+static bool g_SawEof      = false;
+
+static void (*g_EofHandler)(void)           = NULL;
+static void (*g_PromptHook)(const char *kind) = NULL;
+
+#ifndef _WIN32
+static struct termios g_SavedTermios;
+
+/* Bytes read from stdin but not yet delivered as events. */
+static unsigned char g_ReadBuffer[256];
+static size_t        g_ReadPos = 0;
+static size_t        g_ReadLen = 0;
+#endif
+
+/* ------------------------------------------------------------------------- */
+/* Terminal mode                                                             */
+/* ------------------------------------------------------------------------- */
+
+#ifndef _WIN32
+/** Restore the terminal and re-raise, so Ctrl+C never leaves echo off. */
+static void restore_on_signal(int signo)
+{
+    if (g_RawMode) tcsetattr(STDIN_FILENO, TCSANOW, &g_SavedTermios);
+    signal(signo, SIG_DFL);
+    raise(signo);
+}
+#endif
+
+void input_init(void)
+{
+    if (g_Initialized) return;
+    g_Initialized = true;
+
+#ifdef _WIN32
+    /* _getch() is already unbuffered and silent; nothing to switch. */
+    g_IsTerminal = _isatty(_fileno(stdin)) != 0;
+    g_RawMode    = g_IsTerminal;
+#else
+    g_IsTerminal = isatty(STDIN_FILENO) != 0;
+    if (!g_IsTerminal || tcgetattr(STDIN_FILENO, &g_SavedTermios) != 0) return;
+
+    struct termios raw = g_SavedTermios;
+    raw.c_lflag &= (tcflag_t)~(ICANON | ECHO);   /* keep ISIG for Ctrl+C */
+    raw.c_cc[VMIN]  = 1;
+    raw.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSANOW, &raw) != 0) return;
+    g_RawMode = true;
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = restore_on_signal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT,  &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    sigaction(SIGQUIT, &action, NULL);
+#endif
+
+    atexit(input_shutdown);
+}
+
+void input_shutdown(void)
+{
+#ifndef _WIN32
+    if (g_RawMode) tcsetattr(STDIN_FILENO, TCSANOW, &g_SavedTermios);
+#endif
+    g_RawMode = false;
+}
+
+void input_set_eof_handler(void (*handler)(void))
+{
+    g_EofHandler = handler;
+}
+
+void input_set_prompt_hook(void (*hook)(const char *kind))
+{
+    g_PromptHook = hook;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Idle tasks                                                                */
+/* ------------------------------------------------------------------------- */
+
+bool input_add_idle_task(InputIdleFn fn, void *arg, unsigned int periodMs)
+{
+    if (!fn || g_IdleTaskCount >= INPUT_MAX_IDLE_TASKS) return false;
+
+    IdleTask *task  = &g_IdleTasks[g_IdleTaskCount++];
+    task->fn        = fn;
+    task->arg       = arg;
+    task->periodMs  = periodMs ? periodMs : 1;
+    task->nextDueMs = platform_now_ms() + task->periodMs;
+    return true;
+}
+
+/**
+ * run_due_idle_tasks
+ * Run every task whose deadline has passed.
+ *
+ * @return milliseconds until the next task is due (or -1 if there are none).
+ */
+static long run_due_idle_tasks(void)
+{
+    if (g_IdleTaskCount == 0) return -1;
+
+    const uint64_t now = platform_now_ms();
+    uint64_t nextDue   = UINT64_MAX;
+
+    for (int i = 0; i < g_IdleTaskCount; ++i) {
+        IdleTask *task = &g_IdleTasks[i];
+        if (now >= task->nextDueMs) {
+            task->fn(task->arg);
+            task->nextDueMs = now + task->periodMs;
+        }
+        if (task->nextDueMs < nextDue) nextDue = task->nextDueMs;
+    }
+
+    const uint64_t after = platform_now_ms();
+    return (nextDue > after) ? (long)(nextDue - after) : 0;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Event loop                                                                */
+/* ------------------------------------------------------------------------- */
+
+bool input_poll_event(InputEvent *event, int timeoutMs)
+{
+    if (!event) return false;
+    input_init();
+    fflush(stdout);   /* prompts must be visible before we block */
+
+    const uint64_t deadline = (timeoutMs >= 0) ? platform_now_ms() + (uint64_t)timeoutMs : 0;
+
+    for (;;) {
+#ifndef _WIN32
+        if (g_ReadPos < g_ReadLen) {
+            event->type = INPUT_EVENT_KEY;
+            event->key  = g_ReadBuffer[g_ReadPos++];
+            return true;
+        }
+#endif
+        if (g_SawEof) {
+            event->type = INPUT_EVENT_EOF;
+            event->key  = 0;
+            return true;
+        }
+
+        /* Wait until input arrives, the next idle task is due, or we time out. */
+        long waitMs = run_due_idle_tasks();
+        if (timeoutMs >= 0) {
+            const uint64_t now  = platform_now_ms();
+            const long     left = (deadline > now) ? (long)(deadline - now) : 0;
+            if (waitMs < 0 || left < waitMs) waitMs = left;
+        }
+
+#ifdef _WIN32
+        (void)waitMs;   /* the console is polled below in 10 ms steps */
+        if (!g_IsTerminal) {
+            /* Redirected stdin: no way to poll, so read blocking. */
+            const int ch = fgetc(stdin);
+            if (ch == EOF) { g_SawEof = true; continue; }
+            event->type = INPUT_EVENT_KEY;
+            event->key  = ch;
+            return true;
+        }
+        if (_kbhit()) {
+            int key = _getch();
+            if (key == 0 || key == 0xE0) { (void)_getch(); continue; }   /* arrows/F-keys */
+            event->type = INPUT_EVENT_KEY;
+            event->key  = key;
+            return true;
+        }
+        if (timeoutMs >= 0 && platform_now_ms() >= deadline) {
+            event->type = INPUT_EVENT_NONE;
+            return false;
+        }
+        Sleep(10);   /* console has no waitable "key ready" we can mix with timers */
+#else
+        struct pollfd pfd = { .fd = STDIN_FILENO, .events = POLLIN, .revents = 0 };
+        const int ready = poll(&pfd, 1, (waitMs > 0x7FFFFFFFL) ? 0x7FFFFFFF : (int)waitMs);
+
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            g_SawEof = true;
+            continue;
+        }
+        if (ready == 0) {
+            if (timeoutMs >= 0 && platform_now_ms() >= deadline) {
+                event->type = INPUT_EVENT_NONE;
+                return false;
+            }
+            continue;   /* an idle task is due */
+        }
+
+        const ssize_t got = read(STDIN_FILENO, g_ReadBuffer, sizeof(g_ReadBuffer));
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) { g_SawEof = true; continue; }
+        g_ReadPos = 0;
+        g_ReadLen = (size_t)got;
+#endif
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* Line helpers                                                              */
+/* ------------------------------------------------------------------------- */
+
+static void echo_text(const char *text)
+{
+    if (!g_RawMode) return;
+    fputs(text, stdout);
+    fflush(stdout);
+}
+
+/** Default EOF policy: nothing more can be read, so leave cleanly. */
+static void handle_eof(void)
+{
+    if (g_EofHandler) {
+        g_EofHandler();
+        return;
+    }
+    printf("\n");
+    exit(EXIT_SUCCESS);   /* atexit handlers flush saves + restore the tty */
+}
+
+bool input_read_line(char *buffer, size_t capacity)
+{
+    if (!buffer || capacity == 0) return false;
+
+    size_t length     = 0;
+    int    escapeState = 0;   /* 0 = normal, 1 = after ESC, 2 = inside CSI */
+    buffer[0] = '\0';
+
+    for (;;) {
+        InputEvent event;
+        if (!input_poll_event(&event, -1)) continue;
+
+        if (event.type == INPUT_EVENT_EOF ||
+            (g_RawMode && event.key == KEY_CTRL_D && length == 0)) {
+            handle_eof();
+            return false;
+        }
+
+        const int key = event.key;
+
+        /* Drop arrow/function key sequences (ESC [ ... final-byte). */
+        if (escapeState == 1) { escapeState = (key == '[' || key == 'O') ? 2 : 0; continue; }
+        if (escapeState == 2) { if (key >= 0x40 && key <= 0x7E) escapeState = 0; continue; }
+        if (key == KEY_ESCAPE) { escapeState = 1; continue; }
+
+        if (key == '\n' || key == '\r') {
+            echo_text("\n");
+            buffer[length] = '\0';
+            return true;
+        }
+
+        if (key == KEY_BACKSPACE || key == KEY_DELETE) {
+            if (length > 0) {
+                --length;
+                echo_text("\b \b");
+            }
+            continue;
+        }
+
+        if ((key >= 0x20 && key != KEY_DELETE) || key == '\t') {
+            if (length + 1 < capacity) {
+                buffer[length++] = (char)key;
+                const char echoed[2] = { (char)key, '\0' };
+                echo_text(echoed);
+            }
+        }
+    }
+}
+
+static void notify_prompt(const char *kind)
+{
+    if (g_PromptHook) g_PromptHook(kind);
+}
+
+/** Read lines until one is non-blank (scanf skips blank lines too). */
+static bool read_nonblank_line(char *buffer, size_t capacity, const char *kind)
+{
+    notify_prompt(kind);
+    for (;;) {
+        if (!input_read_line(buffer, capacity)) return false;
+
+        for (const char *cursor = buffer; *cursor; ++cursor) {
+            if (*cursor != ' ' && *cursor != '\t') return true;
+        }
+    }
+}
+
+bool input_read_int(int *out)
+{
+    char line[INPUT_MAX_LINE];
+    if (!out || !read_nonblank_line(line, sizeof(line), "int")) return false;
+
+    char *end = NULL;
+    errno = 0;
+    const long value = strtol(line, &end, 10);
+    if (end == line || errno == ERANGE || value < INT32_MIN || value > INT32_MAX) return false;
+
+    *out = (int)value;
+    return true;
+}
+
+/** Parse an unsigned decimal, rejecting a leading minus sign. */
+static bool parse_unsigned(const char *line, unsigned long long *value)
+{
+    const char *cursor = line;
+    while (*cursor == ' ' || *cursor == '\t') ++cursor;
+    if (*cursor == '-') return false;
+
+    char *end = NULL;
+    errno = 0;
+    *value = strtoull(cursor, &end, 10);
+    return end != cursor && errno != ERANGE;
+}
+
+bool input_read_uint(unsigned int *out)
+{
+    char line[INPUT_MAX_LINE];
+    unsigned long long value = 0;
+    if (!out || !read_nonblank_line(line, sizeof(line), "uint")) return false;
+    if (!parse_unsigned(line, &value) || value > UINT32_MAX) return false;
+
+    *out = (unsigned int)value;
+    return true;
+}
+
+bool input_read_u64(unsigned long long *out)
+{
+    char line[INPUT_MAX_LINE];
+    unsigned long long value = 0;
+    if (!out || !read_nonblank_line(line, sizeof(line), "u64")) return false;
+    if (!parse_unsigned(line, &value)) return false;
+
+    *out = value;
+    return true;
+}
+
+void input_wait_enter(void)
+{
+    char line[INPUT_MAX_LINE];
+    notify_prompt("enter");
+    (void)input_read_line(line, sizeof(line));
+}
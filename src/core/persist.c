@@ -0,0 +1,178 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Write-behind persistence service.
+ *
+ * Responsibilities:
+ *   - Track which save targets are dirty and since when.
+ *   - Run one writer thread that sleeps until the oldest mark reaches
+ *     PERSIST_MAX_STALENESS_MS, then writes every dirty target once.
+ *   - Serialize all file writes (writer thread vs. explicit flushes) so the
+ *     same file is never written from two threads at once.
+ */
+
+#include "core.h"
+#include "persist.h"
+#include "platform.h"
+#include "rollups.h"
+#include "profile.h"
+#include "state.h"
+
+/* ------------------------------------------------------------------------- */
+/* File-scope state                                                          */
+/* ------------------------------------------------------------------------- */
+
+static PlatformMutex  g_StateLock;          /* guards everything below        */
+static PlatformMutex  g_WriteLock;          /* serializes the actual file I/O */
+static PlatformCond   g_WakeWriter;
+static PlatformThread g_WriterThread;
+
+static bool           g_Initialized   = false;
+static bool           g_WriterRunning = false;
+static bool           g_StopRequested = false;
+static unsigned int   g_DirtyMask     = 0;
+static uint64_t       g_FirstDirtyMs  = 0;  /* when the oldest pending mark landed */
+
+/* ------------------------------------------------------------------------- */
+/* Internal helpers                                                          */
+/* ------------------------------------------------------------------------- */
+
+/** Take the dirty mask and clear it. Caller holds g_StateLock. */
+static unsigned int take_dirty_locked(void)
+{
+    unsigned int taken = g_DirtyMask;
+    g_DirtyMask    = 0;
+    g_FirstDirtyMs = 0;
+    return taken;
+}
+
+/**
+ * Perform the writes for a taken mask. Caller holds g_WriteLock.
+ * Every target saves from a copy taken under its owner's lock (the state.h
+ * snapshot, the achievements and rollups save copies), never from live
+ * globals, so this is safe to run while the game thread keeps playing.
+ */
+static void write_targets(unsigned int what)
+{
+    if (what & PERSIST_PLAYER) {
+        (void)save_player_data();
+        profile_sync_index();      /* balance + last played for the profile list */
+    }
+    if (what & PERSIST_ACHIEVEMENTS) (void)save_achievements();
+    if (what & PERSIST_ROLLUPS)      (void)rollups_save();
+}
+
+/**
+ * writer_main
+ * Sleep until something is dirty, then until the staleness window of the
+ * oldest mark expires, then write. Marks that land in the meantime ride
+ * along with the same write.
+ */
+static void writer_main(void *unused)
+{
+    (void)unused;
+
+    platform_mutex_lock(&g_StateLock);
+    while (!g_StopRequested) {
+        if (g_DirtyMask == 0) {
+            platform_cond_wait(&g_WakeWriter, &g_StateLock);
+            continue;
+        }
+
+        const uint64_t now      = platform_now_ms();
+        const uint64_t deadline = g_FirstDirtyMs + PERSIST_MAX_STALENESS_MS;
+        if (now < deadline) {
+            (void)platform_cond_timedwait(&g_WakeWriter, &g_StateLock, deadline - now);
+            continue;
+        }
+
+        platform_mutex_unlock(&g_StateLock);
+        platform_mutex_lock(&g_WriteLock);
+
+        platform_mutex_lock(&g_StateLock);
+        const unsigned int what = take_dirty_locked();
+        platform_mutex_unlock(&g_StateLock);
+
+        write_targets(what);
+        platform_mutex_unlock(&g_WriteLock);
+
+        platform_mutex_lock(&g_StateLock);
+    }
+    platform_mutex_unlock(&g_StateLock);
+}
+
+/* ------------------------------------------------------------------------- */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------- */
+
+void persist_init(void)
+{
+    if (g_Initialized) return;
+
+    platform_mutex_init(&g_StateLock);
+    platform_mutex_init(&g_WriteLock);
+    platform_cond_init(&g_WakeWriter);
+    g_Initialized   = true;
+    g_StopRequested = false;
+
+    g_WriterRunning = platform_thread_create(&g_WriterThread, writer_main, NULL);
+
+    /* Never lose a pending write, whichever exit path the menus take. */
+    atexit(persist_shutdown);
+}
+
+void persist_mark_dirty(unsigned int what)
+{
+    /* The writer saves the published snapshot, never the live globals. */
+    if (what & PERSIST_PLAYER) state_publish();
+
+    if (!g_Initialized || !g_WriterRunning) {
+        /* No writer: behave exactly like the old synchronous saves. */
+        write_targets(what);
+        return;
+    }
+
+    platform_mutex_lock(&g_StateLock);
+    if (g_DirtyMask == 0) {
+        g_FirstDirtyMs = platform_now_ms();
+        g_DirtyMask    = what;
+        platform_cond_signal(&g_WakeWriter);
+    } else {
+        g_DirtyMask   |= what;   /* coalesce into the pending write */
+    }
+    platform_mutex_unlock(&g_StateLock);
+}
+
+void persist_flush(void)
+{
+    if (!g_Initialized) return;
+
+    platform_mutex_lock(&g_WriteLock);
+
+    platform_mutex_lock(&g_StateLock);
+    const unsigned int what = take_dirty_locked();
+    platform_mutex_unlock(&g_StateLock);
+
+    write_targets(what);
+    platform_mutex_unlock(&g_WriteLock);
+}
+
+void persist_shutdown(void)
+{
+    if (!g_Initialized) return;
+
+    state_publish();   /* pick up play time accrued since the last mark */
+
+    if (g_WriterRunning) {
+        platform_mutex_lock(&g_StateLock);
+        g_StopRequested = true;
+        platform_cond_signal(&g_WakeWriter);
+        platform_mutex_unlock(&g_StateLock);
+
+        platform_thread_join(g_WriterThread);
+        g_WriterRunning = false;
+    }
+
+    persist_flush();
+}
@@ -0,0 +1,252 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Portability layer implementation (Win32 + POSIX).
+ *
+ * Responsibilities:
+ *   - Thread start/join with a common void(*)(void*) body signature, and
+ *     the online processor count.
+ *   - Mutex/condition wrappers, including a relative-timeout wait.
+ *   - Monotonic clock + sleep.
+ */
+
+#ifndef _WIN32
+  #define _POSIX_C_SOURCE 200809L   /* clock_gettime, nanosleep, condattr_setclock */
+#endif
+
+#include "platform.h"
+
+#include <stdlib.h>
+
+#ifndef _WIN32
+  #include <errno.h>
+  #include <time.h>
+  #include <unistd.h>
+#endif
+
+/* ------------------------------------------------------------------------- */
+/* Threads                                                                   */
+/* ------------------------------------------------------------------------- */
+
+/* Heap-allocated start block handed to the OS trampoline. */
+typedef struct {
+    PlatformThreadFn fn;
+    void            *arg;
+} ThreadStart;
+
+#ifdef _WIN32
+static DWORD WINAPI thread_trampoline(LPVOID param)
+{
+    ThreadStart start = *(ThreadStart *)param;
+    free(param);
+    start.fn(start.arg);
+    return 0;
+}
+#else
+static void *thread_trampoline(void *param)
+{
+    ThreadStart start = *(ThreadStart *)param;
+    free(param);
+    start.fn(start.arg);
+    return NULL;
+}
+#endif
+
+bool platform_thread_create(PlatformThread *thread, PlatformThreadFn fn, void *arg)
+{
+    if (!thread || !fn) return false;
+
+    ThreadStart *start = (ThreadStart *)malloc(sizeof(ThreadStart));
+    if (!start) return false;
+    start->fn  = fn;
+    start->arg = arg;
+
+#ifdef _WIN32
+    *thread = CreateThread(NULL, 0, thread_trampoline, start, 0, NULL);
+    if (!*thread) { free(start); return false; }
+#else
+    if (pthread_create(thread, NULL, thread_trampoline, start) != 0) { free(start); return false; }
+#endif
+    return true;
+}
+
+void platform_thread_join(PlatformThread thread)
+{
+#ifdef _WIN32
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+int platform_cpu_count(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    const long online = sysconf(_SC_NPROCESSORS_ONLN);
+    return online > 0 ? (int)online : 1;
+#endif
+}
+
+/* ------------------------------------------------------------------------- */
+/* Mutex                                                                     */
+/* ------------------------------------------------------------------------- */
+
+void platform_mutex_init(PlatformMutex *mutex)
+{
+#ifdef _WIN32
+    InitializeCriticalSection(mutex);
+#else
+    pthread_mutex_init(mutex, NULL);
+#endif
+}
+
+void platform_mutex_destroy(PlatformMutex *mutex)
+{
+#ifdef _WIN32
+    DeleteCriticalSection(mutex);
+#else
+    pthread_mutex_destroy(mutex);
+#endif
+}
+
+void platform_mutex_lock(PlatformMutex *mutex)
+{
+#ifdef _WIN32
+    EnterCriticalSection(mutex);
+#else
+    pthread_mutex_lock(mutex);
+#endif
+}
+
+void platform_mutex_unlock(PlatformMutex *mutex)
+{
+#ifdef _WIN32
+    LeaveCriticalSection(mutex);
+#else
+    pthread_mutex_unlock(mutex);
+#endif
+}
+
+/* ------------------------------------------------------------------------- */
+/* Condition variable                                                        */
+/* ------------------------------------------------------------------------- */
+
+void platform_cond_init(PlatformCond *cond)
+{
+#ifdef _WIN32
+    InitializeConditionVariable(cond);
+#else
+    /* Time out against the monotonic clock so wall-clock jumps don't matter. */
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+#endif
+}
+
+void platform_cond_destroy(PlatformCond *cond)
+{
+#ifdef _WIN32
+    (void)cond;   /* Win32 condition variables need no cleanup. */
+#else
+    pthread_cond_destroy(cond);
+#endif
+}
+
+void platform_cond_wait(PlatformCond *cond, PlatformMutex *mutex)
+{
+#ifdef _WIN32
+    SleepConditionVariableCS(cond, mutex, INFINITE);
+#else
+    pthread_cond_wait(cond, mutex);
+#endif
+}
+
+bool platform_cond_timedwait(PlatformCond *cond, PlatformMutex *mutex, uint64_t timeoutMs)
+{
+#ifdef _WIN32
+    if (timeoutMs > 0xFFFFFFF0ULL) timeoutMs = 0xFFFFFFF0ULL;   /* stay below INFINITE */
+    return SleepConditionVariableCS(cond, mutex, (DWORD)timeoutMs) != 0;
+#else
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec  += (time_t)(timeoutMs / 1000ULL);
+    deadline.tv_nsec += (long)(timeoutMs % 1000ULL) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec  += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    return pthread_cond_timedwait(cond, mutex, &deadline) != ETIMEDOUT;
+#endif
+}
+
+void platform_cond_signal(PlatformCond *cond)
+{
+#ifdef _WIN32
+    WakeConditionVariable(cond);
+#else
+    pthread_cond_signal(cond);
+#endif
+}
+
+void platform_cond_broadcast(PlatformCond *cond)
+{
+#ifdef _WIN32
+    WakeAllConditionVariable(cond);
+#else
+    pthread_cond_broadcast(cond);
+#endif
+}
+
+/* ------------------------------------------------------------------------- */
+/* Time                                                                      */
+/* ------------------------------------------------------------------------- */
+
+uint64_t platform_now_ms(void)
+{
+#ifdef _WIN32
+    /* Unbiased: excludes suspend, matching CLOCK_MONOTONIC on Linux. */
+    ULONGLONG ticks = 0;
+    QueryUnbiasedInterruptTime(&ticks);        /* 100 ns units */
+    return (uint64_t)(ticks / 10000ULL);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000ULL + (uint64_t)(now.tv_nsec / 1000000L);
+#endif
+}
+
+uint64_t platform_now_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;             /* fixed at boot */
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    const uint64_t ticks = (uint64_t)counter.QuadPart;
+    const uint64_t hz    = (uint64_t)frequency.QuadPart;
+    return (ticks / hz) * 1000000000ULL + (ticks % hz) * 1000000000ULL / hz;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#endif
+}
+
+void platform_sleep_ms(unsigned int ms)
+{
+#ifdef _WIN32
+    Sleep(ms);
+#else
+    struct timespec request = { (time_t)(ms / 1000U), (long)(ms % 1000U) * 1000000L };
+    while (nanosleep(&request, &request) == -1 && errno == EINTR) { /* resume */ }
+#endif
+}
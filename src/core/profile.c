@@ -0,0 +1,270 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Named player profiles (see profile.h).
+ *
+ * Responsibilities:
+ *   - Load/save the fixed-record profile index (saves/profiles.idx).
+ *   - Track the active profile and resolve its save directory (paths.h).
+ *   - Switch profiles: flush pending writes, close per-profile handles and
+ *     re-point the save paths.
+ *
+ * The index is read by menus on the main thread and rewritten by the
+ * persistence writer thread (profile_sync_index), so it is guarded by g_Lock.
+ */
+
+#include "core.h"
+#include "profile.h"
+#include "paths.h"
+#include "persist.h"
+#include "history.h"
+#include "platform.h"
+#include "state.h"
+
+#define PROFILE_INDEX_MAGIC     0x49505343u   /* "CSPI" */
+#define PROFILE_INDEX_VERSION   1u
+
+_Static_assert(sizeof(PROFILES_DIR "/") + PROFILE_NAME_MAX - 1 <= PROFILE_DIR_MAX,
+               "PROFILE_DIR_MAX must hold the longest profile directory");
+
+/* ------------------------------------------------------------------------- */
+/* Types                                                                     */
+/* ------------------------------------------------------------------------- */
+
+/* On-disk header; followed by `count` ProfileSummary rows. */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t recordSize;                 /* sizeof(ProfileSummary) */
+    char     current[PROFILE_NAME_MAX];  /* last selected profile  */
+} ProfileIndexHeader;
+
+/* ------------------------------------------------------------------------- */
+/* File-scope state                                                          */
+/* ------------------------------------------------------------------------- */
+
+static ProfileSummary g_Index[PROFILE_MAX_COUNT];
+static int            g_IndexCount = 0;
+
+static char           g_Current[PROFILE_NAME_MAX] = PROFILE_DEFAULT_NAME;
+static char           g_Dir[PROFILE_DIR_MAX]      = SAVE_DIR;
+
+static PlatformMutex  g_Lock;
+static bool           g_LockReady = false;
+
+/* ------------------------------------------------------------------------- */
+/* Internal helpers                                                          */
+/* ------------------------------------------------------------------------- */
+
+static void ensure_lock(void)
+{
+    if (g_LockReady) return;
+    platform_mutex_init(&g_Lock);
+    g_LockReady = true;
+}
+
+/** Row index of `name`, or -1. Caller holds g_Lock. */
+static int find_row(const char *name)
+{
+    for (int i = 0; i < g_IndexCount; ++i) {
+        if (strcmp(g_Index[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+/** Find or append the row for `name`. Caller holds g_Lock. */
+static int ensure_row(const char *name)
+{
+    const int existing = find_row(name);
+    if (existing >= 0 || g_IndexCount >= PROFILE_MAX_COUNT) return existing;
+
+    ProfileSummary *row = &g_Index[g_IndexCount];
+    memset(row, 0, sizeof(*row));
+    snprintf(row->name, sizeof(row->name), "%s", name);
+    return g_IndexCount++;
+}
+
+/** Read saves/profiles.idx into g_Index. Caller holds g_Lock. */
+static void load_index(char *lastSelected, size_t capacity)
+{
+    g_IndexCount    = 0;
+    lastSelected[0] = '\0';
+
+    FILE *fp = fopen(PROFILE_INDEX_PATH, "rb");
+    if (!fp) return;
+
+    ProfileIndexHeader header;
+    if (fread(&header, sizeof(header), 1, fp) == 1 &&
+        header.magic      == PROFILE_INDEX_MAGIC   &&
+        header.version    == PROFILE_INDEX_VERSION &&
+        header.recordSize == (uint32_t)sizeof(ProfileSummary))
+    {
+        const size_t wanted = (header.count < PROFILE_MAX_COUNT) ? header.count : PROFILE_MAX_COUNT;
+        g_IndexCount = (int)fread(g_Index, sizeof(ProfileSummary), wanted, fp);
+
+        header.current[PROFILE_NAME_MAX - 1] = '\0';
+        snprintf(lastSelected, capacity, "%s", header.current);
+    }
+    fclose(fp);
+
+    /* Drop rows that could not have been written by us. */
+    int kept = 0;
+    for (int i = 0; i < g_IndexCount; ++i) {
+        g_Index[i].name[PROFILE_NAME_MAX - 1] = '\0';
+        if (profile_valid_name(g_Index[i].name)) g_Index[kept++] = g_Index[i];
+    }
+    g_IndexCount = kept;
+}
+
+/** Rewrite saves/profiles.idx from g_Index. Caller holds g_Lock. */
+static bool write_index(void)
+{
+    FILE *fp = fopen(PROFILE_INDEX_PATH, "wb");
+    if (!fp) return false;
+
+    ProfileIndexHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic      = PROFILE_INDEX_MAGIC;
+    header.version    = PROFILE_INDEX_VERSION;
+    header.count      = (uint32_t)g_IndexCount;
+    header.recordSize = (uint32_t)sizeof(ProfileSummary);
+    snprintf(header.current, sizeof(header.current), "%s", g_Current);
+
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+    if (g_IndexCount > 0) {
+        ok &= fwrite(g_Index, sizeof(ProfileSummary), (size_t)g_IndexCount, fp) == (size_t)g_IndexCount;
+    }
+    fclose(fp);
+    return ok;
+}
+
+/** Make `name` active and compute its directory. Caller holds g_Lock. */
+static void set_active(const char *name)
+{
+    snprintf(g_Current, sizeof(g_Current), "%s", name);
+
+    if (strcmp(name, PROFILE_DEFAULT_NAME) == 0) {
+        snprintf(g_Dir, sizeof(g_Dir), "%s", SAVE_DIR);
+    } else {
+        snprintf(g_Dir, sizeof(g_Dir), "%s/%s", PROFILES_DIR, name);
+    }
+
+    (void)ensure_row(PROFILE_DEFAULT_NAME);
+    (void)ensure_row(name);
+}
+
+/* ------------------------------------------------------------------------- */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------- */
+
+void profile_dir(char *buf, size_t bufsize)
+{
+    if (!buf || bufsize == 0) return;
+    ensure_lock();
+
+    platform_mutex_lock(&g_Lock);
+    snprintf(buf, bufsize, "%s", g_Dir);
+    platform_mutex_unlock(&g_Lock);
+}
+
+const char *profile_current(void)
+{
+    return g_Current;
+}
+
+bool profile_valid_name(const char *name)
+{
+    if (!name || !*name) return false;
+
+    size_t length = 0;
+    for (const char *c = name; *c; ++c, ++length) {
+        if (length >= PROFILE_NAME_MAX - 1) return false;
+        if (!isalnum((unsigned char)*c) && *c != '-' && *c != '_') return false;
+    }
+    return true;
+}
+
+bool profile_init(const char *requested)
+{
+    if (requested && !profile_valid_name(requested)) return false;
+    ensure_lock();
+
+    platform_mutex_lock(&g_Lock);
+
+    char lastSelected[PROFILE_NAME_MAX];
+    load_index(lastSelected, sizeof(lastSelected));
+
+    const char *name = requested;
+    if (!name) name = profile_valid_name(lastSelected) ? lastSelected : PROFILE_DEFAULT_NAME;
+
+    set_active(name);
+    (void)write_index();
+
+    platform_mutex_unlock(&g_Lock);
+    return true;
+}
+
+int profile_count(void)
+{
+    ensure_lock();
+
+    platform_mutex_lock(&g_Lock);
+    const int count = g_IndexCount;
+    platform_mutex_unlock(&g_Lock);
+    return count;
+}
+
+bool profile_at(int index, ProfileSummary *out)
+{
+    if (!out) return false;
+    ensure_lock();
+
+    platform_mutex_lock(&g_Lock);
+    const bool ok = index >= 0 && index < g_IndexCount;
+    if (ok) *out = g_Index[index];
+    platform_mutex_unlock(&g_Lock);
+    return ok;
+}
+
+bool profile_switch(const char *name)
+{
+    if (!profile_valid_name(name)) return false;
+    ensure_lock();
+
+    /* Everything pending belongs to the old profile: publish the live state
+       and write it there first (the writer only sees published snapshots). */
+    persist_mark_dirty(PERSIST_PLAYER);
+    persist_flush();
+    history_close();
+
+    platform_mutex_lock(&g_Lock);
+    if (find_row(name) < 0 && g_IndexCount >= PROFILE_MAX_COUNT) {
+        platform_mutex_unlock(&g_Lock);
+        return false;
+    }
+    set_active(name);
+    (void)write_index();
+    platform_mutex_unlock(&g_Lock);
+
+    fs_init();   /* create the profile's directories on first use */
+    return true;
+}
+
+void profile_sync_index(void)
+{
+    ensure_lock();
+
+    StateSnapshot snapshot;
+    state_snapshot(&snapshot);   /* runs on the writer thread */
+
+    platform_mutex_lock(&g_Lock);
+    const int row = ensure_row(g_Current);
+    if (row >= 0) {
+        g_Index[row].balance    = snapshot.player.uPlayerMoney;
+        g_Index[row].lastPlayed = (int64_t)time(NULL);
+    }
+    (void)write_index();
+    platform_mutex_unlock(&g_Lock);
+}
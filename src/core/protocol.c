@@ -0,0 +1,181 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Machine protocol mode (see protocol.h).
+ *
+ * Responsibilities:
+ *   - Duplicate the original stdout as the event stream, then route stdout
+ *     (human text, frames) to stderr.
+ *   - Emit line-delimited JSON events; flush after every line so a driver
+ *     reading the pipe sees them immediately.
+ *   - Translate input-layer prompts and EOF into events.
+ */
+
+#ifndef _WIN32
+  #define _POSIX_C_SOURCE 200809L   /* dup, dup2, fdopen, fileno */
+#endif
+
+#include "protocol.h"
+#include "input.h"
+
+#include <stdarg.h>
+
+#ifdef _WIN32
+  #include <io.h>
+  #define protocol_dup(fd)          _dup(fd)
+  #define protocol_dup2(fd, to)     _dup2((fd), (to))
+  #define protocol_fdopen(fd, mode) _fdopen((fd), (mode))
+  #define protocol_fileno(fp)       _fileno(fp)
+#else
+  #include <unistd.h>
+  #define protocol_dup(fd)          dup(fd)
+  #define protocol_dup2(fd, to)     dup2((fd), (to))
+  #define protocol_fdopen(fd, mode) fdopen((fd), (mode))
+  #define protocol_fileno(fp)       fileno(fp)
+#endif
+
+/* ------------------------------------------------------------------------- */
+/* File-scope state                                                          */
+/* ------------------------------------------------------------------------- */
+
+static FILE       *g_Events  = NULL;          /* original stdout */
+static const char *g_Screen  = "startup";
+static char        g_CardsJson[2048];
+static char        g_StringJson[512];
+
+/* ------------------------------------------------------------------------- */
+/* Input-layer hooks                                                         */
+/* ------------------------------------------------------------------------- */
+
+static void on_prompt(const char *kind)
+{
+    protocol_emit("prompt", "\"screen\":\"%s\",\"kind\":\"%s\"", g_Screen, kind);
+}
+
+static void on_eof(void)
+{
+    protocol_emit("eof", NULL);
+    exit(EXIT_SUCCESS);   /* atexit handlers flush saves and emit "exit" */
+}
+
+static void on_exit_event(void)
+{
+    protocol_emit("exit", "\"funds\":%llu", playerData.uPlayerMoney);
+}
+
+/* ------------------------------------------------------------------------- */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------- */
+
+bool protocol_init(void)
+{
+    if (g_Events) return true;
+
+    fflush(stdout);
+
+    const int eventFd = protocol_dup(protocol_fileno(stdout));
+    if (eventFd < 0) return false;
+
+    g_Events = protocol_fdopen(eventFd, "w");
+    if (!g_Events) return false;
+
+    /* From here on printf/render output lands on stderr. */
+    protocol_dup2(protocol_fileno(stderr), protocol_fileno(stdout));
+
+    input_set_prompt_hook(on_prompt);
+    input_set_eof_handler(on_eof);
+    atexit(on_exit_event);
+
+    protocol_emit("hello", "\"version\":1");
+    return true;
+}
+
+bool protocol_enabled(void)
+{
+    return g_Events != NULL;
+}
+
+void protocol_emit(const char *event, const char *fieldsFmt, ...)
+{
+    if (!g_Events) return;
+
+    fprintf(g_Events, "{\"event\":\"%s\"", event);
+    if (fieldsFmt) {
+        va_list args;
+        va_start(args, fieldsFmt);
+        fputc(',', g_Events);
+        vfprintf(g_Events, fieldsFmt, args);
+        va_end(args);
+    }
+    fputs("}\n", g_Events);
+    fflush(g_Events);
+}
+
+void protocol_screen(const char *name)
+{
+    if (!g_Events) return;
+
+    g_Screen = name ? name : "unknown";
+    protocol_emit("screen", "\"name\":\"%s\",\"funds\":%llu", g_Screen, playerData.uPlayerMoney);
+}
+
+const char *protocol_cards(const Card *cards, int count)
+{
+    size_t used = 0;
+    g_CardsJson[used++] = '[';
+
+    for (int i = 0; i < count && cards; ++i) {
+        const char *name  = cs_card_meta(&cards[i])->name;
+        const int   wrote = name
+            ? snprintf(g_CardsJson + used, sizeof(g_CardsJson) - used, "%s\"%s\"",
+                       i ? "," : "", name)
+            : snprintf(g_CardsJson + used, sizeof(g_CardsJson) - used, "%s\"%s of %s\"",
+                       i ? "," : "", cards[i].rank, cards[i].suit);
+        if (wrote < 0 || (size_t)wrote >= sizeof(g_CardsJson) - used - 2) break;
+        used += (size_t)wrote;
+    }
+
+    g_CardsJson[used++] = ']';
+    g_CardsJson[used]   = '\0';
+    return g_CardsJson;
+}
+
+const char *protocol_json_string(const char *text)
+{
+    static const char hex[] = "0123456789abcdef";
+    const size_t limit = sizeof(g_StringJson) - 2;   /* room for '"' + '\0' */
+    size_t used = 0;
+    g_StringJson[used++] = '"';
+
+    for (const unsigned char *c = (const unsigned char *)(text ? text : ""); *c; ++c) {
+        char escaped[6];
+        size_t length = 0;
+
+        switch (*c) {
+        case '"':  escaped[length++] = '\\'; escaped[length++] = '"';  break;
+        case '\\': escaped[length++] = '\\'; escaped[length++] = '\\'; break;
+        case '\n': escaped[length++] = '\\'; escaped[length++] = 'n';  break;
+        case '\r': escaped[length++] = '\\'; escaped[length++] = 'r';  break;
+        case '\t': escaped[length++] = '\\'; escaped[length++] = 't';  break;
+        default:
+            if (*c < 0x20) {
+                memcpy(escaped, "\\u00", 4);
+                escaped[4] = hex[*c >> 4];
+                escaped[5] = hex[*c & 0x0F];
+                length = 6;
+            } else {
+                escaped[length++] = (char)*c;
+            }
+            break;
+        }
+
+        if (used + length > limit) break;   /* truncate, never split an escape */
+        memcpy(g_StringJson + used, escaped, length);
+        used += length;
+    }
+
+    g_StringJson[used++] = '"';
+    g_StringJson[used]   = '\0';
+    return g_StringJson;
+}
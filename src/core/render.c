@@ -0,0 +1,346 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Frame-buffered terminal renderer (Win32 + POSIX).
+ *
+ * Responsibilities:
+ *   - Grow-on-demand frame buffer filled by render_printf().
+ *   - Compose clear/cursor escapes + frame into one output buffer and write
+ *     it with a single write() call.
+ *   - Line diff against the previous frame for partial redraws.
+ */
+
+#ifndef _WIN32
+  #define _POSIX_C_SOURCE 200809L   /* fileno, isatty */
+#endif
+
+#include "render.h"
+#include "trace.h"
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+  #include <windows.h>
+  #include <io.h>
+  #ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+    #define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+  #endif
+  #define render_isatty(fd)            _isatty(fd)
+  #define render_write(fd, buf, len)   _write((fd), (buf), (unsigned int)(len))
+#else
+  #include <unistd.h>
+  #include <sys/ioctl.h>
+  #define render_isatty(fd)            isatty(fd)
+  #define render_write(fd, buf, len)   write((fd), (buf), (len))
+#endif
+
+#define ANSI_HOME_CLEAR      "\033[H\033[2J"
+#define ANSI_CLEAR_SCROLL    "\033[3J"
+#define ANSI_CLEAR_EOL       "\033[K"
+#define ANSI_CLEAR_BELOW     "\033[J"
+
+/* ------------------------------------------------------------------------- */
+/* File-scope state                                                          */
+/* ------------------------------------------------------------------------- */
+
+/* Simple growable byte buffer. */
+typedef struct {
+    char   *data;
+    size_t  length;
+    size_t  capacity;
+} TextBuffer;
+
+static TextBuffer g_Frame;          /* frame being built                  */
+static TextBuffer g_Previous;       /* last frame written (for diffing)   */
+static TextBuffer g_Output;         /* escapes + frame, handed to write() */
+
+static bool g_Initialized   = false;
+static bool g_IsTerminal    = false;   /* stdout is an interactive console  */
+static bool g_AnsiEnabled   = false;   /* escapes are understood            */
+static bool g_PartialRedraw = true;
+static bool g_FrameOpen     = false;
+static bool g_PreviousValid = false;
+
+/* ------------------------------------------------------------------------- */
+/* Buffer helpers                                                            */
+/* ------------------------------------------------------------------------- */
+
+static bool buffer_reserve(TextBuffer *buffer, size_t extra)
+{
+    const size_t needed = buffer->length + extra + 1;
+    if (needed <= buffer->capacity) return true;
+
+    size_t newCapacity = buffer->capacity ? buffer->capacity : 4096;
+    while (newCapacity < needed) newCapacity *= 2;
+
+    char *grown = (char *)realloc(buffer->data, newCapacity);
+    if (!grown) return false;
+
+    buffer->data     = grown;
+    buffer->capacity = newCapacity;
+    return true;
+}
+
+static void buffer_append(TextBuffer *buffer, const char *text, size_t length)
+{
+    if (!buffer_reserve(buffer, length)) return;
+    memcpy(buffer->data + buffer->length, text, length);
+    buffer->length += length;
+    buffer->data[buffer->length] = '\0';
+}
+
+static void buffer_append_str(TextBuffer *buffer, const char *text)
+{
+    buffer_append(buffer, text, strlen(text));
+}
+
+static void buffer_vappendf(TextBuffer *buffer, const char *fmt, va_list args)
+{
+    va_list measure;
+    va_copy(measure, args);
+    const int needed = vsnprintf(NULL, 0, fmt, measure);
+    va_end(measure);
+
+    if (needed <= 0 || !buffer_reserve(buffer, (size_t)needed)) return;
+
+    vsnprintf(buffer->data + buffer->length, (size_t)needed + 1, fmt, args);
+    buffer->length += (size_t)needed;
+}
+
+/* Move the cursor to (row, 1); rows are 1-based. */
+static void buffer_append_goto_row(TextBuffer *buffer, int row)
+{
+    char escape[32];
+    const int length = snprintf(escape, sizeof(escape), "\033[%d;1H", row);
+    buffer_append(buffer, escape, (size_t)length);
+}
+
+/* ------------------------------------------------------------------------- */
+/* Terminal helpers                                                          */
+/* ------------------------------------------------------------------------- */
+
+/** Write the whole buffer to stdout, retrying short writes. */
+static void write_all(const char *data, size_t length)
+{
+    fflush(stdout);   /* keep ordering with anything printf'd before us */
+
+    while (length > 0) {
+        const long written = (long)render_write(1, data, length);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        data   += written;
+        length -= (size_t)written;
+    }
+}
+
+/** Visible terminal height in rows, or 0 if unknown. */
+static int terminal_rows(void)
+{
+#ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) return 0;
+    return info.srWindow.Bottom - info.srWindow.Top + 1;
+#else
+    struct winsize size;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0) return 0;
+    return size.ws_row;
+#endif
+}
+
+#ifdef _WIN32
+/**
+ * console_clear
+ * Clear a legacy console (no VT support) through the console API: blank the
+ * whole screen buffer, reset its attributes and home the cursor. This is what
+ * `cls` does, without spawning a shell per frame.
+ */
+static void console_clear(void)
+{
+    HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (console == INVALID_HANDLE_VALUE || !GetConsoleScreenBufferInfo(console, &info)) return;
+
+    const DWORD cells = (DWORD)info.dwSize.X * (DWORD)info.dwSize.Y;
+    const COORD home  = { 0, 0 };
+    DWORD written = 0;
+
+    FillConsoleOutputCharacterA(console, ' ', cells, home, &written);
+    FillConsoleOutputAttribute(console, info.wAttributes, cells, home, &written);
+    SetConsoleCursorPosition(console, home);
+}
+#endif
+
+/** Number of rows a frame occupies (text after the last '\n' counts as one). */
+static int count_lines(const char *text, size_t length)
+{
+    int lines = 1;
+    for (size_t i = 0; i < length; ++i) {
+        if (text[i] == '\n') ++lines;
+    }
+    return lines;
+}
+
+/** Return the start of line `index` and store its length (without '\n'). */
+static const char *line_at(const TextBuffer *buffer, int index, size_t *lineLength)
+{
+    const char *cursor = buffer->data;
+    const char *end    = buffer->data + buffer->length;
+
+    for (int i = 0; i < index && cursor < end; ++i) {
+        const char *newline = memchr(cursor, '\n', (size_t)(end - cursor));
+        cursor = newline ? newline + 1 : end;
+    }
+
+    const char *newline = memchr(cursor, '\n', (size_t)(end - cursor));
+    *lineLength = (size_t)((newline ? newline : end) - cursor);
+    return cursor;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------- */
+
+void render_init(void)
+{
+    if (g_Initialized) return;
+    g_Initialized = true;
+
+#ifdef _WIN32
+    g_IsTerminal = render_isatty(_fileno(stdout)) != 0;
+
+    HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD  mode    = 0;
+    if (g_IsTerminal && GetConsoleMode(console, &mode)) {
+        g_AnsiEnabled = SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING) != 0;
+    }
+#else
+    g_IsTerminal  = render_isatty(fileno(stdout)) != 0;
+    g_AnsiEnabled = g_IsTerminal;
+#endif
+}
+
+void render_set_plain(void)
+{
+    render_init();
+    g_IsTerminal    = false;
+    g_AnsiEnabled   = false;
+    g_PreviousValid = false;
+}
+
+void render_set_partial(bool enabled)
+{
+    g_PartialRedraw = enabled;
+    if (!enabled) g_PreviousValid = false;
+}
+
+void render_begin(void)
+{
+    render_init();
+    g_Frame.length = 0;
+    g_FrameOpen    = buffer_reserve(&g_Frame, 0);
+    if (g_FrameOpen) g_Frame.data[0] = '\0';
+}
+
+void render_printf(const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    if (g_FrameOpen) {
+        buffer_vappendf(&g_Frame, fmt, args);
+    } else {
+        vprintf(fmt, args);
+    }
+    va_end(args);
+}
+
+/**
+ * render_end
+ * Emit the open frame. With ANSI available and a previous frame still on
+ * screen, only lines that differ are rewritten (each followed by clear-to-
+ * end-of-line) and everything below the frame is cleared; otherwise the
+ * screen is cleared and the frame written in full. Either way the terminal
+ * receives exactly one write().
+ */
+void render_end(void)
+{
+    TRACE_SCOPE("render_end");
+    if (!g_FrameOpen) return;
+    g_FrameOpen = false;
+
+    if (!g_AnsiEnabled) {
+#ifdef _WIN32
+        if (g_IsTerminal) console_clear();   /* legacy console without VT support */
+#endif
+        write_all(g_Frame.data, g_Frame.length);
+        return;
+    }
+
+    const int newLines  = count_lines(g_Frame.data, g_Frame.length);
+    const int rows      = terminal_rows();
+    const int prevLines = g_PreviousValid ? count_lines(g_Previous.data, g_Previous.length) : 0;
+
+    const bool partial = g_PartialRedraw && g_PreviousValid && rows > 0 &&
+                         newLines  + RENDER_SCROLL_MARGIN <= rows &&
+                         prevLines + RENDER_SCROLL_MARGIN <= rows;
+
+    g_Output.length = 0;
+
+    if (!partial) {
+        buffer_append_str(&g_Output, ANSI_HOME_CLEAR);
+        buffer_append(&g_Output, g_Frame.data, g_Frame.length);
+    } else {
+        for (int line = 0; line < newLines; ++line) {
+            size_t newLength = 0, oldLength = 0;
+            const char *newText = line_at(&g_Frame, line, &newLength);
+            const char *oldText = (line < prevLines) ? line_at(&g_Previous, line, &oldLength) : NULL;
+
+            /* The last line is always rewritten so the cursor ends after it. */
+            const bool isLast  = (line == newLines - 1);
+            const bool changed = !oldText || oldLength != newLength ||
+                                 memcmp(oldText, newText, newLength) != 0;
+            if (!changed && !isLast) continue;
+
+            buffer_append_goto_row(&g_Output, line + 1);
+            buffer_append(&g_Output, newText, newLength);
+            if (!isLast) buffer_append_str(&g_Output, ANSI_CLEAR_EOL);
+        }
+        /* Drop stale frame rows, prompts and messages below the new frame. */
+        buffer_append_str(&g_Output, ANSI_CLEAR_BELOW);
+    }
+
+    write_all(g_Output.data, g_Output.length);
+
+    /* Keep this frame as the diff base for the next one. */
+    g_Previous.length = 0;
+    buffer_append(&g_Previous, g_Frame.data, g_Frame.length);
+    g_PreviousValid = (g_Previous.data != NULL) && g_PartialRedraw;
+}
+
+void render_clear(void)
+{
+    render_init();
+    g_PreviousValid = false;
+
+    if (g_AnsiEnabled) {
+        static const char clearAll[] = ANSI_HOME_CLEAR ANSI_CLEAR_SCROLL;
+        write_all(clearAll, sizeof(clearAll) - 1);
+    }
+#ifdef _WIN32
+    else if (g_IsTerminal) {
+        fflush(stdout);
+        console_clear();   /* legacy console without VT support */
+    }
+#endif
+}
+
+void render_invalidate(void)
+{
+    g_PreviousValid = false;
+}
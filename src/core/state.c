@@ -0,0 +1,121 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Seqlock snapshot + atomic counters for the global state (see state.h).
+ *
+ * Responsibilities:
+ *   - Store the published snapshot as an array of atomic words, so a reader
+ *     racing a publish sees torn *data* (detected by the sequence check and
+ *     retried) but never performs a C11 data race.
+ *   - Serialize publishers with a mutex; readers stay lock-free.
+ *   - Derive play time from the monotonic clock.
+ */
+
+#include "state.h"
+#include "platform.h"
+
+#include <stdatomic.h>
+
+/* ------------------------------------------------------------------------- */
+/* File-scope state                                                          */
+/* ------------------------------------------------------------------------- */
+
+#define STATE_WORDS  ((sizeof(StateSnapshot) + sizeof(uint64_t) - 1) / sizeof(uint64_t))
+
+/* Word view of a snapshot, so it can be copied word by word. */
+typedef union {
+    StateSnapshot snapshot;
+    uint64_t      words[STATE_WORDS];
+} StateWords;
+
+static _Atomic uint32_t           g_Sequence = 0;          /* odd while publishing */
+static _Atomic uint64_t           g_Words[STATE_WORDS];
+static _Atomic int64_t            g_PlaytimeOriginMs = 0;  /* now_ms at zero play time */
+
+static PlatformMutex g_PublishLock;
+static bool          g_PublishLockReady = false;   /* first publish is on the main thread */
+
+/* ------------------------------------------------------------------------- */
+/* Internal helpers                                                          */
+/* ------------------------------------------------------------------------- */
+
+static void ensure_publish_lock(void)
+{
+    if (g_PublishLockReady) return;
+    platform_mutex_init(&g_PublishLock);
+    g_PublishLockReady = true;
+}
+
+/** Write the atomic play time back into the h/m/s fields of playerData. */
+static void fold_playtime(void)
+{
+    const unsigned long long total = state_playtime_seconds();
+    playerData.time_played_hours   = (int)(total / 3600ULL);
+    playerData.time_played_minutes = (int)((total / 60ULL) % 60ULL);
+    playerData.time_played_seconds = (int)(total % 60ULL);
+}
+
+/* ------------------------------------------------------------------------- */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------- */
+
+void state_publish(void)
+{
+    ensure_publish_lock();
+    platform_mutex_lock(&g_PublishLock);
+
+    fold_playtime();
+
+    StateWords source;
+    memset(&source, 0, sizeof(source));
+    source.snapshot.player = playerData;
+    source.snapshot.config = config;
+
+    const uint32_t sequence = atomic_load_explicit(&g_Sequence, memory_order_relaxed);
+    atomic_store_explicit(&g_Sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    for (size_t i = 0; i < STATE_WORDS; ++i) {
+        atomic_store_explicit(&g_Words[i], source.words[i], memory_order_relaxed);
+    }
+
+    atomic_store_explicit(&g_Sequence, sequence + 2, memory_order_release);
+
+    platform_mutex_unlock(&g_PublishLock);
+}
+
+void state_snapshot(StateSnapshot *out)
+{
+    if (!out) return;
+
+    StateWords copy;
+    uint32_t   before = 0, after = 0;
+
+    do {
+        before = atomic_load_explicit(&g_Sequence, memory_order_acquire);
+        if (before & 1u) continue;   /* publish in progress */
+
+        for (size_t i = 0; i < STATE_WORDS; ++i) {
+            copy.words[i] = atomic_load_explicit(&g_Words[i], memory_order_relaxed);
+        }
+
+        atomic_thread_fence(memory_order_acquire);
+        after = atomic_load_explicit(&g_Sequence, memory_order_relaxed);
+    } while ((before & 1u) || before != after);
+
+    *out = copy.snapshot;
+}
+
+unsigned long long state_playtime_seconds(void)
+{
+    const int64_t origin  = atomic_load_explicit(&g_PlaytimeOriginMs, memory_order_relaxed);
+    const int64_t elapsed = (int64_t)platform_now_ms() - origin;
+    return (elapsed > 0) ? (unsigned long long)elapsed / 1000ULL : 0ULL;
+}
+
+void state_playtime_set(unsigned long long seconds)
+{
+    const int64_t origin = (int64_t)platform_now_ms() - (int64_t)(seconds * 1000ULL);
+    atomic_store_explicit(&g_PlaytimeOriginMs, origin, memory_order_relaxed);
+}
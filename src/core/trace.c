@@ -0,0 +1,384 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Trace recording and export (see trace.h).
+ *
+ * Responsibilities:
+ *   - Give each thread its own fixed-size ring of begin/end events, so
+ *     recording never takes a lock.
+ *   - Export the rings as Chrome trace JSON or as folded stacks.
+ *
+ * Export runs at exit on the main thread. Other threads are expected to be
+ * idle by then (the persistence writer is flushed first); an event written
+ * during export may be torn, which only costs that one sample.
+ */
+
+#ifndef _WIN32
+  #define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "trace.h"
+
+#include <stdio.h>
+
+#ifndef CARDSIM_TRACE
+
+/* ------------------------------------------------------------------------- */
+/* Tracing compiled out                                                      */
+/* ------------------------------------------------------------------------- */
+
+bool trace_available(void) { return false; }
+
+bool trace_start(const char *path)
+{
+    (void)path;
+    return false;
+}
+
+bool trace_export(const char *path)
+{
+    (void)path;
+    return false;
+}
+
+#else /* CARDSIM_TRACE */
+
+#include "platform.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_RING_EVENTS   (1u << 17)     /* per thread, power of two */
+#define TRACE_MAX_THREADS   64
+#define TRACE_MAX_DEPTH     1024
+#define TRACE_PATH_MAX      (64 * 1024)
+
+/* ------------------------------------------------------------------------- */
+/* Types                                                                     */
+/* ------------------------------------------------------------------------- */
+
+/* One event; name == NULL marks an end. */
+typedef struct {
+    uint64_t    ns;
+    const char *name;
+} TraceEvent;
+
+typedef struct {
+    int              tid;
+    _Atomic uint64_t written;              /* total events ever written */
+    TraceEvent       events[TRACE_RING_EVENTS];
+} TraceRing;
+
+/* Open frame while replaying one thread. */
+typedef struct {
+    const char *name;
+    uint64_t    startNs;
+    uint64_t    childNs;
+    size_t      pathLength;                 /* folded path length before push */
+} TraceFrame;
+
+/* Folded-stack accumulator (open addressing, keyed by the full path). */
+typedef struct {
+    char     *path;
+    uint64_t  selfNs;
+} FoldedEntry;
+
+typedef struct {
+    FoldedEntry *entries;
+    size_t       capacity;
+    size_t       count;
+} FoldedTable;
+
+/* ------------------------------------------------------------------------- */
+/* File-scope state                                                          */
+/* ------------------------------------------------------------------------- */
+
+static _Atomic bool        g_Enabled = false;
+static bool                g_Started = false;      /* trace_start ran (lock ready) */
+static char                g_ExportPath[512];
+
+static PlatformMutex       g_Lock;                 /* guards g_Rings/g_RingCount */
+static TraceRing          *g_Rings[TRACE_MAX_THREADS];
+static int                 g_RingCount = 0;
+
+static _Thread_local TraceRing *t_Ring    = NULL;
+static _Thread_local bool       t_NoRing  = false; /* registry was full */
+
+/* ------------------------------------------------------------------------- */
+/* Recording                                                                 */
+/* ------------------------------------------------------------------------- */
+
+static TraceRing *thread_ring(void)
+{
+    if (t_Ring || t_NoRing) return t_Ring;
+
+    TraceRing *ring = calloc(1, sizeof(*ring));
+    if (!ring) { t_NoRing = true; return NULL; }
+
+    platform_mutex_lock(&g_Lock);
+    if (g_RingCount < TRACE_MAX_THREADS) {
+        ring->tid = g_RingCount + 1;
+        g_Rings[g_RingCount++] = ring;
+    } else {
+        free(ring);
+        ring = NULL;
+    }
+    platform_mutex_unlock(&g_Lock);
+
+    t_Ring   = ring;
+    t_NoRing = (ring == NULL);
+    return ring;
+}
+
+static void record(const char *name)
+{
+    if (!atomic_load_explicit(&g_Enabled, memory_order_relaxed)) return;
+
+    TraceRing *ring = thread_ring();
+    if (!ring) return;
+
+    const uint64_t slot = atomic_load_explicit(&ring->written, memory_order_relaxed);
+    TraceEvent    *event = &ring->events[slot & (TRACE_RING_EVENTS - 1)];
+    event->ns   = platform_now_ns();
+    event->name = name;
+    atomic_store_explicit(&ring->written, slot + 1, memory_order_release);
+}
+
+void trace_begin(const char *name) { record(name ? name : "?"); }
+void trace_end(void)               { record(NULL); }
+
+/* ------------------------------------------------------------------------- */
+/* Export helpers                                                            */
+/* ------------------------------------------------------------------------- */
+
+/** Oldest retained event index and one-past-newest for a ring. */
+static void ring_window(TraceRing *ring, uint64_t *first, uint64_t *end)
+{
+    *end   = atomic_load_explicit(&ring->written, memory_order_acquire);
+    *first = (*end > TRACE_RING_EVENTS) ? *end - TRACE_RING_EVENTS : 0;
+}
+
+static uint64_t earliest_ns(void)
+{
+    uint64_t earliest = UINT64_MAX;
+    for (int r = 0; r < g_RingCount; ++r) {
+        uint64_t first, end;
+        ring_window(g_Rings[r], &first, &end);
+        if (first < end) {
+            const uint64_t ns = g_Rings[r]->events[first & (TRACE_RING_EVENTS - 1)].ns;
+            if (ns < earliest) earliest = ns;
+        }
+    }
+    return (earliest == UINT64_MAX) ? 0 : earliest;
+}
+
+static void write_json_string(FILE *fp, const char *text)
+{
+    fputc('"', fp);
+    for (const char *c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') fputc('\\', fp);
+        if ((unsigned char)*c >= 0x20) fputc(*c, fp);
+    }
+    fputc('"', fp);
+}
+
+static bool export_chrome(FILE *fp)
+{
+    const uint64_t origin = earliest_ns();
+    bool first = true;
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", fp);
+
+    for (int r = 0; r < g_RingCount; ++r) {
+        TraceRing *ring = g_Rings[r];
+        uint64_t   begin, end;
+        ring_window(ring, &begin, &end);
+
+        int depth = 0;
+        for (uint64_t i = begin; i < end; ++i) {
+            const TraceEvent *event = &ring->events[i & (TRACE_RING_EVENTS - 1)];
+
+            /* Ends whose begin was overwritten by the ring are dropped. */
+            if (!event->name && depth == 0) continue;
+            depth += event->name ? 1 : -1;
+
+            fprintf(fp, "%s{\"ph\":\"%c\",\"pid\":1,\"tid\":%d,\"ts\":%.3f",
+                    first ? "" : ",\n", event->name ? 'B' : 'E', ring->tid,
+                    (double)(event->ns - origin) / 1000.0);
+            if (event->name) {
+                fputs(",\"name\":", fp);
+                write_json_string(fp, event->name);
+            }
+            fputc('}', fp);
+            first = false;
+        }
+    }
+
+    fputs("\n]}\n", fp);
+    return !ferror(fp);
+}
+
+static uint64_t hash_path(const char *path)
+{
+    uint64_t hash = 1469598103934665603ULL;              /* FNV-1a */
+    for (const char *c = path; *c; ++c) {
+        hash ^= (unsigned char)*c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static bool folded_grow(FoldedTable *table)
+{
+    const size_t capacity = table->capacity ? table->capacity * 2 : 1024;
+    FoldedEntry *entries  = calloc(capacity, sizeof(*entries));
+    if (!entries) return false;
+
+    for (size_t i = 0; i < table->capacity; ++i) {
+        if (!table->entries[i].path) continue;
+        size_t slot = hash_path(table->entries[i].path) & (capacity - 1);
+        while (entries[slot].path) slot = (slot + 1) & (capacity - 1);
+        entries[slot] = table->entries[i];
+    }
+
+    free(table->entries);
+    table->entries  = entries;
+    table->capacity = capacity;
+    return true;
+}
+
+static void folded_add(FoldedTable *table, const char *path, uint64_t selfNs)
+{
+    if ((table->count + 1) * 2 > table->capacity && !folded_grow(table)) return;
+
+    size_t slot = hash_path(path) & (table->capacity - 1);
+    while (table->entries[slot].path && strcmp(table->entries[slot].path, path) != 0) {
+        slot = (slot + 1) & (table->capacity - 1);
+    }
+
+    if (!table->entries[slot].path) {
+        const size_t length = strlen(path) + 1;
+        char *copy = malloc(length);
+        if (!copy) return;
+        memcpy(copy, path, length);
+        table->entries[slot].path = copy;
+        table->count++;
+    }
+    table->entries[slot].selfNs += selfNs;
+}
+
+/** Close the innermost frame at `ns` and charge its self time. */
+static void fold_pop(FoldedTable *table, TraceFrame *stack, int *depth, char *path, uint64_t ns)
+{
+    TraceFrame *frame = &stack[--*depth];
+    const uint64_t total = (ns > frame->startNs) ? ns - frame->startNs : 0;
+
+    folded_add(table, path, (total > frame->childNs) ? total - frame->childNs : 0);
+    if (*depth > 0) stack[*depth - 1].childNs += total;
+    path[frame->pathLength] = '\0';
+}
+
+static bool export_folded(FILE *fp)
+{
+    FoldedTable table   = { 0 };
+    TraceFrame *stack   = malloc(sizeof(TraceFrame) * TRACE_MAX_DEPTH);
+    char       *path    = malloc(TRACE_PATH_MAX);
+    if (!stack || !path) { free(stack); free(path); return false; }
+
+    const uint64_t now = platform_now_ns();
+
+    for (int r = 0; r < g_RingCount; ++r) {
+        TraceRing *ring = g_Rings[r];
+        uint64_t   begin, end;
+        ring_window(ring, &begin, &end);
+
+        int depth    = 0;
+        int overflow = 0;          /* frames deeper than TRACE_MAX_DEPTH */
+        snprintf(path, TRACE_PATH_MAX, "thread-%d", ring->tid);
+
+        for (uint64_t i = begin; i < end; ++i) {
+            const TraceEvent *event = &ring->events[i & (TRACE_RING_EVENTS - 1)];
+
+            if (!event->name) {
+                if (overflow > 0)   { --overflow; continue; }
+                if (depth == 0)     continue;               /* begin lost to wrap */
+                fold_pop(&table, stack, &depth, path, event->ns);
+                continue;
+            }
+
+            const size_t length = strlen(path);
+            const size_t extra  = strlen(event->name) + 1;
+            if (depth == TRACE_MAX_DEPTH || length + extra >= TRACE_PATH_MAX) { ++overflow; continue; }
+
+            stack[depth++] = (TraceFrame){ event->name, event->ns, 0, length };
+            path[length] = ';';
+            memcpy(path + length + 1, event->name, extra);
+        }
+
+        /* Frames still open at export (e.g. the menu loop) end now. */
+        while (depth > 0) fold_pop(&table, stack, &depth, path, now);
+    }
+
+    for (size_t i = 0; i < table.capacity; ++i) {
+        FoldedEntry *entry = &table.entries[i];
+        if (!entry->path) continue;
+        const uint64_t micros = entry->selfNs / 1000ULL;
+        if (micros > 0) fprintf(fp, "%s %llu\n", entry->path, (unsigned long long)micros);
+        free(entry->path);
+    }
+
+    free(table.entries);
+    free(stack);
+    free(path);
+    return !ferror(fp);
+}
+
+static void export_at_exit(void)
+{
+    atomic_store_explicit(&g_Enabled, false, memory_order_relaxed);
+    if (!trace_export(g_ExportPath)) {
+        fprintf(stderr, "Could not write trace to %s\n", g_ExportPath);
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------- */
+
+bool trace_available(void) { return true; }
+
+bool trace_start(const char *path)
+{
+    if (!path || !*path || strlen(path) >= sizeof(g_ExportPath)) return false;
+    if (g_Started) return true;
+
+    snprintf(g_ExportPath, sizeof(g_ExportPath), "%s", path);
+    platform_mutex_init(&g_Lock);
+    atexit(export_at_exit);
+
+    g_Started = true;
+    atomic_store(&g_Enabled, true);
+    return true;
+}
+
+bool trace_export(const char *path)
+{
+    if (!path || !g_Started) return false;
+
+    FILE *fp = fopen(path, "w");
+    if (!fp) return false;
+
+    const size_t length = strlen(path);
+    const bool   json   = length >= 5 && strcmp(path + length - 5, ".json") == 0;
+
+    platform_mutex_lock(&g_Lock);
+    const bool ok = json ? export_chrome(fp) : export_folded(fp);
+    platform_mutex_unlock(&g_Lock);
+
+    return (fclose(fp) == 0) && ok;
+}
+
+#endif /* CARDSIM_TRACE */
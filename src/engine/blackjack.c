@@ -0,0 +1,325 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * libcardsim: Blackjack shoe, hand rules and round engine (see cardsim.h).
+ *
+ * Responsibilities:
+ *   - Multi-deck shoe: build, shuffle, cut-card reshuffle, deal.
+ *   - Hand evaluation (soft Aces), naturals, pairs, the dealer policy.
+ *   - Settlement and net payouts.
+ *   - CsBlackjackTable: a headless round (deal -> decisions -> dealer ->
+ *     settle) with the same rules as the terminal game, minus insurance.
+ *     Every settled hand goes to the table's stats sink.
+ */
+
+#include "cardsim.h"
+
+#include <string.h>
+
+/* ------------------------------------------------------------------------- */
+/* Shoe                                                                      */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * cs_shoe_build
+ * Fill the shoe with N concatenated decks (each via cs_deck_init()).
+ */
+void cs_shoe_build(Shoe *shoe, int decks)
+{
+    if (decks < 1)              decks = 1;
+    if (decks > MAX_SHOE_DECKS) decks = MAX_SHOE_DECKS;
+
+    shoe->decks_in_shoe = decks;
+    shoe->total         = decks * DECK_SIZE;
+    shoe->next_index    = 0;
+
+    for (int d = 0; d < decks; ++d) {
+        cs_deck_init(&shoe->cards[d * DECK_SIZE]);
+    }
+}
+
+void cs_shoe_shuffle(Shoe *shoe, CsRng *rng)
+{
+    cs_deck_shuffle(shoe->cards, shoe->total, rng);
+    shoe->next_index = 0;
+}
+
+int cs_shoe_remaining(const Shoe *shoe)
+{
+    return (shoe->total >= shoe->next_index) ? (shoe->total - shoe->next_index) : 0;
+}
+
+/**
+ * cs_shoe_needs_reshuffle
+ * The cut card sits CUT_CARD_PENETRATION_PERCENT (clamped 50..95) into the
+ * shoe; reaching it, or running short of `needed`, calls for a new shoe.
+ */
+bool cs_shoe_needs_reshuffle(const Shoe *shoe, int needed)
+{
+    int pct = CUT_CARD_PENETRATION_PERCENT;
+    if (pct < 50) pct = 50;           /* sanity clamp to sensible range */
+    if (pct > 95) pct = 95;
+
+    const int cut_index = (shoe->total * pct) / 100;       /* cards dealt */
+
+    return cs_shoe_remaining(shoe) < needed || shoe->next_index >= cut_index;
+}
+
+bool cs_shoe_deal(Shoe *shoe, CsRng *rng, Hand *hand)
+{
+    if (hand->count >= CS_HAND_MAX_CARDS) return false;
+
+    if (cs_shoe_needs_reshuffle(shoe, 1)) {
+        cs_shoe_build(shoe, shoe->decks_in_shoe);
+        cs_shoe_shuffle(shoe, rng);
+    }
+
+    hand->cards[hand->count++] = shoe->cards[shoe->next_index++];
+    return true;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Hands                                                                     */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * cs_hand_value
+ * Sum hand value with proper Ace adjustment (11 -> 1 as needed).
+ */
+int cs_hand_value(const Hand *hand)
+{
+    int total = 0, aces = 0;
+
+    for (int i = 0; i < hand->count; ++i)
+    {
+        const int value = cs_card_blackjack_value(&hand->cards[i]);
+        total += value;
+        if (value == 11) aces++;
+    }
+
+    while (total > 21 && aces > 0) {
+        total -= 10; /* count one Ace as 1 instead of 11 */
+        aces--;
+    }
+
+    return total;
+}
+
+bool cs_hand_is_blackjack(const Hand *hand)
+{
+    return hand->count == 2 && cs_hand_value(hand) == 21;
+}
+
+bool cs_hand_is_pair(const Hand *hand)
+{
+    return hand->count == 2 && cs_card_same_rank(&hand->cards[0], &hand->cards[1]);
+}
+
+bool cs_dealer_should_hit(const Hand *dealer)
+{
+    return cs_hand_value(dealer) < 17;
+}
+
+CsHandResult cs_hand_settle(const Hand *player, int dealerValue)
+{
+    const int playerValue = cs_hand_value(player);
+
+    if (playerValue > 21)                               return CS_HAND_BUST;
+    if (dealerValue > 21 || playerValue > dealerValue)  return CS_HAND_WIN;
+    if (playerValue < dealerValue)                      return CS_HAND_LOSS;
+    return CS_HAND_PUSH;
+}
+
+int64_t cs_hand_payout(CsHandResult result, unsigned int bet)
+{
+    switch (result)
+    {
+        case CS_HAND_WIN:        return (int64_t)bet;
+        case CS_HAND_BLACKJACK:  return (int64_t)bet * 3 / 2;
+        case CS_HAND_LOSS:
+        case CS_HAND_BUST:       return -(int64_t)bet;
+        case CS_HAND_SURRENDER:  return -(int64_t)(bet - bet / 2);
+        default:                 return 0;
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* Round engine                                                              */
+/* ------------------------------------------------------------------------- */
+
+static void table_deal(CsBlackjackTable *table, Hand *hand)
+{
+    (void)cs_shoe_deal(&table->shoe, &table->rng, hand);
+}
+
+/* Report hand `index` (already settled) to the table's sink. */
+static void table_report(CsBlackjackTable *table, int index, uint16_t flags)
+{
+    const Hand        *hand   = &table->hands[index];
+    const CsHandResult result = table->results[index];
+
+    if (hand->doubled)              flags |= CS_ROUND_DOUBLE;
+    if (hand->fromSplit)            flags |= CS_ROUND_SPLIT;
+    if (hand->surrendered)          flags |= CS_ROUND_SURRENDER;
+    if (result == CS_HAND_BUST)     flags |= CS_ROUND_BUST;
+
+    const CsRoundResult record = {
+        .game    = CS_GAME_BLACKJACK,
+        .outcome = (result == CS_HAND_WIN || result == CS_HAND_BLACKJACK) ? CS_OUTCOME_WIN
+                 : (result == CS_HAND_PUSH)                               ? CS_OUTCOME_PUSH
+                 :                                                          CS_OUTCOME_LOSS,
+        .flags   = flags,
+        .bet     = hand->bet,
+        .net     = cs_hand_payout(result, hand->bet),
+    };
+    cs_stats_emit(&table->stats, &record);
+}
+
+/* Dealer draws (unless every hand is already settled), then settle the rest. */
+static void table_finish(CsBlackjackTable *table)
+{
+    bool dealerNeeded = false;
+    for (int i = 0; i < table->handCount; ++i) {
+        const Hand *hand = &table->hands[i];
+        if (!hand->surrendered && cs_hand_value(hand) <= 21) dealerNeeded = true;
+    }
+
+    if (dealerNeeded) {
+        while (cs_dealer_should_hit(&table->dealer)) table_deal(table, &table->dealer);
+    }
+
+    const int dealerValue = cs_hand_value(&table->dealer);
+
+    table->net = 0;
+    for (int i = 0; i < table->handCount; ++i) {
+        Hand *hand = &table->hands[i];
+        if (table->results[i] == CS_HAND_PENDING) {
+            table->results[i] = cs_hand_settle(hand, dealerValue);
+        }
+        table->net += cs_hand_payout(table->results[i], hand->bet);
+        table_report(table, i, 0);
+    }
+    table->active = table->handCount;
+}
+
+/* Move past the active hand; the round settles after the last one. */
+static void table_next_hand(CsBlackjackTable *table)
+{
+    if (++table->active >= table->handCount) table_finish(table);
+}
+
+void cs_blackjack_init(CsBlackjackTable *table, int decks, uint64_t seed, const CsStatsSink *stats)
+{
+    memset(table, 0, sizeof(*table));
+    cs_rng_seed(&table->rng, seed);
+    if (stats) table->stats = *stats;
+    cs_shoe_build(&table->shoe, decks);
+    cs_shoe_shuffle(&table->shoe, &table->rng);
+}
+
+/**
+ * cs_blackjack_deal
+ * Deal P, D, P, D from a shoe with at least 10 cards before the cut. A
+ * dealer natural beats anything but a player natural (push); a lone player
+ * natural pays 3:2.
+ */
+void cs_blackjack_deal(CsBlackjackTable *table, unsigned int bet)
+{
+    if (cs_shoe_needs_reshuffle(&table->shoe, 10)) {
+        cs_shoe_build(&table->shoe, table->shoe.decks_in_shoe);
+        cs_shoe_shuffle(&table->shoe, &table->rng);
+    }
+
+    memset(&table->dealer, 0, sizeof(table->dealer));
+    memset(table->hands, 0, sizeof(table->hands));
+    table->results[0] = table->results[1] = CS_HAND_PENDING;
+    table->hands[0].bet = bet;
+    table->handCount    = 1;
+    table->active       = 0;
+    table->net          = 0;
+
+    table_deal(table, &table->hands[0]);
+    table_deal(table, &table->dealer);
+    table_deal(table, &table->hands[0]);
+    table_deal(table, &table->dealer);
+
+    const bool dealerNatural = cs_hand_is_blackjack(&table->dealer);
+    const bool playerNatural = cs_hand_is_blackjack(&table->hands[0]);
+
+    if (dealerNatural || playerNatural) {
+        table->results[0] = playerNatural ? (dealerNatural ? CS_HAND_PUSH : CS_HAND_BLACKJACK)
+                                          : CS_HAND_LOSS;
+        table->net    = cs_hand_payout(table->results[0], bet);
+        table->active = table->handCount;
+        table_report(table, 0, playerNatural ? CS_ROUND_NATURAL : 0);
+    }
+}
+
+bool cs_blackjack_can(const CsBlackjackTable *table, CsBlackjackAction action)
+{
+    if (cs_blackjack_round_over(table)) return false;
+
+    const Hand *hand          = &table->hands[table->active];
+    const bool  firstDecision = (hand->count == 2);   /* split hands get a second card first */
+
+    switch (action)
+    {
+        case CS_BJ_HIT:
+        case CS_BJ_STAND:      return true;
+        case CS_BJ_DOUBLE:     return firstDecision;
+        case CS_BJ_SPLIT:      return table->handCount == 1 && cs_hand_is_pair(hand);
+        case CS_BJ_SURRENDER:  return firstDecision && !hand->fromSplit;
+        default:               return false;
+    }
+}
+
+bool cs_blackjack_act(CsBlackjackTable *table, CsBlackjackAction action)
+{
+    if (!cs_blackjack_can(table, action)) return false;
+
+    Hand *hand = &table->hands[table->active];
+
+    switch (action)
+    {
+        case CS_BJ_HIT:
+            table_deal(table, hand);
+            if (cs_hand_value(hand) > 21) table_next_hand(table);
+            break;
+
+        case CS_BJ_STAND:
+            table_next_hand(table);
+            break;
+
+        case CS_BJ_DOUBLE:
+            hand->bet    *= 2;
+            hand->doubled = true;
+            table_deal(table, hand);
+            table_next_hand(table);
+            break;
+
+        case CS_BJ_SPLIT:
+        {
+            Hand *second = &table->hands[1];
+            second->cards[0]  = hand->cards[1];
+            second->count     = 1;
+            second->bet       = hand->bet;
+            second->fromSplit = 1;
+
+            hand->count     = 1;
+            hand->fromSplit = 1;
+
+            table_deal(table, hand);
+            table_deal(table, second);
+            table->handCount = 2;
+            break;
+        }
+
+        case CS_BJ_SURRENDER:
+            hand->surrendered               = 1;
+            table->results[table->active]   = CS_HAND_SURRENDER;
+            table_next_hand(table);
+            break;
+    }
+    return true;
+}
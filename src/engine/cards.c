@@ -0,0 +1,166 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * libcardsim: random streams and decks (see cardsim.h).
+ *
+ * Responsibilities:
+ *   - CsRng: splitmix64 stream + unbiased bounded draws.
+ *   - 52-card deck construction and Fisher–Yates shuffling.
+ *   - The rank/suit string tables every engine card points into, and the
+ *     compact card ids built on them.
+ *   - cs_card_info: per-id values for every game, so rules never parse
+ *     rank strings.
+ */
+
+#include "cardsim.h"
+
+#include <string.h>
+
+/* ------------------------------------------------------------------------- */
+/* Local tables (rank/suit strings)                                          */
+/* ------------------------------------------------------------------------- */
+
+static const char *suits[NUM_SUITS] = {"Hearts", "Diamonds", "Clubs", "Spades"};
+static const char *ranks[NUM_RANKS] = {"2","3","4","5","6","7","8","9","10","Jack","Queen","King","Ace"};
+
+/* ------------------------------------------------------------------------- */
+/* Card metadata                                                             */
+/* ------------------------------------------------------------------------- */
+
+/* One suit's 13 rows, 2..Ace. Blackjack counts faces as 10 and the Ace
+   soft; Idiot ranks the Ace high; Klondike ranks it low. */
+#define SUIT_ROWS(s, red, suitName)                               \
+    { s,  0,  2,  2,  2, red, "2 of "     suitName },             \
+    { s,  1,  3,  3,  3, red, "3 of "     suitName },             \
+    { s,  2,  4,  4,  4, red, "4 of "     suitName },             \
+    { s,  3,  5,  5,  5, red, "5 of "     suitName },             \
+    { s,  4,  6,  6,  6, red, "6 of "     suitName },             \
+    { s,  5,  7,  7,  7, red, "7 of "     suitName },             \
+    { s,  6,  8,  8,  8, red, "8 of "     suitName },             \
+    { s,  7,  9,  9,  9, red, "9 of "     suitName },             \
+    { s,  8, 10, 10, 10, red, "10 of "    suitName },             \
+    { s,  9, 10, 11, 11, red, "Jack of "  suitName },             \
+    { s, 10, 10, 12, 12, red, "Queen of " suitName },             \
+    { s, 11, 10, 13, 13, red, "King of "  suitName },             \
+    { s, 12, 11, 14,  1, red, "Ace of "   suitName }
+
+const CsCardInfo cs_card_info[CS_CARD_COUNT + 1] = {
+    SUIT_ROWS(0, true,  "Hearts"),
+    SUIT_ROWS(1, true,  "Diamonds"),
+    SUIT_ROWS(2, false, "Clubs"),
+    SUIT_ROWS(3, false, "Spades"),
+    { NUM_SUITS, NUM_RANKS,     0, 3, 0, false, "Joker" },   /* CS_CARD_JOKER */
+    { NUM_SUITS, NUM_RANKS + 1, 0, 0, 0, false, NULL    },   /* unknown card  */
+};
+
+#undef SUIT_ROWS
+
+/* ------------------------------------------------------------------------- */
+/* Random streams                                                            */
+/* ------------------------------------------------------------------------- */
+
+void cs_rng_seed(CsRng *rng, uint64_t seed)
+{
+    rng->state = seed;
+}
+
+/**
+ * cs_rng_next
+ * splitmix64: a Weyl sequence pushed through a 64-bit finalizer. Every seed
+ * (including 0) gives a full-period stream.
+ */
+uint64_t cs_rng_next(CsRng *rng)
+{
+    uint64_t z = (rng->state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * cs_rng_below
+ * Lemire's multiply-shift: map 32 random bits onto [0, bound) and reject
+ * the few low products that would make some values more likely.
+ */
+uint32_t cs_rng_below(CsRng *rng, uint32_t bound)
+{
+    if (bound == 0) return 0;
+
+    uint64_t product = (cs_rng_next(rng) >> 32) * (uint64_t)bound;
+    uint32_t low     = (uint32_t)product;
+
+    if (low < bound) {
+        const uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold) {
+            product = (cs_rng_next(rng) >> 32) * (uint64_t)bound;
+            low     = (uint32_t)product;
+        }
+    }
+    return (uint32_t)(product >> 32);
+}
+
+/* ------------------------------------------------------------------------- */
+/* Decks                                                                     */
+/* ------------------------------------------------------------------------- */
+
+void cs_deck_init(Card *deck)
+{
+    int cardWriteIndex = 0;
+    for (int suitIndex = 0; suitIndex < NUM_SUITS; ++suitIndex) {
+        for (int rankIndex = 0; rankIndex < NUM_RANKS; ++rankIndex) {
+            deck[cardWriteIndex].suit     = (char*)suits[suitIndex];
+            deck[cardWriteIndex].rank     = (char*)ranks[rankIndex];
+            deck[cardWriteIndex].revealed = 0;
+            deck[cardWriteIndex].is_joker = false;
+            deck[cardWriteIndex].code     = (uint8_t)(cardWriteIndex + 1);
+            ++cardWriteIndex;
+        }
+    }
+}
+
+/* Index of `name` in `table`: pointer match first (cards dealt by the library),
+   then by content. */
+static int table_index(const char *const *table, int size, const char *name)
+{
+    for (int i = 0; i < size; ++i) {
+        if (table[i] == name) return i;
+    }
+    for (int i = 0; i < size; ++i) {
+        if (strcmp(table[i], name) == 0) return i;
+    }
+    return -1;
+}
+
+int cs_card_id(Card card)
+{
+    if (card.code)     return card.code - 1;
+    if (card.is_joker) return CS_CARD_JOKER;
+
+    const int suit = table_index(suits, NUM_SUITS, card.suit);
+    const int rank = table_index(ranks, NUM_RANKS, card.rank);
+    return (suit < 0 || rank < 0) ? -1 : suit * NUM_RANKS + rank;
+}
+
+Card cs_card_from_id(int id)
+{
+    if (id == CS_CARD_JOKER) {
+        return (Card){ .suit = "Joker", .rank = "Joker", .revealed = 0, .is_joker = true,
+                       .code = CS_CARD_JOKER + 1 };
+    }
+    return (Card){ .suit     = (char*)suits[id / NUM_RANKS],
+                   .rank     = (char*)ranks[id % NUM_RANKS],
+                   .revealed = 0,
+                   .is_joker = false,
+                   .code     = (uint8_t)(id + 1) };
+}
+
+void cs_deck_shuffle(Card *cards, int count, CsRng *rng)
+{
+    for (int cardIndex = count - 1; cardIndex > 0; --cardIndex) {
+        const int swapIndex = (int)cs_rng_below(rng, (uint32_t)cardIndex + 1);
+        Card tmp            = cards[cardIndex];
+        cards[cardIndex]    = cards[swapIndex];
+        cards[swapIndex]    = tmp;
+    }
+}
@@ -0,0 +1,1054 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * libcardsim: Idiot rules, AI and game driver (see cardsim.h).
+ *
+ * Responsibilities:
+ *   - Rules: card values, play legality (mirrors through 3s/Jokers), burns,
+ *     drawing up and picking up the pile.
+ *   - Dealing a game from a shuffled deck.
+ *   - The Easy/Normal/Hard AI (Hard includes a greedy look-ahead scorer).
+ *   - CsIdiotGame: games driven one turn at a time, by the AI
+ *     (cs_idiot_step) or by a human's choice (cs_idiot_play).
+ */
+
+#include "cardsim.h"
+#include "trace.h"
+
+#include <string.h>
+
+/* --------------------------------------------------------------------------- */
+/* INTERNAL / FILE-LOCAL DECLARATIONS                                          */
+/* --------------------------------------------------------------------------- */
+
+/* ----- AI utilities ----- */
+static void          lm_reset           (AILastMove *summary);
+static void          lm_record          (AILastMove *summary, Card played);
+static int           duplicates_in_hand (const IdiotPlayer *playerState, const Card *rankCard);
+static int           top_run_length_by_value(const CardPile *pile);
+static int           should_burn_now_with_10(const CardPile *pile, int difficulty);
+static int           count_playable_for_next(const CardPile *pile, const IdiotPlayer *nextPlayer);
+static int           hard_best_followup_index(const IdiotPlayer *aiState, const CardPile *pileAfterTwo);
+static int           hard_score_candidate(const IdiotPlayer *aiState,
+                                          const IdiotPlayer *opponentState,
+                                          const CardPile    *pileState,
+                                          const CardPile    *drawPileState,
+                                          int fromHandZone,
+                                          int indexInZone);
+static Card          take_at            (Card *arr, int *countRef, int index); /* Remove at index, shift left. */
+static int           dump_same_rank_in_hand(IdiotPlayer *aiState, CardPile *pile,
+                                            const Card *rankCard, int capToPlay,
+                                            AILastMove *summary);
+
+/* --------------------------------------------------------------------------- */
+/* CORE RULE HELPERS                                                           */
+/* --------------------------------------------------------------------------- */
+
+/**
+ * cs_idiot_card_value
+ * Card value from the cs_card_info table. Jokers function exactly like a “3”
+ * in Idiot (wild mirror and always playable), so the table gives 3 for Jokers.
+ *
+ * Value order: Ace=14, King=13, Queen=12, Jack=11, 10..2 as integers.
+ */
+int cs_idiot_card_value(const Card *card) {
+    return cs_card_meta(card)->idiotValue;
+}
+
+/** True if the card’s value equals v. */
+bool cs_idiot_card_is(const Card *card, int v) {
+    return cs_idiot_card_value(card) == v;
+}
+
+/** True for Joker, 2, 3, 10 (the “power” cards). */
+bool cs_idiot_is_power_card(const Card *card) {
+    return card->is_joker ||
+           cs_idiot_card_is(card, 2) ||
+           cs_idiot_card_is(card, 3) ||
+           cs_idiot_card_is(card, 10);
+}
+
+/**
+ * cs_idiot_can_play
+ * Enforce Idiot’s placement rules:
+ *  - If next is Joker / 2 / 3 / 10 → always playable.
+ *  - If top is a 3 (or Joker), recursively “mirror” to the last non-3/Joker
+ *    below the run and compare against that card’s value.
+ *  - Otherwise, next must be >= top by value.
+ */
+bool cs_idiot_can_play(const Card *top, const Card *next, const CardPile *wastePile) {
+    /* Power cards are always playable. */
+    if (next->is_joker || cs_idiot_card_is(next, 2) || cs_idiot_card_is(next, 3) || cs_idiot_card_is(next, 10))
+        return 1;
+
+    if (!top) return 1;  /* Empty pile: anything goes. */
+
+    /* Mirror effect: walk down over any chain of 3s/Jokers. */
+    if (top->is_joker || cs_idiot_card_is(top, 3)) {
+        if (wastePile && wastePile->count > 1) {
+            int idx = wastePile->count - 2;
+            while (idx >= 0 &&
+                   (wastePile->pile[idx].is_joker || cs_idiot_card_is(&wastePile->pile[idx], 3))) {
+                --idx;
+            }
+            return (idx >= 0) ? cs_idiot_can_play(&wastePile->pile[idx], next, wastePile) : 1;
+        }
+        return 1;
+    }
+
+    /* Normal restriction: must be >= the top value. */
+    return cs_idiot_card_value(next) >= cs_idiot_card_value(top);
+}
+
+/** Four of a kind on the pile burns it immediately. */
+bool cs_idiot_is_four_of_a_kind(const CardPile *wastePile) {
+    if (wastePile->count < 4) return 0;
+    int topValue = cs_idiot_card_value(&wastePile->pile[wastePile->count - 1]);
+    for (int i = 2; i <= 4; ++i) {
+        if (cs_idiot_card_value(&wastePile->pile[wastePile->count - i]) != topValue)
+            return 0;
+    }
+    return 1;
+}
+
+/** Burn: discard the waste pile entirely. */
+void cs_idiot_burn(CardPile *wastePile) {
+    wastePile->count = 0;
+}
+
+/**
+ * cs_idiot_draw_up
+ * Draw until the hand reaches HAND_SIZE or the draw pile is empty.
+ */
+void cs_idiot_draw_up(IdiotPlayer *playerState, CardPile *drawPile) {
+    while (playerState->handCount < HAND_SIZE && drawPile->count > 0) {
+        playerState->hand[playerState->handCount++] = drawPile->pile[--drawPile->count];
+    }
+}
+
+/**
+ * cs_idiot_sort_hand
+ * Simple O(n^2) sort by card value to present hand in ascending order.
+ */
+void cs_idiot_sort_hand(IdiotPlayer *playerState) {
+    for (int i = 0; i < playerState->handCount - 1; ++i) {
+        for (int j = i + 1; j < playerState->handCount; ++j) {
+            if (cs_idiot_card_value(&playerState->hand[i]) > cs_idiot_card_value(&playerState->hand[j])) {
+                Card tmp               = playerState->hand[i];
+                playerState->hand[i]   = playerState->hand[j];
+                playerState->hand[j]   = tmp;
+            }
+        }
+    }
+}
+
+/**
+ * cs_idiot_pick_up
+ * Move the entire waste pile into the player’s hand (order preserved), then
+ * clear the waste pile and resort the hand for readability.
+ */
+void cs_idiot_pick_up(IdiotPlayer *playerState, CardPile *wastePile) {
+    for (int i = 0; i < wastePile->count; ++i)
+        playerState->hand[playerState->handCount++] = wastePile->pile[i];
+    wastePile->count = 0;
+    cs_idiot_sort_hand(playerState);
+}
+
+/**
+ * cs_idiot_mirrored_card
+ * When the top of the waste is a 3 (or Joker), return the last non-3/Joker
+ * below it that acts as the “lock” being mirrored. Returns NULL if none.
+ */
+Card *cs_idiot_mirrored_card(CardPile *wastePile) {
+    int idx = wastePile->count - 2;
+    while (idx >= 0 &&
+           (wastePile->pile[idx].is_joker || cs_idiot_card_is(&wastePile->pile[idx], 3))) {
+        --idx;
+    }
+    return (idx >= 0) ? &wastePile->pile[idx] : NULL;
+}
+
+/* --------------------------------------------------------------------------- */
+/* DEALING                                                                     */
+/* --------------------------------------------------------------------------- */
+
+void cs_idiot_deal(const Card *deck, IdiotPlayer *first, IdiotPlayer *second, CardPile *drawPile) {
+    /* Face-down. */
+    for (int i = 0; i < FACE_DOWN_SIZE; ++i) {
+        first->faceDown[i]  = deck[i];
+        second->faceDown[i] = deck[i + FACE_DOWN_SIZE];
+    }
+    /* Face-up. */
+    for (int i = 0; i < FACE_UP_SIZE; ++i) {
+        first->faceUp[i]           = deck[i + 2 * FACE_DOWN_SIZE];
+        first->faceUp[i].revealed  = 1;
+        second->faceUp[i]          = deck[i + 2 * FACE_DOWN_SIZE + FACE_UP_SIZE];
+        second->faceUp[i].revealed = 1;
+    }
+    /* Hands. */
+    for (int i = 0; i < HAND_SIZE; ++i) {
+        first->hand[i]  = deck[i + 2 * FACE_DOWN_SIZE + 2 * FACE_UP_SIZE];
+        second->hand[i] = deck[i + 2 * FACE_DOWN_SIZE + 2 * FACE_UP_SIZE + HAND_SIZE];
+    }
+
+    first->handCount      = second->handCount      = HAND_SIZE;
+    first->faceUpCount    = second->faceUpCount    = FACE_UP_SIZE;
+    first->faceDownCount  = second->faceDownCount  = FACE_DOWN_SIZE;
+
+    /* Draw pile: remaining cards. */
+    drawPile->count = 0;
+    for (int i = 2 * (FACE_DOWN_SIZE + FACE_UP_SIZE + HAND_SIZE); i < DECK_SIZE; ++i) {
+        drawPile->pile[drawPile->count++] = deck[i];
+    }
+}
+
+/* --------------------------------------------------------------------------- */
+/* AI UTILITIES                                                                */
+/* --------------------------------------------------------------------------- */
+
+/** Reset the AI turn summary prior to its move. */
+static void lm_reset(AILastMove *summary) {
+    summary->playedCount = 0;
+    summary->burned      = 0;
+    summary->mirrored    = 0;
+    summary->mirroredCard = NULL;
+}
+
+/** Append a played card to the AI turn summary (capped). */
+static void lm_record(AILastMove *summary, Card played) {
+    if (summary->playedCount < LASTMOVE_MAX) {
+        summary->played[summary->playedCount++] = played;
+    }
+}
+
+/** Count duplicates of a rank currently in hand. */
+static int duplicates_in_hand(const IdiotPlayer *playerState, const Card *rankCard) {
+    int count = 0;
+    for (int i = 0; i < playerState->handCount; ++i)
+        if (cs_card_same_rank(&playerState->hand[i], rankCard)) ++count;
+    return count;
+}
+
+/**
+ * top_run_length_by_value
+ * Length (2..4) of the same-valued run ending at the top of the waste pile.
+ */
+static int top_run_length_by_value(const CardPile *pile) {
+    if (pile->count == 0) return 0;
+    int lastValue = cs_idiot_card_value(&pile->pile[pile->count - 1]);
+    int runLength = 1;
+    for (int i = pile->count - 2; i >= 0 && runLength < 4; --i) {
+        if (cs_idiot_card_value(&pile->pile[i]) == lastValue) ++runLength;
+        else break;
+    }
+    return runLength;
+}
+
+/**
+ * should_burn_now_with_10
+ * Conservative “is it worth using a 10 now?” policy:
+ *   - Normal: prefer to burn only when the pile is large (>= 6).
+ *   - Hard:   burn on large piles (>= 6) or when the top run is already 3.
+ */
+static int should_burn_now_with_10(const CardPile *pile, int difficulty) {
+    int runLen = top_run_length_by_value(pile);
+    int size   = pile->count;
+    if (difficulty >= DIFFICULTY_HARD) return (size >= 6) || (runLen >= 3);
+    return (size >= 6);
+}
+
+/**
+ * count_playable_for_next
+ * Rough ply-ahead: “If we pass the turn with this pile, how many replies does
+ * the opponent have?” Counts legal plays from the next player’s current zone.
+ */
+static int count_playable_for_next(const CardPile *pile, const IdiotPlayer *nextPlayer) {
+    const Card *top = (pile->count > 0) ? &pile->pile[pile->count - 1] : NULL;
+    int count = 0;
+
+    if (nextPlayer->handCount > 0) {
+        for (int i = 0; i < nextPlayer->handCount; ++i)
+            if (cs_idiot_can_play(top, &nextPlayer->hand[i], pile)) ++count;
+        return count;
+    }
+
+    if (nextPlayer->faceUpCount > 0) {
+        for (int i = 0; i < nextPlayer->faceUpCount; ++i)
+            if (cs_idiot_can_play(top, &nextPlayer->faceUp[i], pile)) ++count;
+        return count;
+    }
+
+    return (nextPlayer->faceDownCount > 0) ? 1 : 0;  /* At least a blind try. */
+}
+
+/**
+ * hard_best_followup_index
+ * After playing a 2, pick the best immediate follow-up (by simple score).
+ * Returns the HAND index of the chosen card, or -1 if none are playable.
+ */
+static int hard_best_followup_index(const IdiotPlayer *aiState, const CardPile *pileAfterTwo) {
+    int bestIndex = -1;
+    int bestScore = -9999;
+
+    for (int j = 0; j < aiState->handCount; ++j) {
+        const Card *candidate = &aiState->hand[j];
+        if (!cs_idiot_can_play(&pileAfterTwo->pile[pileAfterTwo->count - 1], candidate, pileAfterTwo)) continue;
+
+        int score = 0;
+        if (cs_idiot_card_is(candidate, 10)) score += 40;
+        if (candidate->is_joker || cs_idiot_card_is(candidate, 3)) score += 12;
+
+        if (!candidate->is_joker &&
+            !cs_idiot_card_is(candidate, 2) &&
+            !cs_idiot_card_is(candidate, 3) &&
+            !cs_idiot_card_is(candidate, 10)) {
+            score += 8 * (duplicates_in_hand(aiState, candidate) - 1);
+            if (cs_idiot_card_value(candidate) >= 11) score += 6;
+        }
+
+        if (score > bestScore) { bestScore = score; bestIndex = j; }
+    }
+    return bestIndex;
+}
+
+/**
+ * hard_score_candidate
+ * Simulate one candidate play (either from hand or face-up when hand is empty)
+ * and compute a greedy score that prefers:
+ *   - burning big piles,
+ *   - reducing opponent replies,
+ *   - dumping duplicates,
+ *   - conserving 10s unless valuable,
+ *   - continuing after a 2 with a strong follow-up.
+ *
+ * We clone the involved states by value to keep this function side-effect free.
+ */
+static int hard_score_candidate(const IdiotPlayer *aiState,
+                                const IdiotPlayer *opponentState,
+                                const CardPile    *pileState,
+                                const CardPile    *drawPileState,
+                                int                fromHandZone,   /* 1=hand, 0=face-up */
+                                int                indexInZone)
+{
+    TRACE_SCOPE("hard_score_candidate");
+    (void)drawPileState; /* Not used in this heuristic; draw is handled at play time. */
+
+    IdiotPlayer ai    = *aiState;
+    IdiotPlayer opp   = *opponentState;
+    CardPile    pile  = *pileState;
+
+    Card played = fromHandZone ? ai.hand[indexInZone] : ai.faceUp[indexInZone];
+
+    if (fromHandZone) {
+        for (int j = indexInZone; j < ai.handCount - 1; ++j) ai.hand[j] = ai.hand[j + 1];
+        ai.handCount--;
+    } else {
+        for (int j = indexInZone; j < ai.faceUpCount - 1; ++j) ai.faceUp[j] = ai.faceUp[j + 1];
+        ai.faceUpCount--;
+    }
+
+    pile.pile[pile.count++] = played;
+
+    int burned = 0;
+
+    if (cs_idiot_card_is(&played, 10)) {
+        pile.count = 0;
+        burned     = 1;
+    } else if (cs_idiot_card_is(&played, 2)) {
+        CardPile afterTwo = pile;
+        int idx = hard_best_followup_index(&ai, &afterTwo);
+        if (idx != -1) {
+            Card follow = ai.hand[idx];
+            for (int k = idx; k < ai.handCount - 1; ++k) ai.hand[k] = ai.hand[k + 1];
+            ai.handCount--;
+            afterTwo.pile[afterTwo.count++] = follow;
+
+            if (cs_idiot_card_is(&follow, 10)) {
+                afterTwo.count = 0;
+                burned         = 1;
+            } else if (!follow.is_joker &&
+                       !cs_idiot_card_is(&follow, 2) &&
+                       !cs_idiot_card_is(&follow, 3) &&
+                       !cs_idiot_card_is(&follow, 10)) {
+                int dumped = 0;
+                for (int i = 0; i < ai.handCount && dumped < 3; ) {
+                    if (cs_card_same_rank(&ai.hand[i], &follow)) {
+                        afterTwo.pile[afterTwo.count++] = ai.hand[i];
+                        for (int k = i; k < ai.handCount - 1; ++k) ai.hand[k] = ai.hand[k + 1];
+                        ai.handCount--; dumped++;
+                        if (cs_idiot_is_four_of_a_kind(&afterTwo)) { afterTwo.count = 0; burned = 1; break; }
+                    } else {
+                        ++i;
+                    }
+                }
+            }
+            pile = afterTwo;
+        }
+    } else if (!played.is_joker && !cs_idiot_card_is(&played, 3)) {
+        /* Dump duplicates of a normal card from the same zone. */
+        int dumped = 0;
+        if (fromHandZone) {
+            for (int i = 0; i < ai.handCount && dumped < 3; ) {
+                if (cs_card_same_rank(&ai.hand[i], &played)) {
+                    pile.pile[pile.count++] = ai.hand[i];
+                    for (int k = i; k < ai.handCount - 1; ++k) ai.hand[k] = ai.hand[k + 1];
+                    ai.handCount--; dumped++;
+                    if (cs_idiot_is_four_of_a_kind(&pile)) { pile.count = 0; burned = 1; break; }
+                } else {
+                    ++i;
+                }
+            }
+        } else {
+            for (int i = 0; i < ai.faceUpCount && dumped < 3; ) {
+                if (cs_card_same_rank(&ai.faceUp[i], &played)) {
+                    pile.pile[pile.count++] = ai.faceUp[i];
+                    for (int k = i; k < ai.faceUpCount - 1; ++k) ai.faceUp[k] = ai.faceUp[k + 1];
+                    ai.faceUpCount--; dumped++;
+                    if (cs_idiot_is_four_of_a_kind(&pile)) { pile.count = 0; burned = 1; break; }
+                } else {
+                    ++i;
+                }
+            }
+        }
+    }
+
+    /* Greedy score: fewer replies from opponent is good; burns are great. */
+    int replies = count_playable_for_next(&pile, &opp);
+    int score   = (replies == 0 ? 1000 : -8 * replies) + (burned ? 200 : 0);
+
+    /* Leaving a high lock with no escape in opponent’s hand is a bonus. */
+    if (pile.count > 0 && opp.handCount > 0) {
+        const Card *lock = &pile.pile[pile.count - 1];
+        int oppHasEscape = 0;
+        for (int i = 0; i < opp.handCount; ++i) {
+            const Card *pc = &opp.hand[i];
+            if (pc->is_joker || cs_idiot_card_is(pc, 2) || cs_idiot_card_is(pc, 3) || cs_idiot_card_is(pc, 10)) {
+                oppHasEscape = 1; break;
+            }
+        }
+        if (!oppHasEscape && cs_idiot_card_value(lock) >= 11) score += 30;
+    }
+
+    /* Prefer moves that reduce our total cards. */
+    int ourBefore = aiState->handCount + aiState->faceUpCount + aiState->faceDownCount;
+    int ourAfter  = ai.handCount    + ai.faceUpCount    + ai.faceDownCount;
+    score += (ourBefore - ourAfter) * 6;
+
+    /* Discourage wasting a 10 on tiny piles. */
+    if (cs_idiot_card_is(&played, 10) && pileState->count < 3) score -= 25;
+
+    return score;
+}
+
+/** Remove and return arr[index], shifting the remainder left. */
+static Card take_at(Card *arr, int *countRef, int index) {
+    Card c = arr[index];
+    for (int j = index; j < *countRef - 1; ++j) arr[j] = arr[j + 1];
+    (*countRef)--;
+    return c;
+}
+
+/**
+ * dump_same_rank_in_hand
+ * After seeding a normal card, dump up to capToPlay more of the same rank from
+ * the AI’s hand to accelerate toward a burn. Returns the number added.
+ */
+static int dump_same_rank_in_hand(IdiotPlayer *aiState,
+                                  CardPile    *pile,
+                                  const Card  *rankCard,
+                                  int          capToPlay,
+                                  AILastMove  *summary)
+{
+    int playedExtra = 0;
+    for (int i = 0; i < aiState->handCount && playedExtra < capToPlay; ) {
+        if (cs_card_same_rank(&aiState->hand[i], rankCard)) {
+            pile->pile[pile->count++] = aiState->hand[i];
+            if (summary) lm_record(summary, aiState->hand[i]);
+            for (int j = i; j < aiState->handCount - 1; ++j) aiState->hand[j] = aiState->hand[j + 1];
+            aiState->handCount--; playedExtra++;
+        } else {
+            ++i;
+        }
+    }
+    return playedExtra;
+}
+
+/* --------------------------------------------------------------------------- */
+/* AI TURN DRIVER                                                              */
+/* --------------------------------------------------------------------------- */
+
+/**
+ * cs_idiot_ai_play
+ * Drive a single AI turn according to difficulty:
+ *
+ * EASY:
+ *   - Timid, prioritizes non-power plays, then 3, then 2, then 10.
+ *   - Uses face-up cards only after the hand empties; otherwise picks up.
+ *
+ * NORMAL:
+ *   - If a 2 is available/usable: play it and immediately follow with the
+ *     lowest non-power (or 3, or 10 on large piles), dumping duplicates.
+ *   - Otherwise: lowest non-power (+dump), else 3, else 10 (only if worth it).
+ *   - A 10 that is not worth it still beats picking up when nothing else plays.
+ *
+ * HARD:
+ *   - Greedy look-ahead scoring of all candidates (hand first, then face-up
+ *     only if hand is empty), with bonuses for burns, duplicate dumps, and
+ *     limiting opponent replies. Chains after a 2.
+ *   - Face-down cards are tried blind once the hand and face-up are empty.
+ */
+void cs_idiot_ai_play(IdiotPlayer *aiState,
+                      IdiotPlayer *opponentState,
+                      CardPile    *wastePile,
+                      CardPile    *drawPile,
+                      int          difficulty,
+                      AILastMove  *aiLastTurnSummary)
+{
+    TRACE_SCOPE("cs_idiot_ai_play");
+    Card *topOfWaste = (wastePile->count > 0) ? &wastePile->pile[wastePile->count - 1] : NULL;
+    lm_reset(aiLastTurnSummary);
+
+    /* -------------------- EASY -------------------- */
+    if (difficulty == DIFFICULTY_EASY) {
+        /* 1) Hand: non-power playable */
+        for (int i = 0; i < aiState->handCount; ++i) {
+            if (cs_idiot_is_power_card(&aiState->hand[i])) continue;
+            if (!cs_idiot_can_play(topOfWaste, &aiState->hand[i], wastePile)) continue;
+            Card played = take_at(aiState->hand, &aiState->handCount, i);
+            wastePile->pile[wastePile->count++] = played;
+            lm_record(aiLastTurnSummary, played);
+            cs_idiot_draw_up(aiState, drawPile);
+            if (cs_idiot_card_is(&played, 10)) { aiLastTurnSummary->burned = 1; cs_idiot_burn(wastePile); }
+            if (cs_idiot_card_is(&played, 3))  { aiLastTurnSummary->mirrored = 1; aiLastTurnSummary->mirroredCard = cs_idiot_mirrored_card(wastePile); }
+            return;
+        }
+        /* 2) Hand: 3, then 2, then 10 */
+        for (int i = 0; i < aiState->handCount; ++i) {
+            if (cs_idiot_card_is(&aiState->hand[i], 3) && cs_idiot_can_play(topOfWaste, &aiState->hand[i], wastePile)) {
+                Card played = take_at(aiState->hand, &aiState->handCount, i);
+                wastePile->pile[wastePile->count++] = played;
+                lm_record(aiLastTurnSummary, played);
+                aiLastTurnSummary->mirrored = 1; aiLastTurnSummary->mirroredCard = cs_idiot_mirrored_card(wastePile);
+                cs_idiot_draw_up(aiState, drawPile);
+                return;
+            }
+        }
+        for (int i = 0; i < aiState->handCount; ++i) {
+            if (cs_idiot_card_is(&aiState->hand[i], 2) && cs_idiot_can_play(topOfWaste, &aiState->hand[i], wastePile)) {
+                Card played = take_at(aiState->hand, &aiState->handCount, i);
+                wastePile->pile[wastePile->count++] = played;
+                lm_record(aiLastTurnSummary, played);
+                cs_idiot_draw_up(aiState, drawPile);
+                return; /* main loop grants another turn after a 2 */
+            }
+        }
+        for (int i = 0; i < aiState->handCount; ++i) {
+            if (cs_idiot_card_is(&aiState->hand[i], 10) && cs_idiot_can_play(topOfWaste, &aiState->hand[i], wastePile)) {
+                Card played = take_at(aiState->hand, &aiState->handCount, i);
+                wastePile->pile[wastePile->count++] = played;
+                lm_record(aiLastTurnSummary, played);
+                aiLastTurnSummary->burned = 1; cs_idiot_burn(wastePile);
+                cs_idiot_draw_up(aiState, drawPile);
+                return;
+            }
+        }
+        /* 3) Face-up fallback (same order) when hand is empty */
+        if (aiState->handCount == 0 && aiState->faceUpCount > 0) {
+            for (int i = 0; i < aiState->faceUpCount; ++i) {
+                if (cs_idiot_is_power_card(&aiState->faceUp[i])) continue;
+                if (!cs_idiot_can_play(topOfWaste, &aiState->faceUp[i], wastePile)) continue;
+                Card played = take_at(aiState->faceUp, &aiState->faceUpCount, i);
+                wastePile->pile[wastePile->count++] = played;
+                lm_record(aiLastTurnSummary, played);
+                return;
+            }
+            for (int i = 0; i < aiState->faceUpCount; ++i) {
+                if (cs_idiot_card_is(&aiState->faceUp[i], 3) && cs_idiot_can_play(topOfWaste, &aiState->faceUp[i], wastePile)) {
+                    Card played = take_at(aiState->faceUp, &aiState->faceUpCount, i);
+                    wastePile->pile[wastePile->count++] = played;
+                    lm_record(aiLastTurnSummary, played);
+                    aiLastTurnSummary->mirrored = 1; aiLastTurnSummary->mirroredCard = cs_idiot_mirrored_card(wastePile);
+                    return;
+                }
+            }
+            for (int i = 0; i < aiState->faceUpCount; ++i) {
+                if (cs_idiot_card_is(&aiState->faceUp[i], 2) && cs_idiot_can_play(topOfWaste, &aiState->faceUp[i], wastePile)) {
+                    Card played = take_at(aiState->faceUp, &aiState->faceUpCount, i);
+                    wastePile->pile[wastePile->count++] = played;
+                    lm_record(aiLastTurnSummary, played);
+                    return;
+                }
+            }
+            for (int i = 0; i < aiState->faceUpCount; ++i) {
+                if (cs_idiot_card_is(&aiState->faceUp[i], 10) && cs_idiot_can_play(topOfWaste, &aiState->faceUp[i], wastePile)) {
+                    Card played = take_at(aiState->faceUp, &aiState->faceUpCount, i);
+                    wastePile->pile[wastePile->count++] = played;
+                    lm_record(aiLastTurnSummary, played);
+                    aiLastTurnSummary->burned = 1; cs_idiot_burn(wastePile);
+                    return;
+                }
+            }
+        }
+        /* 4) Face-down phase (blind try), else pick up */
+        if (aiState->handCount == 0 && aiState->faceUpCount == 0 && aiState->faceDownCount > 0) {
+            Card blind = take_at(aiState->faceDown, &aiState->faceDownCount, 0);
+            if (cs_idiot_can_play(topOfWaste, &blind, wastePile)) {
+                wastePile->pile[wastePile->count++] = blind;
+                lm_record(aiLastTurnSummary, blind);
+                if (cs_idiot_card_is(&blind, 10) || cs_idiot_is_four_of_a_kind(wastePile)) { aiLastTurnSummary->burned = 1; cs_idiot_burn(wastePile); }
+                if (cs_idiot_card_is(&blind, 3)) { aiLastTurnSummary->mirrored = 1; aiLastTurnSummary->mirroredCard = cs_idiot_mirrored_card(wastePile); }
+                return;
+            } else {
+                for (int i = 0; i < wastePile->count; ++i) aiState->hand[aiState->handCount++] = wastePile->pile[i];
+                aiState->hand[aiState->handCount++] = blind;
+                wastePile->count = 0;
+                lm_reset(aiLastTurnSummary);
+                return;
+            }
+        }
+        /* 5) Nothing playable → pick up */
+        for (int i = 0; i < wastePile->count; ++i) aiState->hand[aiState->handCount++] = wastePile->pile[i];
+        wastePile->count = 0;
+        return;
+    }
+
+    /* -------------------- NORMAL -------------------- */
+    if (difficulty == DIFFICULTY_NORMAL) {
+        int idxTwo = -1, idxTen = -1, idxThree = -1, idxLowest = -1, lowestVal = 1000;
+
+        /* Scan the hand for candidates. */
+        for (int i = 0; i < aiState->handCount; ++i) {
+            if (!cs_idiot_can_play(topOfWaste, &aiState->hand[i], wastePile)) continue;
+            int v = cs_idiot_card_value(&aiState->hand[i]);
+            if (cs_idiot_is_power_card(&aiState->hand[i]) == 0 && v < lowestVal) { lowestVal = v; idxLowest = i; }
+            if (cs_idiot_card_is(&aiState->hand[i], 2))  idxTwo  = i;
+            if (cs_idiot_card_is(&aiState->hand[i], 3))  idxThree = i;
+            if (cs_idiot_card_is(&aiState->hand[i], 10)) idxTen   = i;
+        }
+
+        /* 2 then follow-up (lowest non-power preferred; else 3; else 10 on large piles) */
+        if (idxTwo != -1) {
+            Card two = take_at(aiState->hand, &aiState->handCount, idxTwo);
+            wastePile->pile[wastePile->count++] = two;
+            lm_record(aiLastTurnSummary, two);
+            cs_idiot_draw_up(aiState, drawPile);
+
+            Card *topAfterTwo = &wastePile->pile[wastePile->count - 1];
+            int idxNextLow = -1, idxNextThree = -1, idxNextTen = -1, lowV = 1000;
+
+            for (int i = 0; i < aiState->handCount; ++i) {
+                if (!cs_idiot_can_play(topAfterTwo, &aiState->hand[i], wastePile)) continue;
+                int v = cs_idiot_card_value(&aiState->hand[i]);
+                if (cs_idiot_is_power_card(&aiState->hand[i]) == 0 && v < lowV) { lowV = v; idxNextLow = i; }
+                if (cs_idiot_card_is(&aiState->hand[i], 3))  idxNextThree = i;
+                if (cs_idiot_card_is(&aiState->hand[i], 10)) idxNextTen   = i;
+            }
+
+            if (idxNextLow != -1) {
+                Card n = take_at(aiState->hand, &aiState->handCount, idxNextLow);
+                wastePile->pile[wastePile->count++] = n;
+                lm_record(aiLastTurnSummary, n);
+                (void)dump_same_rank_in_hand(aiState, wastePile, &n, 3, aiLastTurnSummary);
+                cs_idiot_draw_up(aiState, drawPile);
+            } else if (idxNextThree != -1) {
+                Card n = take_at(aiState->hand, &aiState->handCount, idxNextThree);
+                wastePile->pile[wastePile->count++] = n;
+                lm_record(aiLastTurnSummary, n);
+                aiLastTurnSummary->mirrored = 1; aiLastTurnSummary->mirroredCard = cs_idiot_mirrored_card(wastePile);
+                cs_idiot_draw_up(aiState, drawPile);
+            } else if (idxNextTen != -1 && should_burn_now_with_10(wastePile, difficulty)) {
+                Card n = take_at(aiState->hand, &aiState->handCount, idxNextTen);
+                wastePile->pile[wastePile->count++] = n;
+                lm_record(aiLastTurnSummary, n);
+                aiLastTurnSummary->burned = 1; cs_idiot_burn(wastePile);
+                cs_idiot_draw_up(aiState, drawPile);
+            }
+            return;
+        }
+
+        /* Lowest non-power (+dump), else 3, else 10 if worth it. */
+        if (idxLowest != -1) {
+            Card c = take_at(aiState->hand, &aiState->handCount, idxLowest);
+            wastePile->pile[wastePile->count++] = c;
+            lm_record(aiLastTurnSummary, c);
+            (void)dump_same_rank_in_hand(aiState, wastePile, &c, 3, aiLastTurnSummary);
+            cs_idiot_draw_up(aiState, drawPile);
+            return;
+        }
+
+        if (idxThree != -1) {
+            Card c = take_at(aiState->hand, &aiState->handCount, idxThree);
+            wastePile->pile[wastePile->count++] = c;
+            lm_record(aiLastTurnSummary, c);
+            aiLastTurnSummary->mirrored = 1; aiLastTurnSummary->mirroredCard = cs_idiot_mirrored_card(wastePile);
+            cs_idiot_draw_up(aiState, drawPile);
+            return;
+        }
+
+        if (idxTen != -1 && should_burn_now_with_10(wastePile, difficulty)) {
+            Card c = take_at(aiState->hand, &aiState->handCount, idxTen);
+            wastePile->pile[wastePile->count++] = c;
+            lm_record(aiLastTurnSummary, c);
+            aiLastTurnSummary->burned = 1; cs_idiot_burn(wastePile);
+            cs_idiot_draw_up(aiState, drawPile);
+            return;
+        }
+
+        /* Face-up mirror of the above (no drawing). */
+        if (aiState->handCount == 0 && aiState->faceUpCount > 0) {
+            int fuTwo = -1, fuTen = -1, fuThree = -1, fuLow = -1, fuLowV = 1000;
+            for (int i = 0; i < aiState->faceUpCount; ++i) {
+                if (!cs_idiot_can_play(topOfWaste, &aiState->faceUp[i], wastePile)) continue;
+                int v = cs_idiot_card_value(&aiState->faceUp[i]);
+                if (cs_idiot_is_power_card(&aiState->faceUp[i]) == 0 && v < fuLowV) { fuLowV = v; fuLow = i; }
+                if (cs_idiot_card_is(&aiState->faceUp[i], 2))  fuTwo  = i;
+                if (cs_idiot_card_is(&aiState->faceUp[i], 3))  fuThree = i;
+                if (cs_idiot_card_is(&aiState->faceUp[i], 10)) fuTen   = i;
+            }
+            if (fuTwo   != -1) { Card c = take_at(aiState->faceUp, &aiState->faceUpCount, fuTwo);   wastePile->pile[wastePile->count++] = c; lm_record(aiLastTurnSummary, c); return; }
+            if (fuLow   != -1) { Card c = take_at(aiState->faceUp, &aiState->faceUpCount, fuLow);   wastePile->pile[wastePile->count++] = c; lm_record(aiLastTurnSummary, c); return; }
+            if (fuThree != -1) { Card c = take_at(aiState->faceUp, &aiState->faceUpCount, fuThree); wastePile->pile[wastePile->count++] = c; lm_record(aiLastTurnSummary, c); aiLastTurnSummary->mirrored = 1; aiLastTurnSummary->mirroredCard = cs_idiot_mirrored_card(wastePile); return; }
+            if (fuTen   != -1 && should_burn_now_with_10(wastePile, difficulty)) {
+                Card c = take_at(aiState->faceUp, &aiState->faceUpCount, fuTen);
+                wastePile->pile[wastePile->count++] = c; lm_record(aiLastTurnSummary, c);
+                aiLastTurnSummary->burned = 1; cs_idiot_burn(wastePile);
+                return;
+            }
+        }
+
+        /* Face-down blind try, else pick up. */
+        if (aiState->handCount == 0 && aiState->faceUpCount == 0 && aiState->faceDownCount > 0) {
+            Card blind = take_at(aiState->faceDown, &aiState->faceDownCount, 0);
+            if (cs_idiot_can_play(topOfWaste, &blind, wastePile)) {
+                wastePile->pile[wastePile->count++] = blind; lm_record(aiLastTurnSummary, blind);
+                if (cs_idiot_card_is(&blind, 10) || cs_idiot_is_four_of_a_kind(wastePile)) { aiLastTurnSummary->burned = 1; cs_idiot_burn(wastePile); }
+                if (cs_idiot_card_is(&blind, 3)) { aiLastTurnSummary->mirrored = 1; aiLastTurnSummary->mirroredCard = cs_idiot_mirrored_card(wastePile); }
+                return;
+            } else {
+                for (int i = 0; i < wastePile->count; ++i) aiState->hand[aiState->handCount++] = wastePile->pile[i];
+                aiState->hand[aiState->handCount++] = blind;
+                wastePile->count = 0;
+                lm_reset(aiLastTurnSummary);
+                return;
+            }
+        }
+
+        /* Only a 10 still plays: burn after all. Picking up keeps the turn,
+           and a pile that is empty or holds just our own 2 would come back
+           to this same choice forever. */
+        {
+            Card *zone  = (aiState->handCount > 0) ? aiState->hand       : aiState->faceUp;
+            int  *count = (aiState->handCount > 0) ? &aiState->handCount : &aiState->faceUpCount;
+            for (int i = 0; i < *count; ++i) {
+                if (!cs_idiot_card_is(&zone[i], 10)) continue;
+                Card c = take_at(zone, count, i);
+                wastePile->pile[wastePile->count++] = c;
+                lm_record(aiLastTurnSummary, c);
+                aiLastTurnSummary->burned = 1; cs_idiot_burn(wastePile);
+                cs_idiot_draw_up(aiState, drawPile);
+                return;
+            }
+        }
+
+        for (int i = 0; i < wastePile->count; ++i) aiState->hand[aiState->handCount++] = wastePile->pile[i];
+        wastePile->count = 0;
+        return;
+    }
+
+    /* -------------------- HARD -------------------- */
+    if (difficulty == DIFFICULTY_HARD) {
+        int fromHandZone = -1, bestIndex = -1, bestScore = -999999;
+
+        /* Prefer hand candidates; if none, try face-up (only when hand is empty). */
+        if (aiState->handCount > 0) {
+            for (int i = 0; i < aiState->handCount; ++i) {
+                if (!cs_idiot_can_play(topOfWaste, &aiState->hand[i], wastePile)) continue;
+                int score = hard_score_candidate(aiState, opponentState, wastePile, drawPile, 1, i);
+                if (score > bestScore) { bestScore = score; bestIndex = i; fromHandZone = 1; }
+            }
+        }
+        if (fromHandZone == -1 && aiState->faceUpCount > 0 && aiState->handCount == 0) {
+            for (int i = 0; i < aiState->faceUpCount; ++i) {
+                if (!cs_idiot_can_play(topOfWaste, &aiState->faceUp[i], wastePile)) continue;
+                int score = hard_score_candidate(aiState, opponentState, wastePile, drawPile, 0, i);
+                if (score > bestScore) { bestScore = score; bestIndex = i; fromHandZone = 0; }
+            }
+        }
+        /* Only face-down cards left: blind try, as Normal does. */
+        if (fromHandZone == -1 && aiState->handCount == 0 && aiState->faceUpCount == 0 && aiState->faceDownCount > 0) {
+            Card blind = take_at(aiState->faceDown, &aiState->faceDownCount, 0);
+            if (cs_idiot_can_play(topOfWaste, &blind, wastePile)) {
+                wastePile->pile[wastePile->count++] = blind; lm_record(aiLastTurnSummary, blind);
+                if (cs_idiot_card_is(&blind, 10) || cs_idiot_is_four_of_a_kind(wastePile)) { aiLastTurnSummary->burned = 1; cs_idiot_burn(wastePile); }
+                if (cs_idiot_card_is(&blind, 3)) { aiLastTurnSummary->mirrored = 1; aiLastTurnSummary->mirroredCard = cs_idiot_mirrored_card(wastePile); }
+                return;
+            }
+            for (int i = 0; i < wastePile->count; ++i) aiState->hand[aiState->handCount++] = wastePile->pile[i];
+            aiState->hand[aiState->handCount++] = blind;
+            wastePile->count = 0;
+            return;
+        }
+
+        /* Nothing playable → pick up. */
+        if (fromHandZone == -1) {
+            for (int i = 0; i < wastePile->count; ++i) aiState->hand[aiState->handCount++] = wastePile->pile[i];
+            wastePile->count = 0;
+            return;
+        }
+
+        /* Execute chosen play. */
+        Card played = fromHandZone ? aiState->hand[bestIndex] : aiState->faceUp[bestIndex];
+        if (fromHandZone) { for (int j = bestIndex; j < aiState->handCount - 1; ++j) aiState->hand[j] = aiState->hand[j + 1]; aiState->handCount--; }
+        else              { for (int j = bestIndex; j < aiState->faceUpCount - 1; ++j) aiState->faceUp[j] = aiState->faceUp[j + 1]; aiState->faceUpCount--; }
+
+        wastePile->pile[wastePile->count++] = played;
+        lm_record(aiLastTurnSummary, played);
+
+        if (cs_idiot_card_is(&played, 10)) {
+            aiLastTurnSummary->burned = 1; cs_idiot_burn(wastePile); cs_idiot_draw_up(aiState, drawPile); return;
+        }
+
+        if (!played.is_joker && !cs_idiot_card_is(&played, 2) && !cs_idiot_card_is(&played, 3)) {
+            int dumped = 0;
+            if (fromHandZone) {
+                for (int i = 0; i < aiState->handCount && dumped < 3; ) {
+                    if (cs_card_same_rank(&aiState->hand[i], &played)) {
+                        wastePile->pile[wastePile->count++] = aiState->hand[i];
+                        lm_record(aiLastTurnSummary, aiState->hand[i]);
+                        for (int k = i; k < aiState->handCount - 1; ++k) aiState->hand[k] = aiState->hand[k + 1];
+                        aiState->handCount--; dumped++;
+                        if (cs_idiot_is_four_of_a_kind(wastePile)) { aiLastTurnSummary->burned = 1; cs_idiot_burn(wastePile); cs_idiot_draw_up(aiState, drawPile); return; }
+                    } else ++i;
+                }
+            } else {
+                for (int i = 0; i < aiState->faceUpCount && dumped < 3; ) {
+                    if (cs_card_same_rank(&aiState->faceUp[i], &played)) {
+                        wastePile->pile[wastePile->count++] = aiState->faceUp[i];
+                        lm_record(aiLastTurnSummary, aiState->faceUp[i]);
+                        for (int k = i; k < aiState->faceUpCount - 1; ++k) aiState->faceUp[k] = aiState->faceUp[k + 1];
+                        aiState->faceUpCount--; dumped++;
+                        if (cs_idiot_is_four_of_a_kind(wastePile)) { aiLastTurnSummary->burned = 1; cs_idiot_burn(wastePile); return; }
+                    } else ++i;
+                }
+            }
+            cs_idiot_draw_up(aiState, drawPile);
+            return;
+        }
+
+        if (cs_idiot_card_is(&played, 3) || played.is_joker) {
+            aiLastTurnSummary->mirrored = 1;
+            aiLastTurnSummary->mirroredCard = cs_idiot_mirrored_card(wastePile);
+            cs_idiot_draw_up(aiState, drawPile);
+            return;
+        }
+
+        if (cs_idiot_card_is(&played, 2)) {
+            cs_idiot_draw_up(aiState, drawPile);
+            int j = hard_best_followup_index(aiState, wastePile);
+            if (j != -1 && cs_idiot_can_play(&wastePile->pile[wastePile->count - 1], &aiState->hand[j], wastePile)) {
+                Card follow = aiState->hand[j];
+                for (int k = j; k < aiState->handCount - 1; ++k) aiState->hand[k] = aiState->hand[k + 1];
+                aiState->handCount--;
+                wastePile->pile[wastePile->count++] = follow; lm_record(aiLastTurnSummary, follow);
+
+                if (cs_idiot_card_is(&follow, 10)) { aiLastTurnSummary->burned = 1; cs_idiot_burn(wastePile); cs_idiot_draw_up(aiState, drawPile); return; }
+                if (cs_idiot_card_is(&follow, 3) || follow.is_joker) { aiLastTurnSummary->mirrored = 1; aiLastTurnSummary->mirroredCard = cs_idiot_mirrored_card(wastePile); cs_idiot_draw_up(aiState, drawPile); return; }
+
+                if (!follow.is_joker && !cs_idiot_card_is(&follow, 2) && !cs_idiot_card_is(&follow, 3) && !cs_idiot_card_is(&follow, 10)) {
+                    int dumped = 0;
+                    for (int i = 0; i < aiState->handCount && dumped < 3; ) {
+                        if (cs_card_same_rank(&aiState->hand[i], &follow)) {
+                            wastePile->pile[wastePile->count++] = aiState->hand[i];
+                            lm_record(aiLastTurnSummary, aiState->hand[i]);
+                            for (int k = i; k < aiState->handCount - 1; ++k) aiState->hand[k] = aiState->hand[k + 1];
+                            aiState->handCount--; dumped++;
+                            if (cs_idiot_is_four_of_a_kind(wastePile)) { aiLastTurnSummary->burned = 1; cs_idiot_burn(wastePile); cs_idiot_draw_up(aiState, drawPile); return; }
+                        } else ++i;
+                    }
+                }
+                cs_idiot_draw_up(aiState, drawPile);
+            }
+            return;
+        }
+
+        cs_idiot_draw_up(aiState, drawPile);
+        return;
+    }
+}
+
+/* --------------------------------------------------------------------------- */
+/* GAME DRIVER                                                                 */
+/* --------------------------------------------------------------------------- */
+
+/** True once a player has no cards left in any zone. */
+static int is_out(const IdiotPlayer *playerState) {
+    return playerState->handCount == 0 && playerState->faceUpCount == 0 && playerState->faceDownCount == 0;
+}
+
+void cs_idiot_new_game(CsIdiotGame *game, int difficulty0, int difficulty1, bool jokers,
+                       CsRng *rng, const CsStatsSink *stats) {
+    Card deck[DECK_SIZE];
+
+    memset(game, 0, sizeof(*game));
+    cs_deck_init(deck);
+    cs_deck_shuffle(deck, DECK_SIZE, rng);
+    cs_idiot_deal(deck, &game->players[0], &game->players[1], &game->drawPile);
+
+    /* Optional: insert two Jokers randomly into the draw pile. */
+    if (jokers) {
+        Card jokerTemplate = cs_card_from_id(CS_CARD_JOKER);
+        jokerTemplate.revealed = 1;
+        for (int n = 0; n < 2; ++n) {
+            int insertPos = (int)cs_rng_below(rng, (uint32_t)game->drawPile.count + 1);
+            for (int k = game->drawPile.count; k > insertPos; --k) game->drawPile.pile[k] = game->drawPile.pile[k - 1];
+            game->drawPile.pile[insertPos] = jokerTemplate;
+            game->drawPile.count++;
+        }
+    }
+
+    game->difficulty[0] = difficulty0;
+    game->difficulty[1] = difficulty1;
+    game->turn          = 0;
+    game->winner        = -1;
+    if (stats) game->stats = *stats;
+}
+
+/**
+ * cs_idiot_step
+ * Same turn order as the interactive game: a burn, a pick-up or a turn that
+ * ends on a 2 keeps the turn; anything else passes it.
+ */
+/* After `seat` moved: settle a win, else pass the turn unless lastMove keeps it. */
+static int finish_turn(CsIdiotGame *game, int seat) {
+    if (is_out(&game->players[seat])) {
+        const CsRoundResult result = {
+            .game    = CS_GAME_IDIOT,
+            .outcome = (seat == 0) ? CS_OUTCOME_WIN : CS_OUTCOME_LOSS,
+            .flags   = (uint16_t)((game->difficulty[0] == DIFFICULTY_HARD ? CS_ROUND_HARD : 0) |
+                                  (game->difficulty[0] == DIFFICULTY_EASY ? CS_ROUND_EASY : 0)),
+        };
+        game->winner = seat;
+        cs_stats_emit(&game->stats, &result);
+        return seat;
+    }
+
+    /* Normal/Hard chain their follow-up onto a 2 in the same move, which
+       spends the extra turn; only a move that ends on the 2 keeps it. */
+    const AILastMove *lastMove = &game->lastMove;
+    const int keepsTurn = lastMove->burned ||
+                          lastMove->playedCount == 0 ||
+                          cs_idiot_card_is(&lastMove->played[lastMove->playedCount - 1], 2);
+    if (!keepsTurn) game->turn = !seat;
+
+    return -1;
+}
+
+int cs_idiot_step(CsIdiotGame *game) {
+    if (game->winner >= 0) return game->winner;
+
+    const int    seat  = game->turn;
+    IdiotPlayer *mover = &game->players[seat];
+
+    if (!is_out(mover)) {
+        cs_idiot_ai_play(mover, &game->players[!seat], &game->wastePile, &game->drawPile,
+                         game->difficulty[seat], &game->lastMove);
+    }
+    return finish_turn(game, seat);
+}
+
+/**
+ * take_choice
+ * Take the 1-based choice `index` out of the zone the player is playing
+ * from: the hand, then the face-up cards, then (blind) the face-down ones.
+ * Returns -1 (nothing taken) for an illegal choice, 1 for a face-down card
+ * that does not fit the pile, else 0.
+ */
+static int take_choice(IdiotPlayer *player, const CardPile *waste, int index, Card *selected) {
+    const Card *top = (waste->count > 0) ? &waste->pile[waste->count - 1] : NULL;
+
+    /* Hand first, then face-up; both must be playable. */
+    if (player->handCount > 0 || player->faceUpCount > 0) {
+        Card *zone  = (player->handCount > 0) ? player->hand      : player->faceUp;
+        int  *count = (player->handCount > 0) ? &player->handCount : &player->faceUpCount;
+
+        if (index < 1 || index > *count) return -1;
+        if (top && !cs_idiot_can_play(top, &zone[index - 1], waste)) return -1;
+        *selected = take_at(zone, count, index - 1);
+        return 0;
+    }
+
+    /* Face-down cards are played blind: a miss is picked up with the pile. */
+    if (index < 1 || index > player->faceDownCount) return -1;
+    *selected = take_at(player->faceDown, &player->faceDownCount, index - 1);
+    return (top && !cs_idiot_can_play(top, selected, waste)) ? 1 : 0;
+}
+
+int cs_idiot_play_extras(const CsIdiotGame *game, int index) {
+    if (game->winner >= 0) return -1;
+    if (index == 0) return 0;
+
+    /* Play it on copies of the seat and the draw pile. */
+    IdiotPlayer player = game->players[game->turn];
+    CardPile    draw   = game->drawPile;
+    Card        selected;
+
+    const int taken = take_choice(&player, &game->wastePile, index, &selected);
+    if (taken != 0) return taken < 0 ? -1 : 0;
+
+    cs_idiot_draw_up(&player, &draw);
+
+    int extras = 0;
+    for (int i = 0; i < player.handCount; ++i) {
+        if (cs_card_same_rank(&player.hand[i], &selected)) ++extras;
+    }
+    return extras;
+}
+
+bool cs_idiot_play(CsIdiotGame *game, int index, int extras) {
+    if (game->winner >= 0 || index < 0) return false;
+
+    const int    seat     = game->turn;
+    IdiotPlayer *player   = &game->players[seat];
+    CardPile    *waste    = &game->wastePile;
+    AILastMove  *lastMove = &game->lastMove;
+    Card         selected;
+
+    if (index == 0) {
+        lm_reset(lastMove);
+        cs_idiot_pick_up(player, waste);
+        finish_turn(game, seat);
+        return true;
+    }
+
+    const int taken = take_choice(player, waste, index, &selected);
+    if (taken < 0) return false;
+    if (taken > 0) {
+        lm_reset(lastMove);
+        waste->pile[waste->count++] = selected;
+        cs_idiot_pick_up(player, waste);
+        finish_turn(game, seat);
+        return true;
+    }
+
+    lm_reset(lastMove);
+    waste->pile[waste->count++] = selected;
+    lm_record(lastMove, selected);
+    cs_idiot_draw_up(player, &game->drawPile);
+
+    if (extras > 0 && dump_same_rank_in_hand(player, waste, &selected, extras, lastMove) > 0) {
+        cs_idiot_draw_up(player, &game->drawPile);
+        cs_idiot_sort_hand(player);
+    }
+
+    if (cs_idiot_card_is(&selected, 10) || cs_idiot_is_four_of_a_kind(waste)) {
+        cs_idiot_burn(waste);
+        lastMove->burned = 1;
+    } else if (cs_idiot_card_is(&selected, 3)) {
+        lastMove->mirroredCard = cs_idiot_mirrored_card(waste);
+        lastMove->mirrored     = lastMove->mirroredCard != NULL;
+    }
+
+    finish_turn(game, seat);
+    return true;
+}
@@ -0,0 +1,1496 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * libcardsim: Klondike model and solver (see cardsim.h).
+ *
+ * Responsibilities:
+ *   - Dealing, stock/waste cycling and the placement rules shared by the
+ *     interactive game and the solver.
+ *   - Player moves (cs_klondike_move), as offered by the terminal game.
+ *   - Scripted policies that play a whole game (cs_klondike_play) for
+ *     win-rate simulations.
+ *   - The depth-first winnability solver:
+ *       - a reusable, arena-backed context (SolverContext) so repeated
+ *         solves allocate nothing,
+ *       - an explicit stack of move iterators instead of recursion, so a
+ *         solve can yield after N nodes and resume later,
+ *       - a transposition table (visited-state hash set) cleared by generation,
+ *       - move ordering and pruning heuristics (e.g., safe-to-foundation),
+ *       - an optional complete move set (unsafe pushes, split runs,
+ *         foundation -> column), ordered so progress moves come first,
+ *       - a forced move pass that collapses obvious/“safe” moves prior to
+ *         branching.
+ *   - A blind solver that samples the cards a player cannot see and solves
+ *     each sample, estimating how often the deal is won without knowing them.
+ */
+
+#include "cardsim.h"
+#include "trace.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ------------------------------------------------------------------------- */
+/* Solver pruning helpers (internal)                                         */
+/* ------------------------------------------------------------------------- */
+
+/* Return 1 if pushing card to foundations is “safe” by heuristic. */
+static int  is_safe_foundation_push(Card candidateCard, const KlondikeGame *gameState);
+
+/* Apply all forced (safe) foundation moves repeatedly; return 1 if changed. */
+static int  apply_forced_moves(KlondikeGame *gameState);
+
+/* Coarse predicates to prune dead ends quickly. */
+static int  exists_any_table_to_table_move(const KlondikeGame *gameState);  /* Any legal table->table move? */
+static int  exists_any_waste_to_table_move(const KlondikeGame *gameState);  /* Waste top fits anywhere?     */
+static int  exists_any_safe_foundation_push(const KlondikeGame *gameState);
+static int  exists_any_progress_move(const KlondikeGame *gameState);
+static int  exists_any_complete_move(const KlondikeGame *gameState);        /* Unsafe push or foundation->table? */
+
+/* Table sequence helpers. */
+static inline bool is_king(const Card *card);   /* Only Kings fill an empty column. */
+static inline void reveal_new_table_top_card(KlondikeGame *gameState, int tableColumnIndex);
+static int  can_move_sequence_onto_column(const KlondikeGame *gameState, int fromColumnIndex, int startRowIndex, int toColumnIndex);
+static void apply_move_sequence_between_columns(KlondikeGame *gameState, int fromColumnIndex, int startRowIndex, int toColumnIndex);
+
+/* Hashing utilities for solver. */
+static uint64_t rotl64_u(uint64_t value64, int rotateBits);
+static uint64_t compute_card_hash(Card card);
+static uint64_t compute_state_hash(const KlondikeGame *gameState);
+
+/* Transposition helpers. */
+static int  visited_table_contains(const SolverContext *solver, uint64_t stateKey);
+static void visited_table_insert(SolverContext *solver, uint64_t stateKey);
+
+/* DFS core (iterative; one frame per depth). */
+static int  solver_next_child(SolverContext *solver, int searchDepth);
+
+/* ------------------------------------------------------------------------- */
+/* Dealing                                                                   */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * cs_klondike_deal
+ * Deal the table in the 1..7 pyramid pattern; last in each column face up.
+ * Remaining cards are placed into the draw pile; foundations and waste start empty.
+ *
+ * @param gameState     Destination game state to initialize.
+ * @param shuffledDeck  A 52-card deck (already shuffled by caller).
+ */
+void cs_klondike_deal(KlondikeGame *gameState, Card *shuffledDeck)
+{
+    int deckReadIndex = 0;
+
+    for (int tableColumnIndex = 0; tableColumnIndex < COLUMNS; ++tableColumnIndex)
+    {
+        for (int tableRowIndex = 0; tableRowIndex <= tableColumnIndex; ++tableRowIndex)
+        {
+            gameState->table[tableColumnIndex][tableRowIndex] = shuffledDeck[deckReadIndex++];  /* Place cards into table columns. */
+            gameState->table[tableColumnIndex][tableRowIndex].revealed = (tableRowIndex == tableColumnIndex);  /* Only the top card is face-up. */
+        }
+        gameState->table_counts[tableColumnIndex] = tableColumnIndex + 1;  /* Column sizes are 1..7. */
+    }
+
+    /* Stock (draw pile) gets the remainder of the deck. */
+    gameState->drawPile.count = 0;
+
+    for (; deckReadIndex < DECK_SIZE; ++deckReadIndex)
+    {
+        shuffledDeck[deckReadIndex].revealed = 1;  /* Will be face-up when in waste; keep the flag. */
+        gameState->drawPile.cards[gameState->drawPile.count++] = shuffledDeck[deckReadIndex];
+    }
+
+    /* Foundations start empty. */
+    for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
+    {
+        gameState->foundation[foundationIndex].count = 0;
+    }
+
+    gameState->wastePile.count = 0;  /* Waste starts empty. */
+    gameState->recycled        = false;
+}
+
+void cs_klondike_deal_random(KlondikeGame *gameState, int difficulty, CsRng *rng)
+{
+    Card shuffledDeck[DECK_SIZE];
+
+    cs_deck_init(shuffledDeck);   /* every card starts face down */
+    cs_deck_shuffle(shuffledDeck, DECK_SIZE, rng);
+    cs_klondike_deal(gameState, shuffledDeck);
+
+    gameState->difficulty = difficulty;
+    gameState->undo       = false;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Stock and placement rules                                                 */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * cs_klondike_draw
+ * Move 1 or 3 cards from stock to waste depending on difficulty. In Easy mode,
+ * when the stock is empty and waste is non-empty, recycle waste -> stock and
+ * immediately draw again.
+ */
+void cs_klondike_draw(KlondikeGame *gameState)
+{
+    int drawCount  = (gameState->difficulty == DIFFICULTY_HARD) ? 3 : 1;
+    int actualDraw = (gameState->drawPile.count < drawCount) ? gameState->drawPile.count : drawCount;
+
+    if (actualDraw > 0)
+    {
+        for (int drawIndex = 0; drawIndex < actualDraw; ++drawIndex)
+        {
+            gameState->wastePile.cards[gameState->wastePile.count++] =
+                gameState->drawPile.cards[--gameState->drawPile.count];
+        }
+    }
+    else if (gameState->difficulty == DIFFICULTY_EASY && gameState->wastePile.count > 0)
+    {
+        /* Easy mode: recycle waste -> draw, then draw again. */
+        for (int wasteIndex = gameState->wastePile.count - 1; wasteIndex >= 0; --wasteIndex)
+        {
+            gameState->drawPile.cards[gameState->drawPile.count++] = gameState->wastePile.cards[wasteIndex];
+        }
+        gameState->wastePile.count = 0;
+        gameState->recycled        = true;
+
+        /* Recurse once to perform the draw after recycle. */
+        cs_klondike_draw(gameState);
+    }
+}
+
+/**
+ * cs_card_is_red
+ * Utility to check a card color by suit (Hearts/Diamonds).
+ * @return true if red.
+ */
+bool cs_card_is_red(Card card)
+{
+    return cs_card_red(&card);
+}
+
+/**
+ * cs_klondike_fits_foundation
+ * Enforce foundation rules: card must match suit and be exactly one rank above
+ * the current top (or be an Ace into an empty foundation).
+ */
+bool cs_klondike_fits_foundation(Card candidateCard, const Stack *foundationStack)
+{
+    const CsCardInfo *candidateInfo = cs_card_meta(&candidateCard);
+
+    if (foundationStack->count == 0) { return candidateInfo->klondikeRank == 1; }
+
+    const CsCardInfo *topInfo = cs_card_meta(&foundationStack->cards[foundationStack->count - 1]);
+
+    return (candidateInfo->suit == topInfo->suit) && (candidateInfo->klondikeRank == topInfo->klondikeRank + 1);
+}
+
+/**
+ * cs_klondike_rank
+ * Map ranks to numbers for general comparisons. (Ace=1, Jack=11, Queen=12, King=13)
+ */
+int cs_klondike_rank(Card card)
+{
+    return cs_card_klondike_rank(&card);
+}
+
+/**
+ * cs_klondike_fits_table
+ * Check whether movingCard can be placed on top of destinationCard in the table:
+ * colors must alternate and ranks must be descending by exactly 1.
+ */
+bool cs_klondike_fits_table(Card movingCard, Card destinationCard)
+{
+    const CsCardInfo *movingInfo      = cs_card_meta(&movingCard);
+    const CsCardInfo *destinationInfo = cs_card_meta(&destinationCard);
+
+    return (movingInfo->red != destinationInfo->red) &&
+           (movingInfo->klondikeRank == destinationInfo->klondikeRank - 1);
+}
+
+/* ------------------------------------------------------------------------- */
+/* Player moves                                                              */
+/* ------------------------------------------------------------------------- */
+
+static inline bool is_king(const Card *card)
+{
+    return cs_card_klondike_rank(card) == 13;
+}
+
+/* Can `card` go on top of column `columnIndex` (Kings only on empty)? */
+static bool fits_column(const KlondikeGame *gameState, Card card, int columnIndex)
+{
+    const int count = gameState->table_counts[columnIndex];
+
+    if (count == 0)              { return is_king(&card); }
+    if (count >= MAX_DRAW_STACK) { return false; }
+    return cs_klondike_fits_table(card, gameState->table[columnIndex][count - 1]);
+}
+
+/* Push `card` onto the first foundation that takes it; false if none does. */
+static bool push_to_foundation(KlondikeGame *gameState, Card card)
+{
+    for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
+    {
+        Stack *foundation = &gameState->foundation[foundationIndex];
+        if (cs_klondike_fits_foundation(card, foundation))
+        {
+            foundation->cards[foundation->count++] = card;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool cs_klondike_move(KlondikeGame *gameState, CsKlondikeMove move, int from, int to)
+{
+    const bool fromColumn     = from >= 0 && from < COLUMNS;
+    const bool toColumn       = to   >= 0 && to   < COLUMNS;
+    const bool fromFoundation = from >= 0 && from < FOUNDATION_PILES;
+
+    Stack *waste = &gameState->wastePile;
+
+    switch (move)
+    {
+        case CS_KLONDIKE_WASTE_TO_FOUNDATION:
+            if (waste->count == 0 || !push_to_foundation(gameState, waste->cards[waste->count - 1])) { return false; }
+            waste->count--;
+            return true;
+
+        case CS_KLONDIKE_WASTE_TO_COLUMN:
+        {
+            if (waste->count == 0 || !toColumn) { return false; }
+
+            Card wasteTopCard = waste->cards[waste->count - 1];
+            if (!fits_column(gameState, wasteTopCard, to)) { return false; }
+
+            wasteTopCard.revealed = 1;
+            gameState->table[to][gameState->table_counts[to]++] = wasteTopCard;
+            waste->count--;
+            return true;
+        }
+
+        case CS_KLONDIKE_COLUMN_TO_COLUMN:
+            if (!fromColumn || !toColumn || from == to) { return false; }
+
+            /* Longest face-up run first, as the terminal game does. */
+            for (int startRowIndex = 0; startRowIndex < gameState->table_counts[from]; ++startRowIndex)
+            {
+                if (!gameState->table[from][startRowIndex].revealed) { continue; }
+                if (can_move_sequence_onto_column(gameState, from, startRowIndex, to))
+                {
+                    apply_move_sequence_between_columns(gameState, from, startRowIndex, to);
+                    return true;
+                }
+            }
+            return false;
+
+        case CS_KLONDIKE_COLUMN_TO_FOUNDATION:
+        {
+            if (!fromColumn || gameState->table_counts[from] == 0) { return false; }
+
+            const Card topTableCard = gameState->table[from][gameState->table_counts[from] - 1];
+            if (!topTableCard.revealed || !push_to_foundation(gameState, topTableCard)) { return false; }
+
+            gameState->table_counts[from]--;
+            reveal_new_table_top_card(gameState, from);
+            return true;
+        }
+
+        case CS_KLONDIKE_FOUNDATION_TO_COLUMN:
+        {
+            if (!fromFoundation || !toColumn || gameState->foundation[from].count == 0) { return false; }
+
+            Stack *foundation        = &gameState->foundation[from];
+            Card   foundationTopCard = foundation->cards[foundation->count - 1];
+            if (!fits_column(gameState, foundationTopCard, to)) { return false; }
+
+            foundationTopCard.revealed = 1;
+            gameState->table[to][gameState->table_counts[to]++] = foundationTopCard;
+            foundation->count--;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Policies                                                                  */
+/* ------------------------------------------------------------------------- */
+
+typedef enum { POLICY_STUCK, POLICY_MOVED, POLICY_DREW } PolicyStep;
+
+/* The terminal game's auto-complete condition: everything on the table is
+   face up and every foundation has reached at least a 5. */
+static bool auto_complete_ready(const KlondikeGame *gameState)
+{
+    for (int columnIndex = 0; columnIndex < COLUMNS; ++columnIndex)
+    {
+        if (gameState->table_counts[columnIndex] > 0 && !gameState->table[columnIndex][0].revealed) { return false; }
+    }
+    for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
+    {
+        const Stack *foundation = &gameState->foundation[foundationIndex];
+        if (foundation->count == 0 || cs_klondike_rank(foundation->cards[foundation->count - 1]) < 5) { return false; }
+    }
+    return true;
+}
+
+/* May `card` go up to a foundation under this policy right now? */
+static bool policy_allows_push(const KlondikeGame *gameState, CsKlondikePolicy policy, Card card)
+{
+    switch (policy)
+    {
+        case CS_KLONDIKE_POLICY_GREEDY:        return true;
+        case CS_KLONDIKE_POLICY_AUTO_COMPLETE: if (auto_complete_ready(gameState)) { return true; } break;
+        default:                               break;
+    }
+    return is_safe_foundation_push(card, gameState) != 0;
+}
+
+/**
+ * policy_step
+ * Make the policy's next move, in order: a foundation push (columns, then
+ * the waste), a run that uncovers a face-down card, the waste onto the
+ * table, a draw. None of the first three can be undone by a later one, so
+ * only drawing can repeat a position.
+ */
+static PolicyStep policy_step(KlondikeGame *gameState, CsKlondikePolicy policy)
+{
+    const Stack *waste = &gameState->wastePile;
+
+    for (int columnIndex = 0; columnIndex < COLUMNS; ++columnIndex)
+    {
+        const int count = gameState->table_counts[columnIndex];
+        if (count > 0 && policy_allows_push(gameState, policy, gameState->table[columnIndex][count - 1]) &&
+            cs_klondike_move(gameState, CS_KLONDIKE_COLUMN_TO_FOUNDATION, columnIndex, 0))
+        {
+            return POLICY_MOVED;
+        }
+    }
+    if (waste->count > 0 && policy_allows_push(gameState, policy, waste->cards[waste->count - 1]) &&
+        cs_klondike_move(gameState, CS_KLONDIKE_WASTE_TO_FOUNDATION, 0, 0))
+    {
+        return POLICY_MOVED;
+    }
+
+    /* Whole face-up runs with a face-down card under them. */
+    for (int fromColumnIndex = 0; fromColumnIndex < COLUMNS; ++fromColumnIndex)
+    {
+        int firstFaceUp = 0;
+        while (firstFaceUp < gameState->table_counts[fromColumnIndex] &&
+               !gameState->table[fromColumnIndex][firstFaceUp].revealed) { ++firstFaceUp; }
+        if (firstFaceUp == 0 || firstFaceUp == gameState->table_counts[fromColumnIndex]) { continue; }
+
+        for (int toColumnIndex = 0; toColumnIndex < COLUMNS; ++toColumnIndex)
+        {
+            if (toColumnIndex != fromColumnIndex &&
+                can_move_sequence_onto_column(gameState, fromColumnIndex, firstFaceUp, toColumnIndex))
+            {
+                apply_move_sequence_between_columns(gameState, fromColumnIndex, firstFaceUp, toColumnIndex);
+                return POLICY_MOVED;
+            }
+        }
+    }
+
+    for (int toColumnIndex = 0; toColumnIndex < COLUMNS; ++toColumnIndex)
+    {
+        if (cs_klondike_move(gameState, CS_KLONDIKE_WASTE_TO_COLUMN, 0, toColumnIndex)) { return POLICY_MOVED; }
+    }
+
+    const bool canRecycle = gameState->difficulty == DIFFICULTY_EASY && waste->count > 0;
+    if (gameState->drawPile.count > 0 || canRecycle)
+    {
+        cs_klondike_draw(gameState);
+        return POLICY_DREW;
+    }
+    return POLICY_STUCK;
+}
+
+bool cs_klondike_play(KlondikeGame *gameState, CsKlondikePolicy policy, int maxMoves, int *moves)
+{
+    int moveCount  = 0;
+    int idleDraws  = 0;     /* draws since the last other move */
+
+    while (moveCount < maxMoves && !cs_klondike_is_won(gameState))
+    {
+        const PolicyStep step = policy_step(gameState, policy);
+        if (step == POLICY_STUCK) { break; }
+        ++moveCount;
+
+        if (step == POLICY_MOVED) { idleDraws = 0; continue; }
+
+        /* A whole trip through stock + waste with nothing to play: the
+           position only repeats from here on. */
+        if (++idleDraws > gameState->drawPile.count + gameState->wastePile.count + 1) { break; }
+    }
+
+    if (moves) { *moves = moveCount; }
+    return cs_klondike_is_won(gameState);
+}
+
+/* ------------------------------------------------------------------------- */
+/* DFS / Backtracking Solver (heap-backed states + transposition + pruning)   */
+/* ------------------------------------------------------------------------- */
+
+/* Small helper: 64-bit rotate-left (used by the hasher). */
+static uint64_t rotl64_u(uint64_t value64, int rotateBits)
+{
+    return (value64 << rotateBits) | (value64 >> (64 - rotateBits));
+}
+
+/* --- Hashing helpers to create a stable, compact key for a game state --- */
+
+/* Lightly mixed per-card hash (includes revealed flag). Rank is Ace=1..King=13
+   and suit 0..3; Jokers and unknown cards fold onto suit 0. */
+static uint64_t compute_card_hash(Card card)
+{
+    const CsCardInfo *cardInfo = cs_card_meta(&card);
+
+    uint64_t mixedValue = (uint64_t)(cardInfo->klondikeRank & 0x3F) |
+                          ((uint64_t)(cardInfo->suit & 0x03) << 6);
+
+    mixedValue |= ((uint64_t)(card.revealed ? 1 : 0) << 8);
+    mixedValue ^= rotl64_u(mixedValue * 0x9E3779B185EBCA87ULL + 0xC2B2AE3D27D4EB4FULL, 23);
+    return mixedValue;
+}
+
+/* State hash: foundations (top+count), full table arrays (up to counts),
+ * waste sequence, draw sequence, and difficulty. */
+static uint64_t compute_state_hash(const KlondikeGame *gameState)
+{
+    uint64_t stateHash = 0xDEADBEEFCAFEBABEULL;
+
+    /* Foundations: count and top card carry most of the signal. */
+    for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
+    {
+        stateHash ^= (uint64_t)gameState->foundation[foundationIndex].count + 0x9E37;
+
+        if (gameState->foundation[foundationIndex].count > 0)
+        {
+            Card topFoundationCard = gameState->foundation[foundationIndex].cards[gameState->foundation[foundationIndex].count - 1];
+            stateHash ^= rotl64_u(compute_card_hash(topFoundationCard), foundationIndex + 1);
+        }
+    }
+
+    /* Table: mix in all present cards in each column. */
+    for (int tableColumnIndex = 0; tableColumnIndex < COLUMNS; ++tableColumnIndex)
+    {
+        stateHash ^= rotl64_u((uint64_t)gameState->table_counts[tableColumnIndex] + 0x12D + tableColumnIndex, 7);
+
+        for (int cardIndex = 0; cardIndex < gameState->table_counts[tableColumnIndex]; ++cardIndex)
+        {
+            stateHash ^= rotl64_u(compute_card_hash(gameState->table[tableColumnIndex][cardIndex]),
+                                  (cardIndex + tableColumnIndex) & 31);
+        }
+    }
+
+    /* Waste sequence (from bottom to top). */
+    stateHash ^= rotl64_u((uint64_t)gameState->wastePile.count + 0x55, 13);
+    for (int cardIndex = 0; cardIndex < gameState->wastePile.count; ++cardIndex)
+    {
+        stateHash ^= rotl64_u(compute_card_hash(gameState->wastePile.cards[cardIndex]), cardIndex & 31);
+    }
+
+    /* Draw sequence. */
+    stateHash ^= rotl64_u((uint64_t)gameState->drawPile.count + 0xA3, 17);
+    for (int cardIndex = 0; cardIndex < gameState->drawPile.count; ++cardIndex)
+    {
+        stateHash ^= rotl64_u(compute_card_hash(gameState->drawPile.cards[cardIndex]), cardIndex & 31);
+    }
+
+    /* Include difficulty since it changes stock cycling. */
+    stateHash ^= (uint64_t)gameState->difficulty * 0x1000193ULL;
+
+    return stateHash;
+}
+
+/*
+ * Transposition table probes (linear probing with short probe cap for speed).
+ * Slots from earlier solves carry a stale generation and read as empty.
+ */
+static int visited_table_contains(const SolverContext *solver, uint64_t stateKey)
+{
+    const VisitedEntry *visitedTable = solver->visited;
+    uint64_t startSlot = stateKey % VISITED_CAP;
+
+    for (int probeStep = 0; probeStep < 16; ++probeStep)
+    {
+        uint64_t tableIndex = (startSlot + probeStep) % VISITED_CAP;
+
+        if (visitedTable[tableIndex].generation != solver->generation) { return 0; }
+        if (visitedTable[tableIndex].key == stateKey) { return 1; }
+    }
+    return 0;
+}
+static void visited_table_insert(SolverContext *solver, uint64_t stateKey)
+{
+    VisitedEntry *visitedTable = solver->visited;
+    uint64_t startSlot = stateKey % VISITED_CAP;
+
+    for (int probeStep = 0; probeStep < VISITED_CAP; ++probeStep)
+    {
+        uint64_t tableIndex = (startSlot + probeStep) % VISITED_CAP;
+
+        if (visitedTable[tableIndex].generation != solver->generation)
+        {
+            visitedTable[tableIndex].generation = solver->generation;
+            visitedTable[tableIndex].key        = stateKey;
+            return;
+        }
+        if (visitedTable[tableIndex].key == stateKey) { return; }
+    }
+}
+
+/* --- Small utilities used by both gameplay and solver --- */
+
+/* Reveal the new top of a table column after cards were removed. */
+static inline void reveal_new_table_top_card(KlondikeGame *gameState, int tableColumnIndex)
+{
+    if (gameState->table_counts[tableColumnIndex] > 0)
+    {
+        gameState->table[tableColumnIndex][gameState->table_counts[tableColumnIndex] - 1].revealed = 1;
+    }
+}
+
+/* Try to move sequence starting at index `startRowIndex` in column `fromColumnIndex` onto column `toColumnIndex`.
+ * In addition to normal legality, we require that the destination has room. */
+static int can_move_sequence_onto_column(const KlondikeGame *gameState, int fromColumnIndex, int startRowIndex, int toColumnIndex)
+{
+    int moveCount = gameState->table_counts[fromColumnIndex] - startRowIndex;
+    if (moveCount <= 0) { return 0; }
+
+    /* Capacity guard for destination column. */
+    if (gameState->table_counts[toColumnIndex] + moveCount > MAX_DRAW_STACK) { return 0; }
+
+    if (gameState->table_counts[toColumnIndex] == 0)
+    {
+        return is_king(&gameState->table[fromColumnIndex][startRowIndex]);
+    }
+    else
+    {
+        Card destTopCard = gameState->table[toColumnIndex][gameState->table_counts[toColumnIndex] - 1];
+        return cs_klondike_fits_table(gameState->table[fromColumnIndex][startRowIndex], destTopCard);
+    }
+}
+
+/* Apply table-sequence move with capacity guard. */
+static void apply_move_sequence_between_columns(KlondikeGame *gameState, int fromColumnIndex, int startRowIndex, int toColumnIndex)
+{
+    int moveCount = gameState->table_counts[fromColumnIndex] - startRowIndex;
+    if (moveCount <= 0) { return; }
+
+    /* Destination capacity check (defensive; should already be filtered). */
+    if (gameState->table_counts[toColumnIndex] + moveCount > MAX_DRAW_STACK) { return; }
+
+    for (int j = 0; j < moveCount; ++j)
+    {
+        gameState->table[toColumnIndex][gameState->table_counts[toColumnIndex]++] =
+            gameState->table[fromColumnIndex][startRowIndex + j];
+    }
+
+    gameState->table_counts[fromColumnIndex] = startRowIndex;
+
+    if (gameState->table_counts[fromColumnIndex] > 0)
+    {
+        gameState->table[fromColumnIndex][gameState->table_counts[fromColumnIndex] - 1].revealed = 1;
+    }
+}
+
+/* Goal check: all four foundations must be complete. */
+bool cs_klondike_is_won(const KlondikeGame *gameState)
+{
+    int completeCount = 0;
+
+    for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
+    {
+        if (gameState->foundation[foundationIndex].count == MAX_FOUNDATION) { ++completeCount; }
+    }
+
+    return completeCount == FOUNDATION_PILES;
+}
+
+/* -------------------------------------------------------------------------- */
+/* Pruning / Forced-move heuristics (shared with solver)                      */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * max_foundation_rank_by_color
+ * Compute the highest rank currently placed on foundations for red suits
+ * (Hearts/Diamonds) and black suits (Clubs/Spades). Used by safe-to-foundation.
+ */
+static void max_foundation_rank_by_color(const KlondikeGame *gameState, int *maxRedOut, int *maxBlackOut)
+{
+    int maxRedLocal   = 0;
+    int maxBlackLocal = 0;
+
+    for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
+    {
+        if (gameState->foundation[foundationIndex].count == 0) { continue; }
+
+        Card topFoundationCard = gameState->foundation[foundationIndex].cards[gameState->foundation[foundationIndex].count - 1];
+        int  rankValue         = cs_klondike_rank(topFoundationCard);
+
+        if (cs_card_is_red(topFoundationCard))
+        {
+            if (rankValue > maxRedLocal)   { maxRedLocal   = rankValue; }
+        }
+        else
+        {
+            if (rankValue > maxBlackLocal) { maxBlackLocal = rankValue; }
+        }
+    }
+
+    *maxRedOut   = maxRedLocal;
+    *maxBlackOut = maxBlackLocal;
+}
+
+/**
+ * is_safe_foundation_push
+ * Classic heuristic: moving Ace/Two is always safe. For higher cards of value v:
+ *  - Only move a red card if the max black foundation is at least v-1.
+ *  - Only move a black card if the max red foundation is at least v-1.
+ * This prevents “locking” low cards on foundation when they are still needed
+ * to build sequences in the table.
+ */
+static int is_safe_foundation_push(Card candidateCard, const KlondikeGame *gameState)
+{
+    int rankValue = cs_klondike_rank(candidateCard);
+    if (rankValue <= 2) { return 1; }  /* A, 2 are always safe. */
+
+    int maxRed   = 0;
+    int maxBlack = 0;
+
+    max_foundation_rank_by_color(gameState, &maxRed, &maxBlack);
+
+    if (cs_card_is_red(candidateCard)) { return maxBlack >= (rankValue - 1); }
+    else                             { return maxRed   >= (rankValue - 1); }
+}
+
+/**
+ * exists_any_table_to_table_move
+ * Lightweight “is there any legal table move?” predicate.
+ * Helps prune dead branches quickly in the solver.
+ */
+static int exists_any_table_to_table_move(const KlondikeGame *gameState)
+{
+    for (int fromColumnIndex = 0; fromColumnIndex < COLUMNS; ++fromColumnIndex)
+    {
+        int columnCount = gameState->table_counts[fromColumnIndex];
+        if (columnCount == 0) { continue; }
+
+        int firstRevealedRowIndex = -1;
+
+        for (int tableRowIndex = 0; tableRowIndex < columnCount; ++tableRowIndex)
+        {
+            if (gameState->table[fromColumnIndex][tableRowIndex].revealed)
+            {
+                firstRevealedRowIndex = tableRowIndex;
+                break;
+            }
+        }
+
+        if (firstRevealedRowIndex == -1) { continue; }
+
+        for (int splitRowIndex = firstRevealedRowIndex; splitRowIndex < columnCount; ++splitRowIndex)
+        {
+            /* Ensure the subsequence is valid (descending, alternating colors). */
+            int isValidSequence = 1;
+
+            for (int checkIndex = splitRowIndex; checkIndex < columnCount - 1; ++checkIndex)
+            {
+                if (!cs_klondike_fits_table(gameState->table[fromColumnIndex][checkIndex + 1],
+                                              gameState->table[fromColumnIndex][checkIndex]))
+                {
+                    isValidSequence = 0;
+                    break;
+                }
+            }
+
+            if (!isValidSequence) { continue; }
+
+            for (int toColumnIndex = 0; toColumnIndex < COLUMNS; ++toColumnIndex)
+            {
+                if (toColumnIndex == fromColumnIndex) { continue; }
+
+                if (gameState->table_counts[toColumnIndex] == 0)
+                {
+                    if (is_king(&gameState->table[fromColumnIndex][splitRowIndex])) { return 1; }
+                }
+                else
+                {
+                    Card destTopCard = gameState->table[toColumnIndex][gameState->table_counts[toColumnIndex] - 1];
+                    if (cs_klondike_fits_table(gameState->table[fromColumnIndex][splitRowIndex], destTopCard)) { return 1; }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * exists_any_waste_to_table_move
+ * Quick predicate for whether the waste top can be placed on any column.
+ */
+static int exists_any_waste_to_table_move(const KlondikeGame *gameState)
+{
+    if (gameState->wastePile.count == 0) { return 0; }
+
+    Card wasteTopCard = gameState->wastePile.cards[gameState->wastePile.count - 1];
+
+    for (int toColumnIndex = 0; toColumnIndex < COLUMNS; ++toColumnIndex)
+    {
+        if (gameState->table_counts[toColumnIndex] == 0)
+        {
+            if (is_king(&wasteTopCard)) { return 1; }
+        }
+        else
+        {
+            Card destTopCard = gameState->table[toColumnIndex][gameState->table_counts[toColumnIndex] - 1];
+            if (cs_klondike_fits_table(wasteTopCard, destTopCard)) { return 1; }
+        }
+    }
+    return 0;
+}
+
+/**
+ * exists_any_safe_foundation_push
+ * True if *any* safe-to-foundation move exists from table or waste.
+ */
+static int exists_any_safe_foundation_push(const KlondikeGame *gameState)
+{
+    for (int tableColumnIndex = 0; tableColumnIndex < COLUMNS; ++tableColumnIndex)
+    {
+        if (gameState->table_counts[tableColumnIndex] == 0) { continue; }
+
+        Card topTableCard = gameState->table[tableColumnIndex][gameState->table_counts[tableColumnIndex] - 1];
+        if (!topTableCard.revealed) { continue; }
+
+        for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
+        {
+            if (cs_klondike_fits_foundation(topTableCard, &gameState->foundation[foundationIndex]) &&
+                is_safe_foundation_push(topTableCard, gameState))
+            {
+                return 1;
+            }
+        }
+    }
+
+    if (gameState->wastePile.count > 0)
+    {
+        Card wasteTopCard = gameState->wastePile.cards[gameState->wastePile.count - 1];
+
+        for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
+        {
+            if (cs_klondike_fits_foundation(wasteTopCard, &gameState->foundation[foundationIndex]) &&
+                is_safe_foundation_push(wasteTopCard, gameState))
+            {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * exists_any_progress_move
+ * Coarse pruning gate for the solver:
+ *  - Any safe-to-foundation push?
+ *  - Any table->table move?
+ *  - Any waste->table move?
+ *  - Else, can we draw (or recycle in Easy)?
+ *  - Otherwise: dead leaf (return 0).
+ */
+static int exists_any_progress_move(const KlondikeGame *gameState)
+{
+    if (exists_any_safe_foundation_push(gameState)) { return 1; }
+    if (exists_any_table_to_table_move(gameState))  { return 1; }
+    if (exists_any_waste_to_table_move(gameState))  { return 1; }
+
+    if (gameState->drawPile.count > 0) { return 1; }
+    if (gameState->difficulty == DIFFICULTY_EASY && gameState->wastePile.count > 0) { return 1; }
+
+    return 0;
+}
+
+/**
+ * exists_any_complete_move
+ * The moves only the complete move set adds: any foundation push (safe or
+ * not) from the table or waste, or a foundation top that fits a column.
+ */
+static int exists_any_complete_move(const KlondikeGame *gameState)
+{
+    for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
+    {
+        const Stack *foundation = &gameState->foundation[foundationIndex];
+
+        for (int tableColumnIndex = 0; tableColumnIndex < COLUMNS; ++tableColumnIndex)
+        {
+            const int columnCount = gameState->table_counts[tableColumnIndex];
+
+            if (columnCount > 0 && gameState->table[tableColumnIndex][columnCount - 1].revealed &&
+                cs_klondike_fits_foundation(gameState->table[tableColumnIndex][columnCount - 1], foundation))
+            {
+                return 1;
+            }
+            if (foundation->count > 0 && fits_column(gameState, foundation->cards[foundation->count - 1], tableColumnIndex))
+            {
+                return 1;
+            }
+        }
+
+        if (gameState->wastePile.count > 0 &&
+            cs_klondike_fits_foundation(gameState->wastePile.cards[gameState->wastePile.count - 1], foundation))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * apply_forced_moves
+ * Collapse “obvious” safe foundation moves repeatedly until none apply.
+ * This reduces branching and tends to expose more revealed table cards.
+ *
+ * @return 1 if the position changed at least once, 0 otherwise.
+ */
+static int apply_forced_moves(KlondikeGame *gameState)
+{
+    TRACE_SCOPE("apply_forced_moves");
+    int changedAny      = 0;
+    int changedThisPass = 0;
+
+    do
+    {
+        changedThisPass = 0;
+
+        /* Table -> foundation (safe only). */
+        for (int tableColumnIndex = 0; tableColumnIndex < COLUMNS; ++tableColumnIndex)
+        {
+            if (gameState->table_counts[tableColumnIndex] == 0) { continue; }
+
+            Card topTableCard = gameState->table[tableColumnIndex][gameState->table_counts[tableColumnIndex] - 1];
+            if (!topTableCard.revealed) { continue; }
+
+            for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
+            {
+                if (cs_klondike_fits_foundation(topTableCard, &gameState->foundation[foundationIndex]) &&
+                    is_safe_foundation_push(topTableCard, gameState))
+                {
+                    gameState->foundation[foundationIndex].cards[gameState->foundation[foundationIndex].count++] = topTableCard;
+                    gameState->table_counts[tableColumnIndex]--;
+
+                    if (gameState->table_counts[tableColumnIndex] > 0)
+                    {
+                        gameState->table[tableColumnIndex][gameState->table_counts[tableColumnIndex] - 1].revealed = 1;
+                    }
+
+                    changedThisPass = 1;
+                    changedAny      = 1;
+                    break;
+                }
+            }
+        }
+
+        /* Waste -> foundation (safe only). */
+        if (!changedThisPass && gameState->wastePile.count > 0)
+        {
+            Card wasteTopCard = gameState->wastePile.cards[gameState->wastePile.count - 1];
+
+            for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
+            {
+                if (cs_klondike_fits_foundation(wasteTopCard, &gameState->foundation[foundationIndex]) &&
+                    is_safe_foundation_push(wasteTopCard, gameState))
+                {
+                    gameState->foundation[foundationIndex].cards[gameState->foundation[foundationIndex].count++] = wasteTopCard;
+                    gameState->wastePile.count--;
+
+                    changedThisPass = 1;
+                    changedAny      = 1;
+                    break;
+                }
+            }
+        }
+    }
+    while (changedThisPass);
+
+    return changedAny;
+}
+
+/* -------------------------------------------------------------------------- */
+/* DFS search engine                                                          */
+/* -------------------------------------------------------------------------- */
+
+/*
+ * The search is iterative: solver->frames[depth] is the move iterator of
+ * states[depth], so the whole search lives in the context and can stop
+ * between any two nodes and pick up again later (cs_solver_run).
+ */
+
+/* Move family a frame is enumerating. */
+enum
+{
+    SOLVER_PHASE_ENTER = 0,            /* node reached, not yet expanded     */
+    SOLVER_PHASE_TABLE_TO_FOUNDATION,  /* column -> foundation target (safe) */
+    SOLVER_PHASE_WASTE_TO_FOUNDATION,  /* waste -> foundation target (safe)  */
+    SOLVER_PHASE_TABLE_TO_TABLE,       /* run at column/row -> column target */
+    SOLVER_PHASE_WASTE_TO_TABLE,       /* waste -> column target             */
+    SOLVER_PHASE_DRAW,                 /* draw, or recycle in Easy           */
+    SOLVER_PHASE_DONE,
+
+    /* CS_SOLVER_COMPLETE_MOVES only */
+    SOLVER_PHASE_RUN_TO_TABLE,         /* whole face-up runs only            */
+    SOLVER_PHASE_TABLE_TO_FOUNDATION_UNSAFE,
+    SOLVER_PHASE_WASTE_TO_FOUNDATION_UNSAFE,
+    SOLVER_PHASE_PART_TO_TABLE,        /* runs split below their first card  */
+    SOLVER_PHASE_FOUNDATION_TO_TABLE,  /* foundation column -> column target */
+    SOLVER_PHASE_COUNT
+};
+
+/*
+ * The order phases are tried in. The complete move set puts the moves that
+ * make progress (safe pushes, runs that uncover a card or empty a column,
+ * waste plays) ahead of the ones that mostly widen the tree (unsafe pushes,
+ * split runs, cards back off the foundations), and never moves a whole
+ * column onto an empty one.
+ */
+static const uint8_t g_NextPhase[2][SOLVER_PHASE_COUNT] = {
+    {
+        [SOLVER_PHASE_ENTER]               = SOLVER_PHASE_TABLE_TO_FOUNDATION,
+        [SOLVER_PHASE_TABLE_TO_FOUNDATION] = SOLVER_PHASE_WASTE_TO_FOUNDATION,
+        [SOLVER_PHASE_WASTE_TO_FOUNDATION] = SOLVER_PHASE_TABLE_TO_TABLE,
+        [SOLVER_PHASE_TABLE_TO_TABLE]      = SOLVER_PHASE_WASTE_TO_TABLE,
+        [SOLVER_PHASE_WASTE_TO_TABLE]      = SOLVER_PHASE_DRAW,
+        [SOLVER_PHASE_DRAW]                = SOLVER_PHASE_DONE,
+        [SOLVER_PHASE_DONE]                = SOLVER_PHASE_DONE,
+    },
+    {
+        [SOLVER_PHASE_ENTER]                      = SOLVER_PHASE_TABLE_TO_FOUNDATION,
+        [SOLVER_PHASE_TABLE_TO_FOUNDATION]        = SOLVER_PHASE_WASTE_TO_FOUNDATION,
+        [SOLVER_PHASE_WASTE_TO_FOUNDATION]        = SOLVER_PHASE_RUN_TO_TABLE,
+        [SOLVER_PHASE_RUN_TO_TABLE]               = SOLVER_PHASE_WASTE_TO_TABLE,
+        [SOLVER_PHASE_WASTE_TO_TABLE]             = SOLVER_PHASE_TABLE_TO_FOUNDATION_UNSAFE,
+        [SOLVER_PHASE_TABLE_TO_FOUNDATION_UNSAFE] = SOLVER_PHASE_WASTE_TO_FOUNDATION_UNSAFE,
+        [SOLVER_PHASE_WASTE_TO_FOUNDATION_UNSAFE] = SOLVER_PHASE_PART_TO_TABLE,
+        [SOLVER_PHASE_PART_TO_TABLE]              = SOLVER_PHASE_FOUNDATION_TO_TABLE,
+        [SOLVER_PHASE_FOUNDATION_TO_TABLE]        = SOLVER_PHASE_DRAW,
+        [SOLVER_PHASE_DRAW]                       = SOLVER_PHASE_DONE,
+        [SOLVER_PHASE_DONE]                       = SOLVER_PHASE_DONE,
+    },
+};
+
+typedef enum { NODE_PRUNED, NODE_EXPAND, NODE_WON } NodeVisit;
+
+/* Which table -> table moves a phase generates. */
+typedef enum { RUNS_ALL, RUNS_WHOLE, RUNS_PARTIAL } RunFilter;
+
+/**
+ * solver_visit_node
+ * First visit of states[depth]: apply forced moves in place, then check for
+ * a win and run the node budget, transposition and "no progress" prunes.
+ */
+static NodeVisit solver_visit_node(SolverContext *solver, int searchDepth)
+{
+    if (searchDepth >= DFS_MAX_DEPTH) { return NODE_PRUNED; }
+
+    KlondikeGame *currentState = &solver->states[searchDepth];
+
+    /* Apply safe/forced moves in-place to shrink branching. */
+    apply_forced_moves(currentState);
+
+    if (cs_klondike_is_won(currentState)) { return NODE_WON; }
+
+    /* Node budget (hard cap). */
+    if (++solver->nodeCount > DFS_NODE_LIMIT) { return NODE_PRUNED; }
+
+    /* Transposition table guard. */
+    uint64_t stateKey = compute_state_hash(currentState);
+
+    if (visited_table_contains(solver, stateKey)) { return NODE_PRUNED; }
+    visited_table_insert(solver, stateKey);
+
+    /* Quick prune (no moves & no draw/recycle). */
+    if (!exists_any_progress_move(currentState) &&
+        !((solver->options & CS_SOLVER_COMPLETE_MOVES) && exists_any_complete_move(currentState)))
+    {
+        return NODE_PRUNED;
+    }
+
+    return NODE_EXPAND;
+}
+
+/* First row of a face-up run in `column`, -1 if none is face up. */
+static int first_revealed_row(const KlondikeGame *gameState, int tableColumnIndex)
+{
+    for (int tableRowIndex = 0; tableRowIndex < gameState->table_counts[tableColumnIndex]; ++tableRowIndex)
+    {
+        if (gameState->table[tableColumnIndex][tableRowIndex].revealed) { return tableRowIndex; }
+    }
+    return -1;
+}
+
+/* True if the cards from `startRowIndex` to the top of the column form a run. */
+static int is_valid_sequence(const KlondikeGame *gameState, int tableColumnIndex, int startRowIndex)
+{
+    const Card *columnCards = gameState->table[tableColumnIndex];
+
+    for (int checkIndex = startRowIndex; checkIndex < gameState->table_counts[tableColumnIndex] - 1; ++checkIndex)
+    {
+        if (!cs_klondike_fits_table(columnCards[checkIndex + 1], columnCards[checkIndex])) { return 0; }
+    }
+    return 1;
+}
+
+/*
+ * Child generators. Each resumes from the frame's indices, writes the next
+ * child of `currentState` into `nextState` and returns 1, or returns 0 once
+ * its move family is exhausted.
+ */
+
+/* Table top -> foundation; `wantSafe` picks the safe or the unsafe pushes. */
+static int next_table_to_foundation(SolverFrame *frame, const KlondikeGame *currentState, KlondikeGame *nextState, int wantSafe)
+{
+    for (; frame->column < COLUMNS; ++frame->column, frame->target = 0)
+    {
+        const int tableColumnIndex = frame->column;
+        if (currentState->table_counts[tableColumnIndex] == 0) { continue; }
+
+        Card topTableCard = currentState->table[tableColumnIndex][currentState->table_counts[tableColumnIndex] - 1];
+        if (!topTableCard.revealed) { continue; }
+
+        while (frame->target < FOUNDATION_PILES)
+        {
+            const int foundationIndex = frame->target++;
+
+            if (cs_klondike_fits_foundation(topTableCard, &currentState->foundation[foundationIndex]) &&
+                is_safe_foundation_push(topTableCard, currentState) == wantSafe)
+            {
+                *nextState = *currentState;
+                nextState->foundation[foundationIndex].cards[nextState->foundation[foundationIndex].count++] = topTableCard;
+                nextState->table_counts[tableColumnIndex]--;
+
+                reveal_new_table_top_card(nextState, tableColumnIndex);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/* Waste -> foundation; `wantSafe` as above. */
+static int next_waste_to_foundation(SolverFrame *frame, const KlondikeGame *currentState, KlondikeGame *nextState, int wantSafe)
+{
+    if (currentState->wastePile.count == 0) { return 0; }
+
+    Card wasteTopCard = currentState->wastePile.cards[currentState->wastePile.count - 1];
+
+    while (frame->target < FOUNDATION_PILES)
+    {
+        const int foundationIndex = frame->target++;
+
+        if (cs_klondike_fits_foundation(wasteTopCard, &currentState->foundation[foundationIndex]) &&
+            is_safe_foundation_push(wasteTopCard, currentState) == wantSafe)
+        {
+            *nextState = *currentState;
+            nextState->foundation[foundationIndex].cards[nextState->foundation[foundationIndex].count++] = wasteTopCard;
+            nextState->wastePile.count--;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Table -> table: any legal revealed run, or only the whole/split ones. */
+static int next_table_to_table(SolverFrame *frame, const KlondikeGame *currentState, KlondikeGame *nextState, RunFilter filter)
+{
+    for (; frame->column < COLUMNS; ++frame->column, frame->row = 0, frame->target = 0)
+    {
+        const int fromColumnIndex       = frame->column;
+        const int firstRevealedRowIndex = first_revealed_row(currentState, fromColumnIndex);
+        if (firstRevealedRowIndex == -1) { continue; }
+
+        const int firstSplitRowIndex = firstRevealedRowIndex + (filter == RUNS_PARTIAL);
+        const int lastSplitRowIndex  = (filter == RUNS_WHOLE) ? firstRevealedRowIndex
+                                                              : currentState->table_counts[fromColumnIndex] - 1;
+
+        if (frame->row < firstSplitRowIndex) { frame->row = (uint8_t)firstSplitRowIndex; }
+
+        for (; frame->row <= lastSplitRowIndex; ++frame->row, frame->target = 0)
+        {
+            const int splitRowIndex = frame->row;
+            if (!is_valid_sequence(currentState, fromColumnIndex, splitRowIndex)) { continue; }
+
+            while (frame->target < COLUMNS)
+            {
+                const int toColumnIndex = frame->target++;
+                if (toColumnIndex == fromColumnIndex) { continue; }
+
+                /* A whole column onto an empty one changes nothing. */
+                if (filter == RUNS_WHOLE && splitRowIndex == 0 && currentState->table_counts[toColumnIndex] == 0) { continue; }
+
+                if (!can_move_sequence_onto_column(currentState, fromColumnIndex, splitRowIndex, toColumnIndex)) { continue; }
+
+                *nextState = *currentState;
+                apply_move_sequence_between_columns(nextState, fromColumnIndex, splitRowIndex, toColumnIndex);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/* Waste -> table (King to empty, descending/alt-color otherwise). */
+static int next_waste_to_table(SolverFrame *frame, const KlondikeGame *currentState, KlondikeGame *nextState)
+{
+    if (currentState->wastePile.count == 0) { return 0; }
+
+    Card wasteTopCard = currentState->wastePile.cards[currentState->wastePile.count - 1];
+    wasteTopCard.revealed = 1;
+
+    while (frame->target < COLUMNS)
+    {
+        const int toColumnIndex = frame->target++;
+
+        if (currentState->table_counts[toColumnIndex] == 0)
+        {
+            if (!is_king(&wasteTopCard)) { continue; }
+        }
+        else
+        {
+            Card destTopCard = currentState->table[toColumnIndex][currentState->table_counts[toColumnIndex] - 1];
+            if (!cs_klondike_fits_table(wasteTopCard, destTopCard)) { continue; }
+        }
+
+        *nextState = *currentState;
+        nextState->table[toColumnIndex][nextState->table_counts[toColumnIndex]++] = wasteTopCard;
+        nextState->wastePile.count--;
+        return 1;
+    }
+    return 0;
+}
+
+/* Foundation top -> table; the frame's column is the foundation. */
+static int next_foundation_to_table(SolverFrame *frame, const KlondikeGame *currentState, KlondikeGame *nextState)
+{
+    for (; frame->column < FOUNDATION_PILES; ++frame->column, frame->target = 0)
+    {
+        const int    foundationIndex = frame->column;
+        const Stack *foundation      = &currentState->foundation[foundationIndex];
+        if (foundation->count == 0) { continue; }
+
+        Card foundationTopCard = foundation->cards[foundation->count - 1];
+        foundationTopCard.revealed = 1;
+
+        while (frame->target < COLUMNS)
+        {
+            const int toColumnIndex = frame->target++;
+            if (!fits_column(currentState, foundationTopCard, toColumnIndex)) { continue; }
+
+            *nextState = *currentState;
+            nextState->table[toColumnIndex][nextState->table_counts[toColumnIndex]++] = foundationTopCard;
+            nextState->foundation[foundationIndex].count--;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Draw from stock (or recycle the waste in Easy); one child at most. */
+static int next_draw(SolverFrame *frame, const KlondikeGame *currentState, KlondikeGame *nextState)
+{
+    if (frame->target++ > 0) { return 0; }
+
+    if (currentState->drawPile.count > 0)
+    {
+        int drawCount  = (currentState->difficulty == DIFFICULTY_HARD) ? 3 : 1;
+        int actualDraw = (currentState->drawPile.count < drawCount) ? currentState->drawPile.count : drawCount;
+
+        *nextState = *currentState;
+        for (int drawIndex = 0; drawIndex < actualDraw; ++drawIndex)
+        {
+            nextState->wastePile.cards[nextState->wastePile.count++] =
+                nextState->drawPile.cards[--nextState->drawPile.count];
+        }
+        return 1;
+    }
+    if (currentState->difficulty == DIFFICULTY_EASY && currentState->wastePile.count > 0)
+    {
+        /* Easy: recycle waste -> draw and keep searching. */
+        *nextState = *currentState;
+        for (int wasteIndex = nextState->wastePile.count - 1; wasteIndex >= 0; --wasteIndex)
+        {
+            nextState->drawPile.cards[nextState->drawPile.count++] = nextState->wastePile.cards[wasteIndex];
+        }
+        nextState->wastePile.count = 0;
+        nextState->recycled        = true;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * solver_next_child
+ * Advance the iterator of states[depth] to its next child and write that
+ * child into states[depth+1], moving through the phases in g_NextPhase
+ * order. The default order is:
+ *   1) table top -> foundation (safe only),
+ *   2) waste -> foundation (safe only),
+ *   3) table -> table (any legal revealed run),
+ *   4) waste -> table (King to empty, descending/alt-color otherwise),
+ *   5) draw from stock (or recycle the waste in Easy).
+ *
+ * @return 1 if a child was produced, 0 once the node is exhausted.
+ */
+static int solver_next_child(SolverContext *solver, int searchDepth)
+{
+    SolverFrame        *frame        = &solver->frames[searchDepth];
+    const KlondikeGame *currentState = &solver->states[searchDepth];
+    KlondikeGame       *nextState    = &solver->states[searchDepth + 1];
+    const int           moveSet      = (solver->options & CS_SOLVER_COMPLETE_MOVES) ? 1 : 0;
+
+    for (;;)
+    {
+        int produced;
+
+        switch (frame->phase)
+        {
+        case SOLVER_PHASE_TABLE_TO_FOUNDATION:        produced = next_table_to_foundation(frame, currentState, nextState, 1); break;
+        case SOLVER_PHASE_WASTE_TO_FOUNDATION:        produced = next_waste_to_foundation(frame, currentState, nextState, 1); break;
+        case SOLVER_PHASE_TABLE_TO_TABLE:             produced = next_table_to_table(frame, currentState, nextState, RUNS_ALL); break;
+        case SOLVER_PHASE_WASTE_TO_TABLE:             produced = next_waste_to_table(frame, currentState, nextState); break;
+        case SOLVER_PHASE_DRAW:                       produced = next_draw(frame, currentState, nextState); break;
+        case SOLVER_PHASE_RUN_TO_TABLE:               produced = next_table_to_table(frame, currentState, nextState, RUNS_WHOLE); break;
+        case SOLVER_PHASE_TABLE_TO_FOUNDATION_UNSAFE: produced = next_table_to_foundation(frame, currentState, nextState, 0); break;
+        case SOLVER_PHASE_WASTE_TO_FOUNDATION_UNSAFE: produced = next_waste_to_foundation(frame, currentState, nextState, 0); break;
+        case SOLVER_PHASE_PART_TO_TABLE:              produced = next_table_to_table(frame, currentState, nextState, RUNS_PARTIAL); break;
+        case SOLVER_PHASE_FOUNDATION_TO_TABLE:        produced = next_foundation_to_table(frame, currentState, nextState); break;
+        default:                                      return 0;   /* done (or a damaged checkpoint) */
+        }
+
+        if (produced) { return 1; }
+
+        frame->phase  = g_NextPhase[moveSet][frame->phase];
+        frame->column = 0;
+        frame->row    = 0;
+        frame->target = 0;
+    }
+}
+
+/**
+ * cs_solver_create
+ * One zeroed arena holds the state stack, the frame stack and then the
+ * transposition table (heap-backed so deep searches cannot overflow the C
+ * stack). Generation 0 is never live, so the zeroed table starts out empty.
+ */
+SolverContext *cs_solver_create(void)
+{
+    const size_t statesBytes  = sizeof(KlondikeGame) * (DFS_MAX_DEPTH + 2);
+    const size_t framesBytes  = sizeof(SolverFrame) * (DFS_MAX_DEPTH + 1);
+    const size_t visitedAlign = _Alignof(VisitedEntry);
+    const size_t visitedAt    = (statesBytes + framesBytes + visitedAlign - 1) / visitedAlign * visitedAlign;
+    const size_t arenaBytes   = visitedAt + sizeof(VisitedEntry) * VISITED_CAP;
+
+    SolverContext *solver = (SolverContext *)calloc(1, sizeof(SolverContext));
+    if (!solver) { return NULL; }
+
+    solver->arena = calloc(1, arenaBytes);
+    if (!solver->arena)
+    {
+        free(solver);
+        return NULL;
+    }
+
+    solver->states  = (KlondikeGame *)solver->arena;
+    solver->frames  = (SolverFrame *)((unsigned char *)solver->arena + statesBytes);
+    solver->visited = (VisitedEntry *)((unsigned char *)solver->arena + visitedAt);
+    solver->status  = CS_SOLVE_LOST;
+    return solver;
+}
+
+void cs_solver_destroy(SolverContext *solver)
+{
+    if (!solver) { return; }
+    free(solver->arena);
+    free(solver);
+}
+
+/**
+ * cs_solver_begin
+ * Start a new table generation (an O(1) clear) and put the root on the
+ * state stack, unexpanded. A root that is already won settles at once.
+ */
+void cs_solver_begin(SolverContext *solver, const KlondikeGame *gameState)
+{
+    solver->nodeCount = 0;
+    solver->depth     = 0;
+
+    if (cs_klondike_is_won(gameState))
+    {
+        solver->status = CS_SOLVE_WON;
+        return;
+    }
+
+    /* After 2^32 - 1 solves the tags wrap: clear for real, once. */
+    if (++solver->generation == 0)
+    {
+        memset(solver->visited, 0, sizeof(VisitedEntry) * VISITED_CAP);
+        solver->generation = 1;
+    }
+
+    solver->states[0] = *gameState;
+    solver->frames[0] = (SolverFrame){ 0 };
+    solver->status    = CS_SOLVE_RUNNING;
+}
+
+/**
+ * cs_solver_run
+ * Drive the frame stack: visit the node on top, then either descend into
+ * its next child or pop it once exhausted. Yields (still RUNNING) before
+ * visiting a node once `nodeBudget` nodes were expanded by this call.
+ */
+CsSolveStatus cs_solver_run(SolverContext *solver, size_t nodeBudget)
+{
+    TRACE_SCOPE("cs_solver_run");
+    const size_t yieldAt = nodeBudget ? solver->nodeCount + nodeBudget : SIZE_MAX;
+
+    while (solver->status == CS_SOLVE_RUNNING)
+    {
+        const int searchDepth = solver->depth;
+
+        if (searchDepth < 0)
+        {
+            solver->status = CS_SOLVE_LOST;
+            break;
+        }
+
+        SolverFrame *frame = &solver->frames[searchDepth];
+
+        if (frame->phase == SOLVER_PHASE_ENTER)
+        {
+            if (solver->nodeCount >= yieldAt) { break; }
+
+            const NodeVisit visit = solver_visit_node(solver, searchDepth);
+            if (visit == NODE_WON)
+            {
+                solver->status = CS_SOLVE_WON;
+                break;
+            }
+            if (visit == NODE_PRUNED)
+            {
+                solver->depth--;
+                continue;
+            }
+            frame->phase = g_NextPhase[(solver->options & CS_SOLVER_COMPLETE_MOVES) ? 1 : 0][SOLVER_PHASE_ENTER];
+        }
+
+        if (solver_next_child(solver, searchDepth))
+        {
+            solver->frames[searchDepth + 1] = (SolverFrame){ 0 };
+            solver->depth = searchDepth + 1;
+        }
+        else
+        {
+            solver->depth--;
+        }
+    }
+
+    return solver->status;
+}
+
+/**
+ * cs_klondike_solve
+ * Entry point for the solver: cs_solver_begin() then cs_solver_run() with
+ * no node budget.
+ *
+ * @return true if a winning sequence was found from the initial state.
+ */
+bool cs_klondike_solve(SolverContext *solver, const KlondikeGame *gameState)
+{
+    TRACE_SCOPE("cs_klondike_solve");
+    if (!solver) { return cs_klondike_is_won(gameState); }
+
+    cs_solver_begin(solver, gameState);
+    return cs_solver_run(solver, 0) == CS_SOLVE_WON;
+}
+
+/* -------------------------------------------------------------------------- */
+/* Blind solving (determinized sampling)                                      */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * cs_klondike_determinize
+ * Gather the unseen cards (face-down column cards, then the stock unless it
+ * was recycled: every card in it has then been through the waste), shuffle
+ * them and deal them back into the same places; every slot keeps its
+ * face-down/face-up flag.
+ */
+void cs_klondike_determinize(const KlondikeGame *gameState, KlondikeGame *outState, CsRng *rng)
+{
+    Card unseenCards[DECK_SIZE];
+    int  unseenCount = 0;
+
+    *outState = *gameState;
+
+    for (int tableColumnIndex = 0; tableColumnIndex < COLUMNS; ++tableColumnIndex)
+    {
+        for (int tableRowIndex = 0; tableRowIndex < outState->table_counts[tableColumnIndex]; ++tableRowIndex)
+        {
+            const Card *tableCard = &outState->table[tableColumnIndex][tableRowIndex];
+            if (!tableCard->revealed && unseenCount < DECK_SIZE) { unseenCards[unseenCount++] = *tableCard; }
+        }
+    }
+    const int unseenStock = outState->recycled ? 0 : outState->drawPile.count;
+    for (int stockIndex = 0; stockIndex < unseenStock && unseenCount < DECK_SIZE; ++stockIndex)
+    {
+        unseenCards[unseenCount++] = outState->drawPile.cards[stockIndex];
+    }
+
+    cs_deck_shuffle(unseenCards, unseenCount, rng);
+
+    int readIndex = 0;
+    for (int tableColumnIndex = 0; tableColumnIndex < COLUMNS; ++tableColumnIndex)
+    {
+        for (int tableRowIndex = 0; tableRowIndex < outState->table_counts[tableColumnIndex]; ++tableRowIndex)
+        {
+            Card *tableCard = &outState->table[tableColumnIndex][tableRowIndex];
+            if (tableCard->revealed || readIndex >= unseenCount) { continue; }
+
+            *tableCard          = unseenCards[readIndex++];
+            tableCard->revealed = 0;
+        }
+    }
+    for (int stockIndex = 0; stockIndex < unseenStock && readIndex < unseenCount; ++stockIndex)
+    {
+        outState->drawPile.cards[stockIndex]          = unseenCards[readIndex++];
+        outState->drawPile.cards[stockIndex].revealed = 1;
+    }
+}
+
+/**
+ * cs_klondike_blind_solve
+ * Solve `samples` determinizations of `gameState`, each cut off after
+ * `nodeBudget` nodes, and add the outcome to `result`.
+ */
+void cs_klondike_blind_solve(SolverContext *solver, const KlondikeGame *gameState, int samples,
+                             size_t nodeBudget, CsRng *rng, CsBlindResult *result)
+{
+    TRACE_SCOPE("cs_klondike_blind_solve");
+    KlondikeGame sampleState;
+
+    for (int sampleIndex = 0; sampleIndex < samples; ++sampleIndex)
+    {
+        cs_klondike_determinize(gameState, &sampleState, rng);
+
+        cs_solver_begin(solver, &sampleState);
+        const CsSolveStatus status = cs_solver_run(solver, nodeBudget);
+
+        result->samples++;
+        result->wins       += (status == CS_SOLVE_WON);
+        result->unresolved += (status == CS_SOLVE_RUNNING || solver->nodeCount > DFS_NODE_LIMIT);
+        result->nodes      += solver->nodeCount;
+    }
+}
@@ -0,0 +1,584 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * libcardsim: game state snapshots (see cardsim.h).
+ *
+ * Responsibilities:
+ *   - The per-game field schemas every snapshot is checked against.
+ *   - Opening snapshots and snapshot streams with full bounds checks, so
+ *     the inline accessors can read fields in place.
+ *   - The snapshot writer, and the engine writers/restorers built on it,
+ *     including the player views that hide what seat 0 may not see.
+ *   - Solver checkpoints: a paused search (frames, path states as a
+ *     snapshot stream, transposition table) flattened and loaded back.
+ */
+
+#include "cardsim.h"
+
+#include <string.h>
+
+/* ------------------------------------------------------------------------- */
+/* Schemas                                                                   */
+/* ------------------------------------------------------------------------- */
+
+/* A field kind is its scalar width in bytes, or LIST for a card list. */
+#define LIST  0
+
+static const uint8_t g_BlackjackKinds[CS_SNAP_BJ_FIELDS] = {
+    [CS_SNAP_BJ_RNG]        = 8, [CS_SNAP_BJ_NET]        = 8,
+    [CS_SNAP_BJ_DECKS]      = 1, [CS_SNAP_BJ_SHOE_NEXT]  = 2,
+    [CS_SNAP_BJ_SHOE]       = LIST,
+    [CS_SNAP_BJ_HAND_COUNT] = 1, [CS_SNAP_BJ_ACTIVE]     = 1,
+    [CS_SNAP_BJ_DEALER]     = LIST,
+    [CS_SNAP_BJ_HAND0]      = LIST, [CS_SNAP_BJ_HAND1]   = LIST,
+    [CS_SNAP_BJ_BET0]       = 4, [CS_SNAP_BJ_BET1]       = 4,
+    [CS_SNAP_BJ_FLAGS0]     = 1, [CS_SNAP_BJ_FLAGS1]     = 1,
+    [CS_SNAP_BJ_RESULT0]    = 1, [CS_SNAP_BJ_RESULT1]    = 1,
+};
+
+static const uint8_t g_KlondikeKinds[CS_SNAP_KL_FIELDS] = {
+    [CS_SNAP_KL_DIFFICULTY] = 1, [CS_SNAP_KL_UNDO]       = 1,
+    /* columns, stock, waste and foundations are lists (LIST == 0) */
+    [CS_SNAP_KL_VERDICT]    = 1, [CS_SNAP_KL_NODES]      = 4,
+    [CS_SNAP_KL_SOLVER]     = 1, [CS_SNAP_KL_RECYCLED]   = 1,
+};
+
+static const uint8_t g_IdiotKinds[CS_SNAP_ID_FIELDS] = {
+    [CS_SNAP_ID_TURN]         = 1, [CS_SNAP_ID_WINNER]      = 1,
+    [CS_SNAP_ID_DIFFICULTY0]  = 1, [CS_SNAP_ID_DIFFICULTY1] = 1,
+    /* seat zones, draw, waste and the last turn are lists */
+    [CS_SNAP_ID_LAST_BURNED]  = 1, [CS_SNAP_ID_LAST_MIRRORED] = 1,
+};
+
+/* Most cards a game's lists can hold between them (a card is in one list,
+   except the copies of the last Idiot turn). */
+static const int g_MaxCards[4] = {
+    0, MAX_SHOE_DECKS * DECK_SIZE, DECK_SIZE, DECK_SIZE + 2 + LASTMOVE_MAX
+};
+
+static const uint8_t *schema(int game, int *count)
+{
+    switch (game) {
+        case CS_GAME_BLACKJACK: *count = CS_SNAP_BJ_FIELDS; return g_BlackjackKinds;
+        case CS_GAME_KLONDIKE:  *count = CS_SNAP_KL_FIELDS; return g_KlondikeKinds;
+        case CS_GAME_IDIOT:     *count = CS_SNAP_ID_FIELDS; return g_IdiotKinds;
+        default:                *count = 0;                 return NULL;
+    }
+}
+
+size_t cs_snap_max_size(CsGame game)
+{
+    int            count;
+    const uint8_t *kinds = schema(game, &count);
+    if (!kinds) return 0;
+
+    size_t size = CS_SNAP_HEADER_SIZE + 2 * (size_t)count + (size_t)g_MaxCards[game];
+    for (int i = 0; i < count; ++i) size += kinds[i] == LIST ? 2 : kinds[i];
+    return size;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Reading                                                                   */
+/* ------------------------------------------------------------------------- */
+
+bool cs_snap_open(CsSnapshot *snap, const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    if (size < CS_SNAP_HEADER_SIZE || cs_snap_le(bytes, 4) != CS_SNAP_MAGIC) return false;
+
+    const uint32_t total      = (uint32_t)cs_snap_le(bytes + 8, 4);
+    const uint16_t fieldCount = (uint16_t)cs_snap_le(bytes + 12, 2);
+    const uint32_t dataStart  = CS_SNAP_HEADER_SIZE + 2u * fieldCount;
+    if (cs_snap_le(bytes + 4, 2) == 0 || total > size || total < dataStart) return false;
+
+    int            known;
+    const uint8_t *kinds = schema(bytes[6], &known);
+    if (!kinds) return false;
+
+    snap->data       = bytes;
+    snap->size       = total;
+    snap->fieldCount = fieldCount;
+    snap->game       = bytes[6];
+    snap->flags      = bytes[7];
+
+    /* Fields from newer writers are skipped, so only ours need checking. */
+    for (int i = 0; i < known && i < fieldCount; ++i) {
+        const uint32_t offset = cs_snap_offset(snap, i);
+        if (offset == 0) continue;
+        if (offset < dataStart) return false;
+
+        uint32_t end = offset + (kinds[i] == LIST ? 2u : kinds[i]);
+        if (end > total) return false;
+        if (kinds[i] == LIST) end += (uint32_t)cs_snap_le(bytes + offset, 2);
+        if (end > total) return false;
+    }
+    return true;
+}
+
+bool cs_snap_next(const void *stream, size_t size, size_t *offset, CsSnapshot *snap)
+{
+    if (*offset >= size) return false;
+    if (!cs_snap_open(snap, (const uint8_t *)stream + *offset, size - *offset)) return false;
+    *offset += snap->size;
+    return true;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Writing                                                                   */
+/* ------------------------------------------------------------------------- */
+
+static void put_le(uint8_t *bytes, uint64_t value, int width)
+{
+    for (int i = 0; i < width; ++i) bytes[i] = (uint8_t)(value >> (8 * i));
+}
+
+void cs_snap_begin(CsSnapWriter *writer, void *buffer, size_t capacity, CsGame game, unsigned flags)
+{
+    int count;
+    schema(game, &count);
+
+    writer->data       = (uint8_t *)buffer;
+    writer->capacity   = capacity;
+    writer->fieldCount = count;
+    writer->flags      = flags;
+    writer->length     = CS_SNAP_HEADER_SIZE + 2 * (size_t)count;
+    writer->overflow   = count == 0 || writer->length > capacity;
+    if (writer->overflow) return;
+
+    put_le(writer->data, CS_SNAP_MAGIC, 4);
+    put_le(writer->data + 4, CS_SNAP_VERSION, 2);
+    writer->data[6] = (uint8_t)game;
+    writer->data[7] = (uint8_t)flags;
+    put_le(writer->data + 12, (uint64_t)count, 2);
+    memset(writer->data + CS_SNAP_HEADER_SIZE, 0, 2 * (size_t)count);
+}
+
+/* Claim `bytes` for `field` (which must be of `kind`) and point its offset at them. */
+static uint8_t *take(CsSnapWriter *writer, int field, int kind, size_t bytes)
+{
+    int            count;
+    const uint8_t *kinds = writer->overflow ? NULL : schema(writer->data[6], &count);
+
+    if (!kinds || field < 0 || field >= count || kinds[field] != kind ||
+        writer->length + bytes > writer->capacity || writer->length > 0xFFFF) {
+        writer->overflow = true;
+        return NULL;
+    }
+    uint8_t *out = writer->data + writer->length;
+    put_le(writer->data + CS_SNAP_HEADER_SIZE + 2 * field, writer->length, 2);
+    writer->length += bytes;
+    return out;
+}
+
+void cs_snap_put(CsSnapWriter *writer, int field, uint64_t value, int width)
+{
+    uint8_t *out = take(writer, field, width, (size_t)width);
+    if (out) put_le(out, value, width);
+}
+
+uint8_t *cs_snap_put_list(CsSnapWriter *writer, int field, int count)
+{
+    uint8_t *out = take(writer, field, LIST, 2 + (size_t)count);
+    if (!out) return NULL;
+    put_le(out, (uint64_t)count, 2);
+    return out + 2;
+}
+
+void cs_snap_put_cards(CsSnapWriter *writer, int field, const Card *cards, int count, bool hideFaceDown)
+{
+    uint8_t *out = cs_snap_put_list(writer, field, count);
+    if (!out) return;
+    for (int i = 0; i < count; ++i) {
+        out[i] = (hideFaceDown && !cards[i].revealed) ? CS_SNAP_HIDDEN : cs_snap_card(cards[i]);
+    }
+}
+
+void cs_snap_put_hidden(CsSnapWriter *writer, int field, int count)
+{
+    uint8_t *out = cs_snap_put_list(writer, field, count);
+    if (out) memset(out, CS_SNAP_HIDDEN, (size_t)count);
+}
+
+size_t cs_snap_finish(CsSnapWriter *writer)
+{
+    if (writer->overflow) return 0;
+    put_le(writer->data + 8, writer->length, 4);
+    return writer->length;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Restoring                                                                 */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * read_cards
+ * Copy list `field` into `cards` (room for `capacity`). Absent lists are
+ * empty; hidden or unknown cards, or too many of them, fail.
+ */
+static bool read_cards(const CsSnapshot *snap, int field, Card *cards, int capacity, int *count)
+{
+    const uint8_t *bytes = cs_snap_cards(snap, field, count);
+    if (*count > capacity) return false;
+
+    for (int i = 0; i < *count; ++i) {
+        const unsigned id = bytes[i] & ~CS_SNAP_FACE_UP;
+        if (bytes[i] == CS_SNAP_HIDDEN || id >= CS_CARD_COUNT) return false;
+        cards[i]          = cs_card_from_id((int)id);
+        cards[i].revealed = (bytes[i] & CS_SNAP_FACE_UP) ? 1 : 0;
+    }
+    return true;
+}
+
+static bool restorable(const CsSnapshot *snap, CsGame game)
+{
+    return snap->game == game && !(snap->flags & CS_SNAP_PLAYER_VIEW);
+}
+
+/* ------------------------------------------------------------------------- */
+/* Blackjack                                                                 */
+/* ------------------------------------------------------------------------- */
+
+void cs_blackjack_snapshot_write(CsSnapWriter *w, const CsBlackjackTable *table)
+{
+    const bool view     = (w->flags & CS_SNAP_PLAYER_VIEW) != 0;
+    const int  shoeNext = table->shoe.next_index;
+
+    if (!view) cs_snap_put(w, CS_SNAP_BJ_RNG, table->rng.state, 8);
+    cs_snap_put(w, CS_SNAP_BJ_NET,        (uint64_t)table->net, 8);
+    cs_snap_put(w, CS_SNAP_BJ_DECKS,      (uint64_t)table->shoe.decks_in_shoe, 1);
+    cs_snap_put(w, CS_SNAP_BJ_SHOE_NEXT,  (uint64_t)shoeNext, 2);
+    if (!view) {
+        cs_snap_put_cards(w, CS_SNAP_BJ_SHOE, &table->shoe.cards[shoeNext],
+                          table->shoe.total - shoeNext, false);
+    }
+    cs_snap_put(w, CS_SNAP_BJ_HAND_COUNT, (uint64_t)table->handCount, 1);
+    cs_snap_put(w, CS_SNAP_BJ_ACTIVE,     (uint64_t)table->active, 1);
+
+    /* The hole card stays hidden from the player until the round is over. */
+    uint8_t *dealer = cs_snap_put_list(w, CS_SNAP_BJ_DEALER, table->dealer.count);
+    if (dealer) {
+        const bool live = table->handCount > 0 && !cs_blackjack_round_over(table);
+        for (int i = 0; i < table->dealer.count; ++i) {
+            dealer[i] = (view && live && i >= 1) ? CS_SNAP_HIDDEN : cs_snap_card(table->dealer.cards[i]);
+        }
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        const Hand *hand = &table->hands[i];
+        cs_snap_put_cards(w, CS_SNAP_BJ_HAND0 + i, hand->cards, hand->count, false);
+        cs_snap_put(w, CS_SNAP_BJ_BET0 + i,   hand->bet, 4);
+        cs_snap_put(w, CS_SNAP_BJ_FLAGS0 + i, (hand->doubled     ? CS_SNAP_HAND_DOUBLED     : 0) |
+                                              (hand->fromSplit   ? CS_SNAP_HAND_SPLIT       : 0) |
+                                              (hand->surrendered ? CS_SNAP_HAND_SURRENDERED : 0), 1);
+        cs_snap_put(w, CS_SNAP_BJ_RESULT0 + i, (uint64_t)table->results[i], 1);
+    }
+}
+
+size_t cs_blackjack_snapshot(const CsBlackjackTable *table, unsigned flags, void *out, size_t capacity)
+{
+    CsSnapWriter writer;
+    cs_snap_begin(&writer, out, capacity, CS_GAME_BLACKJACK, flags);
+    cs_blackjack_snapshot_write(&writer, table);
+    return cs_snap_finish(&writer);
+}
+
+bool cs_blackjack_restore(CsBlackjackTable *table, const CsSnapshot *snap, const CsStatsSink *stats)
+{
+    if (!restorable(snap, CS_GAME_BLACKJACK)) return false;
+
+    const int decks    = cs_snap_u8(snap, CS_SNAP_BJ_DECKS);
+    const int shoeNext = cs_snap_u16(snap, CS_SNAP_BJ_SHOE_NEXT);
+    if (decks < 1 || decks > MAX_SHOE_DECKS || shoeNext > decks * DECK_SIZE) return false;
+
+    table->rng.state          = cs_snap_u64(snap, CS_SNAP_BJ_RNG);
+    table->stats              = stats ? *stats : (CsStatsSink){ 0 };
+    table->net                = (int64_t)cs_snap_u64(snap, CS_SNAP_BJ_NET);
+    table->handCount          = cs_snap_u8(snap, CS_SNAP_BJ_HAND_COUNT);
+    table->active             = cs_snap_u8(snap, CS_SNAP_BJ_ACTIVE);
+    table->shoe.decks_in_shoe = decks;
+    table->shoe.total         = decks * DECK_SIZE;
+    table->shoe.next_index    = shoeNext;
+    if (table->handCount > 2 || table->active > table->handCount) return false;
+
+    int count;
+    if (!read_cards(snap, CS_SNAP_BJ_SHOE, &table->shoe.cards[shoeNext], table->shoe.total - shoeNext, &count) ||
+        count != table->shoe.total - shoeNext) {
+        return false;
+    }
+    if (!read_cards(snap, CS_SNAP_BJ_DEALER, table->dealer.cards, CS_HAND_MAX_CARDS, &table->dealer.count)) {
+        return false;
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        Hand         *hand  = &table->hands[i];
+        const uint8_t flags = cs_snap_u8(snap, CS_SNAP_BJ_FLAGS0 + i);
+        if (!read_cards(snap, CS_SNAP_BJ_HAND0 + i, hand->cards, CS_HAND_MAX_CARDS, &hand->count)) return false;
+        hand->bet         = cs_snap_u32(snap, CS_SNAP_BJ_BET0 + i);
+        hand->doubled     = (flags & CS_SNAP_HAND_DOUBLED) != 0;
+        hand->fromSplit   = (flags & CS_SNAP_HAND_SPLIT) ? 1 : 0;
+        hand->surrendered = (flags & CS_SNAP_HAND_SURRENDERED) ? 1 : 0;
+        table->results[i] = (CsHandResult)cs_snap_u8(snap, CS_SNAP_BJ_RESULT0 + i);
+    }
+    return true;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Klondike                                                                  */
+/* ------------------------------------------------------------------------- */
+
+void cs_klondike_snapshot_write(CsSnapWriter *w, const KlondikeGame *game)
+{
+    const bool view = (w->flags & CS_SNAP_PLAYER_VIEW) != 0;
+
+    cs_snap_put(w, CS_SNAP_KL_DIFFICULTY, (uint64_t)game->difficulty, 1);
+    cs_snap_put(w, CS_SNAP_KL_UNDO,       game->undo ? 1 : 0, 1);
+    cs_snap_put(w, CS_SNAP_KL_RECYCLED,   game->recycled ? 1 : 0, 1);
+    for (int c = 0; c < COLUMNS; ++c) {
+        cs_snap_put_cards(w, CS_SNAP_KL_COLUMN0 + c, game->table[c], game->table_counts[c], view);
+    }
+    if (view) cs_snap_put_hidden(w, CS_SNAP_KL_STOCK, game->drawPile.count);
+    else      cs_snap_put_cards(w, CS_SNAP_KL_STOCK, game->drawPile.cards, game->drawPile.count, false);
+    cs_snap_put_cards(w, CS_SNAP_KL_WASTE, game->wastePile.cards, game->wastePile.count, false);
+    for (int f = 0; f < FOUNDATION_PILES; ++f) {
+        cs_snap_put_cards(w, CS_SNAP_KL_FOUNDATION0 + f, game->foundation[f].cards, game->foundation[f].count, false);
+    }
+}
+
+size_t cs_klondike_snapshot(const KlondikeGame *game, unsigned flags, void *out, size_t capacity)
+{
+    CsSnapWriter writer;
+    cs_snap_begin(&writer, out, capacity, CS_GAME_KLONDIKE, flags);
+    cs_klondike_snapshot_write(&writer, game);
+    return cs_snap_finish(&writer);
+}
+
+bool cs_klondike_restore(KlondikeGame *game, const CsSnapshot *snap)
+{
+    if (!restorable(snap, CS_GAME_KLONDIKE)) return false;
+
+    game->difficulty = cs_snap_u8(snap, CS_SNAP_KL_DIFFICULTY);
+    game->undo       = cs_snap_u8(snap, CS_SNAP_KL_UNDO) != 0;
+    game->recycled   = cs_snap_u8(snap, CS_SNAP_KL_RECYCLED) != 0;
+
+    bool ok = true;
+    for (int c = 0; c < COLUMNS; ++c) {
+        ok = ok && read_cards(snap, CS_SNAP_KL_COLUMN0 + c, game->table[c], MAX_DRAW_STACK, &game->table_counts[c]);
+    }
+    ok = ok && read_cards(snap, CS_SNAP_KL_STOCK, game->drawPile.cards, MAX_DRAW_STACK, &game->drawPile.count);
+    ok = ok && read_cards(snap, CS_SNAP_KL_WASTE, game->wastePile.cards, MAX_DRAW_STACK, &game->wastePile.count);
+    for (int f = 0; f < FOUNDATION_PILES; ++f) {
+        ok = ok && read_cards(snap, CS_SNAP_KL_FOUNDATION0 + f, game->foundation[f].cards, MAX_FOUNDATION,
+                              &game->foundation[f].count);
+    }
+    return ok;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Idiot                                                                     */
+/* ------------------------------------------------------------------------- */
+
+void cs_idiot_snapshot_write(CsSnapWriter *w, const CsIdiotGame *game)
+{
+    const bool view = (w->flags & CS_SNAP_PLAYER_VIEW) != 0;
+
+    cs_snap_put(w, CS_SNAP_ID_TURN,        (uint64_t)game->turn, 1);
+    cs_snap_put(w, CS_SNAP_ID_WINNER,      (uint8_t)game->winner, 1);
+    cs_snap_put(w, CS_SNAP_ID_DIFFICULTY0, (uint64_t)game->difficulty[0], 1);
+    cs_snap_put(w, CS_SNAP_ID_DIFFICULTY1, (uint64_t)game->difficulty[1], 1);
+
+    /* A view shows seat 0's hand and both face-up rows, nothing else. */
+    for (int s = 0; s < 2; ++s) {
+        const IdiotPlayer *player = &game->players[s];
+        const int          base   = s ? CS_SNAP_ID_HAND1 : CS_SNAP_ID_HAND0;
+
+        if (view && s == 1) cs_snap_put_hidden(w, base, player->handCount);
+        else                cs_snap_put_cards(w, base, player->hand, player->handCount, false);
+        cs_snap_put_cards(w, base + 1, player->faceUp, player->faceUpCount, false);
+        if (view) cs_snap_put_hidden(w, base + 2, player->faceDownCount);
+        else      cs_snap_put_cards(w, base + 2, player->faceDown, player->faceDownCount, false);
+    }
+
+    if (view) cs_snap_put_hidden(w, CS_SNAP_ID_DRAW, game->drawPile.count);
+    else      cs_snap_put_cards(w, CS_SNAP_ID_DRAW, game->drawPile.pile, game->drawPile.count, false);
+    cs_snap_put_cards(w, CS_SNAP_ID_WASTE,       game->wastePile.pile, game->wastePile.count, false);
+    cs_snap_put_cards(w, CS_SNAP_ID_LAST_PLAYED, game->lastMove.played, game->lastMove.playedCount, false);
+    cs_snap_put(w, CS_SNAP_ID_LAST_BURNED,   (uint64_t)game->lastMove.burned, 1);
+    cs_snap_put(w, CS_SNAP_ID_LAST_MIRRORED, (uint64_t)game->lastMove.mirrored, 1);
+}
+
+size_t cs_idiot_snapshot(const CsIdiotGame *game, unsigned flags, void *out, size_t capacity)
+{
+    CsSnapWriter writer;
+    cs_snap_begin(&writer, out, capacity, CS_GAME_IDIOT, flags);
+    cs_idiot_snapshot_write(&writer, game);
+    return cs_snap_finish(&writer);
+}
+
+bool cs_idiot_restore(CsIdiotGame *game, const CsSnapshot *snap, const CsStatsSink *stats)
+{
+    if (!restorable(snap, CS_GAME_IDIOT)) return false;
+
+    const uint8_t winner = cs_snap_u8(snap, CS_SNAP_ID_WINNER);
+    game->stats         = stats ? *stats : (CsStatsSink){ 0 };
+    game->turn          = cs_snap_u8(snap, CS_SNAP_ID_TURN);
+    game->winner        = winner == 0xFF ? -1 : winner;
+    game->difficulty[0] = cs_snap_u8(snap, CS_SNAP_ID_DIFFICULTY0);
+    game->difficulty[1] = cs_snap_u8(snap, CS_SNAP_ID_DIFFICULTY1);
+    if (game->turn > 1 || game->winner > 1) return false;
+
+    bool ok = true;
+    for (int s = 0; s < 2; ++s) {
+        IdiotPlayer *player = &game->players[s];
+        const int    base   = s ? CS_SNAP_ID_HAND1 : CS_SNAP_ID_HAND0;
+        ok = ok && read_cards(snap, base,     player->hand,     CS_IDIOT_MAX_CARDS, &player->handCount);
+        ok = ok && read_cards(snap, base + 1, player->faceUp,   FACE_UP_SIZE,       &player->faceUpCount);
+        ok = ok && read_cards(snap, base + 2, player->faceDown, FACE_DOWN_SIZE,     &player->faceDownCount);
+    }
+    ok = ok && read_cards(snap, CS_SNAP_ID_DRAW,  game->drawPile.pile,  MAX_PILE, &game->drawPile.count);
+    ok = ok && read_cards(snap, CS_SNAP_ID_WASTE, game->wastePile.pile, MAX_PILE, &game->wastePile.count);
+    ok = ok && read_cards(snap, CS_SNAP_ID_LAST_PLAYED, game->lastMove.played, LASTMOVE_MAX,
+                          &game->lastMove.playedCount);
+    if (!ok) return false;
+
+    game->lastMove.burned       = cs_snap_u8(snap, CS_SNAP_ID_LAST_BURNED);
+    game->lastMove.mirrored     = cs_snap_u8(snap, CS_SNAP_ID_LAST_MIRRORED);
+    game->lastMove.mirroredCard = game->lastMove.mirrored ? cs_idiot_mirrored_card(&game->wastePile) : NULL;
+    return true;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Solver checkpoints                                                        */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Layout (little-endian):
+ *   header   magic u32, version u16, depth u16, nodes u64,
+ *            visited count u32, state stream size u32, options u32
+ *   frames   (depth + 1) * 4 bytes: phase, column, row, target
+ *   states   depth + 1 back-to-back Klondike snapshots
+ *   visited  count * (slot u32, key u64) of the live table entries
+ * Entries go back into the same slots, so a resumed search probes exactly
+ * as the original would have.
+ */
+#define CHECKPOINT_HEADER_SIZE  28
+#define CHECKPOINT_ENTRY_SIZE   12
+
+static size_t live_visited(const SolverContext *solver)
+{
+    size_t live = 0;
+    for (size_t i = 0; i < VISITED_CAP; ++i) live += solver->visited[i].generation == solver->generation;
+    return live;
+}
+
+size_t cs_solver_checkpoint_size(const SolverContext *solver)
+{
+    if (solver->status != CS_SOLVE_RUNNING) return 0;
+
+    const size_t levels = (size_t)solver->depth + 1;
+    return CHECKPOINT_HEADER_SIZE + levels * (sizeof(SolverFrame) + cs_snap_max_size(CS_GAME_KLONDIKE)) +
+           live_visited(solver) * CHECKPOINT_ENTRY_SIZE;
+}
+
+size_t cs_solver_checkpoint(const SolverContext *solver, void *out, size_t capacity)
+{
+    if (solver->status != CS_SOLVE_RUNNING) return 0;
+
+    uint8_t     *bytes  = (uint8_t *)out;
+    const size_t levels = (size_t)solver->depth + 1;
+    size_t       length = CHECKPOINT_HEADER_SIZE + levels * sizeof(SolverFrame);
+    if (length > capacity) return 0;
+
+    for (size_t d = 0; d < levels; ++d) {
+        const SolverFrame *frame = &solver->frames[d];
+        uint8_t           *at    = bytes + CHECKPOINT_HEADER_SIZE + d * sizeof(SolverFrame);
+        at[0] = frame->phase;  at[1] = frame->column;
+        at[2] = frame->row;    at[3] = frame->target;
+    }
+
+    const size_t streamAt = length;
+    for (size_t d = 0; d < levels; ++d) {
+        const size_t written = cs_klondike_snapshot(&solver->states[d], 0, bytes + length, capacity - length);
+        if (written == 0) return 0;
+        length += written;
+    }
+    const size_t streamSize = length - streamAt;
+
+    uint32_t live = 0;
+    for (uint32_t slot = 0; slot < VISITED_CAP; ++slot) {
+        if (solver->visited[slot].generation != solver->generation) continue;
+        if (length + CHECKPOINT_ENTRY_SIZE > capacity) return 0;
+        put_le(bytes + length, slot, 4);
+        put_le(bytes + length + 4, solver->visited[slot].key, 8);
+        length += CHECKPOINT_ENTRY_SIZE;
+        live++;
+    }
+
+    put_le(bytes, CS_SOLVER_CHECKPOINT_MAGIC, 4);
+    put_le(bytes + 4, CS_SOLVER_CHECKPOINT_VERSION, 2);
+    put_le(bytes + 6, (uint64_t)solver->depth, 2);
+    put_le(bytes + 8, solver->nodeCount, 8);
+    put_le(bytes + 16, live, 4);
+    put_le(bytes + 20, streamSize, 4);
+    put_le(bytes + 24, solver->options, 4);
+    return length;
+}
+
+bool cs_solver_resume(SolverContext *solver, const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    solver->status = CS_SOLVE_LOST;
+
+    if (size < CHECKPOINT_HEADER_SIZE || cs_snap_le(bytes, 4) != CS_SOLVER_CHECKPOINT_MAGIC ||
+        cs_snap_le(bytes + 4, 2) != CS_SOLVER_CHECKPOINT_VERSION) {
+        return false;
+    }
+
+    const uint64_t depth      = cs_snap_le(bytes + 6, 2);
+    const uint64_t live       = cs_snap_le(bytes + 16, 4);
+    const uint64_t streamSize = cs_snap_le(bytes + 20, 4);
+    const size_t   framesAt   = CHECKPOINT_HEADER_SIZE;
+    const size_t   streamAt   = framesAt + ((size_t)depth + 1) * sizeof(SolverFrame);
+    const size_t   visitedAt  = streamAt + (size_t)streamSize;
+    if (depth > DFS_MAX_DEPTH || streamAt > size || streamSize > size - streamAt ||
+        live > VISITED_CAP || live * CHECKPOINT_ENTRY_SIZE != size - visitedAt) {
+        return false;
+    }
+
+    /* The states: exactly depth + 1 Klondike snapshots. */
+    const uint8_t *stream = bytes + streamAt;
+    size_t         offset = 0;
+    for (size_t d = 0; d <= depth; ++d) {
+        CsSnapshot snap;
+        if (!cs_snap_next(stream, (size_t)streamSize, &offset, &snap) ||
+            !cs_klondike_restore(&solver->states[d], &snap)) {
+            return false;
+        }
+    }
+    if (offset != streamSize) return false;
+
+    /* A fresh generation, then the frames, counters and table on top. */
+    solver->options = (unsigned)cs_snap_le(bytes + 24, 4);
+    cs_solver_begin(solver, &solver->states[0]);
+    if (solver->status != CS_SOLVE_RUNNING) {
+        solver->status = CS_SOLVE_LOST;
+        return false;
+    }
+
+    for (size_t d = 0; d <= depth; ++d) {
+        const uint8_t *at = bytes + framesAt + d * sizeof(SolverFrame);
+        solver->frames[d] = (SolverFrame){ at[0], at[1], at[2], at[3] };
+    }
+    for (size_t i = 0; i < live; ++i) {
+        const uint8_t *at   = bytes + visitedAt + i * CHECKPOINT_ENTRY_SIZE;
+        const uint64_t slot = cs_snap_le(at, 4);
+        if (slot >= VISITED_CAP) {
+            solver->status = CS_SOLVE_LOST;
+            return false;
+        }
+        solver->visited[slot] = (VisitedEntry){ cs_snap_le(at + 4, 8), solver->generation };
+    }
+    solver->depth     = (int)depth;
+    solver->nodeCount = (size_t)cs_snap_le(bytes + 8, 8);
+    return true;
+}
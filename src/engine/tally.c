@@ -0,0 +1,40 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * libcardsim: the counting stats sink (see cardsim.h).
+ *
+ * Responsibilities:
+ *   - CsTally: rounds, outcomes, wagered and net, fed through CsStatsSink.
+ *   - Merging per-worker tallies.
+ */
+
+#include "cardsim.h"
+
+void cs_tally_record(void *tally, const CsRoundResult *result)
+{
+    CsTally *counts = (CsTally *)tally;
+
+    counts->rounds++;
+    if      (result->outcome == CS_OUTCOME_WIN)  counts->wins++;
+    else if (result->outcome == CS_OUTCOME_LOSS) counts->losses++;
+    else                                         counts->pushes++;
+
+    counts->wagered += result->bet;
+    counts->net     += result->net;
+}
+
+CsStatsSink cs_tally_sink(CsTally *tally)
+{
+    return (CsStatsSink){ .record = cs_tally_record, .user = tally };
+}
+
+void cs_tally_merge(CsTally *into, const CsTally *from)
+{
+    into->rounds  += from->rounds;
+    into->wins    += from->wins;
+    into->losses  += from->losses;
+    into->pushes  += from->pushes;
+    into->wagered += from->wagered;
+    into->net     += from->net;
+}
@@ -5,23 +5,28 @@
  * Program entry + global menus, persistence, and housekeeping utilities.
  *
  * Responsibilities:
+ *   - Parse command-line options (--protocol, --seed N, --profile NAME,
+ *     --trace FILE, --bench).
  *   - Initialize player/config data and normalize persisted values.
- *   - Start/stop background threads (time tracking, optional autosave).
+ *   - Start/stop background work (write-behind persistence, autosave as an
+ *     input idle task).
  *   - Provide top-level menus (main, games, rules, other) and invoke games.
  *   - Deck helpers (init, shuffle, print) shared across game modules.
  */
 
 #include "core.h"
 #include "paths.h"
-
-#ifdef _WIN32
-  #include <windows.h>                  /* Threads + Sleep.                   */
-#else
-  /* Non-Windows: stub types so the file still compiles if you ever port it. */
-  typedef int BOOL;
-  #define TRUE 1
-  #define FALSE 0
-#endif
+#include "persist.h"
+#include "render.h"
+#include "input.h"
+#include "platform.h"
+#include "protocol.h"
+#include "rollups.h"
+#include "profile.h"
+#include "state.h"
+#include "gametimer.h"
+#include "trace.h"
+#include "bench.h"
 
 /* ------------------------------------------------------------------------- */
 /* Money constraints                                                         */
@@ -34,14 +39,8 @@
 /* Globals                                                                   */
 /* ------------------------------------------------------------------------- */
 
-
-/* Background threads + control flags (Win32 only). */
-#ifdef _WIN32
-  static volatile BOOL gStopTimeThread      = FALSE;
-  static volatile BOOL gStopAutosaveThread  = FALSE;
-  static HANDLE        gTimeThreadHandle    = NULL;
-  static HANDLE        gAutosaveThreadHandle= NULL;
-#endif
+/* Autosave runs as an idle task on the input loop; it checks once a second. */
+#define AUTOSAVE_TICK_MS  1000U
 
 /* ------------------------------------------------------------------------- */
 /* Forward declarations (menus, helpers)                                     */
@@ -49,6 +48,11 @@
 
 static void normalize_config(GameConfig *cfg);
 static void normalize_player_counters(PlayerData *pd);
+static bool load_profile_data(void);
+static int  read_menu_choice(int minOption, int maxOption);
+static void print_rollup(const HistorySummary *summary, bool showDecisions);
+static void print_difficulty_rollups(HistoryGame game);
+static void print_latencies(void);
 
 void deckMenu(void);
 void gamesMenu(void);
@@ -64,101 +68,35 @@ void resetStatistics(void);
 void resetAchievements(void);
 void statsDisplay(void);
 void printAchievements(void);
+void profilesMenu(void);
 
 /* ------------------------------------------------------------------------- */
-/* Threads (Win32)                                                           */
+/* Idle tasks                                                                */
 /* ------------------------------------------------------------------------- */
 
-#ifdef _WIN32
 /**
- * trackTimePlayedThread
- * Update time played counters (sec->min->hr) once per second.
+ * autosave_tick
+ * Every X minutes (config.autosave), write player+config to disk. Runs on
+ * the main thread while it waits for input, so frequency changes made in
+ * the menu are picked up on the next tick.
  */
-static DWORD WINAPI trackTimePlayedThread(LPVOID /*unused*/)
+static void autosave_tick(void *unused)
 {
-    while (!gStopTimeThread) {
-        Sleep(1000);
-        playerData.time_played_seconds++;
-        if (playerData.time_played_seconds >= 60) {
-            playerData.time_played_minutes++;
-            playerData.time_played_seconds = 0;
-        }
-        if (playerData.time_played_minutes >= 60) {
-            playerData.time_played_hours++;
-            playerData.time_played_minutes = 0;
-        }
-    }
-    return 0;
-}
+    (void)unused;
+    static uint64_t lastSaveMs = 0;
 
-/**
- * autosave_worker
- * Every X minutes (config.autosave), write player+config to disk.
- * Sleeps in small steps so UI changes to the frequency are picked up quickly.
- */
-static DWORD WINAPI autosave_worker(LPVOID /*unused*/)
-{
-    const int kMsPerMinute = 60000;
-    const int kTickMs      = 1000;
-
-    int elapsedMs = 0;
-    while (!gStopAutosaveThread) {
-        /* If autosave is disabled, idle lightly. */
-        if (config.autosave <= 0) {
-            Sleep(kTickMs);
-            continue;
-        }
-
-        /* Run save when elapsed crosses threshold; else keep sleeping. */
-        if (elapsedMs >= config.autosave * kMsPerMinute) {
-            save_player_data();
-            save_achievements();
-            elapsedMs = 0;
-        }
-        Sleep(kTickMs);
-        elapsedMs += kTickMs;
+    const uint64_t now = platform_now_ms();
+    if (lastSaveMs == 0 || config.autosave <= 0) {
+        lastSaveMs = now;   /* (re)start the interval when enabled */
+        return;
     }
-    return 0;
-}
 
-static void start_time_thread(void)
-{
-    if (!gTimeThreadHandle) {
-        gStopTimeThread   = FALSE;
-        gTimeThreadHandle = CreateThread(NULL, 0, trackTimePlayedThread, NULL, 0, NULL);
-        if (!gTimeThreadHandle) {
-            printf("Failed to create time tracking thread.\n");
-        }
-    }
-}
-
-static void start_autosave_thread_if_needed(void)
-{
-    if (!gAutosaveThreadHandle) {
-        gStopAutosaveThread   = FALSE;
-        gAutosaveThreadHandle = CreateThread(NULL, 0, autosave_worker, NULL, 0, NULL);
-        if (!gAutosaveThreadHandle) {
-            printf("Failed to create autosave thread.\n");
-        }
-    }
-}
-
-static void stop_threads_and_cleanup(void)
-{
-    if (gTimeThreadHandle) {
-        gStopTimeThread = TRUE;
-        WaitForSingleObject(gTimeThreadHandle, INFINITE);
-        CloseHandle(gTimeThreadHandle);
-        gTimeThreadHandle = NULL;
-    }
-    if (gAutosaveThreadHandle) {
-        gStopAutosaveThread = TRUE;
-        WaitForSingleObject(gAutosaveThreadHandle, INFINITE);
-        CloseHandle(gAutosaveThreadHandle);
-        gAutosaveThreadHandle = NULL;
+    if (now - lastSaveMs >= (uint64_t)config.autosave * 60000ULL) {
+        persist_mark_dirty(PERSIST_ALL);
+        persist_flush();
+        lastSaveMs = now;
     }
 }
-#endif /* _WIN32 */
 
 /* ------------------------------------------------------------------------- */
 /* Small utilities                                                           */
@@ -200,40 +138,139 @@ static void normalize_player_counters(PlayerData *pd)
     }
 }
 
+/**
+ * load_profile_data
+ * Load everything owned by the active profile: achievements, stats rollups
+ * and player data + config (normalized). Used at startup and after a switch.
+ *
+ * @return true if the profile has saved player data; false for a new one.
+ */
+static bool load_profile_data(void)
+{
+    /* Initialize achievements registry (creates file on first run). */
+    initialize_achievements();
+
+    /* Precomputed stats for the dashboard (rebuilt from history if missing). */
+    rollups_init();
+
+    if (!load_player_data()) {
+        memset(&playerData, 0, sizeof(playerData));
+        state_playtime_set(0);
+        return false;
+    }
+
+    normalize_config(&config);
+    normalize_player_counters(&playerData);
+    state_playtime_set((unsigned long long)playerData.time_played_hours * 3600ULL +
+                       (unsigned long long)playerData.time_played_minutes * 60ULL +
+                       (unsigned long long)playerData.time_played_seconds);
+    return true;
+}
+
+/* Command-line options. */
+typedef struct {
+    bool         protocol;   /* --protocol: JSON events out, plain text to stderr */
+    bool         seeded;     /* --seed N given                                      */
+    unsigned int seed;
+    const char  *profile;    /* --profile NAME, or NULL for the last used profile   */
+    const char  *trace;      /* --trace FILE (needs a TRACE=1 build), or NULL        */
+    bool         bench;      /* --bench: run the headless benchmark suite and exit   */
+} LaunchOptions;
+
+/**
+ * parse_args
+ * Fill opts from argv. Prints usage to stderr and returns false on error.
+ */
+static bool parse_args(int argc, char **argv, LaunchOptions *opts)
+{
+    memset(opts, 0, sizeof(*opts));
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--protocol") == 0) {
+            opts->protocol = true;
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            char *end = NULL;
+            const unsigned long value = strtoul(argv[++i], &end, 10);
+            if (!end || *end != '\0') {
+                fprintf(stderr, "Invalid seed: %s\n", argv[i]);
+                return false;
+            }
+            opts->seeded = true;
+            opts->seed   = (unsigned int)value;
+        } else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            opts->profile = argv[++i];
+            if (!profile_valid_name(opts->profile)) {
+                fprintf(stderr, "Invalid profile name: %s (letters, digits, '-' and '_')\n", opts->profile);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--bench") == 0) {
+            opts->bench = true;
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            opts->trace = argv[++i];
+            if (!trace_available()) {
+                fprintf(stderr, "--trace needs a tracing build (make TRACE=1)\n");
+                return false;
+            }
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            fprintf(stderr, "Usage: %s [--protocol] [--seed N] [--profile NAME] [--trace FILE] [--bench]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
 /* ------------------------------------------------------------------------- */
 /* main                                                                      */
 /* ------------------------------------------------------------------------- */
 
-int main(void)
+int main(int argc, char **argv)
 {
-    /* Seed PRNG for shuffles across the program. */
-    srand((unsigned int)time(NULL));
+    LaunchOptions opts;
+    if (!parse_args(argc, argv, &opts)) return 2;
+
+    /* Seed PRNG for shuffles across the program (fixed seed = reproducible run). */
+    srand(opts.seeded ? opts.seed : (unsigned int)time(NULL));
+
+    /* Before persist_init: the trace is exported after the final save (atexit order). */
+    if (opts.trace && !trace_start(opts.trace)) {
+        fprintf(stderr, "Could not start tracing to %s\n", opts.trace);
+        return 1;
+    }
+
+    /* Benchmarks are headless: no terminal setup, no saves. */
+    if (opts.bench) return bench_run();
+
+    /* Protocol mode must claim the real stdout before anything is printed. */
+    if (opts.protocol && !protocol_init()) {
+        fprintf(stderr, "Could not start protocol mode.\n");
+        return 1;
+    }
+
+    /* Terminal detection + ANSI (VT) mode before the first clear_screen(). */
+    render_init();
+    if (protocol_enabled()) render_set_plain();
+
+    /* Keyboard in cbreak mode; restored automatically at exit. */
+    input_init();
+
+    /* Pick the profile (last used unless --profile) before any save I/O. */
+    (void)profile_init(opts.profile);
 
     /* Ensure save directories exist before any I/O */
     fs_init();
 
+    /* Background writer for profile/achievement saves (flushes at exit). */
+    persist_init();
+
     /* Defaults for a fresh run (will be overwritten by load if present). */
     globals_init();
 
-    /* Start background time tracking immediately. */
-#ifdef _WIN32
-    start_time_thread();
-#endif
-
-    /* Initialize achievements registry (creates file on first run). */
-    initialize_achievements();
-
-    /* Load persisted profile (if exists) and normalize values. */
-    if (load_player_data()) {
-        normalize_config(&config);
-        normalize_player_counters(&playerData);
+    /* Autosave shares the input loop instead of owning a thread. */
+    input_add_idle_task(autosave_tick, NULL, AUTOSAVE_TICK_MS);
 
-#ifdef _WIN32
-        /* If autosave was on last session, ensure worker thread exists. */
-        if (!gAutosaveThreadHandle && config.autosave > 0) {
-            start_autosave_thread_if_needed();
-        }
-#endif
+    /* Load the active profile (if it has data) and normalize values. */
+    if (load_profile_data()) {
         deckMenu();
         /* NOTREACHED in normal flow. */
         return 0;
@@ -242,9 +279,10 @@ int main(void)
     /* First-run onboarding: ask for starting funds. */
     do {
         clear_screen();
+        protocol_screen("onboarding");
         printf("Welcome to the Playing Card Simulation!\n");
         printf("Enter your starting money amount: $");
-        scanf("%llu", &playerData.uPlayerMoney);
+        input_read_u64(&playerData.uPlayerMoney);
 
         if (playerData.uPlayerMoney < MIN_PLAYER_MONEY) {
             printf("You inputted $%llu\n", playerData.uPlayerMoney);
@@ -258,12 +296,8 @@ int main(void)
              playerData.uPlayerMoney > MAX_PLAYER_MONEY);
 
     playerData.starting_balance = playerData.uPlayerMoney;
-    save_player_data();
+    persist_mark_dirty(PERSIST_PLAYER);
     deckMenu();
-
-#ifdef _WIN32
-    stop_threads_and_cleanup();
-#endif
     return 0;
 }
 
@@ -282,6 +316,7 @@ void deckMenu(void)
 
     while (1) {
         clear_screen();
+        protocol_screen("main_menu");
         printf("=== MAIN MENU ===\n");
         printf("Funds: $%llu\n", playerData.uPlayerMoney);
         printf("\nPlease select from the options below:\n");
@@ -295,7 +330,7 @@ void deckMenu(void)
         printf("> ");
 
         int menuSelectionOption = 0;
-        scanf("%d", &menuSelectionOption);
+        input_read_int(&menuSelectionOption);
 
         switch (menuSelectionOption) {
             case 1:
@@ -330,10 +365,8 @@ void deckMenu(void)
 
             case 7:
                 printf("\nExiting.\n");
-                save_player_data();
-#ifdef _WIN32
-                stop_threads_and_cleanup();
-#endif
+                persist_mark_dirty(PERSIST_PLAYER);
+                persist_shutdown();    /* flush anything still pending */
                 exit(0);
                 break;
 
@@ -353,6 +386,7 @@ void gamesMenu(void)
 {
     while (1) {
         clear_screen();
+        protocol_screen("games_menu");
         printf("=== GAME MENU ===\n");
         printf("Funds: $%llu\n", playerData.uPlayerMoney);
         printf("\nSelect a game:\n");
@@ -366,12 +400,12 @@ void gamesMenu(void)
         printf("> ");
 
         int menuSelectionOption = 0;
-        scanf("%d", &menuSelectionOption);
+        input_read_int(&menuSelectionOption);
 
         switch (menuSelectionOption) {
             case 1:
                 clear_screen();
-                save_player_data();
+                persist_mark_dirty(PERSIST_PLAYER);
                 blackjack();        /* open Blackjack UI/menu */
                 break;
 
@@ -391,7 +425,7 @@ void gamesMenu(void)
 
             case 4:
                 clear_screen();
-                save_player_data();
+                persist_mark_dirty(PERSIST_PLAYER);
                 solitaire();
                 break;
 
@@ -404,7 +438,7 @@ void gamesMenu(void)
 
             case 6:
                 clear_screen();
-                save_player_data();
+                persist_mark_dirty(PERSIST_PLAYER);
                 idiot();
                 break;
 
@@ -428,6 +462,7 @@ void otherMenu(void)
 {
     while (1) {
         clear_screen();
+        protocol_screen("other_menu");
         printf("=== OTHER MENU ===\n");
         printf("Funds: $%llu\n", playerData.uPlayerMoney);
         printf("\nSelect an option:\n");
@@ -435,11 +470,12 @@ void otherMenu(void)
         printf("2: View Achievements\n");
         printf("3: View Game Statistics\n");
         printf("4: Reset Statistics & Achievements\n");
-        printf("5: Back\n");
+        printf("5: Profiles\n");
+        printf("6: Back\n");
         printf("> ");
 
         int menuSelectionOption = 0;
-        scanf("%d", &menuSelectionOption);
+        input_read_int(&menuSelectionOption);
 
         switch (menuSelectionOption) {
             case 1:
@@ -464,16 +500,86 @@ void otherMenu(void)
                 break;
 
             case 5:
+                profilesMenu();
+                break;
+
+            case 6:
                 return;
 
             default:
-                printf("\nPlease select a valid option (1-5)\n");
+                printf("\nPlease select a valid option (1-6)\n");
                 pause_for_enter();
                 break;
         }
     }
 }
 
+/**
+ * profilesMenu
+ * List profiles from the index (no profile files are opened), then switch
+ * to one or create a new one. A new profile starts with onboarding funds.
+ */
+void profilesMenu(void)
+{
+    while (1) {
+        clear_screen();
+        protocol_screen("profiles");
+        printf("=== PROFILES ===\n");
+        printf("Active: %s\n\n", profile_current());
+
+        const int count = profile_count();
+        for (int i = 0; i < count; ++i) {
+            ProfileSummary row;
+            if (!profile_at(i, &row)) break;
+
+            char lastPlayed[32] = "never";
+            if (row.lastPlayed) {
+                const time_t when = (time_t)row.lastPlayed;
+                const struct tm *local = localtime(&when);
+                if (local) strftime(lastPlayed, sizeof(lastPlayed), "%Y-%m-%d %H:%M", local);
+            }
+            printf("%3d: %-20s $%-14llu %s\n", i + 1, row.name, row.balance, lastPlayed);
+        }
+
+        printf("\n%d: New Profile\n", count + 1);
+        printf("%d: Back\n", count + 2);
+
+        const int choice = read_menu_choice(1, count + 2);
+        if (choice == count + 2) return;
+
+        char name[PROFILE_NAME_MAX] = "";
+        if (choice == count + 1) {
+            char line[INPUT_MAX_LINE];
+            printf("Profile name (letters, digits, '-' and '_'): ");
+            if (!input_read_line(line, sizeof(line)) || !profile_valid_name(line)) {
+                printf("Invalid profile name.\n");
+                pause_for_enter();
+                continue;
+            }
+            memcpy(name, line, strlen(line) + 1);   /* valid names always fit */
+        } else {
+            ProfileSummary row;
+            if (!profile_at(choice - 1, &row)) continue;
+            snprintf(name, sizeof(name), "%s", row.name);
+        }
+
+        if (strcmp(name, profile_current()) == 0) return;
+
+        if (!profile_switch(name)) {
+            printf("Could not switch to profile %s.\n", name);
+            pause_for_enter();
+            continue;
+        }
+
+        /* Only the newly selected profile's files are read here. */
+        if (!load_profile_data()) {
+            printf("New profile: %s\n", name);
+            changeFunds();
+        }
+        return;
+    }
+}
+
 /* ------------------------------------------------------------------------- */
 /* Rules + customizations                                                    */
 /* ------------------------------------------------------------------------- */
@@ -482,6 +588,7 @@ void gameRules(void)
 {
     while (1) {
         clear_screen();
+        protocol_screen("game_rules");
         printf("=== GAME RULES ===\n");
         printf("Funds: $%llu\n", playerData.uPlayerMoney);
         printf("\nSelect a category:\n");
@@ -491,7 +598,7 @@ void gameRules(void)
         printf("> ");
 
         int menuSelectionOption = 0;
-        scanf("%d", &menuSelectionOption);
+        input_read_int(&menuSelectionOption);
 
         switch (menuSelectionOption) {
             case 1:
@@ -514,6 +621,7 @@ void customRules(void)
 {
     while (1) {
         clear_screen();
+        protocol_screen("custom_rules");
         printf("=== CUSTOM GAME RULES ===\n");
         printf("Funds: $%llu\n", playerData.uPlayerMoney);
         printf("\nSelect a rule to change:\n");
@@ -524,7 +632,7 @@ void customRules(void)
         printf("> ");
 
         int menuSelectionOption = 0;
-        scanf("%d", &menuSelectionOption);
+        input_read_int(&menuSelectionOption);
 
         switch (menuSelectionOption) {
             case 1:
@@ -550,6 +658,7 @@ void jokers(void)
 {
     while (1) {
         clear_screen();
+        protocol_screen("jokers");
         printf("=== JOKERS ===\n");
         printf("%s\n\n", config.jokers ? "Enabled" : "Disabled");
 
@@ -561,12 +670,12 @@ void jokers(void)
         printf("> ");
 
         int menuSelectionOption = 0;
-        scanf("%d", &menuSelectionOption);
+        input_read_int(&menuSelectionOption);
 
         switch (menuSelectionOption) {
             case 1:
                 config.jokers = !config.jokers;
-                save_player_data();
+                persist_mark_dirty(PERSIST_PLAYER);
                 break;
             case 2:
                 return;
@@ -585,6 +694,7 @@ void numberOfDecks(void)
 
     while (1) {
         clear_screen();
+        protocol_screen("number_of_decks");
         printf("=== NUMBER OF DECKS ===\n");
         printf("Current number of decks: %d\n\n", config.num_decks);
 
@@ -595,19 +705,19 @@ void numberOfDecks(void)
         printf("> ");
 
         int menuSelectionOption = 0;
-        scanf("%d", &menuSelectionOption);
+        input_read_int(&menuSelectionOption);
 
         switch (menuSelectionOption) {
             case 1: {
                 int newCount = config.num_decks;
                 while (1) {
                     printf("Enter new number of decks (%d-%d)\n> ", minDecks, maxDecks);
-                    scanf("%d", &newCount);
+                    input_read_int(&newCount);
                     if (newCount >= minDecks && newCount <= maxDecks) break;
                     printf("\nPlease select a valid number of decks (%d-%d)\n", minDecks, maxDecks);
                 }
                 config.num_decks = newCount;
-                save_player_data();
+                persist_mark_dirty(PERSIST_PLAYER);
                 break;
             }
             case 2:
@@ -624,6 +734,7 @@ void ensureWinnableSolutions(void)
 {
     while (1) {
         clear_screen();
+        protocol_screen("winnable_solutions");
         printf("=== ENSURE WINNABLE SOLUTIONS (Solitaire) ===\n");
         if (!config.depth_first_search && !config.backtracking) {
             printf("Mode: Disabled\n\n");
@@ -643,19 +754,19 @@ void ensureWinnableSolutions(void)
         printf("> ");
 
         int menuSelectionOption = 0;
-        scanf("%d", &menuSelectionOption);
+        input_read_int(&menuSelectionOption);
 
         switch (menuSelectionOption) {
             case 1:
                 config.depth_first_search = !config.depth_first_search;
                 if (config.depth_first_search) config.backtracking = false;
-                save_player_data();
+                persist_mark_dirty(PERSIST_PLAYER);
                 break;
 
             case 2:
                 config.backtracking = !config.backtracking;
                 if (config.backtracking) config.depth_first_search = false;
-                save_player_data();
+                persist_mark_dirty(PERSIST_PLAYER);
                 break;
 
             case 3:
@@ -676,6 +787,7 @@ void autosave_menu(void)
 
     while (1) {
         clear_screen();
+        protocol_screen("autosave_menu");
         printf("=== AUTOSAVE ===\n");
         if (config.autosave == 0) printf("Current: OFF\n\n");
         else                      printf("Current: %d minute(s)\n\n", config.autosave);
@@ -688,23 +800,19 @@ void autosave_menu(void)
         printf("> ");
 
         int menuSelectionOption = 0;
-        scanf("%d", &menuSelectionOption);
+        input_read_int(&menuSelectionOption);
 
         switch (menuSelectionOption) {
             case 1: {
                 int newFreq = config.autosave;
                 while (1) {
                     printf("Enter new autosave frequency (%d-%d minutes)\n> ", minAutosave, maxAutosave);
-                    scanf("%d", &newFreq);
+                    input_read_int(&newFreq);
                     if (newFreq >= minAutosave && newFreq <= maxAutosave) break;
                     printf("\nPlease select a valid autosave frequency (%d-%d minutes)\n", minAutosave, maxAutosave);
                 }
                 config.autosave = newFreq;
-                save_player_data();
-#ifdef _WIN32
-                /* Ensure worker exists; it handles 0 internally by idling. */
-                start_autosave_thread_if_needed();
-#endif
+                persist_mark_dirty(PERSIST_PLAYER);
                 break;
             }
             case 2:
@@ -724,9 +832,10 @@ void autosave_menu(void)
 
 void changeFunds(void)
 {
+    protocol_screen("change_funds");
     do {
         printf("\nPlease enter the desired funds: $");
-        scanf("%llu", &playerData.uPlayerMoney);
+        input_read_u64(&playerData.uPlayerMoney);
 
         if (playerData.uPlayerMoney < MIN_PLAYER_MONEY) {
             printf("You need at least $%llu to play. ", MIN_PLAYER_MONEY);
@@ -740,7 +849,7 @@ void changeFunds(void)
 
     playerData.starting_balance = playerData.uPlayerMoney;
     printf("\n");
-    save_player_data();
+    persist_mark_dirty(PERSIST_PLAYER);
 }
 
 void resetStatistics(void)
@@ -752,15 +861,16 @@ void resetStatistics(void)
     printf("> ");
 
     int userChoice = 0;
-    scanf("%d", &userChoice);
+    input_read_int(&userChoice);
 
     switch (userChoice) {
         case 1:
             memset(&playerData, 0, sizeof(PlayerData));
+            state_playtime_set(0);
             resetAchievements();
+            rollups_reset();
             changeFunds();         /* also re-sets starting_balance */
-            save_player_data();
-            save_achievements();
+            persist_mark_dirty(PERSIST_ALL);
             break;
         case 2:
             break;
@@ -773,14 +883,15 @@ void resetStatistics(void)
 
 void resetAchievements(void)
 {
-    /* Mark all as locked; the achievements module owns the array. */
-    for (int i = 0; i < achievement_count; ++i) {
-        achievements[i].unlocked = false;
-    }
+    /* Mark all as locked; the achievements module owns the array + bitset. */
+    reset_achievements_state();
 }
 
 void statsDisplay(void)
 {
+    /* Everything below reads precomputed rollups (rollups.h); no history scan. */
+    HistorySummary summary;
+
     printf("=== Statistics ===\n\n");
 
     if (playerData.starting_balance <= playerData.uPlayerMoney) {
@@ -789,30 +900,151 @@ void statsDisplay(void)
         printf("Loss:   $%llu\n", (playerData.starting_balance - playerData.uPlayerMoney));
     }
 
-    printf("Time Played: %d:%02d:%02d\n",
-           playerData.time_played_hours,
-           playerData.time_played_minutes,
-           playerData.time_played_seconds);
+    const unsigned long long playedSeconds = state_playtime_seconds();
+    printf("Time Played: %llu:%02llu:%02llu\n",
+           playedSeconds / 3600ULL, (playedSeconds / 60ULL) % 60ULL, playedSeconds % 60ULL);
 
     printf("\n21 Blackjack\n");
     printf("Wins: %d\n",  playerData.blackjack.wins);
     printf("Losses: %d\n",playerData.blackjack.losses);
     printf("Draws: %d\n", playerData.blackjack.draws);
     printf("Win Streak: %d\n", playerData.blackjack.max_win_streak);
+    rollups_game(HISTORY_GAME_BLACKJACK, &summary);
+    print_rollup(&summary, true);
 
     printf("\nSolitaire\n");
     printf("Wins: %d\n",  playerData.solitaire.wins);
     printf("Losses: %d\n",playerData.solitaire.losses);
     printf("Draws: %d\n", playerData.solitaire.draws);
     printf("Win Streak: %d\n", playerData.solitaire.max_win_streak);
+    rollups_game(HISTORY_GAME_SOLITAIRE, &summary);
+    print_rollup(&summary, false);
+    print_difficulty_rollups(HISTORY_GAME_SOLITAIRE);
 
     printf("\nIdiot\n");
     printf("Wins: %d\n",  playerData.idiot.wins);
     printf("Losses: %d\n",playerData.idiot.losses);
     printf("Draws: %d\n", playerData.idiot.draws);
     printf("Win Streak: %d\n", playerData.idiot.max_win_streak);
+    rollups_game(HISTORY_GAME_IDIOT, &summary);
+    print_rollup(&summary, false);
+    print_difficulty_rollups(HISTORY_GAME_IDIOT);
+
+    printf("\nAll Games\n");
+    rollups_game(HISTORY_GAME_ANY, &summary);
+    print_rollup(&summary, false);
+
+    RollupDay days[7];
+    const int dayCount = rollups_days(days, (int)(sizeof(days) / sizeof(days[0])));
+    if (dayCount > 0) {
+        printf("\nRecent Days\n");
+        for (int i = 0; i < dayCount; ++i) {
+            const time_t midnight = (time_t)(days[i].day * 86400);
+            char date[16] = "?";
+            const struct tm *civil = gmtime(&midnight);   /* day numbers are civil dates */
+            if (civil) strftime(date, sizeof(date), "%Y-%m-%d", civil);
+
+            printf("%s: %llu rounds, %.1f%% won, EV $%+.2f, net $%+lld\n", date,
+                   (unsigned long long)days[i].totals.rounds,
+                   100.0 * rollup_win_rate(&days[i].totals),
+                   rollup_ev(&days[i].totals),
+                   (long long)days[i].totals.net);
+        }
+    }
+
+    print_latencies();
+
+    persist_mark_dirty(PERSIST_PLAYER);
+}
+
+/**
+ * print_latencies
+ * Response times measured this session (gametimer.h): count, median, p95 and
+ * worst case per kind. Prints nothing for kinds that have not run yet.
+ */
+static void print_latencies(void)
+{
+    bool printedHeader = false;
 
-    save_player_data();
+    for (int kind = 0; kind < LATENCY_KIND_COUNT; ++kind) {
+        LatencyHistogram histogram;
+        latency_snapshot((LatencyKind)kind, &histogram);
+        if (histogram.count == 0) continue;
+
+        if (!printedHeader) {
+            printf("\nResponse Times (this session)\n");
+            printedHeader = true;
+        }
+        printf("%-17s %6llu x  p50 %9.3f ms  p95 %9.3f ms  max %9.3f ms\n",
+               latency_kind_name((LatencyKind)kind),
+               (unsigned long long)histogram.count,
+               (double)latency_percentile(&histogram, 50.0) / 1e6,
+               (double)latency_percentile(&histogram, 95.0) / 1e6,
+               (double)histogram.maxNs / 1e6);
+    }
+}
+
+/**
+ * print_rollup
+ * Print one precomputed rollup: mean bet, win rate, EV, average length,
+ * streak distributions and (optionally) the EV of each Blackjack decision.
+ * Prints nothing until at least one round has been recorded.
+ */
+static void print_rollup(const HistorySummary *summary, bool showDecisions)
+{
+    static const char *decisionNames[] = { "Double Down", "Split", "Surrender", "Insurance" };
+
+    if (summary->rounds == 0) return;
+
+    printf("Rounds Logged: %llu (%.1f%% won)\n",
+           (unsigned long long)summary->rounds, 100.0 * rollup_win_rate(summary));
+    printf("Mean Bet: $%.2f\n", rollup_mean_bet(summary));
+    printf("EV: $%+.2f per round", rollup_ev(summary));
+    if (summary->wagered > 0) {
+        printf(", $%+.3f per $1 bet", (double)summary->net / (double)summary->wagered);
+    }
+    printf("\nAverage Length: %.1fs\n", (double)summary->durationMs / (double)summary->rounds / 1000.0);
+
+    printf("Win Streaks: ");
+    for (int i = 0; i < HISTORY_STREAK_BUCKETS; ++i) {
+        printf("%d%s:%u ", i + 1, (i == HISTORY_STREAK_BUCKETS - 1) ? "+" : "", summary->winStreaks[i]);
+    }
+    printf("(longest %u)\n", summary->longestWinStreak);
+
+    printf("Loss Streaks: ");
+    for (int i = 0; i < HISTORY_STREAK_BUCKETS; ++i) {
+        printf("%d%s:%u ", i + 1, (i == HISTORY_STREAK_BUCKETS - 1) ? "+" : "", summary->lossStreaks[i]);
+    }
+    printf("(longest %u)\n", summary->longestLossStreak);
+
+    if (!showDecisions) return;
+
+    for (int bit = 0; bit < (int)(sizeof(decisionNames) / sizeof(decisionNames[0])); ++bit) {
+        if (summary->decisionRounds[bit] == 0) continue;
+        printf("%s: %llu hands, EV $%+.2f\n", decisionNames[bit],
+               (unsigned long long)summary->decisionRounds[bit],
+               (double)summary->decisionNet[bit] / (double)summary->decisionRounds[bit]);
+    }
+}
+
+/**
+ * print_difficulty_rollups
+ * One summary line per difficulty that has been played.
+ */
+static void print_difficulty_rollups(HistoryGame game)
+{
+    static const char *difficultyNames[ROLLUP_DIFFICULTY_COUNT] = { "Easy", "Normal", "Hard" };
+
+    for (int d = 0; d < ROLLUP_DIFFICULTY_COUNT; ++d) {
+        HistorySummary summary;
+        rollups_difficulty(game, (RollupDifficulty)d, &summary);
+        if (summary.rounds == 0) continue;
+
+        printf("  %-6s %llu games, %.1f%% won, mean bet $%.2f, EV $%+.2f, longest streak %u\n",
+               difficultyNames[d], (unsigned long long)summary.rounds,
+               100.0 * rollup_win_rate(&summary), rollup_mean_bet(&summary),
+               rollup_ev(&summary), summary.longestWinStreak);
+    }
 }
 
 void printAchievements(void)
@@ -829,25 +1061,17 @@ void printAchievements(void)
     printf("=== Achievements ===\n");
     printf("%d/%d Unlocked\n", unlockedCount, achievement_count);
 
-    const int general_start   = 0;
-    const int blackjack_start = MAX_GENERAL_ACHIEVEMENTS;
-    const int solitaire_start = blackjack_start + MAX_BLACKJACK_ACHIEVEMENTS;
-    const int idiot_start     = solitaire_start + MAX_SOLITAIRE_ACHIEVEMENTS;
-    const int hidden_start    = idiot_start + MAX_IDIOT_ACHIEVEMENTS;
-
-    printAchievementCategory("General Achievements",   general_start,   MAX_GENERAL_ACHIEVEMENTS);
-    printAchievementCategory("Blackjack Achievements", blackjack_start, MAX_BLACKJACK_ACHIEVEMENTS);
-    printAchievementCategory("Solitaire Achievements", solitaire_start, MAX_SOLITAIRE_ACHIEVEMENTS);
-    printAchievementCategory("Idiot Achievements",     idiot_start,     MAX_IDIOT_ACHIEVEMENTS);
+    printAchievementCategory("General Achievements",   ACH_CAT_GENERAL);
+    printAchievementCategory("Blackjack Achievements", ACH_CAT_BLACKJACK);
+    printAchievementCategory("Solitaire Achievements", ACH_CAT_SOLITAIRE);
+    printAchievementCategory("Idiot Achievements",     ACH_CAT_IDIOT);
 
     /* Sorted print for hidden achievements that are unlocked. */
-    Achievement *unlocked_hidden[MAX_HIDDEN_ACHIEVEMENTS];
+    Achievement *unlocked_hidden[MAX_ACHIEVEMENTS];
     int hiddenUnlockedCount = 0;
 
-    for (int i = hidden_start;
-         i < hidden_start + MAX_HIDDEN_ACHIEVEMENTS && i < achievement_count;
-         ++i) {
-        if (achievements[i].unlocked) {
+    for (int i = 0; i < achievement_count; ++i) {
+        if (achievement_category(i) == ACH_CAT_HIDDEN && achievements[i].unlocked) {
             unlocked_hidden[hiddenUnlockedCount++] = &achievements[i];
         }
     }
@@ -868,16 +1092,13 @@ void printAchievements(void)
  * Discards non-numeric input and reprompts until valid.
  */
 static int read_menu_choice(int minOption, int maxOption) {
-    int choice, scanned;
+    int choice = 0;
     for (;;) {
         printf("> ");
-        scanned = scanf("%d", &choice);
-        if (scanned == 1 && choice >= minOption && choice <= maxOption) {
+        /* input_read_int() consumes the whole line, so bad input can't loop. */
+        if (input_read_int(&choice) && choice >= minOption && choice <= maxOption) {
             return choice;
         }
-        // Flush bad input and reprompt
-        int ch;
-        while ((ch = getchar()) != '\n' && ch != EOF) { /* discard */ }
         printf("Please select a valid option (%d-%d)\n", minOption, maxOption);
     }
 }
@@ -890,6 +1111,7 @@ void blackjack(void) {
     int menuSelection;
     for (;;) {
         clear_screen();
+        protocol_screen("blackjack_menu");
         printf("=== 21 BLACKJACK ===\n");
         printf("\nPlease select an option:\n");
         printf("1: Play\n");
@@ -915,6 +1137,7 @@ void solitaire(void) {
     int menuSelection;
     for (;;) {
         clear_screen();
+        protocol_screen("solitaire_menu");
         printf("=== SOLITAIRE ===\n");
         printf("\nPlease select an option:\n");
         printf("1: Play\n");
@@ -940,6 +1163,7 @@ void idiot(void) {
     int menuSelection;
     for (;;) {
         clear_screen();
+        protocol_screen("idiot_menu");
         printf("=== IDIOT ===\n");
         printf("\nPlease select an option:\n");
         printf("1: Play\n");
@@ -0,0 +1,703 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * cardsim-server: many concurrent Blackjack, Klondike and Idiot sessions
+ * over a Unix socket or localhost TCP (protocol in wire.h).
+ *
+ *   cardsim-server (--unix PATH | --tcp PORT) [--workers N]
+ *                  [--max-sessions N] [--max-connections N]
+ *
+ * Responsibilities:
+ *   - One epoll loop owning every socket, connection buffer and session.
+ *   - Framing: length-prefixed frames parsed straight out of the read
+ *     buffer; replies batched per read and flushed once.
+ *   - Quick actions run inline; solves and AI turns go to the worker pool
+ *     and come back through its eventfd.
+ *   - Sessions belong to the connection that opened them and close with it.
+ *   - SIGINT/SIGTERM (via signalfd) stop the loop; the round tallies of
+ *     every thread are merged and printed on the way out.
+ *
+ * Linux only (epoll, eventfd, signalfd); the terminal game does not need it.
+ */
+
+#define _GNU_SOURCE   /* accept4, signalfd */
+
+#include "server.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* ------------------------------------------------------------------------- */
+/* Limits and tags                                                           */
+/* ------------------------------------------------------------------------- */
+
+#define DEFAULT_MAX_SESSIONS      65536
+#define DEFAULT_MAX_CONNECTIONS   4096
+
+#define READ_CHUNK                65536        /* bytes per read() */
+#define EPOLL_BATCH               256
+#define OUT_LIMIT                 (1u << 20)   /* unsent replies before a peer is dropped */
+
+/* epoll data for the fds that are not connections */
+#define TAG_LISTEN    UINT32_MAX
+#define TAG_WORKERS   (UINT32_MAX - 1)
+#define TAG_SIGNAL    (UINT32_MAX - 2)
+
+/* ------------------------------------------------------------------------- */
+/* Types                                                                     */
+/* ------------------------------------------------------------------------- */
+
+typedef struct {
+    uint8_t *data;
+    size_t   length;
+    size_t   capacity;
+} ByteBuffer;
+
+/**
+ * Connection
+ * A client socket. Idle connections hold no buffers: `in` keeps only a
+ * partial frame between reads, `out` only what the socket did not take.
+ */
+typedef struct {
+    int         fd;             /* -1 while the slot is free              */
+    uint32_t    generation;     /* bumped on close (stale job replies)    */
+    int32_t     sessions;       /* head of the owned session list         */
+    int32_t     nextFree;
+    bool        writing;        /* EPOLLOUT armed                         */
+    bool        lostReply;      /* a reply could not be queued: close     */
+    ByteBuffer  in;
+    ByteBuffer  out;
+    size_t      outSent;
+} Connection;
+
+typedef struct {
+    const char *unixPath;
+    int         tcpPort;
+    int         workers;
+    uint32_t    maxSessions;
+    uint32_t    maxConnections;
+} ServerOptions;
+
+typedef struct {
+    ServerOptions  options;
+    int            epollFd;
+    int            listenFd;
+    int            signalFd;
+    Connection    *conns;
+    int32_t        freeConn;
+    SessionTable   sessions;
+    WorkerPool    *pool;
+    EngineScratch *scratch;     /* loop thread's (heap: the engine structs are large) */
+    uint64_t       requests;
+} Server;
+
+/* ------------------------------------------------------------------------- */
+/* Options                                                                   */
+/* ------------------------------------------------------------------------- */
+
+static bool parse_count(const char *text, long low, long high, long *out)
+{
+    char *end = NULL;
+    const long value = strtol(text, &end, 10);
+    if (!end || *end != '\0' || value < low || value > high) return false;
+    *out = value;
+    return true;
+}
+
+static bool usage(const char *program)
+{
+    fprintf(stderr, "Usage: %s (--unix PATH | --tcp PORT) [--workers N] "
+                    "[--max-sessions N] [--max-connections N]\n", program);
+    return false;
+}
+
+/**
+ * parse_args
+ * Fill opts from argv. Prints usage to stderr and returns false on error.
+ */
+static bool parse_args(int argc, char **argv, ServerOptions *opts)
+{
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+
+    memset(opts, 0, sizeof(*opts));
+    opts->workers        = (online > 0) ? (int)online : 1;
+    opts->maxSessions    = DEFAULT_MAX_SESSIONS;
+    opts->maxConnections = DEFAULT_MAX_CONNECTIONS;
+
+    for (int i = 1; i < argc; ++i) {
+        long value = 0;
+        const bool hasValue = (i + 1 < argc);
+
+        if (strcmp(argv[i], "--unix") == 0 && hasValue) {
+            opts->unixPath = argv[++i];
+        } else if (strcmp(argv[i], "--tcp") == 0 && hasValue && parse_count(argv[i + 1], 1, 65535, &value)) {
+            opts->tcpPort = (int)value; ++i;
+        } else if (strcmp(argv[i], "--workers") == 0 && hasValue && parse_count(argv[i + 1], 1, 256, &value)) {
+            opts->workers = (int)value; ++i;
+        } else if (strcmp(argv[i], "--max-sessions") == 0 && hasValue &&
+                   parse_count(argv[i + 1], 1, SESSION_MAX, &value)) {
+            opts->maxSessions = (uint32_t)value; ++i;
+        } else if (strcmp(argv[i], "--max-connections") == 0 && hasValue &&
+                   parse_count(argv[i + 1], 1, 1000000, &value)) {
+            opts->maxConnections = (uint32_t)value; ++i;
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    /* Exactly one of --unix / --tcp. */
+    if (!opts->unixPath == !opts->tcpPort) return usage(argv[0]);
+    return true;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Sockets                                                                   */
+/* ------------------------------------------------------------------------- */
+
+/* Listening socket on the Unix path (replacing a stale one) or 127.0.0.1:port. */
+static int open_listener(const ServerOptions *opts)
+{
+    int fd = -1;
+
+    if (opts->unixPath) {
+        struct sockaddr_un address = { .sun_family = AF_UNIX };
+        if (strlen(opts->unixPath) >= sizeof(address.sun_path)) {
+            fprintf(stderr, "Socket path too long: %s\n", opts->unixPath);
+            return -1;
+        }
+        strcpy(address.sun_path, opts->unixPath);
+        unlink(opts->unixPath);
+
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0 || bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0) goto fail;
+    } else {
+        struct sockaddr_in address = { .sin_family = AF_INET };
+        address.sin_port        = htons((uint16_t)opts->tcpPort);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        const int on = 1;
+        if (fd < 0 || setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) != 0 ||
+            bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0) goto fail;
+    }
+
+    if (listen(fd, SOMAXCONN) != 0) goto fail;
+    return fd;
+
+fail:
+    perror("cardsim-server: listen");
+    if (fd >= 0) close(fd);
+    return -1;
+}
+
+static bool epoll_watch(Server *server, int op, int fd, uint32_t events, uint32_t tag)
+{
+    struct epoll_event event = { .events = events, .data.u32 = tag };
+    return epoll_ctl(server->epollFd, op, fd, &event) == 0;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Buffers and connections                                                   */
+/* ------------------------------------------------------------------------- */
+
+static bool buffer_reserve(ByteBuffer *buffer, size_t extra)
+{
+    if (buffer->length + extra <= buffer->capacity) return true;
+
+    size_t capacity = buffer->capacity ? buffer->capacity : 256;
+    while (capacity < buffer->length + extra) capacity *= 2;
+
+    uint8_t *data = (uint8_t *)realloc(buffer->data, capacity);
+    if (!data) return false;
+    buffer->data     = data;
+    buffer->capacity = capacity;
+    return true;
+}
+
+static void buffer_release(ByteBuffer *buffer)
+{
+    free(buffer->data);
+    memset(buffer, 0, sizeof(*buffer));
+}
+
+static void conn_close(Server *server, int32_t index)
+{
+    Connection *conn = &server->conns[index];
+
+    while (conn->sessions >= 0) session_close(&server->sessions, conn->sessions, &conn->sessions);
+
+    epoll_ctl(server->epollFd, EPOLL_CTL_DEL, conn->fd, NULL);
+    close(conn->fd);
+    buffer_release(&conn->in);
+    buffer_release(&conn->out);
+
+    conn->fd        = -1;
+    conn->generation++;
+    conn->writing   = false;
+    conn->lostReply = false;
+    conn->outSent   = 0;
+    conn->nextFree  = server->freeConn;
+    server->freeConn = index;
+}
+
+/**
+ * conn_flush
+ * Send what the socket takes; arm EPOLLOUT for the rest. Returns false if
+ * the connection had to be closed.
+ */
+static bool conn_flush(Server *server, int32_t index)
+{
+    Connection *conn = &server->conns[index];
+
+    if (conn->lostReply) {
+        conn_close(server, index);     /* the peer would wait on it forever */
+        return false;
+    }
+
+    while (conn->outSent < conn->out.length) {
+        const ssize_t sent = send(conn->fd, conn->out.data + conn->outSent,
+                                  conn->out.length - conn->outSent, MSG_NOSIGNAL);
+        if (sent > 0) { conn->outSent += (size_t)sent; continue; }
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        conn_close(server, index);
+        return false;
+    }
+
+    const bool pending = conn->outSent < conn->out.length;
+    if (!pending) {
+        /* Everything went out: drop the buffer so idle peers cost nothing. */
+        buffer_release(&conn->out);
+        conn->outSent = 0;
+    } else if (conn->out.length - conn->outSent > OUT_LIMIT) {
+        conn_close(server, index);     /* peer stopped reading */
+        return false;
+    }
+
+    if (pending != conn->writing) {
+        conn->writing = pending;
+        epoll_watch(server, EPOLL_CTL_MOD, conn->fd, EPOLLIN | EPOLLRDHUP | (pending ? EPOLLOUT : 0), (uint32_t)index);
+    }
+    return true;
+}
+
+/**
+ * reply
+ * Queue one reply frame (flushed by the caller). If the buffer cannot grow
+ * the reply is lost, so the connection is marked and conn_flush closes it;
+ * later replies are not queued behind the gap.
+ */
+static void reply(Connection *conn, uint8_t type, uint8_t game, CsWireStatus status,
+                  uint32_t session, uint32_t tag, const uint8_t *body, size_t bodyLength)
+{
+    const size_t frameLength = CS_WIRE_HEADER_SIZE + bodyLength;
+    if (conn->lostReply) return;
+    if (!buffer_reserve(&conn->out, 4 + frameLength)) { conn->lostReply = true; return; }
+
+    uint8_t *at = conn->out.data + conn->out.length;
+    wire_put_u32(at, (uint32_t)frameLength);
+    at[4] = type | CS_MSG_REPLY;
+    at[5] = game;
+    wire_put_u16(at + 6, (uint16_t)status);
+    wire_put_u32(at + 8, session);
+    wire_put_u32(at + 12, tag);
+    if (bodyLength) memcpy(at + 16, body, bodyLength);
+    conn->out.length += 4 + frameLength;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Requests                                                                  */
+/* ------------------------------------------------------------------------- */
+
+/* Reply with the session's current view. */
+static void reply_view(Server *server, Connection *conn, uint8_t type, int32_t slotIndex, uint32_t tag)
+{
+    const SessionSlot *slot = &server->sessions.slots[slotIndex];
+    uint8_t body[CS_WIRE_MAX_FRAME - CS_WIRE_HEADER_SIZE];
+
+    const size_t length = session_view(server->scratch, (CsGame)slot->game, slot->record, body, sizeof(body));
+    reply(conn, type, slot->game, CS_WIRE_OK, session_id(&server->sessions, slotIndex), tag, body, length);
+}
+
+static void handle_open(Server *server, int32_t connIndex, uint8_t game, uint32_t tag,
+                        const uint8_t *body, size_t bodyLength)
+{
+    Connection *conn = &server->conns[connIndex];
+
+    if (bodyLength < CS_WIRE_OPEN_SIZE) {
+        reply(conn, CS_MSG_OPEN, game, CS_WIRE_BAD_FRAME, 0, tag, NULL, 0);
+        return;
+    }
+    if (game < CS_GAME_BLACKJACK || game > CS_GAME_IDIOT) {
+        reply(conn, CS_MSG_OPEN, game, CS_WIRE_BAD_GAME, 0, tag, NULL, 0);
+        return;
+    }
+
+    const WireOpen open = {
+        .difficulty = body[0],
+        .option     = body[1],
+        .seed       = wire_get_u64(body + 4),
+    };
+
+    const int32_t slot = session_open(&server->sessions, (CsGame)game, connIndex, &conn->sessions);
+    if (slot < 0) {
+        reply(conn, CS_MSG_OPEN, game, CS_WIRE_FULL, 0, tag, NULL, 0);
+        return;
+    }
+
+    const CsWireStatus status = session_start(server->scratch, (CsGame)game, server->sessions.slots[slot].record, &open);
+    if (status != CS_WIRE_OK) {
+        session_close(&server->sessions, slot, &conn->sessions);
+        reply(conn, CS_MSG_OPEN, game, status, 0, tag, NULL, 0);
+        return;
+    }
+    reply_view(server, conn, CS_MSG_OPEN, slot, tag);
+}
+
+static void handle_action(Server *server, int32_t connIndex, int32_t slotIndex, uint32_t tag,
+                          const uint8_t *body, size_t bodyLength)
+{
+    Connection  *conn = &server->conns[connIndex];
+    SessionSlot *slot = &server->sessions.slots[slotIndex];
+    const uint32_t id = session_id(&server->sessions, slotIndex);
+
+    if (bodyLength < CS_WIRE_ACTION_SIZE) {
+        reply(conn, CS_MSG_ACTION, slot->game, CS_WIRE_BAD_FRAME, id, tag, NULL, 0);
+        return;
+    }
+
+    const WireAction action = {
+        .action = body[0],
+        .arg    = { body[1], body[2], body[3] },
+        .amount = wire_get_u32(body + 4),
+    };
+
+    if (session_is_slow((CsGame)slot->game, &action)) {
+        ServerJob *job = (ServerJob *)malloc(sizeof(ServerJob));
+        if (!job) {
+            reply(conn, CS_MSG_ACTION, slot->game, CS_WIRE_BUSY, id, tag, NULL, 0);
+            return;
+        }
+        job->slot           = slotIndex;
+        job->conn           = connIndex;
+        job->connGeneration = conn->generation;
+        job->session        = id;
+        job->tag            = tag;
+        job->game           = slot->game;
+        job->action         = action;
+        job->record         = slot->record;
+
+        slot->busy = 1;
+        worker_pool_submit(server->pool, job);
+        return;
+    }
+
+    const CsWireStatus status = session_apply(server->scratch, (CsGame)slot->game, slot->record, &action);
+    if (status != CS_WIRE_OK) {
+        reply(conn, CS_MSG_ACTION, slot->game, status, id, tag, NULL, 0);
+        return;
+    }
+    reply_view(server, conn, CS_MSG_ACTION, slotIndex, tag);
+}
+
+/**
+ * handle_frame
+ * Dispatch one complete frame (header + body, without the length prefix).
+ */
+static void handle_frame(Server *server, int32_t connIndex, const uint8_t *frame, size_t length)
+{
+    Connection    *conn       = &server->conns[connIndex];
+    const uint8_t  type       = frame[0];
+    const uint8_t  game       = frame[1];
+    const uint32_t id         = wire_get_u32(frame + 4);
+    const uint32_t tag        = wire_get_u32(frame + 8);
+    const uint8_t *body       = frame + CS_WIRE_HEADER_SIZE;
+    const size_t   bodyLength = length - CS_WIRE_HEADER_SIZE;
+
+    server->requests++;
+
+    if (type == CS_MSG_OPEN) {
+        handle_open(server, connIndex, game, tag, body, bodyLength);
+        return;
+    }
+    if (type < CS_MSG_OPEN || type > CS_MSG_CLOSE) {
+        reply(conn, type, game, CS_WIRE_BAD_TYPE, id, tag, NULL, 0);
+        return;
+    }
+
+    const int32_t slotIndex = session_lookup(&server->sessions, id, connIndex);
+    if (slotIndex < 0) {
+        reply(conn, type, game, CS_WIRE_NO_SESSION, id, tag, NULL, 0);
+        return;
+    }
+
+    SessionSlot *slot = &server->sessions.slots[slotIndex];
+    if (type == CS_MSG_CLOSE) {
+        const uint8_t slotGame = slot->game;
+        session_close(&server->sessions, slotIndex, &conn->sessions);
+        reply(conn, type, slotGame, CS_WIRE_OK, id, tag, NULL, 0);
+        return;
+    }
+    if (slot->busy) {
+        reply(conn, type, slot->game, CS_WIRE_BUSY, id, tag, NULL, 0);
+        return;
+    }
+
+    if (type == CS_MSG_ACTION) handle_action(server, connIndex, slotIndex, tag, body, bodyLength);
+    else                       reply_view(server, conn, CS_MSG_VIEW, slotIndex, tag);
+}
+
+/**
+ * consume_frames
+ * Handle every complete frame in data[0..length); returns the bytes used,
+ * or SIZE_MAX for a frame that announces an impossible length or whose
+ * reply was lost (either way the connection is closed).
+ */
+static size_t consume_frames(Server *server, int32_t connIndex, const uint8_t *data, size_t length)
+{
+    size_t used = 0;
+
+    while (length - used >= 4) {
+        const uint32_t frameLength = wire_get_u32(data + used);
+        if (frameLength < CS_WIRE_HEADER_SIZE || frameLength > CS_WIRE_MAX_FRAME) return SIZE_MAX;
+        if (length - used - 4 < frameLength) break;
+
+        handle_frame(server, connIndex, data + used + 4, frameLength);
+        used += 4 + frameLength;
+        if (server->conns[connIndex].lostReply) return SIZE_MAX;
+    }
+    return used;
+}
+
+/* Read until the socket is drained, handling frames as they complete. */
+static void conn_read(Server *server, int32_t index)
+{
+    Connection *conn = &server->conns[index];
+    uint8_t     chunk[READ_CHUNK];
+
+    for (;;)
+    {
+        const ssize_t got = recv(conn->fd, chunk, sizeof(chunk), 0);
+        if (got < 0 && errno == EINTR) continue;
+        if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (got <= 0) { conn_close(server, index); return; }
+
+        size_t used;
+        if (conn->in.length == 0) {
+            /* Usual case: parse straight out of the read chunk. */
+            used = consume_frames(server, index, chunk, (size_t)got);
+            if (used != SIZE_MAX && used < (size_t)got) {
+                if (!buffer_reserve(&conn->in, (size_t)got - used)) { conn_close(server, index); return; }
+                memcpy(conn->in.data, chunk + used, (size_t)got - used);
+                conn->in.length = (size_t)got - used;
+            }
+        } else {
+            if (!buffer_reserve(&conn->in, (size_t)got)) { conn_close(server, index); return; }
+            memcpy(conn->in.data + conn->in.length, chunk, (size_t)got);
+            conn->in.length += (size_t)got;
+
+            used = consume_frames(server, index, conn->in.data, conn->in.length);
+            if (used != SIZE_MAX) {
+                memmove(conn->in.data, conn->in.data + used, conn->in.length - used);
+                conn->in.length -= used;
+                if (conn->in.length == 0) buffer_release(&conn->in);
+            }
+        }
+
+        if (used == SIZE_MAX) { conn_close(server, index); return; }
+        if ((size_t)got < sizeof(chunk)) break;
+    }
+
+    conn_flush(server, index);
+}
+
+static void accept_all(Server *server)
+{
+    for (;;)
+    {
+        const int fd = accept4(server->listenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) perror("cardsim-server: accept");
+            return;
+        }
+
+        if (server->freeConn < 0) { close(fd); continue; }   /* at the connection limit */
+
+        if (server->options.tcpPort) {
+            const int on = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        }
+
+        const int32_t index = server->freeConn;
+        Connection   *conn  = &server->conns[index];
+        server->freeConn = conn->nextFree;
+
+        conn->fd       = fd;
+        conn->sessions = -1;
+        if (!epoll_watch(server, EPOLL_CTL_ADD, fd, EPOLLIN | EPOLLRDHUP, (uint32_t)index)) {
+            conn_close(server, index);
+        }
+    }
+}
+
+/* Hand finished worker jobs back to their sessions and connections. */
+static void finish_jobs(Server *server)
+{
+    ServerJob *job = worker_pool_take_done(server->pool);
+
+    while (job)
+    {
+        ServerJob   *next = job->next;
+        SessionSlot *slot = &server->sessions.slots[job->slot];
+
+        slot->busy = 0;
+        if (slot->orphaned) {
+            session_release(&server->sessions, job->slot);
+        } else {
+            Connection *conn = &server->conns[job->conn];
+            if (conn->fd >= 0 && conn->generation == job->connGeneration) {
+                reply(conn, CS_MSG_ACTION, job->game, job->status, job->session, job->tag,
+                      job->body, job->bodyLength);
+                conn_flush(server, job->conn);
+            }
+        }
+
+        free(job);
+        job = next;
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* Setup and main loop                                                       */
+/* ------------------------------------------------------------------------- */
+
+static bool server_init(Server *server)
+{
+    server->listenFd = server->signalFd = server->epollFd = -1;
+
+    /* SIGINT/SIGTERM arrive as reads on signalfd; a dead peer is an EPIPE, not a signal. */
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    server->conns = (Connection *)calloc(server->options.maxConnections, sizeof(Connection));
+    if (!server->conns) {
+        fprintf(stderr, "cardsim-server: out of memory\n");
+        return false;
+    }
+    for (uint32_t i = 0; i < server->options.maxConnections; ++i) {
+        server->conns[i].fd       = -1;
+        server->conns[i].nextFree = (i + 1 < server->options.maxConnections) ? (int32_t)(i + 1) : -1;
+    }
+    server->freeConn = 0;
+
+    server->scratch = (EngineScratch *)calloc(1, sizeof(EngineScratch));
+    if (!server->scratch || !session_table_init(&server->sessions, server->options.maxSessions)) {
+        fprintf(stderr, "cardsim-server: out of memory\n");
+        return false;
+    }
+
+    /* Workers start after the signal mask so they inherit it. */
+    server->pool     = worker_pool_start(server->options.workers);
+    server->listenFd = open_listener(&server->options);
+    server->signalFd = signalfd(-1, &stopSignals, SFD_NONBLOCK | SFD_CLOEXEC);
+    server->epollFd  = epoll_create1(EPOLL_CLOEXEC);
+    if (!server->pool || server->listenFd < 0 || server->signalFd < 0 || server->epollFd < 0) return false;
+
+    return epoll_watch(server, EPOLL_CTL_ADD, server->listenFd, EPOLLIN, TAG_LISTEN) &&
+           epoll_watch(server, EPOLL_CTL_ADD, worker_pool_fd(server->pool), EPOLLIN, TAG_WORKERS) &&
+           epoll_watch(server, EPOLL_CTL_ADD, server->signalFd, EPOLLIN, TAG_SIGNAL);
+}
+
+static void server_run(Server *server)
+{
+    struct epoll_event events[EPOLL_BATCH];
+
+    for (;;)
+    {
+        const int ready = epoll_wait(server->epollFd, events, EPOLL_BATCH, -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            perror("cardsim-server: epoll_wait");
+            return;
+        }
+
+        for (int i = 0; i < ready; ++i) {
+            const uint32_t tag = events[i].data.u32;
+
+            if (tag == TAG_SIGNAL)  return;
+            if (tag == TAG_LISTEN)  { accept_all(server); continue; }
+            if (tag == TAG_WORKERS) { finish_jobs(server); continue; }
+
+            /* An earlier event in this batch may have closed the connection. */
+            const int32_t index = (int32_t)tag;
+            if (server->conns[index].fd < 0) continue;
+
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) conn_read(server, index);
+            if (server->conns[index].fd >= 0 && (events[i].events & EPOLLOUT))  conn_flush(server, index);
+        }
+    }
+}
+
+static void server_shutdown(Server *server)
+{
+    CsTally total = { 0 };
+
+    if (server->conns) {
+        for (uint32_t i = 0; i < server->options.maxConnections; ++i) {
+            if (server->conns[i].fd >= 0) conn_close(server, (int32_t)i);
+        }
+    }
+    worker_pool_stop(server->pool, &total);
+    if (server->scratch) cs_tally_merge(&total, &server->scratch->tally);
+
+    printf("cardsim-server: %llu requests; %llu rounds settled (%llu won, %llu lost, %llu pushed), net %lld\n",
+           (unsigned long long)server->requests, (unsigned long long)total.rounds,
+           (unsigned long long)total.wins, (unsigned long long)total.losses,
+           (unsigned long long)total.pushes, (long long)total.net);
+
+    if (server->epollFd >= 0)  close(server->epollFd);
+    if (server->signalFd >= 0) close(server->signalFd);
+    if (server->listenFd >= 0) close(server->listenFd);
+    if (server->options.unixPath) unlink(server->options.unixPath);
+
+    session_table_free(&server->sessions);
+    free(server->scratch);
+    free(server->conns);
+}
+
+int main(int argc, char **argv)
+{
+    Server server;
+    memset(&server, 0, sizeof(server));
+    if (!parse_args(argc, argv, &server.options)) return 2;
+
+    const bool ready = server_init(&server);
+    if (ready) {
+        if (server.options.unixPath) printf("cardsim-server: listening on %s", server.options.unixPath);
+        else                         printf("cardsim-server: listening on 127.0.0.1:%d", server.options.tcpPort);
+        printf(" (%d workers, up to %u sessions)\n", server.options.workers, server.options.maxSessions);
+        fflush(stdout);
+
+        server_run(&server);
+    }
+
+    server_shutdown(&server);
+    return ready ? 0 : 1;
+}
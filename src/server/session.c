@@ -0,0 +1,361 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * cardsim-server sessions (see server.h).
+ *
+ * Responsibilities:
+ *   - Session table: slot ids with generations, per-connection lists.
+ *   - Slab arenas, one per game, holding each session as a full snapshot
+ *     (cardsim.h); every request restores it into the thread's
+ *     EngineScratch, acts, and snapshots it again.
+ *   - Player-view snapshots of each game for replies.
+ */
+
+#include "server.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Bound on AI moves answering one PLAY. Every AI move after the first lays
+   a card (cs_idiot_step), so a full deck's worth means the engine is broken. */
+#define IDIOT_AI_STEP_CAP  (DECK_SIZE + 2 + 1)
+
+/* The snapshot in a record (written by session_start, so always valid). */
+static CsSnapshot open_record(CsGame game, const void *record)
+{
+    CsSnapshot snap = { 0 };
+    cs_snap_open(&snap, record, cs_snap_max_size(game));
+    return snap;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Slab arenas                                                               */
+/* ------------------------------------------------------------------------- */
+
+#define SLAB_CHUNK_BYTES  (256u * 1024u)
+
+static void slab_init(SlabArena *arena, size_t recordSize)
+{
+    memset(arena, 0, sizeof(*arena));
+    /* Free slots hold the free-list link, so keep them pointer-aligned. */
+    arena->slotSize      = (recordSize + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    arena->slotsPerChunk = SLAB_CHUNK_BYTES / arena->slotSize;
+}
+
+static bool slab_grow(SlabArena *arena)
+{
+    if (arena->chunkCount == arena->chunkCapacity) {
+        const int capacity = arena->chunkCapacity ? arena->chunkCapacity * 2 : 8;
+        void **chunks = (void **)realloc(arena->chunks, (size_t)capacity * sizeof(void *));
+        if (!chunks) return false;
+        arena->chunks        = chunks;
+        arena->chunkCapacity = capacity;
+    }
+
+    char *chunk = (char *)malloc(arena->slotsPerChunk * arena->slotSize);
+    if (!chunk) return false;
+    arena->chunks[arena->chunkCount++] = chunk;
+
+    /* Thread the new slots onto the free list, first slot on top. */
+    for (size_t i = arena->slotsPerChunk; i-- > 0; ) {
+        void *slot = chunk + i * arena->slotSize;
+        *(void **)slot  = arena->freeList;
+        arena->freeList = slot;
+    }
+    return true;
+}
+
+static void *slab_alloc(SlabArena *arena)
+{
+    if (!arena->freeList && !slab_grow(arena)) return NULL;
+
+    void *slot      = arena->freeList;
+    arena->freeList = *(void **)slot;
+    arena->live++;
+    memset(slot, 0, arena->slotSize);
+    return slot;
+}
+
+static void slab_free(SlabArena *arena, void *slot)
+{
+    *(void **)slot  = arena->freeList;
+    arena->freeList = slot;
+    arena->live--;
+}
+
+static void slab_destroy(SlabArena *arena)
+{
+    for (int i = 0; i < arena->chunkCount; ++i) free(arena->chunks[i]);
+    free(arena->chunks);
+    memset(arena, 0, sizeof(*arena));
+}
+
+/* ------------------------------------------------------------------------- */
+/* Session table                                                             */
+/* ------------------------------------------------------------------------- */
+
+bool session_table_init(SessionTable *table, uint32_t capacity)
+{
+    memset(table, 0, sizeof(*table));
+    if (capacity == 0 || capacity > SESSION_MAX) return false;
+
+    table->slots = (SessionSlot *)calloc(capacity, sizeof(SessionSlot));
+    if (!table->slots) return false;
+    table->capacity = capacity;
+
+    for (uint32_t i = 0; i < capacity; ++i) {
+        table->slots[i].next = (i + 1 < capacity) ? (int32_t)(i + 1) : -1;
+    }
+    table->freeHead = 0;
+
+    for (int game = CS_GAME_BLACKJACK; game <= CS_GAME_IDIOT; ++game) {
+        slab_init(&table->arenas[game], cs_snap_max_size((CsGame)game));
+    }
+    return true;
+}
+
+void session_table_free(SessionTable *table)
+{
+    for (int game = CS_GAME_BLACKJACK; game <= CS_GAME_IDIOT; ++game) {
+        slab_destroy(&table->arenas[game]);
+    }
+    free(table->slots);
+    memset(table, 0, sizeof(*table));
+}
+
+int32_t session_open(SessionTable *table, CsGame game, int32_t owner, int32_t *owned)
+{
+    if (table->freeHead < 0) return -1;
+
+    void *record = slab_alloc(&table->arenas[game]);
+    if (!record) return -1;
+
+    const int32_t index = table->freeHead;
+    SessionSlot  *slot  = &table->slots[index];
+    table->freeHead = slot->next;
+
+    slot->record   = record;
+    slot->game     = (uint8_t)game;
+    slot->busy     = 0;
+    slot->orphaned = 0;
+    slot->owner    = owner;
+    slot->prev     = -1;
+    slot->next     = *owned;
+    if (*owned >= 0) table->slots[*owned].prev = index;
+    *owned = index;
+
+    table->live++;
+    return index;
+}
+
+void session_release(SessionTable *table, int32_t index)
+{
+    SessionSlot *slot = &table->slots[index];
+
+    slab_free(&table->arenas[slot->game], slot->record);
+    slot->record = NULL;
+    slot->generation++;                /* stale ids stop resolving */
+    slot->next     = table->freeHead;
+    table->freeHead = index;
+    table->live--;
+}
+
+void session_close(SessionTable *table, int32_t index, int32_t *owned)
+{
+    SessionSlot *slot = &table->slots[index];
+
+    if (slot->prev >= 0) table->slots[slot->prev].next = slot->next;
+    else                 *owned = slot->next;
+    if (slot->next >= 0) table->slots[slot->next].prev = slot->prev;
+
+    if (slot->busy) slot->orphaned = 1;      /* freed when the job returns */
+    else            session_release(table, index);
+}
+
+int32_t session_lookup(const SessionTable *table, uint32_t id, int32_t owner)
+{
+    const uint32_t number = id & SESSION_MAX;
+    if (number == 0 || number > table->capacity) return -1;
+
+    const int32_t      index = (int32_t)(number - 1);
+    const SessionSlot *slot  = &table->slots[index];
+    if (!slot->record || slot->orphaned || slot->owner != owner) return -1;
+    if ((slot->generation & (UINT32_MAX >> SESSION_INDEX_BITS)) != id >> SESSION_INDEX_BITS) return -1;
+    return index;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Game actions                                                              */
+/* ------------------------------------------------------------------------- */
+
+CsWireStatus session_start(EngineScratch *scratch, CsGame game, void *record, const WireOpen *open)
+{
+    const CsStatsSink sink     = cs_tally_sink(&scratch->tally);
+    const size_t      capacity = cs_snap_max_size(game);
+    CsRng rng;
+    cs_rng_seed(&rng, open->seed);
+
+    switch (game)
+    {
+        case CS_GAME_BLACKJACK:
+            if (open->option < 1 || open->option > MAX_SHOE_DECKS) return CS_WIRE_BAD_GAME;
+            cs_blackjack_init(&scratch->blackjack, open->option, open->seed, &sink);
+            cs_blackjack_snapshot(&scratch->blackjack, 0, record, capacity);
+            return CS_WIRE_OK;
+
+        case CS_GAME_KLONDIKE:
+            if (open->difficulty < DIFFICULTY_EASY || open->difficulty > DIFFICULTY_HARD) return CS_WIRE_BAD_GAME;
+            cs_klondike_deal_random(&scratch->klondike, open->difficulty, &rng);
+            cs_klondike_snapshot(&scratch->klondike, 0, record, capacity);
+            return CS_WIRE_OK;
+
+        case CS_GAME_IDIOT:
+            if (open->difficulty < DIFFICULTY_EASY || open->difficulty > DIFFICULTY_HARD || open->option > 1) {
+                return CS_WIRE_BAD_GAME;
+            }
+            cs_idiot_new_game(&scratch->idiot, open->difficulty, open->difficulty, open->option == 1, &rng, &sink);
+            cs_idiot_snapshot(&scratch->idiot, 0, record, capacity);
+            return CS_WIRE_OK;
+    }
+    return CS_WIRE_BAD_GAME;
+}
+
+bool session_is_slow(CsGame game, const WireAction *action)
+{
+    return (game == CS_GAME_KLONDIKE && action->action == CS_ACT_KL_SOLVE) ||
+           (game == CS_GAME_IDIOT    && action->action == CS_ACT_ID_PLAY);
+}
+
+static CsWireStatus apply_blackjack(EngineScratch *scratch, const CsSnapshot *snap, void *record,
+                                    const WireAction *action)
+{
+    const CsStatsSink  sink  = cs_tally_sink(&scratch->tally);
+    CsBlackjackTable  *table = &scratch->blackjack;
+    if (!cs_blackjack_restore(table, snap, &sink)) return CS_WIRE_ILLEGAL;
+
+    if (action->action == CS_ACT_BJ_DEAL) {
+        if (!cs_blackjack_round_over(table) || action->amount == 0) return CS_WIRE_ILLEGAL;
+        cs_blackjack_deal(table, action->amount);
+    } else if (action->action >= CS_ACT_BJ_HIT && action->action <= CS_ACT_BJ_SURRENDER) {
+        if (!cs_blackjack_act(table, (CsBlackjackAction)(action->action - CS_ACT_BJ_HIT))) return CS_WIRE_ILLEGAL;
+    } else {
+        return CS_WIRE_ILLEGAL;
+    }
+
+    cs_blackjack_snapshot(table, 0, record, cs_snap_max_size(CS_GAME_BLACKJACK));
+    return CS_WIRE_OK;
+}
+
+static CsWireStatus apply_klondike(EngineScratch *scratch, const CsSnapshot *snap, void *record,
+                                   const WireAction *action)
+{
+    KlondikeGame *game = &scratch->klondike;
+    if (!cs_klondike_restore(game, snap)) return CS_WIRE_ILLEGAL;
+
+    /* The board only changes on DRAW/MOVE, which drops a stale verdict;
+       SOLVE rewrites the same board with one. */
+    bool     solved = false;
+    uint32_t nodes  = 0;
+
+    switch (action->action)
+    {
+        case CS_ACT_KL_DRAW:
+            cs_klondike_draw(game);
+            break;
+
+        case CS_ACT_KL_MOVE:
+            if (!cs_klondike_move(game, (CsKlondikeMove)action->arg[0], action->arg[1], action->arg[2])) {
+                return CS_WIRE_ILLEGAL;
+            }
+            break;
+
+        case CS_ACT_KL_SOLVE:
+            if (!scratch->solver) return CS_WIRE_ILLEGAL;
+            solved = cs_klondike_solve(scratch->solver, game);
+            nodes  = (uint32_t)scratch->solver->nodeCount;
+            break;
+
+        default:
+            return CS_WIRE_ILLEGAL;
+    }
+
+    CsSnapWriter writer;
+    cs_snap_begin(&writer, record, cs_snap_max_size(CS_GAME_KLONDIKE), CS_GAME_KLONDIKE, 0);
+    cs_klondike_snapshot_write(&writer, game);
+    if (action->action == CS_ACT_KL_SOLVE) {
+        cs_snap_put(&writer, CS_SNAP_KL_VERDICT, solved ? 2 : 1, 1);
+        cs_snap_put(&writer, CS_SNAP_KL_NODES, nodes, 4);
+    }
+    cs_snap_finish(&writer);
+    return CS_WIRE_OK;
+}
+
+static CsWireStatus apply_idiot(EngineScratch *scratch, const CsSnapshot *snap, void *record,
+                                const WireAction *action)
+{
+    const CsStatsSink sink = cs_tally_sink(&scratch->tally);
+    CsIdiotGame      *game = &scratch->idiot;
+    if (!cs_idiot_restore(game, snap, &sink)) return CS_WIRE_ILLEGAL;
+
+    if (action->action != CS_ACT_ID_PLAY || game->winner >= 0 || game->turn != 0) return CS_WIRE_ILLEGAL;
+    if (!cs_idiot_play(game, action->arg[0], action->arg[1])) return CS_WIRE_ILLEGAL;
+
+    /* The AI answers until the turn comes back. Should it not, reject the
+       PLAY and leave the stored game as it was rather than fake a turn. */
+    for (int steps = 0; game->winner < 0 && game->turn == 1; ++steps) {
+        if (steps == IDIOT_AI_STEP_CAP) return CS_WIRE_ILLEGAL;
+        cs_idiot_step(game);
+    }
+
+    cs_idiot_snapshot(game, 0, record, cs_snap_max_size(CS_GAME_IDIOT));
+    return CS_WIRE_OK;
+}
+
+CsWireStatus session_apply(EngineScratch *scratch, CsGame game, void *record, const WireAction *action)
+{
+    const CsSnapshot snap = open_record(game, record);
+
+    switch (game)
+    {
+        case CS_GAME_BLACKJACK:  return apply_blackjack(scratch, &snap, record, action);
+        case CS_GAME_KLONDIKE:   return apply_klondike(scratch, &snap, record, action);
+        case CS_GAME_IDIOT:      return apply_idiot(scratch, &snap, record, action);
+    }
+    return CS_WIRE_BAD_GAME;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Views                                                                     */
+/* ------------------------------------------------------------------------- */
+
+size_t session_view(EngineScratch *scratch, CsGame game, const void *record, uint8_t *out, size_t capacity)
+{
+    const CsSnapshot snap = open_record(game, record);
+    CsSnapWriter     writer;
+    cs_snap_begin(&writer, out, capacity, game, CS_SNAP_PLAYER_VIEW);
+
+    switch (game)
+    {
+        case CS_GAME_BLACKJACK:
+            if (!cs_blackjack_restore(&scratch->blackjack, &snap, NULL)) return 0;
+            cs_blackjack_snapshot_write(&writer, &scratch->blackjack);
+            break;
+
+        case CS_GAME_KLONDIKE:
+            if (!cs_klondike_restore(&scratch->klondike, &snap)) return 0;
+            cs_klondike_snapshot_write(&writer, &scratch->klondike);
+            /* The verdict is read straight out of the record. */
+            if (cs_snap_offset(&snap, CS_SNAP_KL_VERDICT)) {
+                cs_snap_put(&writer, CS_SNAP_KL_VERDICT, cs_snap_u8(&snap, CS_SNAP_KL_VERDICT), 1);
+                cs_snap_put(&writer, CS_SNAP_KL_NODES, cs_snap_u32(&snap, CS_SNAP_KL_NODES), 4);
+            }
+            break;
+
+        case CS_GAME_IDIOT:
+            if (!cs_idiot_restore(&scratch->idiot, &snap, NULL)) return 0;
+            cs_idiot_snapshot_write(&writer, &scratch->idiot);
+            break;
+    }
+    return cs_snap_finish(&writer);
+}
@@ -0,0 +1,195 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * cardsim-server worker pool (see server.h).
+ *
+ * Responsibilities:
+ *   - A FIFO of slow jobs (solves, AI turns) shared by N worker threads.
+ *   - One EngineScratch and solver context per worker, reused for every job.
+ *   - A done queue drained by the loop thread, announced on an eventfd so
+ *     the epoll loop never blocks on a worker.
+ */
+
+#define _GNU_SOURCE   /* eventfd */
+
+#include "server.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+/* ------------------------------------------------------------------------- */
+/* Pool                                                                      */
+/* ------------------------------------------------------------------------- */
+
+typedef struct {
+    WorkerPool     *pool;
+    PlatformThread  thread;
+    EngineScratch   scratch;
+} Worker;
+
+struct WorkerPool {
+    PlatformMutex  lock;
+    PlatformCond   ready;
+    ServerJob     *head, *tail;            /* waiting jobs   */
+    ServerJob     *doneHead, *doneTail;    /* finished jobs  */
+    bool           stopping;
+    int            eventFd;
+    int            count;
+    Worker        *workers;
+};
+
+static void push_job(ServerJob **head, ServerJob **tail, ServerJob *job)
+{
+    job->next = NULL;
+    if (*tail) (*tail)->next = job;
+    else       *head = job;
+    *tail = job;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Worker threads                                                            */
+/* ------------------------------------------------------------------------- */
+
+static void run_job(EngineScratch *scratch, ServerJob *job)
+{
+    job->status     = session_apply(scratch, (CsGame)job->game, job->record, &job->action);
+    job->bodyLength = 0;
+    if (job->status == CS_WIRE_OK) {
+        job->bodyLength = session_view(scratch, (CsGame)job->game, job->record, job->body, sizeof(job->body));
+    }
+}
+
+static void worker_main(void *arg)
+{
+    Worker     *worker = (Worker *)arg;
+    WorkerPool *pool   = worker->pool;
+
+    for (;;)
+    {
+        platform_mutex_lock(&pool->lock);
+        while (!pool->head && !pool->stopping) platform_cond_wait(&pool->ready, &pool->lock);
+        if (!pool->head) { platform_mutex_unlock(&pool->lock); return; }   /* stopping */
+
+        ServerJob *job = pool->head;
+        pool->head = job->next;
+        if (!pool->head) pool->tail = NULL;
+        platform_mutex_unlock(&pool->lock);
+
+        run_job(&worker->scratch, job);
+
+        platform_mutex_lock(&pool->lock);
+        push_job(&pool->doneHead, &pool->doneTail, job);
+        platform_mutex_unlock(&pool->lock);
+
+        const uint64_t one = 1;
+        (void)!write(pool->eventFd, &one, sizeof(one));
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------- */
+
+WorkerPool *worker_pool_start(int count)
+{
+    if (count < 1) count = 1;
+
+    WorkerPool *pool = (WorkerPool *)calloc(1, sizeof(WorkerPool));
+    if (!pool) return NULL;
+
+    pool->workers = (Worker *)calloc((size_t)count, sizeof(Worker));
+    pool->eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (!pool->workers || pool->eventFd < 0) {
+        if (pool->eventFd >= 0) close(pool->eventFd);
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+
+    platform_mutex_init(&pool->lock);
+    platform_cond_init(&pool->ready);
+
+    for (int i = 0; i < count; ++i) {
+        Worker *worker = &pool->workers[i];
+        worker->pool           = pool;
+        worker->scratch.solver = cs_solver_create();
+        if (!worker->scratch.solver || !platform_thread_create(&worker->thread, worker_main, worker)) {
+            cs_solver_destroy(worker->scratch.solver);
+            break;
+        }
+        pool->count++;
+    }
+
+    if (pool->count == 0) {
+        worker_pool_stop(pool, NULL);
+        return NULL;
+    }
+    return pool;
+}
+
+void worker_pool_stop(WorkerPool *pool, CsTally *tally)
+{
+    if (!pool) return;
+
+    /* Cancel what no worker has started: a queued solve can run for seconds
+       and nobody is left to read its reply. Running jobs finish. */
+    platform_mutex_lock(&pool->lock);
+    ServerJob *waiting = pool->head;
+    pool->head = pool->tail = NULL;
+    pool->stopping = true;
+    platform_cond_broadcast(&pool->ready);
+    platform_mutex_unlock(&pool->lock);
+
+    while (waiting) {
+        ServerJob *job = waiting;
+        waiting = job->next;
+        free(job);
+    }
+
+    for (int i = 0; i < pool->count; ++i) {
+        platform_thread_join(pool->workers[i].thread);
+        if (tally) cs_tally_merge(tally, &pool->workers[i].scratch.tally);
+        cs_solver_destroy(pool->workers[i].scratch.solver);
+    }
+
+    /* Jobs still on the done queue were never taken back by the loop. */
+    while (pool->doneHead) {
+        ServerJob *job = pool->doneHead;
+        pool->doneHead = job->next;
+        free(job);
+    }
+
+    platform_cond_destroy(&pool->ready);
+    platform_mutex_destroy(&pool->lock);
+    close(pool->eventFd);
+    free(pool->workers);
+    free(pool);
+}
+
+int worker_pool_fd(const WorkerPool *pool)
+{
+    return pool->eventFd;
+}
+
+void worker_pool_submit(WorkerPool *pool, ServerJob *job)
+{
+    platform_mutex_lock(&pool->lock);
+    push_job(&pool->head, &pool->tail, job);
+    platform_cond_signal(&pool->ready);
+    platform_mutex_unlock(&pool->lock);
+}
+
+ServerJob *worker_pool_take_done(WorkerPool *pool)
+{
+    uint64_t pending;
+    (void)!read(pool->eventFd, &pending, sizeof(pending));   /* reset the counter */
+
+    platform_mutex_lock(&pool->lock);
+    ServerJob *jobs = pool->doneHead;
+    pool->doneHead = pool->doneTail = NULL;
+    platform_mutex_unlock(&pool->lock);
+    return jobs;
+}
@@ -0,0 +1,509 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * cardsim-sim: Monte Carlo win rates of the scripted Klondike policies
+ * (cs_klondike_play) at each difficulty, or with --blind the blind-solver
+ * rating of each deal (cs_klondike_blind_solve), or with --solve the
+ * solver's default move set against the complete one.
+ *
+ *   cardsim-sim [--games N] [--threads N] [--policy greedy|safe|auto|all]
+ *               [--difficulty easy|normal|hard|all] [--seed S] [--max-moves N]
+ *               [--blind SAMPLES [--complete] [--list] | --solve] [--nodes N]
+ *
+ * Responsibilities:
+ *   - A stream of seeded deals: deal i is dealt from seed S + i on demand,
+ *     so every policy and difficulty plays the same N boards and a run is
+ *     reproducible whatever the thread count.
+ *   - Worker threads claiming chunks of the stream, each with one reusable
+ *     board and its own tallies; nothing is shared while games run.
+ *   - Win rate, mean moves and time per game for every policy/difficulty,
+ *     plus the overall throughput.
+ *   - Blind ratings: the estimated win probability of every deal when the
+ *     face-down cards and the stock are unknown, as a mean with the bounds
+ *     left open by cut-off samples and a histogram per difficulty. Deals
+ *     with too many cut-off samples are reported as unrated instead of
+ *     being filed as losses (--list also prints each deal's rating).
+ *   - Move-set comparison: every deal solved with both move sets, counting
+ *     the deals the default set rejects that the complete set wins, and
+ *     the nodes and time each set spends.
+ */
+
+#include "cardsim.h"
+#include "platform.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ------------------------------------------------------------------------- */
+/* Limits                                                                    */
+/* ------------------------------------------------------------------------- */
+
+#define DEFAULT_GAMES        100000
+#define DEFAULT_MAX_MOVES    2000
+#define SIM_CHUNK            512       /* games a worker claims at a time */
+#define SIM_MAX_THREADS      256
+#define DEFAULT_BLIND_NODES  100000    /* per sample; --solve defaults to DFS_NODE_LIMIT */
+#define BLIND_BUCKETS        10        /* histogram of deal ratings, 10% wide */
+#define BLIND_MAX_CUT_OFF    25        /* % of cut-off samples above which a deal is unrated */
+
+static const char *const g_PolicyNames[CS_KLONDIKE_POLICY_COUNT]  = { "greedy", "safe", "auto" };
+static const char *const g_DifficultyNames[DIFFICULTY_HARD + 1]   = { "", "easy", "normal", "hard" };
+
+/* ------------------------------------------------------------------------- */
+/* Types                                                                     */
+/* ------------------------------------------------------------------------- */
+
+typedef struct {
+    long     games;
+    int      threads;
+    int      maxMoves;
+    uint64_t seed;
+    int      blindSamples;             /* 0: play the policies instead */
+    bool     solve;                    /* compare the solver's move sets */
+    bool     complete;                 /* blind samples use CS_SOLVER_COMPLETE_MOVES */
+    long     nodes;                    /* node budget per solve, -1 until set */
+    bool     list;
+    bool     policies[CS_KLONDIKE_POLICY_COUNT];
+    bool     difficulties[DIFFICULTY_HARD + 1];
+} SimOptions;
+
+/* One policy at one difficulty (rating and solving: just the difficulty). */
+typedef struct {
+    CsKlondikePolicy policy;
+    int              difficulty;
+} SimCase;
+
+typedef struct {
+    uint64_t games;
+    uint64_t wins;
+    uint64_t moves;
+    uint64_t elapsedNs;
+    CsBlindResult blind;
+    uint64_t      ratings[BLIND_BUCKETS];
+    uint64_t      unrated;             /* deals over BLIND_MAX_CUT_OFF */
+
+    /* --solve: [0] default move set, [1] complete */
+    uint64_t      solved[2];
+    uint64_t      cutOff[2];
+    uint64_t      solveNodes[2];
+    uint64_t      solveNs[2];
+    uint64_t      rescued;             /* lost by default, won by complete */
+    uint64_t      dropped;             /* won by default, not by complete  */
+} SimTally;
+
+typedef struct Simulator Simulator;
+
+typedef struct {
+    Simulator      *sim;
+    PlatformThread  thread;
+    KlondikeGame    board;                 /* reused for every game */
+    SolverContext  *solver;                /* --blind and --solve   */
+    SimTally        tallies[CS_KLONDIKE_POLICY_COUNT * DIFFICULTY_HARD];
+} SimWorker;
+
+struct Simulator {
+    const SimOptions *opts;
+    SimCase           cases[CS_KLONDIKE_POLICY_COUNT * DIFFICULTY_HARD];
+    int               caseCount;
+    uint64_t          total;               /* caseCount * games */
+
+    PlatformMutex     lock;
+    uint64_t          next;                /* first unclaimed item of the stream */
+};
+
+/* ------------------------------------------------------------------------- */
+/* Options                                                                   */
+/* ------------------------------------------------------------------------- */
+
+static bool parse_count(const char *text, long low, long high, long *out)
+{
+    char *end = NULL;
+    const long value = strtol(text, &end, 10);
+    if (!end || *end != '\0' || value < low || value > high) return false;
+    *out = value;
+    return true;
+}
+
+/* Set the flag named `name` (or all of them) in `flags`; false if unknown. */
+static bool parse_choice(const char *name, const char *const *names, int first, int count, bool *flags)
+{
+    const bool all   = strcmp(name, "all") == 0;
+    bool       found = all;
+    for (int i = first; i < count; ++i) {
+        if (all || strcmp(name, names[i]) == 0) { flags[i] = true; found = true; }
+    }
+    return found;
+}
+
+static bool usage(const char *program)
+{
+    fprintf(stderr, "Usage: %s [--games N] [--threads N] [--policy greedy|safe|auto|all]\n"
+                    "       [--difficulty easy|normal|hard|all] [--seed S] [--max-moves N]\n"
+                    "       [--blind SAMPLES [--complete] [--list] | --solve] [--nodes N]\n", program);
+    return false;
+}
+
+/**
+ * parse_args
+ * Fill opts from argv (every policy and difficulty unless narrowed down).
+ * Prints usage to stderr and returns false on error.
+ */
+static bool parse_args(int argc, char **argv, SimOptions *opts)
+{
+    bool anyPolicy = false, anyDifficulty = false;
+
+    memset(opts, 0, sizeof(*opts));
+    opts->games    = DEFAULT_GAMES;
+    opts->threads  = platform_cpu_count();
+    opts->maxMoves = DEFAULT_MAX_MOVES;
+    opts->seed     = 1;
+    opts->nodes    = -1;
+
+    for (int i = 1; i < argc; ++i) {
+        long value = 0;
+        const bool hasValue = (i + 1 < argc);
+
+        if (strcmp(argv[i], "--games") == 0 && hasValue && parse_count(argv[i + 1], 1, 1000000000L, &value)) {
+            opts->games = value; ++i;
+        } else if (strcmp(argv[i], "--threads") == 0 && hasValue &&
+                   parse_count(argv[i + 1], 1, SIM_MAX_THREADS, &value)) {
+            opts->threads = (int)value; ++i;
+        } else if (strcmp(argv[i], "--max-moves") == 0 && hasValue && parse_count(argv[i + 1], 1, 1000000, &value)) {
+            opts->maxMoves = (int)value; ++i;
+        } else if (strcmp(argv[i], "--blind") == 0 && hasValue && parse_count(argv[i + 1], 1, 100000, &value)) {
+            opts->blindSamples = (int)value; ++i;
+        } else if (strcmp(argv[i], "--nodes") == 0 && hasValue && parse_count(argv[i + 1], 0, DFS_NODE_LIMIT, &value)) {
+            opts->nodes = value; ++i;
+        } else if (strcmp(argv[i], "--solve") == 0) {
+            opts->solve = true;
+        } else if (strcmp(argv[i], "--complete") == 0) {
+            opts->complete = true;
+        } else if (strcmp(argv[i], "--list") == 0) {
+            opts->list = true;
+        } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            opts->seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--policy") == 0 && hasValue &&
+                   parse_choice(argv[i + 1], g_PolicyNames, 0, CS_KLONDIKE_POLICY_COUNT, opts->policies)) {
+            anyPolicy = true; ++i;
+        } else if (strcmp(argv[i], "--difficulty") == 0 && hasValue &&
+                   parse_choice(argv[i + 1], g_DifficultyNames, DIFFICULTY_EASY, DIFFICULTY_HARD + 1,
+                                opts->difficulties)) {
+            anyDifficulty = true; ++i;
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    if (opts->solve && opts->blindSamples) return usage(argv[0]);
+    if (opts->nodes < 0) opts->nodes = opts->blindSamples ? DEFAULT_BLIND_NODES : 0;
+
+    if (!anyPolicy)     parse_choice("all", g_PolicyNames, 0, CS_KLONDIKE_POLICY_COUNT, opts->policies);
+    if (!anyDifficulty) parse_choice("all", g_DifficultyNames, DIFFICULTY_EASY, DIFFICULTY_HARD + 1, opts->difficulties);
+    if (opts->threads > SIM_MAX_THREADS) opts->threads = SIM_MAX_THREADS;
+    return true;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Workers                                                                   */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * claim
+ * Take the next chunk of the stream, cut at a case boundary so a chunk's
+ * time belongs to one case. False once the stream is exhausted.
+ */
+static bool claim(Simulator *sim, uint64_t *first, uint64_t *count)
+{
+    const uint64_t games = (uint64_t)sim->opts->games;
+
+    platform_mutex_lock(&sim->lock);
+    *first = sim->next;
+    *count = 0;
+    if (*first < sim->total) {
+        const uint64_t caseEnd = (*first / games + 1) * games;
+        *count    = (caseEnd - *first < SIM_CHUNK) ? caseEnd - *first : SIM_CHUNK;
+        sim->next = *first + *count;
+    }
+    platform_mutex_unlock(&sim->lock);
+    return *first < sim->total;
+}
+
+/**
+ * rate_deal
+ * Blind-solve the deal in worker->board and file its rating: wins over the
+ * samples that finished. A deal with more than BLIND_MAX_CUT_OFF percent
+ * cut-off samples is counted as unrated, since its rating would measure the
+ * node budget. The samples draw from the deal's own stream, so ratings do
+ * not depend on threads.
+ */
+static void rate_deal(SimWorker *worker, SimTally *tally, CsRng *rng, uint64_t dealSeed)
+{
+    Simulator    *sim    = worker->sim;
+    CsBlindResult result = { 0 };
+
+    cs_klondike_blind_solve(worker->solver, &worker->board, sim->opts->blindSamples,
+                            (size_t)sim->opts->nodes, rng, &result);
+
+    tally->blind.samples    += result.samples;
+    tally->blind.wins       += result.wins;
+    tally->blind.unresolved += result.unresolved;
+    tally->blind.nodes      += result.nodes;
+
+    const uint64_t resolved = result.samples - result.unresolved;
+    const bool     rated    = result.unresolved * 100 <= result.samples * BLIND_MAX_CUT_OFF;
+    if (rated) {
+        tally->wins          += result.wins * 2 >= resolved;
+        const uint64_t bucket = result.wins * BLIND_BUCKETS / resolved;
+        tally->ratings[bucket < BLIND_BUCKETS ? bucket : BLIND_BUCKETS - 1]++;
+    } else {
+        tally->unrated++;
+    }
+
+    if (sim->opts->list) {
+        platform_mutex_lock(&sim->lock);
+        printf("deal %" PRIu64 " %s %" PRIu64 "/%" PRIu64 " (%" PRIu64 " cut off)%s\n", dealSeed,
+               g_DifficultyNames[worker->board.difficulty], result.wins, resolved, result.unresolved,
+               rated ? "" : " unrated");
+        platform_mutex_unlock(&sim->lock);
+    }
+}
+
+/**
+ * compare_move_sets
+ * Solve the deal in worker->board with the default and then the complete
+ * move set, each within the node budget.
+ */
+static void compare_move_sets(SimWorker *worker, SimTally *tally)
+{
+    static const unsigned moveSets[2] = { 0, CS_SOLVER_COMPLETE_MOVES };
+    SolverContext        *solver      = worker->solver;
+    bool                  won[2];
+
+    for (int set = 0; set < 2; ++set) {
+        const uint64_t start = platform_now_ns();
+        solver->options = moveSets[set];
+        cs_solver_begin(solver, &worker->board);
+        const CsSolveStatus status = cs_solver_run(solver, (size_t)worker->sim->opts->nodes);
+
+        won[set]                = status == CS_SOLVE_WON;
+        tally->solved[set]     += won[set];
+        tally->cutOff[set]     += status == CS_SOLVE_RUNNING || solver->nodeCount > DFS_NODE_LIMIT;
+        tally->solveNodes[set] += solver->nodeCount;
+        tally->solveNs[set]    += platform_now_ns() - start;
+    }
+    tally->rescued += !won[0] && won[1];
+    tally->dropped += won[0] && !won[1];
+}
+
+static void worker_main(void *arg)
+{
+    SimWorker      *worker = (SimWorker *)arg;
+    Simulator      *sim    = worker->sim;
+    const uint64_t  games  = (uint64_t)sim->opts->games;
+    uint64_t        first, count;
+
+    while (claim(sim, &first, &count)) {
+        const int      caseIndex = (int)(first / games);
+        const SimCase *simCase   = &sim->cases[caseIndex];
+        SimTally      *tally     = &worker->tallies[caseIndex];
+
+        const uint64_t start = platform_now_ns();
+        for (uint64_t item = first; item < first + count; ++item) {
+            CsRng rng;
+            int   moves = 0;
+            cs_rng_seed(&rng, sim->opts->seed + item % games);
+            cs_klondike_deal_random(&worker->board, simCase->difficulty, &rng);
+
+            if (sim->opts->blindSamples) {
+                rate_deal(worker, tally, &rng, sim->opts->seed + item % games);
+                continue;
+            }
+            if (sim->opts->solve) {
+                compare_move_sets(worker, tally);
+                continue;
+            }
+            tally->wins  += cs_klondike_play(&worker->board, simCase->policy, sim->opts->maxMoves, &moves);
+            tally->moves += (uint64_t)moves;
+        }
+        tally->elapsedNs += platform_now_ns() - start;
+        tally->games     += count;
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* Report                                                                    */
+/* ------------------------------------------------------------------------- */
+
+/* Case `c` summed over every worker. */
+static SimTally case_total(const SimWorker *workers, int workerCount, int c)
+{
+    SimTally sum = { 0 };
+    for (int w = 0; w < workerCount; ++w) {
+        const SimTally *tally = &workers[w].tallies[c];
+        sum.games            += tally->games;
+        sum.wins             += tally->wins;
+        sum.moves            += tally->moves;
+        sum.elapsedNs        += tally->elapsedNs;
+        sum.blind.samples    += tally->blind.samples;
+        sum.blind.wins       += tally->blind.wins;
+        sum.blind.unresolved += tally->blind.unresolved;
+        sum.blind.nodes      += tally->blind.nodes;
+        for (int b = 0; b < BLIND_BUCKETS; ++b) sum.ratings[b] += tally->ratings[b];
+        sum.unrated += tally->unrated;
+        for (int set = 0; set < 2; ++set) {
+            sum.solved[set]     += tally->solved[set];
+            sum.cutOff[set]     += tally->cutOff[set];
+            sum.solveNodes[set] += tally->solveNodes[set];
+            sum.solveNs[set]    += tally->solveNs[set];
+        }
+        sum.rescued += tally->rescued;
+        sum.dropped += tally->dropped;
+    }
+    return sum;
+}
+
+static void report_policies(const Simulator *sim, const SimWorker *workers, int workerCount)
+{
+    printf("%-10s %-8s %10s %8s %12s %10s\n", "difficulty", "policy", "games", "win%", "moves/game", "us/game");
+
+    for (int c = 0; c < sim->caseCount; ++c) {
+        const SimTally sum   = case_total(workers, workerCount, c);
+        const double   games = sum.games ? (double)sum.games : 1.0;
+        printf("%-10s %-8s %10" PRIu64 " %7.2f%% %12.1f %10.2f\n",
+               g_DifficultyNames[sim->cases[c].difficulty], g_PolicyNames[sim->cases[c].policy], sum.games,
+               100.0 * (double)sum.wins / games, (double)sum.moves / games, (double)sum.elapsedNs / games / 1e3);
+    }
+}
+
+/*
+ * Blind win probability over the samples that finished, the bounds the
+ * cut-off samples leave open (all lost .. all won), the rated deals and
+ * the share of them rated 50%+, then the histogram of rated deals.
+ */
+static void report_blind(const Simulator *sim, const SimWorker *workers, int workerCount)
+{
+    printf("%-10s %10s %8s %17s %8s %8s %10s %12s %10s\n",
+           "difficulty", "games", "p(win)", "bounds", "rated", ">=50%", "cut off", "nodes/smpl", "ms/game");
+
+    for (int c = 0; c < sim->caseCount; ++c) {
+        const SimTally sum      = case_total(workers, workerCount, c);
+        const double   games    = sum.games ? (double)sum.games : 1.0;
+        const double   samples  = sum.blind.samples ? (double)sum.blind.samples : 1.0;
+        const uint64_t resolved = sum.blind.samples - sum.blind.unresolved;
+        const uint64_t rated    = sum.games - sum.unrated;
+        printf("%-10s %10" PRIu64 " %7.2f%% %7.2f%% - %6.2f%% %8" PRIu64 " %7.2f%% %9.2f%% %12.0f %10.2f\n",
+               g_DifficultyNames[sim->cases[c].difficulty], sum.games,
+               100.0 * (double)sum.blind.wins / (resolved ? (double)resolved : 1.0),
+               100.0 * (double)sum.blind.wins / samples,
+               100.0 * (double)(sum.blind.wins + sum.blind.unresolved) / samples,
+               rated, 100.0 * (double)sum.wins / (rated ? (double)rated : 1.0),
+               100.0 * (double)sum.blind.unresolved / samples, (double)sum.blind.nodes / samples,
+               (double)sum.elapsedNs / games / 1e6);
+    }
+
+    printf("\n%-10s", "rating");
+    for (int b = 0; b < BLIND_BUCKETS; ++b) printf(" %5d%%", b * 100 / BLIND_BUCKETS);
+    printf("\n");
+    for (int c = 0; c < sim->caseCount; ++c) {
+        const SimTally sum = case_total(workers, workerCount, c);
+        printf("%-10s", g_DifficultyNames[sim->cases[c].difficulty]);
+        for (int b = 0; b < BLIND_BUCKETS; ++b) printf(" %6" PRIu64, sum.ratings[b]);
+        printf("\n");
+    }
+}
+
+/* Wins, cut-offs, nodes and time per move set, then what the complete set changed. */
+static void report_solve(const Simulator *sim, const SimWorker *workers, int workerCount)
+{
+    static const char *const setNames[2] = { "default", "complete" };
+
+    printf("%-10s %-8s %10s %8s %8s %12s %10s\n", "difficulty", "moves", "games", "won", "cut off", "nodes/game",
+           "ms/game");
+    for (int c = 0; c < sim->caseCount; ++c) {
+        const SimTally sum   = case_total(workers, workerCount, c);
+        const double   games = sum.games ? (double)sum.games : 1.0;
+        for (int set = 0; set < 2; ++set) {
+            printf("%-10s %-8s %10" PRIu64 " %7.2f%% %7.2f%% %12.0f %10.2f\n",
+                   g_DifficultyNames[sim->cases[c].difficulty], setNames[set], sum.games,
+                   100.0 * (double)sum.solved[set] / games, 100.0 * (double)sum.cutOff[set] / games,
+                   (double)sum.solveNodes[set] / games, (double)sum.solveNs[set] / games / 1e6);
+        }
+    }
+
+    printf("\n%-10s %10s %10s %10s\n", "difficulty", "rejected", "rescued", "dropped");
+    for (int c = 0; c < sim->caseCount; ++c) {
+        const SimTally sum      = case_total(workers, workerCount, c);
+        const uint64_t rejected = sum.games - sum.solved[0];
+        printf("%-10s %10" PRIu64 " %10" PRIu64 " %10" PRIu64 "\n",
+               g_DifficultyNames[sim->cases[c].difficulty], rejected, sum.rescued, sum.dropped);
+    }
+}
+
+static void report(const Simulator *sim, const SimWorker *workers, int workerCount, uint64_t wallNs)
+{
+    if (sim->opts->blindSamples) report_blind(sim, workers, workerCount);
+    else if (sim->opts->solve)   report_solve(sim, workers, workerCount);
+    else                         report_policies(sim, workers, workerCount);
+
+    const double seconds = (double)(wallNs ? wallNs : 1) / 1e9;
+    printf("cardsim-sim: %" PRIu64 " games in %.2f s on %d thread%s (%.0f games/min)\n",
+           sim->total, seconds, workerCount, workerCount == 1 ? "" : "s", (double)sim->total / seconds * 60.0);
+}
+
+/* ------------------------------------------------------------------------- */
+/* Entry point                                                               */
+/* ------------------------------------------------------------------------- */
+
+int main(int argc, char **argv)
+{
+    SimOptions opts;
+    if (!parse_args(argc, argv, &opts)) return 2;
+
+    Simulator sim = { .opts = &opts };
+    for (int difficulty = DIFFICULTY_EASY; difficulty <= DIFFICULTY_HARD; ++difficulty) {
+        for (int policy = 0; policy < CS_KLONDIKE_POLICY_COUNT; ++policy) {
+            if (opts.difficulties[difficulty] && opts.policies[policy]) {
+                sim.cases[sim.caseCount++] = (SimCase){ (CsKlondikePolicy)policy, difficulty };
+                if (opts.blindSamples || opts.solve) break;   /* neither depends on the policy */
+            }
+        }
+    }
+    sim.total = (uint64_t)sim.caseCount * (uint64_t)opts.games;
+
+    /* Workers are on the heap: each board is a few KB of cards. */
+    SimWorker *workers = (SimWorker *)calloc((size_t)opts.threads, sizeof(SimWorker));
+    bool       ok      = workers != NULL;
+    for (int i = 0; ok && (opts.blindSamples || opts.solve) && i < opts.threads; ++i) {
+        workers[i].solver = cs_solver_create();
+        ok                = workers[i].solver != NULL;
+        if (ok && opts.complete) workers[i].solver->options = CS_SOLVER_COMPLETE_MOVES;
+    }
+    if (!ok) {
+        fprintf(stderr, "cardsim-sim: out of memory\n");
+        for (int i = 0; workers && i < opts.threads; ++i) cs_solver_destroy(workers[i].solver);
+        free(workers);
+        return 1;
+    }
+    platform_mutex_init(&sim.lock);
+
+    const uint64_t start   = platform_now_ns();
+    int            started = 0;
+    for (int i = 0; i < opts.threads; ++i) {
+        workers[i].sim = &sim;
+        if (!platform_thread_create(&workers[i].thread, worker_main, &workers[i])) break;
+        started++;
+    }
+    if (started == 0) worker_main(&workers[0]);   /* no threads to be had: run the stream here */
+    for (int i = 0; i < started; ++i) platform_thread_join(workers[i].thread);
+    const uint64_t wallNs = platform_now_ns() - start;
+
+    report(&sim, workers, started ? started : 1, wallNs);
+
+    platform_mutex_destroy(&sim.lock);
+    for (int i = 0; i < opts.threads; ++i) cs_solver_destroy(workers[i].solver);
+    free(workers);
+    return 0;
+}
@@ -10,17 +10,25 @@
  * waste pile, and four foundation piles (one per suit), with the goal of
  * moving all cards to the foundations in ascending rank (Ace->King).
  *
- * The file also includes a depth-first search (DFS) solver used to probe
- * whether a freshly dealt board is winnable. The solver uses:
- *   - a transposition table (visited-state hash set),
- *   - move ordering and pruning heuristics (e.g., safe-to-foundation),
- *   - a forced move pass that collapses obvious/“safe” moves prior to branching.
- *
- * None of this affects user play; it runs only during deal selection when
+ * The rules (dealing, stock cycling, placement) and the depth-first
+ * winnability solver come from libcardsim (src/engine/klondike.c). The
+ * solver never affects user play; it runs only during deal selection when
  * config.depth_first_search is set to true.
+ *
+ * Per-game state beyond the board (undo slot, solver) lives in a
+ * SolitaireSession owned by solitaire_start(), not in file statics.
  */
 
 #include "solitaire.h"
+#include "persist.h"
+#include "paths.h"
+#include "render.h"
+#include "input.h"
+#include "protocol.h"
+#include "stats.h"
+#include "platform.h"
+#include "gametimer.h"
+#include "trace.h"
 
 /* Local compile-time constants. */
 #define SAVE_FILE_NAME_LEN        256
@@ -33,63 +41,33 @@
 static bool save_slot_exists(int saveSlotNumber);
 static int  load_game_from_slot(KlondikeGame *gameState, int saveSlotNumber);
 
+/* ------------------------------------------------------------------------- */
+/* Session context                                                           */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * SolitaireSession
+ * What one game needs besides the board: the one-level undo snapshot
+ * (Easy mode only) and the solver behind the winnable-deal probe (created
+ * on first use, destroyed when the game ends).
+ */
+typedef struct {
+    KlondikeGame   undoSnapshot;
+    bool           hasUndo;
+    SolverContext *solver;
+} SolitaireSession;
+
 /* Game lifecycle / UI */
-static void deal_new_klondike_game(KlondikeGame *gameState, Card *shuffledDeck);  /* Deal and initialize a new game.   */
 static void render_game_ascii(const KlondikeGame *gameState);                      /* ASCII render for CLI.             */
-static void draw_from_stock(KlondikeGame *gameState);                              /* Stock -> waste (and recycle).     */
-static bool run_game_loop(KlondikeGame *gameState, unsigned int betAmount);        /* Interactive loop.                 */
+static bool run_game_loop(SolitaireSession *session, KlondikeGame *gameState,
+                          unsigned int betAmount, GameTimer *gameTimer);           /* Interactive loop.                 */
+static bool probe_winnable(SolitaireSession *session, const KlondikeGame *gameState);
 
 /* Basic rule checks / utilities */
-static int  is_legal_foundation_placement(Card candidateCard, const Stack *foundationStack);
-static int  is_legal_table_placement(Card movingCard, Card destinationCard);
-static int  is_red_suit(Card card);
-static void snapshot_for_undo(const KlondikeGame *gameState);
-static void restore_undo(KlondikeGame *gameState);
+static void snapshot_for_undo(SolitaireSession *session, const KlondikeGame *gameState);
+static void restore_undo(SolitaireSession *session, KlondikeGame *gameState);
 static void perform_auto_complete(KlondikeGame *gameState);
 static int  is_safe_to_auto_complete(const KlondikeGame *gameState);
-static int  get_card_rank_value(Card card);
-
-/* ------------------------------------------------------------------------- */
-/* Solver pruning helpers (internal)                                         */
-/* ------------------------------------------------------------------------- */
-
-/* Return 1 if pushing card to foundations is “safe” by heuristic. */
-static int  is_safe_foundation_push(Card candidateCard, const KlondikeGame *gameState);
-
-/* Apply all forced (safe) foundation moves repeatedly; return 1 if changed. */
-static int  apply_forced_moves(KlondikeGame *gameState);
-
-/* Coarse predicates to prune dead ends quickly. */
-static int  exists_any_table_to_table_move(const KlondikeGame *gameState);  /* Any legal table->table move? */
-static int  exists_any_waste_to_table_move(const KlondikeGame *gameState);  /* Waste top fits anywhere?     */
-static int  exists_any_safe_foundation_push(const KlondikeGame *gameState);
-static int  exists_any_progress_move(const KlondikeGame *gameState);
-
-/* Table sequence helpers. */
-static int  can_move_sequence_onto_column(const KlondikeGame *gameState, int fromColumnIndex, int startRowIndex, int toColumnIndex);
-static void apply_move_sequence_between_columns(KlondikeGame *gameState, int fromColumnIndex, int startRowIndex, int toColumnIndex);
-
-/* Hashing utilities for solver. */
-static uint64_t rotl64_u(uint64_t value64, int rotateBits);
-static int      encode_rank_to_id(const char *rankStr);
-static int      encode_suit_to_id(const char *suitStr);
-static uint64_t compute_card_hash(Card card);
-static uint64_t compute_state_hash(const KlondikeGame *gameState);
-
-/* Transposition helpers. */
-static int  visited_table_contains(VisitedEntry *visitedTable, uint64_t stateKey);
-static void visited_table_insert(VisitedEntry *visitedTable, uint64_t stateKey);
-
-/* DFS core. */
-static int  dfs_search_inner(KlondikeGame *statesArray, int searchDepth, VisitedEntry *visitedTable);
-
-/* ------------------------------------------------------------------------- */
-/* Save/undo buffer (file-scope)                                             */
-/* ------------------------------------------------------------------------- */
-
-/* One-level undo snapshot and flag (Easy mode only). */
-static KlondikeGame g_UndoSnapshotBuffer;
-static int          g_HasUndoSnapshot = 0;
 
 /* ------------------------------------------------------------------------- */
 /* Save / Load                                                                */
@@ -103,22 +81,27 @@ static int          g_HasUndoSnapshot = 0;
  * @param saveSlotNumber  Slot number [1..MAX_SLOTS].
  * @return 1 on success, 0 on failure (e.g., file open error).
  *
- * Side-effects: Writes a binary blob for game + money into "saves/solitaire/".
+ * Side-effects: Writes a Klondike snapshot (cardsim.h) followed by the money
+ * as a little-endian u64 into the profile's solitaire/ dir.
  * Errors are silent except the return value (no perror to avoid noisy UI).
  */
 static int save_game(KlondikeGame *gameState, int saveSlotNumber)
 {
-    char saveFilePath[SAVE_FILE_NAME_LEN];
+    char    saveFilePath[SAVE_FILE_NAME_LEN];
+    uint8_t saveBytes[CS_SNAP_MAX_SIZE + 8];
+
+    const size_t snapSize = cs_klondike_snapshot(gameState, 0, saveBytes, CS_SNAP_MAX_SIZE);
+    if (snapSize == 0) { return 0; }
+    for (int i = 0; i < 8; ++i) { saveBytes[snapSize + i] = (uint8_t)(playerData.uPlayerMoney >> (8 * i)); }
 
-    sprintf(saveFilePath, "saves/solitaire/solitaire_save_slot_%d.dat", saveSlotNumber);
+    solitaire_slot_path(saveFilePath, sizeof(saveFilePath), saveSlotNumber);
 
     FILE *filePtr = fopen(saveFilePath, "wb");
     if (!filePtr) { return 0; }
 
-    fwrite(gameState, sizeof(KlondikeGame), 1, filePtr);
-    fwrite(&playerData.uPlayerMoney, sizeof(unsigned long long), 1, filePtr);
+    const size_t written = fwrite(saveBytes, 1, snapSize + 8, filePtr);
     fclose(filePtr);
-    return 1;
+    return written == snapSize + 8;
 }
 
 /**
@@ -132,7 +115,7 @@ static bool save_slot_exists(int saveSlotNumber)
 {
     char saveFilePath[SAVE_FILE_NAME_LEN];
 
-    sprintf(saveFilePath, "saves/solitaire/solitaire_save_slot_%d.dat", saveSlotNumber);
+    solitaire_slot_path(saveFilePath, sizeof(saveFilePath), saveSlotNumber);
 
     FILE *filePtr = fopen(saveFilePath, "rb");
     if (filePtr)
@@ -153,7 +136,7 @@ static void print_slots(void)
     for (int slotIndex = 1; slotIndex <= MAX_SLOTS; ++slotIndex)
     {
         char saveFilePath[SAVE_FILE_NAME_LEN];
-        sprintf(saveFilePath, "saves/solitaire/solitaire_save_slot_%d.dat", slotIndex);
+        solitaire_slot_path(saveFilePath, sizeof(saveFilePath), slotIndex);
 
         if (save_slot_exists(slotIndex))
         {
@@ -208,8 +191,7 @@ void save_prompt(KlondikeGame *gameState)
     }
 
     int userMenuChoice = 0;
-    scanf("%d", &userMenuChoice);
-    if (userMenuChoice != 1) { return; }
+    if (!input_read_int(&userMenuChoice) || userMenuChoice != 1) { return; }
 
     while (1)
     {
@@ -218,7 +200,7 @@ void save_prompt(KlondikeGame *gameState)
         printf("> ");
 
         int userChosenSlotNumber = 0;
-        scanf("%d", &userChosenSlotNumber);
+        if (!input_read_int(&userChosenSlotNumber)) { continue; }
 
         if (userChosenSlotNumber < 1 || userChosenSlotNumber > MAX_SLOTS) { continue; }
 
@@ -230,9 +212,8 @@ void save_prompt(KlondikeGame *gameState)
             printf("> ");
 
             int userOverwriteConfirmation = 0;
-            scanf("%d", &userOverwriteConfirmation);
 
-            if (userOverwriteConfirmation == 1)
+            if (input_read_int(&userOverwriteConfirmation) && userOverwriteConfirmation == 1)
             {
                 save_game(gameState, userChosenSlotNumber);
                 printf("Game saved to slot %d.\n", userChosenSlotNumber);
@@ -257,20 +238,30 @@ void save_prompt(KlondikeGame *gameState)
  *
  * @param gameState       Destination game struct (out).
  * @param saveSlotNumber  Slot number [1..MAX_SLOTS].
- * @return 1 on success, 0 on failure (e.g., missing file).
+ * @return 1 on success, 0 on failure (missing file, or anything that is not
+ *         a snapshot + money, such as an empty slot or an old raw dump).
  */
 static int load_game_from_slot(KlondikeGame *gameState, int saveSlotNumber)
 {
-    char saveFilePath[SAVE_FILE_NAME_LEN];
+    char       saveFilePath[SAVE_FILE_NAME_LEN];
+    uint8_t    saveBytes[CS_SNAP_MAX_SIZE + 8];
+    CsSnapshot snap;
 
-    sprintf(saveFilePath, "saves/solitaire/solitaire_save_slot_%d.dat", saveSlotNumber);
+    solitaire_slot_path(saveFilePath, sizeof(saveFilePath), saveSlotNumber);
 
     FILE *filePtr = fopen(saveFilePath, "rb");
     if (!filePtr) { return 0; }
 
-    fread(gameState, sizeof(KlondikeGame), 1, filePtr);
-    fread(&playerData.uPlayerMoney, sizeof(unsigned long long), 1, filePtr);
+    const size_t bytesRead = fread(saveBytes, 1, sizeof(saveBytes), filePtr);
     fclose(filePtr);
+
+    if (!cs_snap_open(&snap, saveBytes, bytesRead) || bytesRead < snap.size + 8) { return 0; }
+
+    KlondikeGame loaded;
+    if (!cs_klondike_restore(&loaded, &snap)) { return 0; }
+
+    *gameState              = loaded;
+    playerData.uPlayerMoney = cs_snap_le(saveBytes + snap.size, 8);
     return 1;
 }
 
@@ -283,22 +274,22 @@ static int load_game_from_slot(KlondikeGame *gameState, int saveSlotNumber)
  * Snapshot the current game state so the next move can be undone.
  * Only one level of undo is supported (easy mode only, by design).
  */
-static void snapshot_for_undo(const KlondikeGame *gameState)
+static void snapshot_for_undo(SolitaireSession *session, const KlondikeGame *gameState)
 {
-    memcpy(&g_UndoSnapshotBuffer, gameState, sizeof(KlondikeGame));
-    g_HasUndoSnapshot = 1;
+    memcpy(&session->undoSnapshot, gameState, sizeof(KlondikeGame));
+    session->hasUndo = true;
 }
 
 /**
  * restore_undo
  * Restore the last snapshot if available, otherwise notify the user.
  */
-static void restore_undo(KlondikeGame *gameState)
+static void restore_undo(SolitaireSession *session, KlondikeGame *gameState)
 {
-    if (g_HasUndoSnapshot)
+    if (session->hasUndo)
     {
-        memcpy(gameState, &g_UndoSnapshotBuffer, sizeof(KlondikeGame));
-        g_HasUndoSnapshot = 0;
+        memcpy(gameState, &session->undoSnapshot, sizeof(KlondikeGame));
+        session->hasUndo = false;
     }
     else
     {
@@ -370,13 +361,16 @@ void solitaireHowToPlay(void)
  */
 void solitaire_start(void)
 {
-    KlondikeGame gameState;
-    int          didPlayerWin = 0;
+    KlondikeGame     gameState;
+    SolitaireSession session      = {0};
+    int              didPlayerWin = 0;
 
-    srand(time(NULL));  /* Randomize deals */
+    /* Time actually spent playing (prompts and the save menu excluded). */
+    GameTimer gameTimer = {0};
 
-    /* Track total session time for achievements/stats. */
-    time_t sessionStartTimestamp = time(NULL);
+    /* History row inputs (history.h). Loaded games carry no new bet. */
+    const unsigned long long balanceAtStart = playerData.uPlayerMoney;
+    unsigned int             betAmount      = 0;
 
     /* Detect available save slots (for load prompt). */
     int numExistingSaveSlots = 0;
@@ -402,11 +396,11 @@ void solitaire_start(void)
             printf("> ");
 
             int userLoadChoice = 0;
-            scanf("%d", &userLoadChoice);
 
-            if (userLoadChoice == 1)
+            if (input_read_int(&userLoadChoice) && userLoadChoice == 1)
             {
-                didPlayerWin = run_game_loop(&gameState, 0);
+                game_timer_start(&gameTimer);
+                didPlayerWin = run_game_loop(&session, &gameState, 0, &gameTimer);
                 goto after_game;
             }
             else
@@ -424,22 +418,22 @@ void solitaire_start(void)
         printf("> ");
 
         int userMenuChoice = 0;
-        scanf("%d", &userMenuChoice);
 
-        if (userMenuChoice == 1)
+        if (input_read_int(&userMenuChoice) && userMenuChoice == 1)
         {
             print_slots();
             int userSelectedSlot = 0;
 
             printf("Slot number (1-%d): ", MAX_SLOTS);
-            scanf("%d", &userSelectedSlot);
 
-            if (userSelectedSlot >= 1 && userSelectedSlot <= MAX_SLOTS && save_slot_exists(userSelectedSlot))
+            if (input_read_int(&userSelectedSlot) &&
+                userSelectedSlot >= 1 && userSelectedSlot <= MAX_SLOTS && save_slot_exists(userSelectedSlot))
             {
                 if (load_game_from_slot(&gameState, userSelectedSlot))
                 {
                     printf("Loaded game from slot %d.\n", userSelectedSlot);
-                    didPlayerWin = run_game_loop(&gameState, 0);
+                    game_timer_start(&gameTimer);
+                    didPlayerWin = run_game_loop(&session, &gameState, 0, &gameTimer);
                     goto after_game;
                 }
             }
@@ -458,10 +452,16 @@ fresh_game:
     printf("3: Hard\n");
     printf("> ");
 
-    scanf("%d", &gameState.difficulty);
+    /* gameState may still hold a declined save, so never keep its difficulty. */
+    int difficultyChoice = 0;
+    while (!input_read_int(&difficultyChoice) ||
+           difficultyChoice < DIFFICULTY_EASY || difficultyChoice > DIFFICULTY_HARD)
+    {
+        printf("Invalid choice. Enter 1-3: ");
+    }
+    gameState.difficulty = difficultyChoice;
 
     /* Optional betting (non-Easy only). */
-    unsigned int betAmount   = 0;
     unsigned int minBet      = 10;
     unsigned int maxBet      = 100;
 
@@ -477,7 +477,7 @@ fresh_game:
             {
                 printf("Enter your bet ($%u - $%lld): ", minBet, playerData.uPlayerMoney);
             }
-            scanf("%u", &betAmount);
+            input_read_uint(&betAmount);
         }
         while (betAmount < minBet || betAmount > maxBet || betAmount > playerData.uPlayerMoney);
 
@@ -486,7 +486,6 @@ fresh_game:
     }
 
     /* Deal a board. Optionally loop until the DFS solver proves it's winnable. */
-    Card shuffledDeck[DECK_SIZE];
     bool isWinnableDeal = false;
     int  maxDealAttempts = 1000;
 
@@ -494,17 +493,13 @@ fresh_game:
     {
         for (int attemptIndex = 0; attemptIndex < maxDealAttempts; ++attemptIndex)
         {
-            initialize_deck(shuffledDeck);
+            solitaire_deal_random(&gameState);
 
-            for (int cardIndex = 0; cardIndex < DECK_SIZE; ++cardIndex)
-            {
-                shuffledDeck[cardIndex].revealed = 0;
-            }
+            const uint64_t probeStartNs = platform_now_ns();
+            const bool     isWinnable   = probe_winnable(&session, &gameState);
+            latency_record_since(LATENCY_SOLITAIRE_SOLVER, probeStartNs);
 
-            shuffle_deck(shuffledDeck);
-            deal_new_klondike_game(&gameState, shuffledDeck);
-
-            if (dfs_solitaire_win(&gameState))
+            if (isWinnable)
             {
                 isWinnableDeal = true;
                 break;
@@ -518,25 +513,23 @@ fresh_game:
             printf("Generating a random board.\n");
             pause_for_enter();
 
-            initialize_deck(shuffledDeck);
-            for (int cardIndex = 0; cardIndex < DECK_SIZE; ++cardIndex) { shuffledDeck[cardIndex].revealed = 0; }
-            shuffle_deck(shuffledDeck);
-            deal_new_klondike_game(&gameState, shuffledDeck);
+            solitaire_deal_random(&gameState);
         }
     }
     else
     {
         /* Plain random deal. */
-        initialize_deck(shuffledDeck);
-        for (int cardIndex = 0; cardIndex < DECK_SIZE; ++cardIndex) { shuffledDeck[cardIndex].revealed = 0; }
-        shuffle_deck(shuffledDeck);
-        deal_new_klondike_game(&gameState, shuffledDeck);
+        solitaire_deal_random(&gameState);
     }
 
     /* Main gameplay loop (blocking until user quits or wins). */
-    didPlayerWin = run_game_loop(&gameState, betAmount);
+    game_timer_start(&gameTimer);
+    didPlayerWin = run_game_loop(&session, &gameState, betAmount, &gameTimer);
 
 after_game:
+    cs_solver_destroy(session.solver);
+    game_timer_pause(&gameTimer);   /* the result screens are not play time */
+
     /* Payouts, streaks, and stats update. */
     if (didPlayerWin)
     {
@@ -560,25 +553,18 @@ after_game:
             playerData.solitaire.easy_wins++;
         }
 
-        playerData.solitaire.wins++;
-
-        if (playerData.solitaire.max_win_streak <= playerData.solitaire.win_streak)
-        {
-            playerData.solitaire.max_win_streak = playerData.solitaire.win_streak;
-        }
+        protocol_emit("game_result", "\"game\":\"solitaire\",\"result\":\"win\",\"difficulty\":%d,\"bet\":%u",
+                      gameState.difficulty, betAmount);
 
         playerData.games_played++;
-        playerData.total_wins++;
 
         if (gameState.undo) { playerData.solitaire.perfect_clear++; }
 
-        time_t sessionEndTimestamp = time(NULL);
-        int    elapsed_minutes     = (int)(difftime(sessionEndTimestamp, sessionStartTimestamp) / 60.0);
-        playerData.solitaire.longest_game_minutes = elapsed_minutes;
-
-        checkAchievements();
-        save_player_data();
-        save_achievements();
+        const int elapsedMinutes = (int)(game_timer_elapsed_ns(&gameTimer) / 60000000000ULL);
+        if (elapsedMinutes > playerData.solitaire.longest_game_minutes)
+        {
+            playerData.solitaire.longest_game_minutes = elapsedMinutes;
+        }
     }
     else
     {
@@ -596,13 +582,28 @@ after_game:
             printf("You lose your bet of $%u.\n", betAmount);
         }
 
+        protocol_emit("game_result", "\"game\":\"solitaire\",\"result\":\"loss\",\"difficulty\":%d,\"bet\":%u",
+                      gameState.difficulty, betAmount);
         pause_for_enter();
-
-        playerData.solitaire.losses++;
-        playerData.solitaire.win_streak = 0;
-        playerData.total_losses++;
     }
 
+    /* Wins/losses, streaks and the history row (stats.h profile sink). */
+    const CsStatsSink   profile = stats_profile_sink();
+    const CsRoundResult result  = {
+        .game       = CS_GAME_KLONDIKE,
+        .outcome    = didPlayerWin ? CS_OUTCOME_WIN : CS_OUTCOME_LOSS,
+        .flags      = (uint16_t)((gameState.undo ? CS_ROUND_UNDO : 0) |
+                                 (gameState.difficulty == DIFFICULTY_HARD ? CS_ROUND_HARD : 0) |
+                                 (gameState.difficulty == DIFFICULTY_EASY ? CS_ROUND_EASY : 0)),
+        .bet        = betAmount,
+        .net        = (int64_t)playerData.uPlayerMoney - (int64_t)balanceAtStart,
+        .durationMs = game_timer_elapsed_ms(&gameTimer),
+    };
+    cs_stats_emit(&profile, &result);
+
+    checkAchievements();
+    persist_mark_dirty(PERSIST_ALL);
+
     printf("Final Balance: $%lld\n", playerData.uPlayerMoney);
     pause_for_enter();
     clear_screen();
@@ -613,65 +614,46 @@ after_game:
 /* ------------------------------------------------------------------------- */
 
 /**
- * deal_new_klondike_game
- * Deal the table in the 1..7 pyramid pattern; last in each column face up.
- * Remaining cards are placed into the draw pile; foundations and waste start empty.
- *
- * @param gameState     Destination game state to initialize.
- * @param shuffledDeck  A 52-card deck (already shuffled by caller).
+ * solitaire_deal_random
+ * The game keeps dealing from rand() (seeded once in main, fixed by --seed)
+ * so seeded runs reproduce; libcardsim callers use cs_klondike_deal_random.
  */
-static void deal_new_klondike_game(KlondikeGame *gameState, Card *shuffledDeck)
+void solitaire_deal_random(KlondikeGame *gameState)
 {
-    int deckReadIndex = 0;
-
-    for (int tableColumnIndex = 0; tableColumnIndex < COLUMNS; ++tableColumnIndex)
-    {
-        for (int tableRowIndex = 0; tableRowIndex <= tableColumnIndex; ++tableRowIndex)
-        {
-            gameState->table[tableColumnIndex][tableRowIndex] = shuffledDeck[deckReadIndex++];  /* Place cards into table columns. */
-            gameState->table[tableColumnIndex][tableRowIndex].revealed = (tableRowIndex == tableColumnIndex);  /* Only the top card is face-up. */
-        }
-        gameState->table_counts[tableColumnIndex] = tableColumnIndex + 1;  /* Column sizes are 1..7. */
-    }
-
-    /* Stock (draw pile) gets the remainder of the deck. */
-    gameState->drawPile.count = 0;
-
-    for (; deckReadIndex < DECK_SIZE; ++deckReadIndex)
-    {
-        shuffledDeck[deckReadIndex].revealed = 1;  /* Will be face-up when in waste; keep the flag. */
-        gameState->drawPile.cards[gameState->drawPile.count++] = shuffledDeck[deckReadIndex];
-    }
-
-    /* Foundations start empty. */
-    for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
-    {
-        gameState->foundation[foundationIndex].count = 0;
-    }
+    Card shuffledDeck[DECK_SIZE];
 
-    gameState->wastePile.count = 0;  /* Waste starts empty. */
+    initialize_deck(shuffledDeck);   /* every card starts face down */
+    shuffle_deck(shuffledDeck);
+    cs_klondike_deal(gameState, shuffledDeck);
 }
 
 /**
  * render_game_ascii
- * Print a simple ASCII snapshot of the current state. Intended for CLI play.
- * (No frame/bounds checking on printf; purely UI.)
+ * Build a simple ASCII snapshot of the current state as one frame (see
+ * render.h) and write it in a single call. Intended for CLI play.
  */
 static void render_game_ascii(const KlondikeGame *gameState)
 {
-    clear_screen();
-    printf("--- Game View ---\n");
+    TRACE_SCOPE("render_game_ascii");
+    protocol_screen("solitaire_board");
+    protocol_emit("board", "\"game\":\"solitaire\",\"draw\":%d,\"waste\":%d,\"foundations\":[%d,%d,%d,%d]",
+                  gameState->drawPile.count, gameState->wastePile.count,
+                  gameState->foundation[0].count, gameState->foundation[1].count,
+                  gameState->foundation[2].count, gameState->foundation[3].count);
+
+    render_begin();
+    render_printf("--- Game View ---\n");
 
-    printf("Draw Pile: %d cards\n", gameState->drawPile.count);
+    render_printf("Draw Pile: %d cards\n", gameState->drawPile.count);
 
     if (gameState->wastePile.count > 0)
     {
         Card topWasteCard = gameState->wastePile.cards[gameState->wastePile.count - 1];
-        printf("Top of Waste: [%s of %s]\n", topWasteCard.rank, topWasteCard.suit);
+        render_printf("Top of Waste: [%s of %s]\n", topWasteCard.rank, topWasteCard.suit);
     }
     else
     {
-        printf("Waste Pile: empty\n");
+        render_printf("Waste Pile: empty\n");
     }
 
     /* Foundations (if non-empty, show the top card). */
@@ -680,18 +662,18 @@ static void render_game_ascii(const KlondikeGame *gameState)
         if (gameState->foundation[foundationIndex].count > 0)
         {
             Card topFoundationCard = gameState->foundation[foundationIndex].cards[gameState->foundation[foundationIndex].count - 1];
-            printf("Foundation %d: [%s of %s]\n", foundationIndex + 1, topFoundationCard.rank, topFoundationCard.suit);
+            render_printf("Foundation %d: [%s of %s]\n", foundationIndex + 1, topFoundationCard.rank, topFoundationCard.suit);
         }
         else
         {
-            printf("Foundation %d: empty\n", foundationIndex + 1);
+            render_printf("Foundation %d: empty\n", foundationIndex + 1);
         }
     }
 
     /* Table columns: show [???] for face-down cards. */
     for (int tableColumnIndex = 0; tableColumnIndex < COLUMNS; ++tableColumnIndex)
     {
-        printf("Column %d: ", tableColumnIndex + 1);
+        render_printf("Column %d: ", tableColumnIndex + 1);
 
         for (int tableRowIndex = 0; tableRowIndex < gameState->table_counts[tableColumnIndex]; ++tableRowIndex)
         {
@@ -699,112 +681,17 @@ static void render_game_ascii(const KlondikeGame *gameState)
 
             if (!cardPtr->revealed)
             {
-                printf("[???] ");
+                render_printf("[???] ");
             }
             else
             {
-                printf("[%s of %s] ", cardPtr->rank, cardPtr->suit);
+                render_printf("[%s of %s] ", cardPtr->rank, cardPtr->suit);
             }
         }
-        printf("\n");
-    }
-}
-
-/**
- * draw_from_stock
- * Move 1 or 3 cards from stock to waste depending on difficulty. In Easy mode,
- * when the stock is empty and waste is non-empty, recycle waste -> stock and
- * immediately draw again.
- */
-static void draw_from_stock(KlondikeGame *gameState)
-{
-    int drawCount  = (gameState->difficulty == DIFFICULTY_HARD) ? 3 : 1;
-    int actualDraw = (gameState->drawPile.count < drawCount) ? gameState->drawPile.count : drawCount;
-
-    if (actualDraw > 0)
-    {
-        for (int drawIndex = 0; drawIndex < actualDraw; ++drawIndex)
-        {
-            gameState->wastePile.cards[gameState->wastePile.count++] =
-                gameState->drawPile.cards[--gameState->drawPile.count];
-        }
+        render_printf("\n");
     }
-    else if (gameState->difficulty == DIFFICULTY_EASY && gameState->wastePile.count > 0)
-    {
-        /* Easy mode: recycle waste -> draw, then draw again. */
-        for (int wasteIndex = gameState->wastePile.count - 1; wasteIndex >= 0; --wasteIndex)
-        {
-            gameState->drawPile.cards[gameState->drawPile.count++] = gameState->wastePile.cards[wasteIndex];
-        }
-        gameState->wastePile.count = 0;
-
-        /* Recurse once to perform the draw after recycle. */
-        draw_from_stock(gameState);
-    }
-}
-
-/**
- * is_red_suit
- * Utility to check a card color by suit (Hearts/Diamonds).
- * @return 1 if red, 0 otherwise.
- */
-static int is_red_suit(Card card)
-{
-    return strcmp(card.suit, "Hearts") == 0 || strcmp(card.suit, "Diamonds") == 0;
-}
-
-/**
- * is_legal_foundation_placement
- * Enforce foundation rules: card must match suit and be exactly one rank above
- * the current top (or be an Ace into an empty foundation).
- */
-static int is_legal_foundation_placement(Card candidateCard, const Stack *foundationStack)
-{
-    int candidateValue = atoi(candidateCard.rank);  /* "2".."10" */
-
-    if (strcmp(candidateCard.rank, "Ace")   == 0) { candidateValue = 1;  }
-    else if (strcmp(candidateCard.rank, "Jack")  == 0) { candidateValue = 11; }
-    else if (strcmp(candidateCard.rank, "Queen") == 0) { candidateValue = 12; }
-    else if (strcmp(candidateCard.rank, "King")  == 0) { candidateValue = 13; }
-
-    if (foundationStack->count == 0) { return candidateValue == 1; }
-
-    Card topFoundationCard = foundationStack->cards[foundationStack->count - 1];
-
-    int topValue = atoi(topFoundationCard.rank);
-    if (strcmp(topFoundationCard.rank, "Ace")   == 0) { topValue = 1;  }
-    else if (strcmp(topFoundationCard.rank, "Jack")  == 0) { topValue = 11; }
-    else if (strcmp(topFoundationCard.rank, "Queen") == 0) { topValue = 12; }
-    else if (strcmp(topFoundationCard.rank, "King")  == 0) { topValue = 13; }
-
-    return (strcmp(candidateCard.suit, topFoundationCard.suit) == 0) && (candidateValue == topValue + 1);
-}
-
-/**
- * get_card_rank_value
- * Map ranks to numbers for general comparisons. (Ace=1, Jack=11, Queen=12, King=13)
- */
-static int get_card_rank_value(Card card)
-{
-    if (strcmp(card.rank, "Ace")   == 0) { return 1;  }
-    if (strcmp(card.rank, "Jack")  == 0) { return 11; }
-    if (strcmp(card.rank, "Queen") == 0) { return 12; }
-    if (strcmp(card.rank, "King")  == 0) { return 13; }
-    return atoi(card.rank);
-}
-
-/**
- * is_legal_table_placement
- * Check whether movingCard can be placed on top of destinationCard in the table:
- * colors must alternate and ranks must be descending by exactly 1.
- */
-static int is_legal_table_placement(Card movingCard, Card destinationCard)
-{
-    int movingValue      = get_card_rank_value(movingCard);
-    int destinationValue = get_card_rank_value(destinationCard);
 
-    return (is_red_suit(movingCard) != is_red_suit(destinationCard)) &&
-           (movingValue == destinationValue - 1);
+    render_end();
 }
 
 /* ------------------------------------------------------------------------- */
@@ -822,10 +709,10 @@ static int is_legal_table_placement(Card movingCard, Card destinationCard)
  *  6: Cancel
  *
  * Input validation is minimal; most invalid moves simply do nothing and
- * return to the game loop. This function performs all state mutations for
- * manual moves.
+ * return to the game loop. The rules and the state changes are
+ * cs_klondike_move()'s; this function only collects the pile numbers.
  */
-static void move_card(KlondikeGame *gameState)
+static void move_card(SolitaireSession *session, KlondikeGame *gameState)
 {
     int userMoveChoice = 0;
 
@@ -837,182 +724,64 @@ static void move_card(KlondikeGame *gameState)
     printf("5: Foundation to column\n");
     printf("6: Cancel\n");
     printf("> ");
-    scanf("%d", &userMoveChoice);
+    input_read_int(&userMoveChoice);   /* stays 0 (cancel) if the line is not a number */
 
     /* Prepare undo snapshot only if a move succeeds; we create the snapshot here
        (prior to any mutation) and keep it if we actually perform a move. */
-    snapshot_for_undo(gameState);
+    snapshot_for_undo(session, gameState);
 
-    /* 1) Waste -> Foundation (try each foundation in order). */
-    if (userMoveChoice == 1 && gameState->wastePile.count > 0)
+    /* Nothing to take from an empty waste: same as cancelling. */
+    if ((userMoveChoice == CS_KLONDIKE_WASTE_TO_FOUNDATION || userMoveChoice == CS_KLONDIKE_WASTE_TO_COLUMN) &&
+        gameState->wastePile.count == 0)
     {
-        Card wasteTopCard = gameState->wastePile.cards[gameState->wastePile.count - 1];
-
-        for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
-        {
-            if (is_legal_foundation_placement(wasteTopCard, &gameState->foundation[foundationIndex]))
-            {
-                gameState->foundation[foundationIndex].cards[gameState->foundation[foundationIndex].count++] = wasteTopCard;
-                gameState->wastePile.count--;
-                return;
-            }
-        }
+        userMoveChoice = 0;
     }
-    /* 2) Waste -> Column (respect King->empty and descending/alternating otherwise). */
-    else if (userMoveChoice == 2 && gameState->wastePile.count > 0)
-    {
-        Card wasteTopCard = gameState->wastePile.cards[gameState->wastePile.count - 1];
 
-        int destColumnNumber = 0;
-        printf("To column #: ");
-        scanf("%d", &destColumnNumber);
-        destColumnNumber--;  /* Convert to 0-based index. */
+    /* Pile numbers are 1-based on screen; cs_klondike_move() wants 0-based. */
+    int fromNumber = 0;
+    int toNumber   = 0;
 
-        if (destColumnNumber >= 0 && destColumnNumber < COLUMNS)
-        {
-            if (gameState->table_counts[destColumnNumber] == 0 && strcmp(wasteTopCard.rank, "King") == 0)
-            {
-                gameState->table[destColumnNumber][0] = wasteTopCard;
-                gameState->table[destColumnNumber][0].revealed = 1;
-                gameState->table_counts[destColumnNumber] = 1;
-                gameState->wastePile.count--;
-            }
-            else if (gameState->table_counts[destColumnNumber] > 0 &&
-                     is_legal_table_placement(wasteTopCard, gameState->table[destColumnNumber][gameState->table_counts[destColumnNumber] - 1]))
-            {
-                gameState->table[destColumnNumber][gameState->table_counts[destColumnNumber]++] = wasteTopCard;
-                gameState->wastePile.count--;
-            }
-        }
-    }
-    /* 3) Column -> Column (moves a face-up run starting anywhere within the column). */
-    else if (userMoveChoice == 3)
+    switch (userMoveChoice)
     {
-        int fromColumnNumber = 0;
-        int toColumnNumber   = 0;
-
-        printf("From column #: ");
-        scanf("%d", &fromColumnNumber);
-        printf("To column #: ");
-        scanf("%d", &toColumnNumber);
-
-        fromColumnNumber--;  /* 0-based */
-        toColumnNumber--;    /* 0-based */
-
-        if (fromColumnNumber >= 0 && fromColumnNumber < COLUMNS &&
-            toColumnNumber   >= 0 && toColumnNumber   < COLUMNS &&
-            gameState->table_counts[fromColumnNumber] > 0)
-        {
-            int firstRevealedRowIndex = -1;
-
-            for (int tableRowIndex = 0; tableRowIndex < gameState->table_counts[fromColumnNumber]; ++tableRowIndex)
-            {
-                if (gameState->table[fromColumnNumber][tableRowIndex].revealed)
-                {
-                    firstRevealedRowIndex = tableRowIndex;
-                    break;
-                }
-            }
-
-            if (firstRevealedRowIndex != -1)
-            {
-                Card *destTopPtr =
-                    (gameState->table_counts[toColumnNumber] > 0)
-                        ? &gameState->table[toColumnNumber][gameState->table_counts[toColumnNumber] - 1]
-                        : NULL;
-
-                for (int splitRowIndex = firstRevealedRowIndex; splitRowIndex < gameState->table_counts[fromColumnNumber]; ++splitRowIndex)
-                {
-                    if ((destTopPtr == NULL && strcmp(gameState->table[fromColumnNumber][splitRowIndex].rank, "King") == 0) ||
-                        (destTopPtr != NULL && is_legal_table_placement(gameState->table[fromColumnNumber][splitRowIndex], *destTopPtr)))
-                    {
-                        /* Move the entire suffix [splitRowIndex..end]. */
-                        int runLength = gameState->table_counts[fromColumnNumber] - splitRowIndex;
-
-                        for (int runOffset = 0; runOffset < runLength; ++runOffset)
-                        {
-                            gameState->table[toColumnNumber][gameState->table_counts[toColumnNumber]++] =
-                                gameState->table[fromColumnNumber][splitRowIndex + runOffset];
-                        }
-
-                        gameState->table_counts[fromColumnNumber] = splitRowIndex;
-
-                        if (splitRowIndex > 0)
-                        {
-                            gameState->table[fromColumnNumber][splitRowIndex - 1].revealed = 1;
-                        }
-                        return;
-                    }
-                }
+        case CS_KLONDIKE_WASTE_TO_FOUNDATION:
+            break;
 
-                printf("\nInvalid move: No valid sequence to move.\n");
-            }
-        }
-    }
-    /* 4) Column -> Foundation (top card only). */
-    else if (userMoveChoice == 4)
-    {
-        int fromColumnNumber = 0;
+        case CS_KLONDIKE_WASTE_TO_COLUMN:
+            printf("To column #: ");
+            input_read_int(&toNumber);
+            break;
 
-        printf("From column #: ");
-        scanf("%d", &fromColumnNumber);
-        fromColumnNumber--;
+        case CS_KLONDIKE_COLUMN_TO_COLUMN:
+            printf("From column #: ");
+            input_read_int(&fromNumber);
+            printf("To column #: ");
+            input_read_int(&toNumber);
+            break;
 
-        if (fromColumnNumber >= 0 && fromColumnNumber < COLUMNS &&
-            gameState->table_counts[fromColumnNumber] > 0 &&
-            gameState->table[fromColumnNumber][gameState->table_counts[fromColumnNumber] - 1].revealed)
-        {
-            Card topTableCard = gameState->table[fromColumnNumber][gameState->table_counts[fromColumnNumber] - 1];
+        case CS_KLONDIKE_COLUMN_TO_FOUNDATION:
+            printf("From column #: ");
+            input_read_int(&fromNumber);
+            break;
 
-            for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
-            {
-                if (is_legal_foundation_placement(topTableCard, &gameState->foundation[foundationIndex]))
-                {
-                    gameState->foundation[foundationIndex].cards[gameState->foundation[foundationIndex].count++] = topTableCard;
-                    gameState->table_counts[fromColumnNumber]--;
+        case CS_KLONDIKE_FOUNDATION_TO_COLUMN:
+            printf("From foundation #: ");
+            input_read_int(&fromNumber);
+            printf("To column #: ");
+            input_read_int(&toNumber);
+            break;
 
-                    if (gameState->table_counts[fromColumnNumber] > 0)
-                    {
-                        gameState->table[fromColumnNumber][gameState->table_counts[fromColumnNumber] - 1].revealed = 1;
-                    }
-                    break;
-                }
-            }
-        }
+        default:
+            printf("\nMove canceled.\n");
+            return;
     }
-    /* 5) Foundation -> Column (mostly used to unblock moves; rare but legal). */
-    else if (userMoveChoice == 5)
-    {
-        int fromFoundationNumber = 0;
-        int toColumnNumber       = 0;
-
-        printf("From foundation #: ");
-        scanf("%d", &fromFoundationNumber);
-        printf("To column #: ");
-        scanf("%d", &toColumnNumber);
-
-        fromFoundationNumber--;
-        toColumnNumber--;
-
-        if (fromFoundationNumber >= 0 && fromFoundationNumber < FOUNDATION_PILES &&
-            gameState->foundation[fromFoundationNumber].count > 0 &&
-            toColumnNumber >= 0 && toColumnNumber < COLUMNS)
-        {
-            Card foundationTopCard = gameState->foundation[fromFoundationNumber].cards[gameState->foundation[fromFoundationNumber].count - 1];
 
-            if ((gameState->table_counts[toColumnNumber] == 0 && strcmp(foundationTopCard.rank, "King") == 0) ||
-                (gameState->table_counts[toColumnNumber] > 0 &&
-                 is_legal_table_placement(foundationTopCard, gameState->table[toColumnNumber][gameState->table_counts[toColumnNumber] - 1])))
-            {
-                foundationTopCard.revealed = 1;
-                gameState->table[toColumnNumber][gameState->table_counts[toColumnNumber]++] = foundationTopCard;
-                gameState->foundation[fromFoundationNumber].count--;
-            }
-        }
-    }
-    else
+    /* Illegal moves leave the board untouched; only a run that fits nowhere is reported. */
+    if (!cs_klondike_move(gameState, (CsKlondikeMove)userMoveChoice, fromNumber - 1, toNumber - 1) &&
+        userMoveChoice == CS_KLONDIKE_COLUMN_TO_COLUMN &&
+        fromNumber >= 1 && fromNumber <= COLUMNS && toNumber >= 1 && toNumber <= COLUMNS &&
+        gameState->table_counts[fromNumber - 1] > 0)
     {
-        printf("\nMove canceled.\n");
+        printf("\nInvalid move: No valid sequence to move.\n");
     }
 }
 
@@ -1025,15 +794,20 @@ static void move_card(KlondikeGame *gameState)
  * Main interactive loop for the game session. Renders the state, collects user
  * input, and applies moves (including draw and optional auto-complete).
  *
+ * @param session    Undo slot for this game.
  * @param gameState  In/out game state (mutated as player plays).
  * @param betAmount  Bet amount (0 in Easy).
+ * @param gameTimer  Running game timer; paused while the save prompt is up.
  * @return true on a win, false otherwise (quit or loss).
  */
-static bool run_game_loop(KlondikeGame *gameState, unsigned int betAmount)
+static bool run_game_loop(SolitaireSession *session, KlondikeGame *gameState,
+                          unsigned int betAmount, GameTimer *gameTimer)
 {
     while (1)
     {
+        const uint64_t frameStartNs = platform_now_ns();
         render_game_ascii(gameState);
+        latency_record_since(LATENCY_SOLITAIRE_FRAME, frameStartNs);
 
         printf("\nOptions:\n");
         printf("1: Draw card\n");
@@ -1061,26 +835,27 @@ static bool run_game_loop(KlondikeGame *gameState, unsigned int betAmount)
         printf("> ");
 
         int userActionChoice = 0;
-        scanf("%d", &userActionChoice);
+        input_read_int(&userActionChoice);   /* 0 (no action) if the line is not a number */
 
         if (userActionChoice == 1)
         {
-            snapshot_for_undo(gameState);
-            draw_from_stock(gameState);
+            snapshot_for_undo(session, gameState);
+            cs_klondike_draw(gameState);
         }
         else if (userActionChoice == 2)
         {
-            move_card(gameState);
+            move_card(session, gameState);
         }
         else if (userActionChoice == 3 && gameState->difficulty == DIFFICULTY_EASY)
         {
-            restore_undo(gameState);
+            restore_undo(session, gameState);
             gameState->undo = true;  /* Mark that undo was used (affects stats like perfect clears). */
         }
         else if ((gameState->difficulty == DIFFICULTY_EASY && userActionChoice == 4) ||
                  (gameState->difficulty != DIFFICULTY_EASY && userActionChoice == 3))
         {
             /* Quit path: offer to save and then report loss. */
+            game_timer_pause(gameTimer);
             save_prompt(gameState);
 
             printf("\nGame over. You did not complete all foundations.\n");
@@ -1094,12 +869,10 @@ static bool run_game_loop(KlondikeGame *gameState, unsigned int betAmount)
                 printf("You lose your bet of $%u.\n", betAmount);
             }
 
+            protocol_emit("game_result", "\"game\":\"solitaire\",\"result\":\"quit\",\"difficulty\":%d,\"bet\":%u",
+                          gameState->difficulty, betAmount);
             pause_for_enter();
 
-            playerData.solitaire.losses++;
-            playerData.solitaire.win_streak = 0;
-            playerData.total_losses++;
-
             solitaire();  /* Return to main menu */
             return false;
         }
@@ -1141,8 +914,7 @@ static bool run_game_loop(KlondikeGame *gameState, unsigned int betAmount)
             playerData.total_wins++;
             if (gameState->undo) { playerData.solitaire.perfect_clear++; }
             checkAchievements();
-            save_player_data();
-            save_achievements();
+            persist_mark_dirty(PERSIST_ALL);
         }
 
         /* Manual win detection (if the player achieves goal without auto-complete). */
@@ -1189,7 +961,7 @@ static void perform_auto_complete(KlondikeGame *gameState)
                 {
                     for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
                     {
-                        if (is_legal_foundation_placement(topTableCard, &gameState->foundation[foundationIndex]))
+                        if (cs_klondike_fits_foundation(topTableCard, &gameState->foundation[foundationIndex]))
                         {
                             gameState->foundation[foundationIndex].cards[gameState->foundation[foundationIndex].count++] = topTableCard;
                             gameState->table_counts[tableColumnIndex]--;
@@ -1214,7 +986,7 @@ static void perform_auto_complete(KlondikeGame *gameState)
 
             for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
             {
-                if (is_legal_foundation_placement(wasteTopCard, &gameState->foundation[foundationIndex]))
+                if (cs_klondike_fits_foundation(wasteTopCard, &gameState->foundation[foundationIndex]))
                 {
                     gameState->foundation[foundationIndex].cards[gameState->foundation[foundationIndex].count++] = wasteTopCard;
                     gameState->wastePile.count--;
@@ -1251,7 +1023,7 @@ static int is_safe_to_auto_complete(const KlondikeGame *gameState)
         if (gameState->foundation[foundationIndex].count == 0) { return 0; }
 
         Card topFoundationCard = gameState->foundation[foundationIndex].cards[gameState->foundation[foundationIndex].count - 1];
-        int  topValue          = get_card_rank_value(topFoundationCard);
+        int  topValue          = cs_klondike_rank(topFoundationCard);
 
         if (topValue < 5) { return 0; }
     }
@@ -1260,725 +1032,18 @@ static int is_safe_to_auto_complete(const KlondikeGame *gameState)
 }
 
 /* ------------------------------------------------------------------------- */
-/* DFS / Backtracking Solver (heap-backed states + transposition + pruning)   */
+/* DFS deal probe                                                            */
 /* ------------------------------------------------------------------------- */
 
-/* Small helper: 64-bit rotate-left (used by the hasher). */
-static uint64_t rotl64_u(uint64_t value64, int rotateBits)
-{
-    return (value64 << rotateBits) | (value64 >> (64 - rotateBits));
-}
-
-/* --- Hashing helpers to create a stable, compact key for a game state --- */
-
-/* Map rank/suit strings to small integers for hash mixing. */
-static int encode_rank_to_id(const char *rankStr)
-{
-    if (!strcmp(rankStr, "Ace"))   { return 1;  }
-    if (!strcmp(rankStr, "Jack"))  { return 11; }
-    if (!strcmp(rankStr, "Queen")) { return 12; }
-    if (!strcmp(rankStr, "King"))  { return 13; }
-    return atoi(rankStr);  /* "2".."10" */
-}
-static int encode_suit_to_id(const char *suitStr)
-{
-    if (!strcmp(suitStr, "Hearts"))   { return 0; }
-    if (!strcmp(suitStr, "Diamonds")) { return 1; }
-    if (!strcmp(suitStr, "Clubs"))    { return 2; }
-    if (!strcmp(suitStr, "Spades"))   { return 3; }
-    return 0; /* fallback */
-}
-
-/* Lightly mixed per-card hash (includes revealed flag). */
-static uint64_t compute_card_hash(Card card)
-{
-    uint64_t mixedValue = (uint64_t)(encode_rank_to_id(card.rank) & 0x3F) |
-                          ((uint64_t)(encode_suit_to_id(card.suit) & 0x03) << 6);
-
-    mixedValue |= ((uint64_t)(card.revealed ? 1 : 0) << 8);
-    mixedValue ^= rotl64_u(mixedValue * 0x9E3779B185EBCA87ULL + 0xC2B2AE3D27D4EB4FULL, 23);
-    return mixedValue;
-}
-
-/* State hash: foundations (top+count), full table arrays (up to counts),
- * waste sequence, draw sequence, and difficulty. */
-static uint64_t compute_state_hash(const KlondikeGame *gameState)
-{
-    uint64_t stateHash = 0xDEADBEEFCAFEBABEULL;
-
-    /* Foundations: count and top card carry most of the signal. */
-    for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
-    {
-        stateHash ^= (uint64_t)gameState->foundation[foundationIndex].count + 0x9E37;
-
-        if (gameState->foundation[foundationIndex].count > 0)
-        {
-            Card topFoundationCard = gameState->foundation[foundationIndex].cards[gameState->foundation[foundationIndex].count - 1];
-            stateHash ^= rotl64_u(compute_card_hash(topFoundationCard), foundationIndex + 1);
-        }
-    }
-
-    /* Table: mix in all present cards in each column. */
-    for (int tableColumnIndex = 0; tableColumnIndex < COLUMNS; ++tableColumnIndex)
-    {
-        stateHash ^= rotl64_u((uint64_t)gameState->table_counts[tableColumnIndex] + 0x12D + tableColumnIndex, 7);
-
-        for (int cardIndex = 0; cardIndex < gameState->table_counts[tableColumnIndex]; ++cardIndex)
-        {
-            stateHash ^= rotl64_u(compute_card_hash(gameState->table[tableColumnIndex][cardIndex]),
-                                  (cardIndex + tableColumnIndex) & 31);
-        }
-    }
-
-    /* Waste sequence (from bottom to top). */
-    stateHash ^= rotl64_u((uint64_t)gameState->wastePile.count + 0x55, 13);
-    for (int cardIndex = 0; cardIndex < gameState->wastePile.count; ++cardIndex)
-    {
-        stateHash ^= rotl64_u(compute_card_hash(gameState->wastePile.cards[cardIndex]), cardIndex & 31);
-    }
-
-    /* Draw sequence. */
-    stateHash ^= rotl64_u((uint64_t)gameState->drawPile.count + 0xA3, 17);
-    for (int cardIndex = 0; cardIndex < gameState->drawPile.count; ++cardIndex)
-    {
-        stateHash ^= rotl64_u(compute_card_hash(gameState->drawPile.cards[cardIndex]), cardIndex & 31);
-    }
-
-    /* Include difficulty since it changes stock cycling. */
-    stateHash ^= (uint64_t)gameState->difficulty * 0x1000193ULL;
-
-    return stateHash;
-}
-
-/* Transposition table probes (linear probing with short probe cap for speed). */
-static int visited_table_contains(VisitedEntry *visitedTable, uint64_t stateKey)
-{
-    uint64_t startSlot = stateKey % VISITED_CAP;
-
-    for (int probeStep = 0; probeStep < 16; ++probeStep)
-    {
-        uint64_t tableIndex = (startSlot + probeStep) % VISITED_CAP;
-
-        if (!visitedTable[tableIndex].used) { return 0; }
-        if (visitedTable[tableIndex].key == stateKey) { return 1; }
-    }
-    return 0;
-}
-static void visited_table_insert(VisitedEntry *visitedTable, uint64_t stateKey)
-{
-    uint64_t startSlot = stateKey % VISITED_CAP;
-
-    for (int probeStep = 0; probeStep < VISITED_CAP; ++probeStep)
-    {
-        uint64_t tableIndex = (startSlot + probeStep) % VISITED_CAP;
-
-        if (!visitedTable[tableIndex].used)
-        {
-            visitedTable[tableIndex].used = 1;
-            visitedTable[tableIndex].key  = stateKey;
-            return;
-        }
-        if (visitedTable[tableIndex].key == stateKey) { return; }
-    }
-}
-
-/* --- Small utilities used by both gameplay and solver --- */
-
-/* Reveal the new top of a table column after cards were removed. */
-static inline void reveal_new_table_top_card(KlondikeGame *gameState, int tableColumnIndex)
-{
-    if (gameState->table_counts[tableColumnIndex] > 0)
-    {
-        gameState->table[tableColumnIndex][gameState->table_counts[tableColumnIndex] - 1].revealed = 1;
-    }
-}
-
-/* Try to move sequence starting at index `startRowIndex` in column `fromColumnIndex` onto column `toColumnIndex`.
- * In addition to normal legality, we require that the destination has room. */
-static int can_move_sequence_onto_column(const KlondikeGame *gameState, int fromColumnIndex, int startRowIndex, int toColumnIndex)
-{
-    int moveCount = gameState->table_counts[fromColumnIndex] - startRowIndex;
-    if (moveCount <= 0) { return 0; }
-
-    /* Capacity guard for destination column. */
-    if (gameState->table_counts[toColumnIndex] + moveCount > MAX_DRAW_STACK) { return 0; }
-
-    if (gameState->table_counts[toColumnIndex] == 0)
-    {
-        return strcmp(gameState->table[fromColumnIndex][startRowIndex].rank, "King") == 0;
-    }
-    else
-    {
-        Card destTopCard = gameState->table[toColumnIndex][gameState->table_counts[toColumnIndex] - 1];
-        return is_legal_table_placement(gameState->table[fromColumnIndex][startRowIndex], destTopCard);
-    }
-}
-
-/* Apply table-sequence move with capacity guard. */
-static void apply_move_sequence_between_columns(KlondikeGame *gameState, int fromColumnIndex, int startRowIndex, int toColumnIndex)
-{
-    int moveCount = gameState->table_counts[fromColumnIndex] - startRowIndex;
-    if (moveCount <= 0) { return; }
-
-    /* Destination capacity check (defensive; should already be filtered). */
-    if (gameState->table_counts[toColumnIndex] + moveCount > MAX_DRAW_STACK) { return; }
-
-    for (int j = 0; j < moveCount; ++j)
-    {
-        gameState->table[toColumnIndex][gameState->table_counts[toColumnIndex]++] =
-            gameState->table[fromColumnIndex][startRowIndex + j];
-    }
-
-    gameState->table_counts[fromColumnIndex] = startRowIndex;
-
-    if (gameState->table_counts[fromColumnIndex] > 0)
-    {
-        gameState->table[fromColumnIndex][gameState->table_counts[fromColumnIndex] - 1].revealed = 1;
-    }
-}
-
-/* Goal check: all four foundations must be complete. */
-static inline int is_goal_state(const KlondikeGame *gameState)
+/**
+ * probe_winnable
+ * cs_klondike_solve() on the session's solver, created on the first probe
+ * and reused for every later deal attempt of the same game.
+ */
+static bool probe_winnable(SolitaireSession *session, const KlondikeGame *gameState)
 {
-    int completeCount = 0;
-
-    for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
-    {
-        if (gameState->foundation[foundationIndex].count == MAX_FOUNDATION) { ++completeCount; }
-    }
-
-    return completeCount == FOUNDATION_PILES;
-}
-
-/* -------------------------------------------------------------------------- */
-/* Pruning / Forced-move heuristics (shared with solver)                      */
-/* -------------------------------------------------------------------------- */
-
-/**
- * max_foundation_rank_by_color
- * Compute the highest rank currently placed on foundations for red suits
- * (Hearts/Diamonds) and black suits (Clubs/Spades). Used by safe-to-foundation.
- */
-static void max_foundation_rank_by_color(const KlondikeGame *gameState, int *maxRedOut, int *maxBlackOut)
-{
-    int maxRedLocal   = 0;
-    int maxBlackLocal = 0;
-
-    for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
-    {
-        if (gameState->foundation[foundationIndex].count == 0) { continue; }
-
-        Card topFoundationCard = gameState->foundation[foundationIndex].cards[gameState->foundation[foundationIndex].count - 1];
-        int  rankValue         = get_card_rank_value(topFoundationCard);
-
-        if (is_red_suit(topFoundationCard))
-        {
-            if (rankValue > maxRedLocal)   { maxRedLocal   = rankValue; }
-        }
-        else
-        {
-            if (rankValue > maxBlackLocal) { maxBlackLocal = rankValue; }
-        }
-    }
-
-    *maxRedOut   = maxRedLocal;
-    *maxBlackOut = maxBlackLocal;
-}
-
-/**
- * is_safe_foundation_push
- * Classic heuristic: moving Ace/Two is always safe. For higher cards of value v:
- *  - Only move a red card if the max black foundation is at least v-1.
- *  - Only move a black card if the max red foundation is at least v-1.
- * This prevents “locking” low cards on foundation when they are still needed
- * to build sequences in the table.
- */
-static int is_safe_foundation_push(Card candidateCard, const KlondikeGame *gameState)
-{
-    int rankValue = get_card_rank_value(candidateCard);
-    if (rankValue <= 2) { return 1; }  /* A, 2 are always safe. */
-
-    int maxRed   = 0;
-    int maxBlack = 0;
-
-    max_foundation_rank_by_color(gameState, &maxRed, &maxBlack);
-
-    if (is_red_suit(candidateCard)) { return maxBlack >= (rankValue - 1); }
-    else                             { return maxRed   >= (rankValue - 1); }
-}
-
-/**
- * exists_any_table_to_table_move
- * Lightweight “is there any legal table move?” predicate.
- * Helps prune dead branches quickly in the solver.
- */
-static int exists_any_table_to_table_move(const KlondikeGame *gameState)
-{
-    for (int fromColumnIndex = 0; fromColumnIndex < COLUMNS; ++fromColumnIndex)
-    {
-        int columnCount = gameState->table_counts[fromColumnIndex];
-        if (columnCount == 0) { continue; }
-
-        int firstRevealedRowIndex = -1;
-
-        for (int tableRowIndex = 0; tableRowIndex < columnCount; ++tableRowIndex)
-        {
-            if (gameState->table[fromColumnIndex][tableRowIndex].revealed)
-            {
-                firstRevealedRowIndex = tableRowIndex;
-                break;
-            }
-        }
-
-        if (firstRevealedRowIndex == -1) { continue; }
-
-        for (int splitRowIndex = firstRevealedRowIndex; splitRowIndex < columnCount; ++splitRowIndex)
-        {
-            /* Ensure the subsequence is valid (descending, alternating colors). */
-            int isValidSequence = 1;
-
-            for (int checkIndex = splitRowIndex; checkIndex < columnCount - 1; ++checkIndex)
-            {
-                if (!is_legal_table_placement(gameState->table[fromColumnIndex][checkIndex + 1],
-                                              gameState->table[fromColumnIndex][checkIndex]))
-                {
-                    isValidSequence = 0;
-                    break;
-                }
-            }
-
-            if (!isValidSequence) { continue; }
-
-            for (int toColumnIndex = 0; toColumnIndex < COLUMNS; ++toColumnIndex)
-            {
-                if (toColumnIndex == fromColumnIndex) { continue; }
-
-                if (gameState->table_counts[toColumnIndex] == 0)
-                {
-                    if (strcmp(gameState->table[fromColumnIndex][splitRowIndex].rank, "King") == 0) { return 1; }
-                }
-                else
-                {
-                    Card destTopCard = gameState->table[toColumnIndex][gameState->table_counts[toColumnIndex] - 1];
-                    if (is_legal_table_placement(gameState->table[fromColumnIndex][splitRowIndex], destTopCard)) { return 1; }
-                }
-            }
-        }
-    }
-    return 0;
-}
-
-/**
- * exists_any_waste_to_table_move
- * Quick predicate for whether the waste top can be placed on any column.
- */
-static int exists_any_waste_to_table_move(const KlondikeGame *gameState)
-{
-    if (gameState->wastePile.count == 0) { return 0; }
-
-    Card wasteTopCard = gameState->wastePile.cards[gameState->wastePile.count - 1];
-
-    for (int toColumnIndex = 0; toColumnIndex < COLUMNS; ++toColumnIndex)
-    {
-        if (gameState->table_counts[toColumnIndex] == 0)
-        {
-            if (strcmp(wasteTopCard.rank, "King") == 0) { return 1; }
-        }
-        else
-        {
-            Card destTopCard = gameState->table[toColumnIndex][gameState->table_counts[toColumnIndex] - 1];
-            if (is_legal_table_placement(wasteTopCard, destTopCard)) { return 1; }
-        }
-    }
-    return 0;
-}
-
-/**
- * exists_any_safe_foundation_push
- * True if *any* safe-to-foundation move exists from table or waste.
- */
-static int exists_any_safe_foundation_push(const KlondikeGame *gameState)
-{
-    for (int tableColumnIndex = 0; tableColumnIndex < COLUMNS; ++tableColumnIndex)
-    {
-        if (gameState->table_counts[tableColumnIndex] == 0) { continue; }
-
-        Card topTableCard = gameState->table[tableColumnIndex][gameState->table_counts[tableColumnIndex] - 1];
-        if (!topTableCard.revealed) { continue; }
-
-        for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
-        {
-            if (is_legal_foundation_placement(topTableCard, &gameState->foundation[foundationIndex]) &&
-                is_safe_foundation_push(topTableCard, gameState))
-            {
-                return 1;
-            }
-        }
-    }
-
-    if (gameState->wastePile.count > 0)
-    {
-        Card wasteTopCard = gameState->wastePile.cards[gameState->wastePile.count - 1];
-
-        for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
-        {
-            if (is_legal_foundation_placement(wasteTopCard, &gameState->foundation[foundationIndex]) &&
-                is_safe_foundation_push(wasteTopCard, gameState))
-            {
-                return 1;
-            }
-        }
-    }
-
-    return 0;
-}
-
-/**
- * exists_any_progress_move
- * Coarse pruning gate for the solver:
- *  - Any safe-to-foundation push?
- *  - Any table->table move?
- *  - Any waste->table move?
- *  - Else, can we draw (or recycle in Easy)?
- *  - Otherwise: dead leaf (return 0).
- */
-static int exists_any_progress_move(const KlondikeGame *gameState)
-{
-    if (exists_any_safe_foundation_push(gameState)) { return 1; }
-    if (exists_any_table_to_table_move(gameState))  { return 1; }
-    if (exists_any_waste_to_table_move(gameState))  { return 1; }
-
-    if (gameState->drawPile.count > 0) { return 1; }
-    if (gameState->difficulty == DIFFICULTY_EASY && gameState->wastePile.count > 0) { return 1; }
-
-    return 0;
-}
-
-/**
- * apply_forced_moves
- * Collapse “obvious” safe foundation moves repeatedly until none apply.
- * This reduces branching and tends to expose more revealed table cards.
- *
- * @return 1 if the position changed at least once, 0 otherwise.
- */
-static int apply_forced_moves(KlondikeGame *gameState)
-{
-    int changedAny      = 0;
-    int changedThisPass = 0;
-
-    do
-    {
-        changedThisPass = 0;
-
-        /* Table -> foundation (safe only). */
-        for (int tableColumnIndex = 0; tableColumnIndex < COLUMNS; ++tableColumnIndex)
-        {
-            if (gameState->table_counts[tableColumnIndex] == 0) { continue; }
-
-            Card topTableCard = gameState->table[tableColumnIndex][gameState->table_counts[tableColumnIndex] - 1];
-            if (!topTableCard.revealed) { continue; }
-
-            for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
-            {
-                if (is_legal_foundation_placement(topTableCard, &gameState->foundation[foundationIndex]) &&
-                    is_safe_foundation_push(topTableCard, gameState))
-                {
-                    gameState->foundation[foundationIndex].cards[gameState->foundation[foundationIndex].count++] = topTableCard;
-                    gameState->table_counts[tableColumnIndex]--;
-
-                    if (gameState->table_counts[tableColumnIndex] > 0)
-                    {
-                        gameState->table[tableColumnIndex][gameState->table_counts[tableColumnIndex] - 1].revealed = 1;
-                    }
-
-                    changedThisPass = 1;
-                    changedAny      = 1;
-                    break;
-                }
-            }
-        }
-
-        /* Waste -> foundation (safe only). */
-        if (!changedThisPass && gameState->wastePile.count > 0)
-        {
-            Card wasteTopCard = gameState->wastePile.cards[gameState->wastePile.count - 1];
-
-            for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
-            {
-                if (is_legal_foundation_placement(wasteTopCard, &gameState->foundation[foundationIndex]) &&
-                    is_safe_foundation_push(wasteTopCard, gameState))
-                {
-                    gameState->foundation[foundationIndex].cards[gameState->foundation[foundationIndex].count++] = wasteTopCard;
-                    gameState->wastePile.count--;
-
-                    changedThisPass = 1;
-                    changedAny      = 1;
-                    break;
-                }
-            }
-        }
-    }
-    while (changedThisPass);
-
-    return changedAny;
-}
-
-/* -------------------------------------------------------------------------- */
-/* DFS search engine                                                          */
-/* -------------------------------------------------------------------------- */
-
-/* Global node counter (guard against runaway searches). */
-static size_t g_DfsNodeCount = 0;
-
-/**
- * dfs_search_inner
- * Core recursive DFS over a heap-allocated “states” array:
- *   - states[depth] is the current node,
- *   - children are written into states[depth+1] before recursing,
- *   - we apply forced moves first and prune via transposition + “no progress”.
- *
- * @param statesArray   Pre-allocated array of size DFS_MAX_DEPTH+2.
- * @param searchDepth   Current search depth (0-based).
- * @param visitedTable  Transposition table (may be NULL to disable).
- * @return 1 if a winning line is found, 0 otherwise.
- */
-static int dfs_search_inner(KlondikeGame *statesArray, int searchDepth, VisitedEntry *visitedTable)
-{
-    if (searchDepth >= DFS_MAX_DEPTH) { return 0; }
-
-    KlondikeGame *currentState = &statesArray[searchDepth];
-
-    /* Apply safe/forced moves in-place to shrink branching. */
-    apply_forced_moves(currentState);
-
-    if (is_goal_state(currentState)) { return 1; }
-
-    /* Node budget (hard cap). */
-    if (++g_DfsNodeCount > DFS_NODE_LIMIT) { return 0; }
-
-    /* Transposition table guard. */
-    uint64_t stateKey = compute_state_hash(currentState);
-
-    if (visitedTable && visited_table_contains(visitedTable, stateKey)) { return 0; }
-    if (visitedTable) { visited_table_insert(visitedTable, stateKey); }
-
-    /* Quick prune (no moves & no draw/recycle). */
-    if (!exists_any_progress_move(currentState)) { return 0; }
-
-    /* 1) Table top -> foundation (safe only). */
-    for (int tableColumnIndex = 0; tableColumnIndex < COLUMNS; ++tableColumnIndex)
-    {
-        if (currentState->table_counts[tableColumnIndex] == 0) { continue; }
-
-        Card topTableCard = currentState->table[tableColumnIndex][currentState->table_counts[tableColumnIndex] - 1];
-        if (!topTableCard.revealed) { continue; }
-
-        for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
-        {
-            if (is_legal_foundation_placement(topTableCard, &currentState->foundation[foundationIndex]) &&
-                is_safe_foundation_push(topTableCard, currentState))
-            {
-                statesArray[searchDepth + 1] = *currentState;
-
-                KlondikeGame *nextState = &statesArray[searchDepth + 1];
-                nextState->foundation[foundationIndex].cards[nextState->foundation[foundationIndex].count++] = topTableCard;
-                nextState->table_counts[tableColumnIndex]--;
-
-                reveal_new_table_top_card(nextState, tableColumnIndex);
-
-                if (dfs_search_inner(statesArray, searchDepth + 1, visitedTable)) { return 1; }
-            }
-        }
-    }
-
-    /* 2) Waste -> foundation (safe only). */
-    if (currentState->wastePile.count > 0)
-    {
-        Card wasteTopCard = currentState->wastePile.cards[currentState->wastePile.count - 1];
-
-        for (int foundationIndex = 0; foundationIndex < FOUNDATION_PILES; ++foundationIndex)
-        {
-            if (is_legal_foundation_placement(wasteTopCard, &currentState->foundation[foundationIndex]) &&
-                is_safe_foundation_push(wasteTopCard, currentState))
-            {
-                statesArray[searchDepth + 1] = *currentState;
-
-                KlondikeGame *nextState = &statesArray[searchDepth + 1];
-                nextState->foundation[foundationIndex].cards[nextState->foundation[foundationIndex].count++] = wasteTopCard;
-
-                if (nextState->wastePile.count > 0) { nextState->wastePile.count--; }
-
-                if (dfs_search_inner(statesArray, searchDepth + 1, visitedTable)) { return 1; }
-            }
-        }
-    }
-
-    /* 3) Table -> table (move any legal revealed sequence). */
-    for (int fromColumnIndex = 0; fromColumnIndex < COLUMNS; ++fromColumnIndex)
-    {
-        int columnCount = currentState->table_counts[fromColumnIndex];
-        if (columnCount == 0) { continue; }
-
-        int firstRevealedRowIndex = -1;
-
-        for (int tableRowIndex = 0; tableRowIndex < columnCount; ++tableRowIndex)
-        {
-            if (currentState->table[fromColumnIndex][tableRowIndex].revealed)
-            {
-                firstRevealedRowIndex = tableRowIndex;
-                break;
-            }
-        }
-
-        if (firstRevealedRowIndex == -1) { continue; }
-
-        for (int splitRowIndex = firstRevealedRowIndex; splitRowIndex < columnCount; ++splitRowIndex)
-        {
-            int isValidSequence = 1;
-
-            for (int checkIndex = splitRowIndex; checkIndex < columnCount - 1; ++checkIndex)
-            {
-                if (!is_legal_table_placement(currentState->table[fromColumnIndex][checkIndex + 1],
-                                              currentState->table[fromColumnIndex][checkIndex]))
-                {
-                    isValidSequence = 0;
-                    break;
-                }
-            }
-
-            if (!isValidSequence) { continue; }
-
-            for (int toColumnIndex = 0; toColumnIndex < COLUMNS; ++toColumnIndex)
-            {
-                if (toColumnIndex == fromColumnIndex) { continue; }
-
-                if (!can_move_sequence_onto_column(currentState, fromColumnIndex, splitRowIndex, toColumnIndex)) { continue; }
-
-                statesArray[searchDepth + 1] = *currentState;
-
-                KlondikeGame *nextState = &statesArray[searchDepth + 1];
-                apply_move_sequence_between_columns(nextState, fromColumnIndex, splitRowIndex, toColumnIndex);
-
-                if (dfs_search_inner(statesArray, searchDepth + 1, visitedTable)) { return 1; }
-            }
-        }
-    }
-
-    /* 4) Waste -> table (place King to empty or descending/alt-color otherwise). */
-    if (currentState->wastePile.count > 0)
-    {
-        Card wasteTopCard = currentState->wastePile.cards[currentState->wastePile.count - 1];
-
-        for (int toColumnIndex = 0; toColumnIndex < COLUMNS; ++toColumnIndex)
-        {
-            if (currentState->table_counts[toColumnIndex] == 0)
-            {
-                if (strcmp(wasteTopCard.rank, "King") != 0) { continue; }
-
-                statesArray[searchDepth + 1] = *currentState;
-
-                KlondikeGame *nextState = &statesArray[searchDepth + 1];
-                wasteTopCard.revealed = 1;
-                nextState->table[toColumnIndex][nextState->table_counts[toColumnIndex]++] = wasteTopCard;
-
-                if (nextState->wastePile.count > 0) { nextState->wastePile.count--; }
-
-                if (dfs_search_inner(statesArray, searchDepth + 1, visitedTable)) { return 1; }
-            }
-            else
-            {
-                Card destTopCard = currentState->table[toColumnIndex][currentState->table_counts[toColumnIndex] - 1];
-
-                if (is_legal_table_placement(wasteTopCard, destTopCard))
-                {
-                    statesArray[searchDepth + 1] = *currentState;
-
-                    KlondikeGame *nextState = &statesArray[searchDepth + 1];
-                    nextState->table[toColumnIndex][nextState->table_counts[toColumnIndex]++] = wasteTopCard;
-
-                    if (nextState->wastePile.count > 0) { nextState->wastePile.count--; }
-
-                    if (dfs_search_inner(statesArray, searchDepth + 1, visitedTable)) { return 1; }
-                }
-            }
-        }
-    }
-
-    /* 5) Draw from stock (and recycle in Easy). */
-    {
-        int drawCount = (currentState->difficulty == DIFFICULTY_HARD) ? 3 : 1;
-
-        if (currentState->drawPile.count > 0)
-        {
-            statesArray[searchDepth + 1] = *currentState;
-
-            KlondikeGame *nextState = &statesArray[searchDepth + 1];
-            int actualDraw = (nextState->drawPile.count < drawCount) ? nextState->drawPile.count : drawCount;
-
-            for (int drawIndex = 0; drawIndex < actualDraw; ++drawIndex)
-            {
-                nextState->wastePile.cards[nextState->wastePile.count++] =
-                    nextState->drawPile.cards[--nextState->drawPile.count];
-            }
-
-            if (dfs_search_inner(statesArray, searchDepth + 1, visitedTable)) { return 1; }
-        }
-        else if (currentState->difficulty == DIFFICULTY_EASY && currentState->wastePile.count > 0)
-        {
-            /* Easy: recycle waste -> draw and keep searching. */
-            statesArray[searchDepth + 1] = *currentState;
-
-            KlondikeGame *nextState = &statesArray[searchDepth + 1];
-
-            for (int wasteIndex = nextState->wastePile.count - 1; wasteIndex >= 0; --wasteIndex)
-            {
-                nextState->drawPile.cards[nextState->drawPile.count++] = nextState->wastePile.cards[wasteIndex];
-            }
-
-            nextState->wastePile.count = 0;
-
-            if (dfs_search_inner(statesArray, searchDepth + 1, visitedTable)) { return 1; }
-        }
-    }
-
-    return 0;
-}
-
-/**
- * dfs_solitaire_win
- * Entry point for the solver. Allocates:
- *  - a transposition table (VisitedEntry[]),
- *  - a heap array of states sized by DFS_MAX_DEPTH (prevents stack overflow),
- * and invokes dfs_search_inner().
- *
- * @return true if a winning sequence was found from the initial state.
- */
-bool dfs_solitaire_win(KlondikeGame *gameState)
-{
-    if (is_goal_state(gameState)) { return true; }
-
-    VisitedEntry *visitedTable = (VisitedEntry *)calloc(VISITED_CAP, sizeof(VisitedEntry));
-    if (!visitedTable)
-    {
-        /* If we can't allocate, fail gracefully (no crash). */
-        return false;
-    }
-
-    KlondikeGame *statesArray = (KlondikeGame *)malloc(sizeof(KlondikeGame) * (DFS_MAX_DEPTH + 2));
-    if (!statesArray)
-    {
-        free(visitedTable);
-        return false;
-    }
-
-    statesArray[0] = *gameState;
-
-    g_DfsNodeCount = 0;
-
-    int dfsResult = dfs_search_inner(statesArray, 0, visitedTable);
-
-    free(statesArray);
-    free(visitedTable);
+    if (!session->solver) { session->solver = cs_solver_create(); }
 
-    return dfsResult ? true : false;
+    /* If we can't allocate, fail gracefully (no crash). */
+    return session->solver ? cs_klondike_solve(session->solver, gameState) : false;
 }
@@ -0,0 +1,461 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * cardsim-solvertest: the Klondike solver's regression corpus.
+ *
+ *   cardsim-solvertest [--threads N] [--node-slack PCT] [--latency-slack PCT]
+ *                      [--baseline FILE [--record]] CORPUS
+ *   cardsim-solvertest --generate CORPUS [--games N] [--seed S] [--max-nodes N]
+ *
+ * The corpus is a stream of Klondike snapshots (cs_snap_next), one per
+ * deal, each carrying the verdict, node count and solver options it was
+ * solved with (CS_SNAP_KL_VERDICT / NODES / SOLVER).
+ *
+ * Responsibilities:
+ *   - Generating a corpus: seeded deals of every difficulty, solved with
+ *     both move sets, keeping a mix of wins and losses that each finish
+ *     within a node cap so the whole corpus runs in seconds.
+ *   - Checking one: every deal solved again on a pool of worker threads.
+ *     Fails on any verdict flip or a node count above the recorded one by
+ *     more than the node slack; fewer nodes are reported, not failed.
+ *   - Latency: the summed solve time against a baseline recorded on this
+ *     machine (--record), failing beyond the latency slack. A --baseline
+ *     that is missing or was recorded for another corpus fails the run.
+ */
+
+#include "cardsim.h"
+#include "platform.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ------------------------------------------------------------------------- */
+/* Limits                                                                    */
+/* ------------------------------------------------------------------------- */
+
+#define MAX_CORPUS_BYTES       (1 << 22)
+#define MAX_ENTRIES            4096
+#define MAX_THREADS            256
+#define DEFAULT_NODE_SLACK     5         /* percent */
+#define DEFAULT_LATENCY_SLACK  25        /* percent */
+#define DEFAULT_GAMES          12        /* per difficulty and move set */
+#define DEFAULT_MAX_NODES      60000
+#define SCAN_FACTOR            25        /* seeds scanned per wanted deal */
+
+#define VERDICT_LOST  1
+#define VERDICT_WON   2
+
+static const char *const g_DifficultyNames[DIFFICULTY_HARD + 1] = { "", "easy", "normal", "hard" };
+static const char *const g_MoveSetNames[2]                      = { "default", "complete" };
+
+/* ------------------------------------------------------------------------- */
+/* Types                                                                     */
+/* ------------------------------------------------------------------------- */
+
+typedef struct {
+    const char *corpus;
+    const char *baseline;
+    bool        record;
+    bool        generate;
+    int         threads;
+    long        nodeSlack;
+    long        latencySlack;
+    long        games;
+    long        maxNodes;
+    uint64_t    seed;
+} TestOptions;
+
+typedef struct {
+    KlondikeGame game;
+    unsigned     options;
+    int          verdict;               /* expected */
+    uint32_t     nodes;                 /* expected */
+
+    int          gotVerdict;            /* 0: still running at the node cap */
+    uint64_t     gotNodes;
+    uint64_t     elapsedNs;
+} CorpusEntry;
+
+typedef struct {
+    const TestOptions *opts;
+    CorpusEntry       *entries;
+    int                count;
+
+    PlatformMutex      lock;
+    int                next;            /* first unclaimed entry */
+} TestRun;
+
+typedef struct {
+    TestRun        *run;
+    PlatformThread  thread;
+    SolverContext  *solver;
+} TestWorker;
+
+/* ------------------------------------------------------------------------- */
+/* Options                                                                   */
+/* ------------------------------------------------------------------------- */
+
+static bool parse_count(const char *text, long low, long high, long *out)
+{
+    char *end = NULL;
+    const long value = strtol(text, &end, 10);
+    if (!end || *end != '\0' || value < low || value > high) return false;
+    *out = value;
+    return true;
+}
+
+static bool parse_seed(const char *text, uint64_t *out)
+{
+    char *end = NULL;
+    errno = 0;
+    const unsigned long long value = strtoull(text, &end, 10);
+    if (text[0] < '0' || text[0] > '9' || !end || *end != '\0' || errno == ERANGE) return false;
+    *out = (uint64_t)value;
+    return true;
+}
+
+static bool usage(const char *program)
+{
+    fprintf(stderr, "Usage: %s [--threads N] [--node-slack PCT] [--latency-slack PCT]\n"
+                    "       [--baseline FILE [--record]] CORPUS\n"
+                    "       %s --generate CORPUS [--games N] [--seed S] [--max-nodes N]\n", program, program);
+    return false;
+}
+
+static bool parse_args(int argc, char **argv, TestOptions *opts)
+{
+    memset(opts, 0, sizeof(*opts));
+    opts->threads      = platform_cpu_count();
+    opts->nodeSlack    = DEFAULT_NODE_SLACK;
+    opts->latencySlack = DEFAULT_LATENCY_SLACK;
+    opts->games        = DEFAULT_GAMES;
+    opts->maxNodes     = DEFAULT_MAX_NODES;
+    opts->seed         = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        long value = 0;
+        const bool hasValue = (i + 1 < argc);
+
+        if (strcmp(argv[i], "--threads") == 0 && hasValue && parse_count(argv[i + 1], 1, MAX_THREADS, &value)) {
+            opts->threads = (int)value; ++i;
+        } else if (strcmp(argv[i], "--node-slack") == 0 && hasValue && parse_count(argv[i + 1], 0, 1000, &value)) {
+            opts->nodeSlack = value; ++i;
+        } else if (strcmp(argv[i], "--latency-slack") == 0 && hasValue &&
+                   parse_count(argv[i + 1], 0, 1000, &value)) {
+            opts->latencySlack = value; ++i;
+        } else if (strcmp(argv[i], "--baseline") == 0 && hasValue) {
+            opts->baseline = argv[++i];
+        } else if (strcmp(argv[i], "--record") == 0) {
+            opts->record = true;
+        } else if (strcmp(argv[i], "--generate") == 0) {
+            opts->generate = true;
+        } else if (strcmp(argv[i], "--games") == 0 && hasValue && parse_count(argv[i + 1], 1, 1000, &value)) {
+            opts->games = value; ++i;
+        } else if (strcmp(argv[i], "--max-nodes") == 0 && hasValue &&
+                   parse_count(argv[i + 1], 1, DFS_NODE_LIMIT, &value)) {
+            opts->maxNodes = value; ++i;
+        } else if (strcmp(argv[i], "--seed") == 0 && hasValue && parse_seed(argv[i + 1], &opts->seed)) {
+            ++i;
+        } else if (argv[i][0] != '-' && !opts->corpus) {
+            opts->corpus = argv[i];
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    if (!opts->corpus || (opts->record && !opts->baseline)) return usage(argv[0]);
+    return true;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Corpus file                                                               */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * load_corpus
+ * Read every snapshot of the stream at `path` into entries[]. Returns the
+ * number of entries, or -1 (after printing why) on a missing file or a
+ * damaged entry.
+ */
+static int load_corpus(const char *path, CorpusEntry *entries, int capacity)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "cardsim-solvertest: cannot open %s\n", path);
+        return -1;
+    }
+
+    uint8_t *stream = (uint8_t *)malloc(MAX_CORPUS_BYTES);
+    size_t   size   = stream ? fread(stream, 1, MAX_CORPUS_BYTES, file) : 0;
+    fclose(file);
+
+    int        count  = 0;
+    size_t     offset = 0;
+    CsSnapshot snap;
+    while (stream && count < capacity && cs_snap_next(stream, size, &offset, &snap)) {
+        CorpusEntry *entry = &entries[count];
+        memset(entry, 0, sizeof(*entry));
+        if (!cs_klondike_restore(&entry->game, &snap)) break;
+
+        entry->verdict = cs_snap_u8(&snap, CS_SNAP_KL_VERDICT);
+        entry->nodes   = cs_snap_u32(&snap, CS_SNAP_KL_NODES);
+        entry->options = cs_snap_u8(&snap, CS_SNAP_KL_SOLVER);
+        if (entry->verdict != VERDICT_LOST && entry->verdict != VERDICT_WON) break;
+        count++;
+    }
+    free(stream);
+
+    if (offset != size || count == 0) {
+        fprintf(stderr, "cardsim-solvertest: %s: damaged or empty at entry %d\n", path, count);
+        return -1;
+    }
+    return count;
+}
+
+/* Append one solved deal to `file` as a snapshot with its expectations. */
+static bool write_entry(FILE *file, const KlondikeGame *game, unsigned options, bool won, size_t nodes)
+{
+    uint8_t      buffer[CS_SNAP_MAX_SIZE];
+    CsSnapWriter writer;
+
+    cs_snap_begin(&writer, buffer, sizeof(buffer), CS_GAME_KLONDIKE, 0);
+    cs_klondike_snapshot_write(&writer, game);
+    cs_snap_put(&writer, CS_SNAP_KL_VERDICT, won ? VERDICT_WON : VERDICT_LOST, 1);
+    cs_snap_put(&writer, CS_SNAP_KL_NODES, (uint64_t)nodes, 4);
+    cs_snap_put(&writer, CS_SNAP_KL_SOLVER, options, 1);
+
+    const size_t length = cs_snap_finish(&writer);
+    return length && fwrite(buffer, 1, length, file) == length;
+}
+
+/**
+ * generate_corpus
+ * For each difficulty and move set, scan seeds from opts->seed and keep up
+ * to opts->games / 2 wins and as many losses among the deals whose solve
+ * ends within opts->maxNodes. Hard deals are rarely won, so their share is
+ * mostly losses.
+ */
+static int generate_corpus(const TestOptions *opts)
+{
+    static const unsigned moveSets[2] = { 0, CS_SOLVER_COMPLETE_MOVES };
+
+    SolverContext *solver = cs_solver_create();
+    FILE          *file   = fopen(opts->corpus, "wb");
+    if (!solver || !file) {
+        fprintf(stderr, "cardsim-solvertest: cannot write %s\n", opts->corpus);
+        if (file) fclose(file);
+        cs_solver_destroy(solver);
+        return 1;
+    }
+
+    bool ok = true;
+    for (int difficulty = DIFFICULTY_EASY; ok && difficulty <= DIFFICULTY_HARD; ++difficulty) {
+        for (int set = 0; ok && set < 2; ++set) {
+            const long wanted = opts->games / 2 + opts->games % 2;
+            long       kept[2] = { 0, 0 };   /* losses, wins */
+
+            for (long scan = 0; ok && scan < opts->games * SCAN_FACTOR && kept[0] + kept[1] < opts->games; ++scan) {
+                KlondikeGame game;
+                CsRng        rng;
+                cs_rng_seed(&rng, opts->seed + (uint64_t)scan);
+                cs_klondike_deal_random(&game, difficulty, &rng);
+
+                solver->options = moveSets[set];
+                cs_solver_begin(solver, &game);
+                const CsSolveStatus status = cs_solver_run(solver, (size_t)opts->maxNodes);
+                const int           won    = status == CS_SOLVE_WON;
+                if (status == CS_SOLVE_RUNNING || kept[won] >= (won ? wanted : opts->games - wanted)) continue;
+
+                ok = write_entry(file, &game, moveSets[set], won, solver->nodeCount);
+                kept[won]++;
+            }
+            printf("%-6s %-8s %2ld won %2ld lost\n", g_DifficultyNames[difficulty], g_MoveSetNames[set], kept[1], kept[0]);
+        }
+    }
+
+    ok = (fclose(file) == 0) && ok;
+    cs_solver_destroy(solver);
+    if (!ok) fprintf(stderr, "cardsim-solvertest: cannot write %s\n", opts->corpus);
+    return ok ? 0 : 1;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Workers                                                                   */
+/* ------------------------------------------------------------------------- */
+
+/* Node cap for re-solving an entry: enough to pass, one more to fail. */
+static size_t node_cap(const TestOptions *opts, const CorpusEntry *entry)
+{
+    return (size_t)entry->nodes + (size_t)entry->nodes * (size_t)opts->nodeSlack / 100 + 1;
+}
+
+static void worker_main(void *arg)
+{
+    TestWorker *worker = (TestWorker *)arg;
+    TestRun    *run    = worker->run;
+
+    for (;;) {
+        platform_mutex_lock(&run->lock);
+        const int index = run->next < run->count ? run->next++ : -1;
+        platform_mutex_unlock(&run->lock);
+        if (index < 0) return;
+
+        CorpusEntry   *entry  = &run->entries[index];
+        SolverContext *solver = worker->solver;
+
+        const uint64_t start = platform_now_ns();
+        solver->options = entry->options;
+        cs_solver_begin(solver, &entry->game);
+        const CsSolveStatus status = cs_solver_run(solver, node_cap(run->opts, entry));
+        entry->elapsedNs = platform_now_ns() - start;
+
+        entry->gotNodes   = solver->nodeCount;
+        entry->gotVerdict = status == CS_SOLVE_WON ? VERDICT_WON : status == CS_SOLVE_LOST ? VERDICT_LOST : 0;
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* Checks                                                                    */
+/* ------------------------------------------------------------------------- */
+
+static const char *verdict_name(int verdict)
+{
+    return verdict == VERDICT_WON ? "won" : "lost";
+}
+
+/**
+ * check_entries
+ * Print every failing entry; returns the number of failures and sums the
+ * expected and actual nodes and the solve time.
+ */
+static int check_entries(const TestRun *run, uint64_t *expectedNodes, uint64_t *gotNodes, uint64_t *elapsedNs)
+{
+    int failures = 0, fewer = 0;
+
+    for (int i = 0; i < run->count; ++i) {
+        const CorpusEntry *entry      = &run->entries[i];
+        const char        *difficulty = g_DifficultyNames[entry->game.difficulty <= DIFFICULTY_HARD ? entry->game.difficulty : 0];
+        const char        *moveSet    = g_MoveSetNames[(entry->options & CS_SOLVER_COMPLETE_MOVES) ? 1 : 0];
+
+        *expectedNodes += entry->nodes;
+        *gotNodes      += entry->gotNodes;
+        *elapsedNs     += entry->elapsedNs;
+
+        if (entry->gotVerdict == 0) {
+            printf("FAIL #%d %s/%s: no verdict within %zu nodes, corpus says %s in %" PRIu32 "\n", i, difficulty,
+                   moveSet, node_cap(run->opts, entry) - 1, verdict_name(entry->verdict), entry->nodes);
+            failures++;
+        } else if (entry->gotVerdict != entry->verdict) {
+            printf("FAIL #%d %s/%s: verdict %s, corpus says %s (%" PRIu64 " nodes)\n", i, difficulty, moveSet,
+                   verdict_name(entry->gotVerdict), verdict_name(entry->verdict), entry->gotNodes);
+            failures++;
+        } else if (entry->gotNodes > node_cap(run->opts, entry) - 1) {
+            printf("FAIL #%d %s/%s: %" PRIu64 " nodes, corpus says %" PRIu32 " (+%ld%% allowed)\n", i, difficulty,
+                   moveSet, entry->gotNodes, entry->nodes, run->opts->nodeSlack);
+            failures++;
+        } else if (entry->gotNodes < entry->nodes) {
+            fewer++;
+        }
+    }
+
+    if (fewer) printf("note: %d entries now need fewer nodes; regenerate the corpus to lock that in\n", fewer);
+    return failures;
+}
+
+/**
+ * check_latency
+ * Compare the summed solve time with the baseline file (or record it).
+ * Returns false on a regression beyond the latency slack, or when there is
+ * no baseline for this corpus to compare with.
+ */
+static bool check_latency(const TestOptions *opts, int entries, uint64_t elapsedNs)
+{
+    if (!opts->baseline) return true;
+
+    if (opts->record) {
+        FILE *file = fopen(opts->baseline, "w");
+        if (!file || fprintf(file, "%d %" PRIu64 "\n", entries, elapsedNs) < 0 || fclose(file) != 0) {
+            fprintf(stderr, "cardsim-solvertest: cannot write %s\n", opts->baseline);
+            return false;
+        }
+        printf("latency baseline recorded in %s\n", opts->baseline);
+        return true;
+    }
+
+    FILE    *file          = fopen(opts->baseline, "r");
+    int      baseEntries   = 0;
+    uint64_t baseElapsedNs = 0;
+    const bool loaded = file && fscanf(file, "%d %" SCNu64, &baseEntries, &baseElapsedNs) == 2;
+    if (file) fclose(file);
+
+    if (!loaded || baseEntries != entries || baseElapsedNs == 0) {
+        printf("latency: no baseline for this corpus in %s (record one with --record) FAIL\n", opts->baseline);
+        return false;
+    }
+
+    const double ratio = (double)elapsedNs / (double)baseElapsedNs;
+    const bool   ok    = ratio <= 1.0 + (double)opts->latencySlack / 100.0;
+    printf("latency: %.2f s vs %.2f s baseline (%+.1f%%, %ld%% allowed)%s\n", (double)elapsedNs / 1e9,
+           (double)baseElapsedNs / 1e9, (ratio - 1.0) * 100.0, opts->latencySlack, ok ? "" : " FAIL");
+    return ok;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Entry point                                                               */
+/* ------------------------------------------------------------------------- */
+
+int main(int argc, char **argv)
+{
+    TestOptions opts;
+    if (!parse_args(argc, argv, &opts)) return 2;
+    if (opts.generate) return generate_corpus(&opts);
+
+    TestRun run = { .opts = &opts };
+    run.entries = (CorpusEntry *)calloc(MAX_ENTRIES, sizeof(CorpusEntry));
+    TestWorker *workers = (TestWorker *)calloc((size_t)opts.threads, sizeof(TestWorker));
+    if (!run.entries || !workers) {
+        fprintf(stderr, "cardsim-solvertest: out of memory\n");
+        free(run.entries);
+        free(workers);
+        return 1;
+    }
+
+    run.count = load_corpus(opts.corpus, run.entries, MAX_ENTRIES);
+    if (run.count < 0) {
+        free(run.entries);
+        free(workers);
+        return 1;
+    }
+    platform_mutex_init(&run.lock);
+
+    const uint64_t start   = platform_now_ns();
+    int            started = 0;
+    for (int i = 0; i < opts.threads; ++i) {
+        workers[i].run    = &run;
+        workers[i].solver = cs_solver_create();
+        if (!workers[i].solver || !platform_thread_create(&workers[i].thread, worker_main, &workers[i])) break;
+        started++;
+    }
+    if (started == 0 && workers[0].solver) worker_main(&workers[0]);   /* no threads to be had: run here */
+    for (int i = 0; i < started; ++i) platform_thread_join(workers[i].thread);
+    const uint64_t wallNs = platform_now_ns() - start;
+
+    uint64_t expectedNodes = 0, gotNodes = 0, elapsedNs = 0;
+    const int  failures  = check_entries(&run, &expectedNodes, &gotNodes, &elapsedNs);
+    const bool latencyOk = failures == 0 && check_latency(&opts, run.count, elapsedNs);
+
+    printf("cardsim-solvertest: %d deals, %d failed; %" PRIu64 " nodes (corpus %" PRIu64 "), "
+           "%.2f s solving, %.2f s wall on %d thread%s\n",
+           run.count, failures, gotNodes, expectedNodes, (double)elapsedNs / 1e9, (double)wallNs / 1e9,
+           started ? started : 1, started == 1 ? "" : "s");
+
+    platform_mutex_destroy(&run.lock);
+    for (int i = 0; i < opts.threads; ++i) cs_solver_destroy(workers[i].solver);
+    free(workers);
+    free(run.entries);
+    return (failures == 0 && latencyOk) ? 0 : 1;
+}
@@ -0,0 +1,304 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Columnar game history (see history.h).
+ *
+ * Responsibilities:
+ *   - Keep one append handle per column file and write rows column by column.
+ *   - Repair torn rows (unequal column lengths) before the first append.
+ *   - Memory-map columns read-only (mmap / MapViewOfFile) and replay them
+ *     row by row without copying.
+ */
+
+#ifndef _WIN32
+  #define _POSIX_C_SOURCE 200809L   /* truncate, posix_madvise */
+#endif
+
+#include "history.h"
+#include "paths.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+  #include <windows.h>
+  #include <io.h>
+  #include <fcntl.h>
+  #include <sys/stat.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+/* ------------------------------------------------------------------------- */
+/* Column layout                                                             */
+/* ------------------------------------------------------------------------- */
+
+typedef enum {
+    COL_TIMESTAMP,
+    COL_GAME,
+    COL_OUTCOME,
+    COL_DECISIONS,
+    COL_BET,
+    COL_PAYOUT,
+    COL_DURATION,
+    COL_COUNT
+} HistoryColumn;
+
+typedef struct {
+    const char *file;     /* inside <profile>/history/ */
+    size_t      width;
+} HistoryColumnInfo;
+
+static const HistoryColumnInfo g_Columns[COL_COUNT] = {
+    [COL_TIMESTAMP] = { "timestamp.col", sizeof(int64_t)  },
+    [COL_GAME]      = { "game.col",      sizeof(uint8_t)  },
+    [COL_OUTCOME]   = { "outcome.col",   sizeof(int8_t)   },
+    [COL_DECISIONS] = { "decisions.col", sizeof(uint16_t) },
+    [COL_BET]       = { "bet.col",       sizeof(uint32_t) },
+    [COL_PAYOUT]    = { "payout.col",    sizeof(int64_t)  },
+    [COL_DURATION]  = { "duration.col",  sizeof(uint32_t) },
+};
+
+/* A read-only view of one column file. */
+typedef struct {
+    const void *data;
+    size_t      length;
+#ifdef _WIN32
+    HANDLE      file;
+    HANDLE      mapping;
+#endif
+} MappedColumn;
+
+/* ------------------------------------------------------------------------- */
+/* File-scope state                                                          */
+/* ------------------------------------------------------------------------- */
+
+static FILE *g_Append[COL_COUNT];
+static bool  g_AppendOpen     = false;
+static bool  g_ExitRegistered = false;
+
+/* ------------------------------------------------------------------------- */
+/* File helpers                                                              */
+/* ------------------------------------------------------------------------- */
+
+/** Path of a column file in the active profile. */
+static void column_path(char *buf, size_t bufsize, HistoryColumn column)
+{
+    char dir[PROFILE_DIR_MAX];
+    profile_dir(dir, sizeof(dir));
+    (void)snprintf(buf, bufsize, "%s/" HISTORY_SUBDIR "/%s", dir, g_Columns[column].file);
+}
+
+/** Size of a file in bytes (0 if missing). */
+static uint64_t file_size(const char *path)
+{
+#ifdef _WIN32
+    struct _stat64 info;
+    return (_stat64(path, &info) == 0) ? (uint64_t)info.st_size : 0;
+#else
+    struct stat info;
+    return (stat(path, &info) == 0) ? (uint64_t)info.st_size : 0;
+#endif
+}
+
+/** Cut a file down to `length` bytes. */
+static void truncate_file(const char *path, uint64_t length)
+{
+#ifdef _WIN32
+    int fd = -1;
+    if (_sopen_s(&fd, path, _O_RDWR | _O_BINARY, _SH_DENYNO, _S_IREAD | _S_IWRITE) == 0) {
+        (void)_chsize_s(fd, (long long)length);
+        _close(fd);
+    }
+#else
+    (void)truncate(path, (off_t)length);
+#endif
+}
+
+/** Rows present in every column (the shortest column wins). */
+static uint64_t complete_rows(void)
+{
+    uint64_t rows = UINT64_MAX;
+    for (int c = 0; c < COL_COUNT; ++c) {
+        char path[SAVE_PATH_MAX];
+        column_path(path, sizeof(path), (HistoryColumn)c);
+        const uint64_t columnRows = file_size(path) / g_Columns[c].width;
+        if (columnRows < rows) rows = columnRows;
+    }
+    return rows;
+}
+
+/**
+ * open_for_append
+ * Drop any torn tail (a row written to only some columns), then open every
+ * column in append mode.
+ */
+static bool open_for_append(void)
+{
+    if (g_AppendOpen) return true;
+
+    const uint64_t rows = complete_rows();
+    char path[SAVE_PATH_MAX];
+    for (int c = 0; c < COL_COUNT; ++c) {
+        column_path(path, sizeof(path), (HistoryColumn)c);
+        const uint64_t wanted = rows * g_Columns[c].width;
+        if (file_size(path) != wanted) truncate_file(path, wanted);
+    }
+
+    for (int c = 0; c < COL_COUNT; ++c) {
+        column_path(path, sizeof(path), (HistoryColumn)c);
+        g_Append[c] = fopen(path, "ab");
+        if (!g_Append[c]) {
+            history_close();
+            return false;
+        }
+    }
+
+    g_AppendOpen = true;
+    if (!g_ExitRegistered) {
+        atexit(history_close);
+        g_ExitRegistered = true;
+    }
+    return true;
+}
+
+/** Map a column read-only. A missing or empty file yields an empty view. */
+static bool map_column(const char *path, MappedColumn *column)
+{
+    memset(column, 0, sizeof(*column));
+
+#ifdef _WIN32
+    column->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                               NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (column->file == INVALID_HANDLE_VALUE) { column->file = NULL; return true; }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(column->file, &size) || size.QuadPart == 0) return true;
+
+    column->mapping = CreateFileMappingA(column->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!column->mapping) return false;
+
+    column->data = MapViewOfFile(column->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!column->data) return false;
+    column->length = (size_t)size.QuadPart;
+#else
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return true;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) { close(fd); return true; }
+
+    void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);   /* the mapping keeps the file alive */
+    if (data == MAP_FAILED) return false;
+
+    (void)posix_madvise(data, (size_t)info.st_size, POSIX_MADV_SEQUENTIAL);
+    column->data   = data;
+    column->length = (size_t)info.st_size;
+#endif
+    return true;
+}
+
+static void unmap_column(MappedColumn *column)
+{
+#ifdef _WIN32
+    if (column->data)    UnmapViewOfFile(column->data);
+    if (column->mapping) CloseHandle(column->mapping);
+    if (column->file)    CloseHandle(column->file);
+#else
+    if (column->data) munmap((void *)column->data, column->length);
+#endif
+    memset(column, 0, sizeof(*column));
+}
+
+/* ------------------------------------------------------------------------- */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------- */
+
+bool history_append(const HistoryRecord *record)
+{
+    if (!record || !open_for_append()) return false;
+
+    const int64_t timestamp = record->timestamp ? record->timestamp : (int64_t)time(NULL);
+
+    const void *fields[COL_COUNT] = {
+        [COL_TIMESTAMP] = &timestamp,
+        [COL_GAME]      = &record->game,
+        [COL_OUTCOME]   = &record->outcome,
+        [COL_DECISIONS] = &record->decisions,
+        [COL_BET]       = &record->bet,
+        [COL_PAYOUT]    = &record->payout,
+        [COL_DURATION]  = &record->durationMs,
+    };
+
+    bool ok = true;
+    for (int c = 0; c < COL_COUNT; ++c) {
+        ok &= fwrite(fields[c], g_Columns[c].width, 1, g_Append[c]) == 1;
+    }
+    for (int c = 0; c < COL_COUNT; ++c) {
+        ok &= fflush(g_Append[c]) == 0;
+    }
+    return ok;
+}
+
+bool history_replay(uint64_t firstRow, void (*fn)(const HistoryRecord *record, void *arg), void *arg)
+{
+    if (!fn) return false;
+
+    MappedColumn columns[COL_COUNT];
+    bool   ok   = true;
+    size_t rows = SIZE_MAX;
+    for (int c = 0; c < COL_COUNT; ++c) {
+        char path[SAVE_PATH_MAX];
+        column_path(path, sizeof(path), (HistoryColumn)c);
+        ok &= map_column(path, &columns[c]);
+        const size_t columnRows = columns[c].length / g_Columns[c].width;
+        if (columnRows < rows) rows = columnRows;
+    }
+
+    if (ok) {
+        const int64_t  *timestamps = columns[COL_TIMESTAMP].data;
+        const uint8_t  *games      = columns[COL_GAME].data;
+        const int8_t   *outcomes   = columns[COL_OUTCOME].data;
+        const uint16_t *decisions  = columns[COL_DECISIONS].data;
+        const uint32_t *bets       = columns[COL_BET].data;
+        const int64_t  *payouts    = columns[COL_PAYOUT].data;
+        const uint32_t *durations  = columns[COL_DURATION].data;
+
+        for (uint64_t row = firstRow; row < rows; ++row) {
+            const HistoryRecord record = {
+                .timestamp  = timestamps[row],
+                .game       = games[row],
+                .outcome    = outcomes[row],
+                .decisions  = decisions[row],
+                .bet        = bets[row],
+                .payout     = payouts[row],
+                .durationMs = durations[row],
+            };
+            fn(&record, arg);
+        }
+    }
+
+    for (int c = 0; c < COL_COUNT; ++c) unmap_column(&columns[c]);
+    return ok;
+}
+
+uint64_t history_rows(void)
+{
+    return complete_rows();
+}
+
+void history_close(void)
+{
+    for (int c = 0; c < COL_COUNT; ++c) {
+        if (g_Append[c]) fclose(g_Append[c]);
+        g_Append[c] = NULL;
+    }
+    g_AppendOpen = false;
+}
@@ -0,0 +1,339 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Incremental stats rollups (see rollups.h).
+ *
+ * Responsibilities:
+ *   - Own the rollup table and fold each settled round into its game, game +
+ *     difficulty, all-games and day buckets.
+ *   - Save/load the table as one versioned blob (<profile>/rollups.dat).
+ *   - Rebuild from the history log when no usable blob exists, and replay
+ *     the rows logged after the last save (e.g. before a crash) when one does.
+ *
+ * The table is updated on the main thread and saved from the persistence
+ * writer thread, so every access goes through g_Lock.
+ */
+
+#include "rollups.h"
+#include "persist.h"
+#include "platform.h"
+#include "paths.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define ROLLUPS_MAGIC      0x55525343u   /* "CSRU" */
+#define ROLLUPS_VERSION    2u
+
+/* ------------------------------------------------------------------------- */
+/* Types                                                                     */
+/* ------------------------------------------------------------------------- */
+
+/* One aggregate plus the streak in progress (>0 wins, <0 losses). */
+typedef struct {
+    HistorySummary totals;
+    int32_t        streak;
+    uint32_t       reserved;
+} Rollup;
+
+typedef struct {
+    int64_t day;
+    Rollup  rollup;
+} DaySlot;
+
+/* On-disk and in-memory layout are the same. */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;                   /* sizeof(RollupTable) when written */
+    uint32_t reserved;
+    uint64_t historyRows;            /* history rows folded in (a log prefix) */
+
+    Rollup   byGame[HISTORY_GAME_COUNT];                               /* [ANY] = all */
+    Rollup   byDifficulty[HISTORY_GAME_COUNT][ROLLUP_DIFFICULTY_COUNT];
+    DaySlot  days[ROLLUP_DAYS];                                        /* day % N */
+} RollupTable;
+
+/* ------------------------------------------------------------------------- */
+/* File-scope state                                                          */
+/* ------------------------------------------------------------------------- */
+
+static RollupTable   g_Table;
+static RollupTable   g_SaveCopy;      /* snapshot written outside the lock */
+static PlatformMutex g_Lock;
+static bool          g_LockReady = false;
+
+/* ------------------------------------------------------------------------- */
+/* Internal helpers                                                          */
+/* ------------------------------------------------------------------------- */
+
+static void ensure_lock(void)
+{
+    if (g_LockReady) return;
+    platform_mutex_init(&g_Lock);
+    g_LockReady = true;
+}
+
+static void clear_table(void)
+{
+    memset(&g_Table, 0, sizeof(g_Table));
+    g_Table.magic   = ROLLUPS_MAGIC;
+    g_Table.version = ROLLUPS_VERSION;
+    g_Table.size    = (uint32_t)sizeof(RollupTable);
+}
+
+/**
+ * local_day
+ * Days since 1970-01-01 of the local calendar date of `timestamp`. The last
+ * answer is cached for the 23 hours after that local midnight (safe across
+ * DST changes), so a history replay calls localtime() about once per day.
+ */
+static int64_t local_day(int64_t timestamp)
+{
+    static int64_t cachedStart = 1, cachedEnd = 0, cachedDay = 0;
+    if (timestamp >= cachedStart && timestamp < cachedEnd) return cachedDay;
+
+    const time_t seconds = (time_t)timestamp;
+    const struct tm *local = localtime(&seconds);
+    if (!local) return timestamp / 86400;
+
+    cachedStart = timestamp - (local->tm_hour * 3600 + local->tm_min * 60 + local->tm_sec);
+    cachedEnd   = cachedStart + 23 * 3600;
+
+    /* Civil date -> day number (proleptic Gregorian). */
+    int64_t        year  = (int64_t)local->tm_year + 1900;
+    const unsigned month = (unsigned)local->tm_mon + 1;
+    const unsigned mday  = (unsigned)local->tm_mday;
+
+    year -= (month <= 2);
+    const int64_t  era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = (unsigned)(year - era * 400);
+    const unsigned doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + mday - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    cachedDay = era * 146097 + (int64_t)doe - 719468;
+    return cachedDay;
+}
+
+static RollupDifficulty difficulty_of(const HistoryRecord *record)
+{
+    if (record->decisions & HISTORY_DEC_HARD) return ROLLUP_DIFFICULTY_HARD;
+    if (record->decisions & HISTORY_DEC_EASY) return ROLLUP_DIFFICULTY_EASY;
+    return ROLLUP_DIFFICULTY_NORMAL;
+}
+
+static void count_streak(uint32_t *buckets, uint32_t length)
+{
+    if (length == 0) return;
+    buckets[(length < HISTORY_STREAK_BUCKETS) ? length - 1 : HISTORY_STREAK_BUCKETS - 1]++;
+}
+
+/** Fold one record into one rollup. Pushes do not break streaks. */
+static void rollup_add(Rollup *rollup, const HistoryRecord *record)
+{
+    HistorySummary *s = &rollup->totals;
+
+    s->rounds++;
+    s->wagered    += record->bet;
+    s->net        += record->payout;
+    s->durationMs += record->durationMs;
+
+    if (record->outcome > 0) {
+        s->wins++;
+        if (rollup->streak < 0) { count_streak(s->lossStreaks, (uint32_t)-rollup->streak); rollup->streak = 0; }
+        rollup->streak++;
+        if ((uint32_t)rollup->streak > s->longestWinStreak) s->longestWinStreak = (uint32_t)rollup->streak;
+    } else if (record->outcome < 0) {
+        s->losses++;
+        if (rollup->streak > 0) { count_streak(s->winStreaks, (uint32_t)rollup->streak); rollup->streak = 0; }
+        rollup->streak--;
+        if ((uint32_t)-rollup->streak > s->longestLossStreak) s->longestLossStreak = (uint32_t)-rollup->streak;
+    } else {
+        s->pushes++;   /* pushes do not break streaks */
+    }
+
+    for (int bit = 0; bit < HISTORY_DECISION_COUNT; ++bit) {
+        if (!(record->decisions & (1u << bit))) continue;
+        s->decisionRounds[bit]++;
+        s->decisionNet[bit] += record->payout;
+    }
+}
+
+/** Copy a rollup out, counting the open streak as if it ended now. */
+static void rollup_export(const Rollup *rollup, HistorySummary *out)
+{
+    *out = rollup->totals;
+    if (rollup->streak > 0) count_streak(out->winStreaks,  (uint32_t)rollup->streak);
+    if (rollup->streak < 0) count_streak(out->lossStreaks, (uint32_t)-rollup->streak);
+}
+
+/** Apply without locking (caller holds g_Lock, or nobody else can run). */
+static void apply_unlocked(const HistoryRecord *record)
+{
+    const int game = (record->game < HISTORY_GAME_COUNT) ? record->game : HISTORY_GAME_ANY;
+
+    rollup_add(&g_Table.byGame[HISTORY_GAME_ANY], record);
+    if (game != HISTORY_GAME_ANY) {
+        rollup_add(&g_Table.byGame[game], record);
+        rollup_add(&g_Table.byDifficulty[game][difficulty_of(record)], record);
+    }
+
+    const int64_t day  = local_day(record->timestamp);
+    DaySlot      *slot = &g_Table.days[((day % ROLLUP_DAYS) + ROLLUP_DAYS) % ROLLUP_DAYS];
+    if (slot->day != day) {
+        if (slot->day > day && slot->rollup.totals.rounds) return;   /* older than the window */
+        memset(slot, 0, sizeof(*slot));
+        slot->day = day;
+    }
+    rollup_add(&slot->rollup, record);
+}
+
+static void replay_row(const HistoryRecord *record, void *unused)
+{
+    (void)unused;
+    apply_unlocked(record);
+    g_Table.historyRows++;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------- */
+
+void rollups_init(void)
+{
+    ensure_lock();
+    platform_mutex_lock(&g_Lock);
+
+    char path[SAVE_PATH_MAX];
+    save_path(path, sizeof(path), ROLLUPS_FILE);
+
+    bool loaded = false;
+    FILE *fp = fopen(path, "rb");
+    if (fp) {
+        loaded = fread(&g_Table, sizeof(g_Table), 1, fp) == 1 &&
+                 g_Table.magic   == ROLLUPS_MAGIC   &&
+                 g_Table.version == ROLLUPS_VERSION &&
+                 g_Table.size    == (uint32_t)sizeof(RollupTable);
+        fclose(fp);
+    }
+
+    /* A blob claiming more rows than the log holds no longer matches it. */
+    const uint64_t rows = history_rows();
+    if (loaded && g_Table.historyRows > rows) loaded = false;
+
+    if (!loaded) {
+        /* First run with rollups (or layout change): one scan of the log. */
+        clear_table();
+    }
+
+    /* Fold in whatever the blob does not cover yet: rounds logged after the
+       last save (crash, kill) or, on a rebuild, the whole log. */
+    const uint64_t covered = g_Table.historyRows;
+    if (covered < rows) (void)history_replay(covered, replay_row, NULL);
+    const bool changed = !loaded || g_Table.historyRows != covered;
+
+    platform_mutex_unlock(&g_Lock);
+
+    if (changed) persist_mark_dirty(PERSIST_ROLLUPS);
+}
+
+void rollups_apply(const HistoryRecord *record, bool logged)
+{
+    if (!record) return;
+    ensure_lock();
+
+    platform_mutex_lock(&g_Lock);
+    apply_unlocked(record);
+    if (logged) g_Table.historyRows++;
+    platform_mutex_unlock(&g_Lock);
+}
+
+bool rollups_save(void)
+{
+    ensure_lock();
+
+    platform_mutex_lock(&g_Lock);
+    g_SaveCopy = g_Table;
+    platform_mutex_unlock(&g_Lock);
+
+    char path[SAVE_PATH_MAX];
+    save_path(path, sizeof(path), ROLLUPS_FILE);
+
+    FILE *fp = fopen(path, "wb");
+    if (!fp) return false;
+
+    const size_t written = fwrite(&g_SaveCopy, sizeof(g_SaveCopy), 1, fp);
+    fclose(fp);
+    return written == 1;
+}
+
+void rollups_reset(void)
+{
+    ensure_lock();
+
+    /* The rows already logged stay out of the cleared rollups. */
+    const uint64_t rows = history_rows();
+
+    platform_mutex_lock(&g_Lock);
+    clear_table();
+    g_Table.historyRows = rows;
+    platform_mutex_unlock(&g_Lock);
+}
+
+void rollups_game(HistoryGame game, HistorySummary *out)
+{
+    if (!out) return;
+    if ((int)game < 0 || game >= HISTORY_GAME_COUNT) game = HISTORY_GAME_ANY;
+    ensure_lock();
+
+    platform_mutex_lock(&g_Lock);
+    rollup_export(&g_Table.byGame[game], out);
+    platform_mutex_unlock(&g_Lock);
+}
+
+void rollups_difficulty(HistoryGame game, RollupDifficulty difficulty, HistorySummary *out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if ((int)game <= HISTORY_GAME_ANY || game >= HISTORY_GAME_COUNT) return;
+    if ((int)difficulty < 0 || difficulty >= ROLLUP_DIFFICULTY_COUNT) return;
+    ensure_lock();
+
+    platform_mutex_lock(&g_Lock);
+    rollup_export(&g_Table.byDifficulty[game][difficulty], out);
+    platform_mutex_unlock(&g_Lock);
+}
+
+int rollups_days(RollupDay *out, int max)
+{
+    if (!out || max <= 0) return 0;
+    ensure_lock();
+
+    int count = 0;
+    platform_mutex_lock(&g_Lock);
+
+    int64_t newest = 0;
+    for (int i = 0; i < ROLLUP_DAYS; ++i) {
+        if (g_Table.days[i].rollup.totals.rounds && g_Table.days[i].day > newest) newest = g_Table.days[i].day;
+    }
+
+    for (int i = 0; i < ROLLUP_DAYS; ++i) {
+        const DaySlot *slot = &g_Table.days[i];
+        if (!slot->rollup.totals.rounds || slot->day <= newest - ROLLUP_DAYS) continue;
+
+        /* Insertion sort, newest first (at most ROLLUP_DAYS entries). */
+        int at = (count < max) ? count : max - 1;
+        if (count >= max && slot->day <= out[at].day) continue;
+        while (at > 0 && out[at - 1].day < slot->day) {
+            out[at] = out[at - 1];
+            --at;
+        }
+        out[at].day = slot->day;
+        rollup_export(&slot->rollup, &out[at].totals);
+        if (count < max) ++count;
+    }
+
+    platform_mutex_unlock(&g_Lock);
+    return count;
+}
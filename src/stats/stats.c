@@ -0,0 +1,104 @@
+/*
+ * @author: Anthony Ward
+ * @upload date: 08/24/2025
+ *
+ * Round recording fan-out (see stats.h).
+ */
+
+#include "stats.h"
+#include "rollups.h"
+#include "persist.h"
+#include "core.h"
+
+#include <time.h>
+
+/* CsRoundResult is copied into a HistoryRecord field by field. */
+_Static_assert((int)CS_GAME_BLACKJACK == (int)HISTORY_GAME_BLACKJACK &&
+               (int)CS_GAME_KLONDIKE  == (int)HISTORY_GAME_SOLITAIRE &&
+               (int)CS_GAME_IDIOT     == (int)HISTORY_GAME_IDIOT, "CsGame must match HistoryGame");
+_Static_assert((int)CS_OUTCOME_WIN  == (int)HISTORY_WIN  && (int)CS_OUTCOME_LOSS == (int)HISTORY_LOSS &&
+               (int)CS_OUTCOME_PUSH == (int)HISTORY_PUSH, "CsOutcome must match HistoryOutcome");
+_Static_assert(CS_ROUND_DOUBLE == HISTORY_DEC_DOUBLE && CS_ROUND_SPLIT == HISTORY_DEC_SPLIT &&
+               CS_ROUND_SURRENDER == HISTORY_DEC_SURRENDER && CS_ROUND_INSURANCE == HISTORY_DEC_INSURANCE &&
+               CS_ROUND_NATURAL == HISTORY_DEC_NATURAL && CS_ROUND_BUST == HISTORY_DEC_BUST &&
+               CS_ROUND_UNDO == HISTORY_DEC_UNDO && CS_ROUND_HARD == HISTORY_DEC_HARD &&
+               CS_ROUND_EASY == HISTORY_DEC_EASY, "CS_ROUND_* must match HISTORY_DEC_*");
+
+void stats_record_round(const HistoryRecord *record)
+{
+    if (!record) return;
+
+    HistoryRecord stamped = *record;
+    if (stamped.timestamp == 0) stamped.timestamp = (int64_t)time(NULL);
+
+    const bool logged = history_append(&stamped);
+    rollups_apply(&stamped, logged);
+    persist_mark_dirty(PERSIST_ROLLUPS);
+}
+
+/* --------------------------------------------------------------------------- */
+/* Profile sink                                                                */
+/* --------------------------------------------------------------------------- */
+
+static GameStats *profile_game_stats(uint8_t game)
+{
+    switch (game)
+    {
+        case CS_GAME_BLACKJACK: return &playerData.blackjack;
+        case CS_GAME_KLONDIKE:  return &playerData.solitaire;
+        case CS_GAME_IDIOT:     return &playerData.idiot;
+        default:                return NULL;
+    }
+}
+
+static void profile_record(void *user, const CsRoundResult *result)
+{
+    (void)user;
+
+    GameStats *stats = profile_game_stats(result->game);
+    if (stats)
+    {
+        if (result->outcome == CS_OUTCOME_WIN)
+        {
+            stats->wins++;
+            stats->win_streak++;
+            if (stats->max_win_streak < stats->win_streak) stats->max_win_streak = stats->win_streak;
+            playerData.total_wins++;
+
+            if (result->flags & CS_ROUND_NATURAL) stats->blackjack_wins++;
+            if (result->flags & CS_ROUND_DOUBLE)  stats->doubledown_wins++;
+        }
+        else if (result->outcome == CS_OUTCOME_LOSS && (result->flags & CS_ROUND_SURRENDER))
+        {
+            /* A surrender forfeits half the bet and breaks the streak, but has
+               never counted toward losses; history still logs it as a loss. */
+            stats->win_streak = 0;
+        }
+        else if (result->outcome == CS_OUTCOME_LOSS)
+        {
+            stats->losses++;
+            stats->win_streak = 0;
+            playerData.total_losses++;
+        }
+        else
+        {
+            stats->draws++;
+            playerData.total_draws++;
+        }
+    }
+
+    const HistoryRecord record = {
+        .game       = result->game,
+        .outcome    = result->outcome,
+        .decisions  = result->flags,
+        .bet        = result->bet,
+        .payout     = result->net,
+        .durationMs = result->durationMs,
+    };
+    stats_record_round(&record);
+}
+
+CsStatsSink stats_profile_sink(void)
+{
+    return (CsStatsSink){ .record = profile_record, .user = NULL };
+}